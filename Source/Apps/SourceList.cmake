@@ -13,3 +13,7 @@ target_include_directories(convert_orientations PUBLIC ${EbsdLibProj_SOURCE_DIR}
 add_executable(gen_sym_code ${EbsdLibProj_SOURCE_DIR}/Source/Apps/gen_sym_code.cpp)
 target_link_libraries(gen_sym_code PUBLIC EbsdLib)
 target_include_directories(gen_sym_code PUBLIC ${EbsdLibProj_SOURCE_DIR}/Source)
+
+add_executable(projection_benchmark ${EbsdLibProj_SOURCE_DIR}/Source/Apps/projection_benchmark.cpp)
+target_link_libraries(projection_benchmark PUBLIC EbsdLib)
+target_include_directories(projection_benchmark PUBLIC ${EbsdLibProj_SOURCE_DIR}/Source)
@@ -10,101 +10,12 @@
 #include "EbsdLib/IO/EbsdReader.h"
 #include "EbsdLib/IO/TSL/AngPhase.h"
 #include "EbsdLib/IO/TSL/AngReader.h"
-#include "EbsdLib/LaueOps/LaueOps.h"
+#include "EbsdLib/LaueOps/IPFColorEngine.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
 #include "EbsdLib/Math/EbsdMatrixMath.h"
 #include "EbsdLib/Utilities/ColorTable.h"
 #include "EbsdLib/Utilities/TiffWriter.h"
 
-class Ang2IPF;
-
-using FloatVec3Type = std::array<float, 3>;
-/**
- * @brief The GenerateIPFColorsImpl class implements a threaded algorithm that computes the IPF
- * colors for each element in a geometry
- */
-class GenerateIPFColorsImpl
-{
-public:
-  GenerateIPFColorsImpl(FloatVec3Type& referenceDir, const std::vector<float>& eulers, int32_t* phases, std::vector<AngPhase::Pointer>& crystalStructures, bool* goodVoxels, uint8_t* colors)
-  : m_ReferenceDir(referenceDir)
-  , m_CellEulerAngles(eulers)
-  , m_CellPhases(phases)
-  , m_PhaseInfos(crystalStructures)
-  , m_GoodVoxels(goodVoxels)
-  , m_CellIPFColors(colors)
-  {
-  }
-
-  virtual ~GenerateIPFColorsImpl() = default;
-
-  void run() const
-  {
-    std::vector<LaueOps::Pointer> ops = LaueOps::GetAllOrientationOps();
-    double refDir[3] = {m_ReferenceDir[0], m_ReferenceDir[1], m_ReferenceDir[2]};
-    double dEuler[3] = {0.0, 0.0, 0.0};
-    EbsdLib::Rgb argb = 0x00000000;
-    int32_t phase = 0;
-    bool calcIPF = false;
-    size_t index = 0;
-    int32_t numPhases = static_cast<int32_t>(m_PhaseInfos.size());
-
-    std::vector<size_t> laueOpsIndex(m_PhaseInfos.size());
-    for(size_t i = 0; i < laueOpsIndex.size(); i++)
-    {
-      laueOpsIndex[i] = m_PhaseInfos[i]->determineLaueGroup();
-    }
-
-    size_t totalPoints = m_CellEulerAngles.size() / 3;
-    for(size_t i = 0; i < totalPoints; i++)
-    {
-      phase = m_CellPhases[i];
-      index = i * 3;
-      m_CellIPFColors[index] = 0;
-      m_CellIPFColors[index + 1] = 0;
-      m_CellIPFColors[index + 2] = 0;
-      dEuler[0] = m_CellEulerAngles[index];
-      dEuler[1] = m_CellEulerAngles[index + 1];
-      dEuler[2] = m_CellEulerAngles[index + 2];
-
-      // Make sure we are using a valid Euler Angles with valid crystal symmetry
-      calcIPF = true;
-      if(nullptr != m_GoodVoxels)
-      {
-        calcIPF = m_GoodVoxels[i];
-      }
-      // Sanity check the phase data to make sure we do not walk off the end of the array
-      if(phase >= numPhases)
-      {
-        // m_Filter->incrementPhaseWarningCount();
-        std::cout << "phase > number of phases" << std::endl;
-      }
-
-      size_t currentLaueOpsIndex = laueOpsIndex[phase];
-
-      if(phase < numPhases && calcIPF && currentLaueOpsIndex < EbsdLib::CrystalStructure::LaueGroupEnd)
-      {
-        argb = ops[currentLaueOpsIndex]->generateIPFColor(dEuler, refDir, false);
-        m_CellIPFColors[index] = static_cast<uint8_t>(EbsdLib::RgbColor::dRed(argb));
-        m_CellIPFColors[index + 1] = static_cast<uint8_t>(EbsdLib::RgbColor::dGreen(argb));
-        m_CellIPFColors[index + 2] = static_cast<uint8_t>(EbsdLib::RgbColor::dBlue(argb));
-
-        //  std::cout << (int32_t)(m_CellIPFColors[index]) << "\t" << (int32_t)(m_CellIPFColors[index + 1]) << (int32_t)(m_CellIPFColors[index + 2]) << m_CellEulerAngles[index] << "\t"
-        //            << m_CellEulerAngles[index + 1] << "\t" << m_CellEulerAngles[index + 2] << std::endl;
-      }
-    }
-  }
-
-private:
-  FloatVec3Type m_ReferenceDir;
-  const std::vector<float>& m_CellEulerAngles;
-  int32_t* m_CellPhases;
-  std::vector<AngPhase::Pointer> m_PhaseInfos;
-
-  bool* m_GoodVoxels;
-  uint8_t* m_CellIPFColors;
-};
-
 // -----------------------------------------------------------------------------
 class Ang2IPF
 {
@@ -178,10 +89,17 @@ public:
       }
     }
 
-    bool* goodVoxels = nullptr;
+    std::vector<uint32_t> laueIndices(crystalStructures.size());
+    for(size_t i = 0; i < laueIndices.size(); i++)
+    {
+      laueIndices[i] = crystalStructures[i]->determineLaueGroup();
+    }
+
     std::vector<uint8_t> ipfColors(totalPoints * 3, 0);
-    GenerateIPFColorsImpl generateIPF(normRefDir, eulers, phaseData, crystalStructures, goodVoxels, ipfColors.data());
-    generateIPF.run();
+    IPFColorEngine ipfColorEngine;
+    ipfColorEngine.setPhaseLaueIndices(laueIndices);
+    ipfColorEngine.setReferenceDirections({{normRefDir[0], normRefDir[1], normRefDir[2]}});
+    ipfColorEngine.computeFromEulers(eulers.data(), phaseData, nullptr, totalPoints, {ipfColors.data()});
 
     std::pair<int32_t, std::string> error = TiffWriter::WriteColorImage(outputFile, dims[0], dims[1], 3, ipfColors.data());
     if(error.first < 0)
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdDataArray.hpp"
+#include "EbsdLib/Math/EbsdLibMath.h"
+#include "EbsdLib/Math/RandomService.h"
+#include "EbsdLib/Utilities/ComputeStereographicProjection.h"
+#include "EbsdLib/Utilities/ModifiedLambertProjection.h"
+#include "EbsdLib/Utilities/PoleFigureUtilities.h"
+
+namespace
+{
+// -----------------------------------------------------------------------------
+EbsdLib::FloatArrayType::Pointer RandomSphereCoords(size_t numCoords, uint64_t seed)
+{
+  std::vector<size_t> cDims(1, 3);
+  EbsdLib::FloatArrayType::Pointer xyz = EbsdLib::FloatArrayType::CreateArray(numCoords, cDims, "xyzCoords", true);
+  EbsdLib::RandomService::EngineType generator = EbsdLib::RandomService::CreateEngine(seed);
+  std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+  for(size_t i = 0; i < numCoords; i++)
+  {
+    float phi = distribution(generator) * EbsdLib::Constants::k_2PiF;
+    float cosTheta = 2.0f * distribution(generator) - 1.0f;
+    float sinTheta = std::sqrt(std::max(0.0f, 1.0f - cosTheta * cosTheta));
+    xyz->setValue(i * 3, sinTheta * std::cos(phi));
+    xyz->setValue(i * 3 + 1, sinTheta * std::sin(phi));
+    xyz->setValue(i * 3 + 2, cosTheta);
+  }
+  return xyz;
+}
+
+// -----------------------------------------------------------------------------
+template <typename Function>
+double TimeOf(Function& function)
+{
+  auto start = std::chrono::steady_clock::now();
+  function();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Prints the best time of the parallel and the serial path. The runs alternate so that a busy
+ * machine slows both of them down alike.
+ */
+template <typename ParallelFunction, typename SerialFunction>
+void Compare(const std::string& name, int repeats, ParallelFunction parallelFunction, SerialFunction serialFunction)
+{
+  double parallelTime = std::numeric_limits<double>::max();
+  double serialTime = std::numeric_limits<double>::max();
+  for(int r = 0; r < repeats; r++)
+  {
+    parallelTime = std::min(parallelTime, TimeOf(parallelFunction));
+    serialTime = std::min(serialTime, TimeOf(serialFunction));
+  }
+  std::cout << name << ": parallel " << parallelTime << " s, serial " << serialTime << " s, speedup " << serialTime / parallelTime << std::endl;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  int imageDim = 2048;
+  int lambertDim = 512;
+  int repeats = 5;
+  if(argc > 4)
+  {
+    std::cout << "Usage: projection_benchmark [imageDim] [lambertDim] [repeats]" << std::endl;
+    return 1;
+  }
+  if(argc > 1)
+  {
+    imageDim = std::stoi(argv[1]);
+  }
+  if(argc > 2)
+  {
+    lambertDim = std::stoi(argv[2]);
+  }
+  if(argc > 3)
+  {
+    repeats = std::stoi(argv[3]);
+  }
+
+  // Two coordinates per pixel so the discrete image is split into private images
+  PoleFigureConfiguration_t config;
+  config.imageDim = imageDim;
+  config.lambertDim = lambertDim;
+  config.sphereRadius = 1.0f;
+  config.discrete = true;
+  const size_t imageSize = static_cast<size_t>(imageDim) * static_cast<size_t>(imageDim);
+  const size_t numCoords = 2 * imageSize + 1;
+  EbsdLib::FloatArrayType::Pointer xyz = RandomSphereCoords(numCoords, 4321);
+
+  EbsdLib::DoubleArrayType::Pointer intensity = EbsdLib::DoubleArrayType::CreateArray(0, "Intensity", true);
+  std::vector<double> serialIntensity;
+  Compare(
+      "Discrete " + std::to_string(imageDim) + "^2", repeats, [&]() { ComputeStereographicProjection(xyz.get(), &config, intensity.get())(); },
+      [&]() {
+        serialIntensity.assign(imageSize, 0.0);
+        ComputeStereographicProjection::AddDiscreteCoordinates(xyz->getPointer(0), numCoords, imageDim, serialIntensity.data());
+      });
+
+  // The Lambert squares interpolate every coordinate so fewer of them are used
+  const size_t numLambertCoords = 6 * static_cast<size_t>(lambertDim) * static_cast<size_t>(lambertDim);
+  xyz->resizeTuples(numLambertCoords);
+  Compare(
+      "Lambert " + std::to_string(lambertDim) + "^2", repeats, [&]() { ModifiedLambertProjection::LambertBallToSquare(xyz.get(), lambertDim, config.sphereRadius); },
+      [&]() {
+        ModifiedLambertProjection::Pointer serial = ModifiedLambertProjection::New();
+        serial->initializeSquares(lambertDim, config.sphereRadius);
+        serial->addCoordinates(xyz->getPointer(0), numLambertCoords);
+      });
+  return 0;
+}
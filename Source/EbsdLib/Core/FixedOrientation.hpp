@@ -0,0 +1,226 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @brief The FixedOrientation class holds a single orientation representation whose
+ * number of elements is known at compile time. The values live inside the object
+ * (std::array) so creating, copying and returning a FixedOrientation never touches
+ * the heap. It provides the same element access and size constructor as the
+ * Orientation class so it can be used as the InputType or OutputType of any of the
+ * OrientationTransformation functions.
+ */
+template <typename T, size_t N>
+class FixedOrientation
+{
+public:
+  using size_type = size_t;
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using iterator = typename std::array<T, N>::iterator;
+  using const_iterator = typename std::array<T, N>::const_iterator;
+
+  static constexpr size_t k_Size = N;
+
+  FixedOrientation() = default;
+  ~FixedOrientation() = default;
+
+  FixedOrientation(const FixedOrientation&) = default;
+  FixedOrientation(FixedOrientation&&) noexcept = default;
+  FixedOrientation& operator=(const FixedOrientation&) = default;
+  FixedOrientation& operator=(FixedOrientation&&) noexcept = default;
+
+  /**
+   * @brief Matches the Orientation(size, init) constructor that the transformation functions use
+   * @param size The number of elements which must equal N
+   * @param init Initialization value to be assigned to each element
+   */
+  explicit FixedOrientation(size_type size, T init = static_cast<T>(0))
+  {
+    if(size != N)
+    {
+      throw std::runtime_error("FixedOrientation constructor needs a size argument equal to its number of elements.");
+    }
+    m_Array.fill(init);
+  }
+
+  /**
+   * @brief Constructs from exactly N values
+   */
+  template <typename... Values, typename = std::enable_if_t<sizeof...(Values) == N && (N > 1)>>
+  FixedOrientation(Values... values)
+  : m_Array{{static_cast<T>(values)...}}
+  {
+  }
+
+  /**
+   * @brief Copies N values from an existing array
+   * @param ptr Pointer to at least N values
+   */
+  explicit FixedOrientation(const T* ptr)
+  {
+    for(size_t i = 0; i < N; i++)
+    {
+      m_Array[i] = ptr[i];
+    }
+  }
+
+  // ######### Iterators #########
+
+  iterator begin()
+  {
+    return m_Array.begin();
+  }
+
+  iterator end()
+  {
+    return m_Array.end();
+  }
+
+  const_iterator begin() const
+  {
+    return m_Array.begin();
+  }
+
+  const_iterator end() const
+  {
+    return m_Array.end();
+  }
+
+  // ######### Capacity #########
+
+  constexpr size_type size() const noexcept
+  {
+    return N;
+  }
+
+  constexpr bool empty() const noexcept
+  {
+    return N == 0;
+  }
+
+  // ######### Element Access #########
+
+  inline reference operator[](size_type index)
+  {
+    return m_Array[index];
+  }
+
+  inline const_reference operator[](size_type index) const
+  {
+    return m_Array[index];
+  }
+
+  inline reference at(size_type index)
+  {
+    return m_Array.at(index);
+  }
+
+  inline const_reference at(size_type index) const
+  {
+    return m_Array.at(index);
+  }
+
+  inline T* data() noexcept
+  {
+    return m_Array.data();
+  }
+
+  inline const T* data() const noexcept
+  {
+    return m_Array.data();
+  }
+
+  /**
+   * @brief Copies the values into an existing array
+   * @param ptr The destination
+   * @param size The number of values to copy. Values past N are not touched.
+   */
+  void copyInto(T* ptr, size_type size) const
+  {
+    if(N < size)
+    {
+      size = N;
+    }
+    for(size_type i = 0; i < size; i++)
+    {
+      ptr[i] = m_Array[i];
+    }
+  }
+
+private:
+  std::array<T, N> m_Array = {};
+};
+
+template <typename T>
+using Euler = FixedOrientation<T, 3>;
+template <typename T>
+using OrientMatrix = FixedOrientation<T, 9>;
+template <typename T>
+using AxisAngle = FixedOrientation<T, 4>;
+template <typename T>
+using Rodrigues = FixedOrientation<T, 4>;
+template <typename T>
+using Homochoric = FixedOrientation<T, 3>;
+template <typename T>
+using Cubochoric = FixedOrientation<T, 3>;
+template <typename T>
+using Stereographic = FixedOrientation<T, 3>;
+
+/**
+ * @brief Gives the type that holds a representation with N elements and the same value
+ * type as OrientationType. The composite transformation functions use it for their
+ * intermediate results: a dynamically sized type such as Orientation<T> is returned
+ * unchanged while a FixedOrientation is resized so that the intermediate stays on the stack.
+ */
+template <typename OrientationType, size_t N>
+struct OrientationRebind
+{
+  using type = OrientationType;
+};
+
+template <typename T, size_t M, size_t N>
+struct OrientationRebind<FixedOrientation<T, M>, N>
+{
+  using type = FixedOrientation<T, N>;
+};
+
+template <typename OrientationType, size_t N>
+using OrientationRebindType = typename OrientationRebind<OrientationType, N>::type;
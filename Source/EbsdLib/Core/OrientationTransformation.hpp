@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include "EbsdLib/Core/FixedOrientation.hpp"
 #include "EbsdLib/Core/Quaternion.hpp"
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/Math/EbsdMatrixMath.h"
@@ -1167,7 +1168,6 @@ OutputType ho2ax(const InputType& h)
 {
   OutputType res(4);
   using value_type = typename OutputType::value_type;
-  using OMHelperType = ArrayHelpers<OutputType, value_type>;
 
   value_type thr = 1.0E-8f;
 
@@ -1185,7 +1185,7 @@ OutputType ho2ax(const InputType& h)
     OutputValueType hm = hmag;
     InputType hn = h;
     OutputValueType sqrRtHMag = static_cast<OutputValueType>(1.0 / sqrt(hmag));
-    OMHelperType::scalarMultiply(hn, sqrRtHMag); // In place scalar multiply
+    ArrayHelpers<InputType, value_type>::scalarMultiply(hn, sqrRtHMag); // In place scalar multiply
     OutputValueType s = static_cast<OutputValueType>(LPs::tfit[0] + LPs::tfit[1] * hmag);
     for(int i = 2; i < 16; i++)
     {
@@ -1310,8 +1310,10 @@ OutputType om2qu(const InputType& om, typename Quaternion<typename OutputType::v
   */
   // om2ax(om, oax);
 
-  InputType eu = om2eu<InputType, InputType>(om);
-  InputType oax = eu2ax<InputType, InputType>(eu);
+  using EulerType = OrientationRebindType<InputType, 3>;
+  using AxisAngleType = OrientationRebindType<InputType, 4>;
+  EulerType eu = om2eu<InputType, EulerType>(om);
+  AxisAngleType oax = eu2ax<EulerType, AxisAngleType>(eu);
 
   if(oax[0] * res[x] < 0.0)
   {
@@ -1567,7 +1569,7 @@ OutputType ro2ho(const InputType& r)
   using OMHelperType = ArrayHelpers<OutputType, value_type>;
 
   value_type f = 0.0;
-  value_type rv = OMHelperType::sumofSquares(r);
+  value_type rv = ArrayHelpers<InputType, value_type>::sumofSquares(r);
   if(rv == 0.0)
   {
     OMHelperType::splat(res, 0.0);
@@ -1806,8 +1808,9 @@ OutputType cu2ho(const InputType& cu)
 template <typename InputType, typename OutputType>
 OutputType ro2om(const InputType& ro)
 {
-  OutputType ax = ro2ax<InputType, OutputType>(ro);
-  return ax2om<OutputType, OutputType>(ax);
+  using AxisAngleType = OrientationRebindType<OutputType, 4>;
+  AxisAngleType ax = ro2ax<InputType, AxisAngleType>(ro);
+  return ax2om<AxisAngleType, OutputType>(ax);
 }
 
 /**: ro2eu
@@ -1825,8 +1828,9 @@ OutputType ro2om(const InputType& ro)
 template <typename InputType, typename OutputType>
 OutputType ro2eu(const InputType& ro)
 {
-  OutputType om = ro2om<InputType, OutputType>(ro);
-  return om2eu<OutputType, OutputType>(om);
+  using OrientationMatrixType = OrientationRebindType<OutputType, 9>;
+  OrientationMatrixType om = ro2om<InputType, OrientationMatrixType>(ro);
+  return om2eu<OrientationMatrixType, OutputType>(om);
 }
 
 /**: eu2ho
@@ -1843,8 +1847,9 @@ OutputType ro2eu(const InputType& ro)
 template <typename InputType, typename OutputType>
 OutputType eu2ho(const InputType& eu)
 {
-  OutputType ax = eu2ax<InputType, OutputType>(eu);
-  return ax2ho<OutputType, OutputType>(ax);
+  using AxisAngleType = OrientationRebindType<OutputType, 4>;
+  AxisAngleType ax = eu2ax<InputType, AxisAngleType>(eu);
+  return ax2ho<AxisAngleType, OutputType>(ax);
 }
 
 /**: om2ro
@@ -1861,8 +1866,9 @@ OutputType eu2ho(const InputType& eu)
 template <typename InputType, typename OutputType>
 OutputType om2ro(const InputType& om)
 {
-  OutputType eu = om2eu<InputType, OutputType>(om); // Convert the OM to Euler
-  return eu2ro<OutputType, OutputType>(eu);         // Convert Euler to Rodrigues
+  using EulerType = OrientationRebindType<OutputType, 3>;
+  EulerType eu = om2eu<InputType, EulerType>(om); // Convert the OM to Euler
+  return eu2ro<EulerType, OutputType>(eu);        // Convert Euler to Rodrigues
 }
 
 /**: om2ho
@@ -1880,8 +1886,9 @@ OutputType om2ro(const InputType& om)
 template <typename InputType, typename OutputType>
 OutputType om2ho(const InputType& om)
 {
-  OutputType ax = om2ax<InputType, OutputType>(om); // Convert the OM to Axis-Angles
-  return ax2ho<OutputType, OutputType>(ax);         // Convert Axis-Angles to Homochoric
+  using AxisAngleType = OrientationRebindType<OutputType, 4>;
+  AxisAngleType ax = om2ax<InputType, AxisAngleType>(om); // Convert the OM to Axis-Angles
+  return ax2ho<AxisAngleType, OutputType>(ax);            // Convert Axis-Angles to Homochoric
 }
 
 /**: ax2eu
@@ -1899,8 +1906,9 @@ OutputType om2ho(const InputType& om)
 template <typename InputType, typename OutputType>
 OutputType ax2eu(const InputType& ax)
 {
-  OutputType om = ax2om<InputType, OutputType>(ax);
-  return om2eu<OutputType, OutputType>(om);
+  using OrientationMatrixType = OrientationRebindType<OutputType, 9>;
+  OrientationMatrixType om = ax2om<InputType, OrientationMatrixType>(ax);
+  return om2eu<OrientationMatrixType, OutputType>(om);
 }
 
 /**: ro2qu
@@ -1917,8 +1925,9 @@ OutputType ax2eu(const InputType& ax)
 template <typename InputType, typename OutputType>
 OutputType ro2qu(const InputType& ro, typename Quaternion<typename OutputType::value_type>::Order layout = Quaternion<typename OutputType::value_type>::Order::VectorScalar)
 {
-  OutputType ax = ro2ax<InputType, OutputType>(ro);
-  return ax2qu<OutputType, OutputType>(ax, layout);
+  using AxisAngleType = OrientationRebindType<OutputType, 4>;
+  AxisAngleType ax = ro2ax<InputType, AxisAngleType>(ro);
+  return ax2qu<AxisAngleType, OutputType>(ax, layout);
 }
 
 /**: ho2eu
@@ -1935,8 +1944,9 @@ OutputType ro2qu(const InputType& ro, typename Quaternion<typename OutputType::v
 template <typename InputType, typename OutputType>
 OutputType ho2eu(const InputType& ho)
 {
-  OutputType ax = ho2ax<InputType, OutputType>(ho);
-  return ax2eu<OutputType, OutputType>(ax);
+  using AxisAngleType = OrientationRebindType<OutputType, 4>;
+  AxisAngleType ax = ho2ax<InputType, AxisAngleType>(ho);
+  return ax2eu<AxisAngleType, OutputType>(ax);
 }
 
 /**: ho2om
@@ -1953,8 +1963,9 @@ OutputType ho2eu(const InputType& ho)
 template <typename InputType, typename OutputType>
 OutputType ho2om(const InputType& ho)
 {
-  OutputType ax = ho2ax<InputType, OutputType>(ho);
-  return ax2om<OutputType, OutputType>(ax);
+  using AxisAngleType = OrientationRebindType<OutputType, 4>;
+  AxisAngleType ax = ho2ax<InputType, AxisAngleType>(ho);
+  return ax2om<AxisAngleType, OutputType>(ax);
 }
 
 /**: ho2ro
@@ -1971,8 +1982,9 @@ OutputType ho2om(const InputType& ho)
 template <typename InputType, typename OutputType>
 OutputType ho2ro(const InputType& ho)
 {
-  OutputType ax = ho2ax<InputType, OutputType>(ho);
-  return ax2ro<OutputType, OutputType>(ax);
+  using AxisAngleType = OrientationRebindType<OutputType, 4>;
+  AxisAngleType ax = ho2ax<InputType, AxisAngleType>(ho);
+  return ax2ro<AxisAngleType, OutputType>(ax);
 }
 
 /**: ho2qu
@@ -1989,8 +2001,9 @@ OutputType ho2ro(const InputType& ho)
 template <typename InputType, typename OutputType>
 OutputType ho2qu(const InputType& ho, typename Quaternion<typename OutputType::value_type>::Order layout = Quaternion<typename OutputType::value_type>::Order::VectorScalar)
 {
-  InputType ax = ho2ax<InputType, InputType>(ho);
-  return ax2qu<InputType, OutputType>(ax, layout);
+  using AxisAngleType = OrientationRebindType<InputType, 4>;
+  AxisAngleType ax = ho2ax<InputType, AxisAngleType>(ho);
+  return ax2qu<AxisAngleType, OutputType>(ax, layout);
 }
 
 /**: eu2cu
@@ -2105,8 +2118,9 @@ OutputType qu2cu(const InputType& qu, typename Quaternion<typename OutputType::v
 template <typename InputType, typename OutputType>
 OutputType cu2eu(const InputType& cu)
 {
-  OutputType ho = cu2ho<InputType, OutputType>(cu);
-  return ho2eu<OutputType, OutputType>(ho);
+  using HomochoricType = OrientationRebindType<OutputType, 3>;
+  HomochoricType ho = cu2ho<InputType, HomochoricType>(cu);
+  return ho2eu<HomochoricType, OutputType>(ho);
 }
 
 /**: cu2om
@@ -2125,8 +2139,9 @@ OutputType cu2eu(const InputType& cu)
 template <typename InputType, typename OutputType>
 OutputType cu2om(const InputType& cu)
 {
-  OutputType ho = cu2ho<InputType, OutputType>(cu);
-  return ho2om<OutputType, OutputType>(ho);
+  using HomochoricType = OrientationRebindType<OutputType, 3>;
+  HomochoricType ho = cu2ho<InputType, HomochoricType>(cu);
+  return ho2om<HomochoricType, OutputType>(ho);
 }
 
 /**: cu2ax
@@ -2145,8 +2160,9 @@ OutputType cu2om(const InputType& cu)
 template <typename InputType, typename OutputType>
 OutputType cu2ax(const InputType& cu)
 {
-  OutputType ho = cu2ho<InputType, OutputType>(cu);
-  return ho2ax<OutputType, OutputType>(ho);
+  using HomochoricType = OrientationRebindType<OutputType, 3>;
+  HomochoricType ho = cu2ho<InputType, HomochoricType>(cu);
+  return ho2ax<HomochoricType, OutputType>(ho);
 }
 
 /**: cu2ro
@@ -2165,8 +2181,9 @@ OutputType cu2ax(const InputType& cu)
 template <typename InputType, typename OutputType>
 OutputType cu2ro(const InputType& cu)
 {
-  OutputType ho = cu2ho<InputType, OutputType>(cu);
-  return ho2ro<OutputType, OutputType>(ho);
+  using HomochoricType = OrientationRebindType<OutputType, 3>;
+  HomochoricType ho = cu2ho<InputType, HomochoricType>(cu);
+  return ho2ro<HomochoricType, OutputType>(ho);
 }
 
 /**: cu2qu
@@ -2280,7 +2297,6 @@ OutputType st2ax(const InputType& st)
   {
     InputType tmp = st;
     ArrayHelpers<InputType, ValueType>::scalarDivide(tmp, l);
-    OutputType ax(4);
     if(EbsdLibMath::closeEnough(l, static_cast<ValueType>(1.0L), threshold))
     {
       res = {tmp[0], tmp[1], tmp[2], static_cast<ValueType>(EbsdLib::Constants::k_PiD)};
@@ -2296,15 +2312,17 @@ OutputType st2ax(const InputType& st)
 template <typename InputType, typename OutputType>
 OutputType st2eu(const InputType& st)
 {
-  InputType ax = st2ax<InputType, InputType>(st); // Convert to Axis-Angle
-  return ax2eu<InputType, OutputType>(ax);        // Convert to Euler
+  using AxisAngleType = OrientationRebindType<InputType, 4>;
+  AxisAngleType ax = st2ax<InputType, AxisAngleType>(st); // Convert to Axis-Angle
+  return ax2eu<AxisAngleType, OutputType>(ax);            // Convert to Euler
 }
 
 template <typename InputType, typename OutputType>
 OutputType st2qu(const InputType& st, typename Quaternion<typename OutputType::value_type>::Order layout = Quaternion<typename OutputType::value_type>::Order::VectorScalar)
 {
-  InputType ax = st2ax<InputType, InputType>(st);  // Convert to Axis-Angle
-  return ax2qu<InputType, OutputType>(ax, layout); // Convert to Quaternion
+  using AxisAngleType = OrientationRebindType<InputType, 4>;
+  AxisAngleType ax = st2ax<InputType, AxisAngleType>(st); // Convert to Axis-Angle
+  return ax2qu<AxisAngleType, OutputType>(ax, layout);    // Convert to Quaternion
 }
 
 template <typename InputType, typename OutputType>
@@ -2319,7 +2337,8 @@ OutputType st2om(const InputType& st)
   {
     InputType tmp = st;
     ArrayHelpers<InputType, ValueType>::scalarDivide(tmp, l);
-    InputType ax(4);
+    using AxisAngleType = OrientationRebindType<InputType, 4>;
+    AxisAngleType ax(4);
     if(EbsdLibMath::closeEnough(l, static_cast<ValueType>(1.0L), threshold))
     {
       ax = {tmp[0], tmp[1], tmp[2], static_cast<ValueType>(EbsdLib::Constants::k_PiD)};
@@ -2328,7 +2347,7 @@ OutputType st2om(const InputType& st)
     {
       ax = {tmp[0], tmp[1], tmp[2], static_cast<ValueType>(4.0 * std::atan(l))};
     }
-    res = ax2om<InputType, OutputType>(ax);
+    res = ax2om<AxisAngleType, OutputType>(ax);
   }
   return res;
 }
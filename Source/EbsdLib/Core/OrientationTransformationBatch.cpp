@@ -0,0 +1,572 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "OrientationTransformationBatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+
+/* The batch loops are compiled once for every instruction set listed below and the
+ * dynamic loader selects the best one for the CPU (GNU indirect functions). Other
+ * compilers and platforms get a single baseline version that still auto-vectorizes
+ * for whatever instruction set the library is compiled for.
+ */
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define EBSD_BATCH_DISPATCH 1
+#define EBSD_BATCH_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default"), flatten))
+#else
+#define EBSD_BATCH_DISPATCH 0
+#define EBSD_BATCH_TARGET_CLONES
+#endif
+
+namespace
+{
+// Number of tuples that are converted into double precision scratch arrays at a time.
+constexpr size_t k_BlockSize = 256;
+
+template <size_t N>
+using Block = double[N][k_BlockSize];
+
+constexpr double k_Pi = EbsdLib::Constants::k_PiD;
+constexpr double k_2Pi = EbsdLib::Constants::k_2PiD;
+constexpr double k_PiOver2 = EbsdLib::Constants::k_PiOver2D;
+constexpr double k_PiOver4 = 0.78539816339744830962;
+
+namespace BatchMath
+{
+/**
+ * @brief Branch free select. Both values are computed before the call so the compiler
+ * can evaluate them for every lane instead of guarding the arithmetic with a branch.
+ */
+inline double Select(bool condition, double a, double b)
+{
+  return condition ? a : b;
+}
+
+/**
+ * @brief Rounds to the nearest integer valued double without calling into libm. Valid for |x| < 2^51
+ */
+inline double RoundToNearest(double x)
+{
+  constexpr double k_Magic = 6755399441055744.0; // 1.5 * 2^52
+  return (x + k_Magic) - k_Magic;
+}
+
+/**
+ * @brief sin and cos using a two part Cody-Waite reduction by pi/2 and the Cephes
+ * minimax polynomials on [-pi/4, pi/4]. Accurate to a few ulp for |x| < 1.0E5.
+ */
+inline void SinCos(double x, double& sinOut, double& cosOut)
+{
+  constexpr double k_2OverPi = 0.63661977236758134308;
+  constexpr double k_PiOver2Hi = 1.57079632673412561417E+00;
+  constexpr double k_PiOver2Lo = 6.07710050650619224932E-11;
+
+  const double q = RoundToNearest(x * k_2OverPi);
+  const double r = (x - q * k_PiOver2Hi) - q * k_PiOver2Lo;
+  const double z = r * r;
+  const double s = r + r * z * (((((1.58962301576546568060E-10 * z - 2.50507477628578072866E-8) * z + 2.75573136213857245213E-6) * z - 1.98412698295895385996E-4) * z + 8.33333333332211858878E-3) * z - 1.66666666666666307295E-1);
+  const double c = 1.0 - 0.5 * z + z * z * (((((-1.13585365213876817300E-11 * z + 2.08757008419747316778E-9) * z - 2.75573141792967388112E-7) * z + 2.48015872888517045348E-5) * z - 1.38888888888730564116E-3) * z + 4.16666666666665929218E-2);
+
+  // Quadrant of x as 0, 1, 2 or 3, computed in floating point so the loop stays in double lanes
+  const double quadrant = q - 4.0 * RoundToNearest(q * 0.25 - 0.375);
+  const bool swap = (quadrant == 1.0 || quadrant == 3.0);
+  const double sv = swap ? c : s;
+  const double cv = swap ? s : c;
+  sinOut = quadrant >= 2.0 ? -sv : sv;
+  cosOut = (quadrant == 1.0 || quadrant == 2.0) ? -cv : cv;
+}
+
+/**
+ * @brief atan2 with the same quadrant and signed zero conventions as std::atan2. The ratio
+ * |y| / |x| is reduced to |t| <= 0.66 as in the Cephes atan (folding the reduction into a
+ * single division) and then evaluated with the Cephes rational approximation.
+ */
+inline double Atan2(double y, double x)
+{
+  constexpr double k_Tan3PiOver8 = 2.41421356237309504880;
+  constexpr double k_MoreBits = 6.123233995736765886130E-17;
+
+  const double ay = std::fabs(y);
+  const double ax = std::fabs(x);
+  // 'big' takes precedence over 'mid' in every Select so the two masks stay independent compares
+  const bool big = ay > k_Tan3PiOver8 * ax;
+  const bool mid = ay > 0.66 * ax;
+  const double num = Select(big, -ax, Select(mid, ay - ax, ay));
+  const double den = Select(big, ay, Select(mid, ay + ax, ax));
+  const double t = num / Select(den == 0.0, 1.0, den); // den is only 0 when x and y are both 0
+  const double y0 = Select(big, k_PiOver2, Select(mid, k_PiOver4, 0.0));
+  const double more = Select(big, k_MoreBits, Select(mid, 0.5 * k_MoreBits, 0.0));
+
+  const double z = t * t;
+  const double p = (((-8.750608600031904122785E-1 * z - 1.615753718733365076637E1) * z - 7.500855792314704667340E1) * z - 1.228866684490136173410E2) * z - 6.485021904942025371773E1;
+  const double q = ((((z + 2.485846490142306297962E1) * z + 1.650270098316988542046E2) * z + 4.328810604912902668951E2) * z + 4.853903996359136964868E2) * z + 1.945506571482613964425E2;
+  const double angle = y0 + ((t * (z * p / q) + t) + more); // atan(|y| / |x|) in [0, pi/2]
+  // copysign(1, x) < 0 instead of signbit(x) keeps -0.0 going to pi and lets GCC vectorize the test
+  return std::copysign(Select(std::copysign(1.0, x) < 0.0, k_Pi - angle, angle), y);
+}
+
+/**
+ * @brief atan(y / x) for x != 0, i.e. the result is always in [-pi/2, pi/2]
+ */
+inline double AtanOfRatio(double y, double x)
+{
+  return Atan2(std::copysign(y, x), std::fabs(x));
+}
+
+inline double Acos(double x)
+{
+  return Atan2(std::sqrt((1.0 - x) * (1.0 + x)), x);
+}
+
+/**
+ * @brief Cube root for 0.15 <= g <= 1 using three Halley iterations from a linear guess
+ */
+inline double CbrtOfRange(double g)
+{
+  double y = 0.5 + 0.5 * g;
+  for(int i = 0; i < 3; i++)
+  {
+    const double y3 = y * y * y;
+    y = y * (y3 + 2.0 * g) / (2.0 * y3 + g);
+  }
+  return y;
+}
+
+/**
+ * @brief Returns (0.75 * (omega - sin(omega)))^(1/3) for 0 <= omega <= 2pi. The value is written
+ * as (omega / 2) * g^(1/3) with g = 6 * (omega - sin(omega)) / omega^3 so that only a cube root on
+ * [0.15, 1] is needed. Small angles use the Taylor series of g which also avoids the cancellation
+ * in omega - sin(omega).
+ */
+inline double HomochoricMagnitude(double omega, double sinOmega)
+{
+  const double w2 = omega * omega;
+  const double series = 1.0 - w2 * (1.0 / 20.0 - w2 * (1.0 / 840.0 - w2 * (1.0 / 60480.0 - w2 * (1.0 / 6652800.0))));
+  const double direct = 6.0 * (omega - sinOmega) / (w2 * omega);
+  const double g = Select(omega < 0.25, series, direct);
+  return 0.5 * omega * CbrtOfRange(g);
+}
+} // namespace BatchMath
+
+// -----------------------------------------------------------------------------
+// Per tuple kernels. These mirror the scalar functions in OrientationTransformation.hpp
+// with every branch turned into a select so that the loops vectorize.
+// -----------------------------------------------------------------------------
+const double k_Eps = Rotations::Constants::epsijkd;
+
+inline void Eu2QuKernel(const Block<3>& in, Block<4>& out, size_t i)
+{
+  const double ee0 = 0.5 * in[0][i];
+  const double ee1 = 0.5 * in[1][i];
+  const double ee2 = 0.5 * in[2][i];
+  double sPhi = 0.0;
+  double cPhi = 0.0;
+  double sm = 0.0;
+  double cm = 0.0;
+  double sp = 0.0;
+  double cp = 0.0;
+  BatchMath::SinCos(ee1, sPhi, cPhi);
+  BatchMath::SinCos(ee0 - ee2, sm, cm);
+  BatchMath::SinCos(ee0 + ee2, sp, cp);
+
+  const double w = cPhi * cp;
+  const double sign = w < 0.0 ? -1.0 : 1.0;
+  out[0][i] = sign * (-k_Eps * sPhi * cm);
+  out[1][i] = sign * (-k_Eps * sPhi * sm);
+  out[2][i] = sign * (-k_Eps * cPhi * sp);
+  out[3][i] = sign * w;
+}
+
+inline double WrapTo2Pi(double angle)
+{
+  return BatchMath::Select(angle < 0.0, angle + k_2Pi, angle);
+}
+
+inline void Qu2EuKernel(const Block<4>& in, Block<3>& out, size_t i)
+{
+  const double x = in[0][i];
+  const double y = in[1][i];
+  const double z = in[2][i];
+  const double w = in[3][i];
+
+  const double q03 = w * w + z * z;
+  const double q12 = x * x + y * y;
+  const double chi = std::sqrt(q03 * q12);
+
+  // When chi is zero the rotation is about the sample z axis (noTilt) or Phi is 180 degrees and phi2
+  // is set to zero. phi1 then comes from a different pair of arguments.
+  const bool degenerate = chi == 0.0;
+  const bool noTilt = q12 == 0.0;
+  const double phi1Y = BatchMath::Select(degenerate, BatchMath::Select(noTilt, -2.0 * k_Eps * w * z, 2.0 * x * y), -k_Eps * w * y + x * z);
+  const double phi1X = BatchMath::Select(degenerate, BatchMath::Select(noTilt, w * w - z * z, x * x - y * y), -k_Eps * w * x - y * z);
+  const double phi = BatchMath::Atan2(2.0 * chi, q03 - q12);
+  const double phi2 = WrapTo2Pi(BatchMath::Atan2(k_Eps * w * y + x * z, -k_Eps * w * x + y * z));
+
+  out[0][i] = WrapTo2Pi(BatchMath::Atan2(phi1Y, phi1X));
+  out[1][i] = BatchMath::Select(degenerate, noTilt ? 0.0 : k_Pi, phi);
+  out[2][i] = BatchMath::Select(degenerate, 0.0, phi2);
+}
+
+inline void Qu2OmKernel(const Block<4>& in, Block<9>& out, size_t i)
+{
+  const double x = in[0][i];
+  const double y = in[1][i];
+  const double z = in[2][i];
+  const double w = in[3][i];
+
+  const double qq = w * w - (x * x + y * y + z * z);
+  out[0][i] = qq + 2.0 * x * x;
+  out[4][i] = qq + 2.0 * y * y;
+  out[8][i] = qq + 2.0 * z * z;
+  out[1][i] = 2.0 * (x * y - w * z);
+  out[5][i] = 2.0 * (y * z - w * x);
+  out[6][i] = 2.0 * (z * x - w * y);
+  out[3][i] = 2.0 * (y * x + w * z);
+  out[7][i] = 2.0 * (z * y + w * x);
+  out[2][i] = 2.0 * (x * z + w * y);
+}
+
+/**
+ * @brief om2eu followed by eu2ax. Only used by om2qu to fix up the signs of the vector part.
+ */
+inline void Om2AxisDirection(double o0, double o1, double o2, double o5, double o6, double o7, double o8, double& ax0, double& ax1, double& ax2)
+{
+  // om2eu
+  const bool nearPole = std::fabs(std::fabs(o8) - 1.0) < 1.0E-6;
+  const bool nearOne = std::fabs(o8 - 1.0) < 1.0E-6;
+  // At the poles the scalar code uses atan2(o1, o0) for o8 = 1 and -atan2(-o1, o0) for o8 = -1 which is the same value
+  const double e0 = WrapTo2Pi(BatchMath::Atan2(BatchMath::Select(nearPole, o1, o6), BatchMath::Select(nearPole, o0, -o7)));
+  const double e1 = BatchMath::Select(nearPole, nearOne ? 0.0 : k_Pi, BatchMath::Acos(o8));
+  const double e2 = BatchMath::Select(nearPole, 0.0, WrapTo2Pi(BatchMath::Atan2(o2, o5)));
+
+  // eu2ax
+  double sHalf = 0.0;
+  double cHalf = 0.0;
+  double sSig = 0.0;
+  double cSig = 0.0;
+  double sDel = 0.0;
+  double cDel = 0.0;
+  BatchMath::SinCos(0.5 * e1, sHalf, cHalf);
+  const double sig = 0.5 * (e0 + e2);
+  BatchMath::SinCos(sig, sSig, cSig);
+  BatchMath::SinCos(0.5 * (e0 - e2), sDel, cDel);
+  const double t = sHalf / cHalf;
+  const double tau = std::sqrt(t * t + sSig * sSig);
+  const double alpha = BatchMath::Select(std::fabs(sig - k_PiOver2) < 1.0E-6, k_Pi, 2.0 * BatchMath::AtanOfRatio(tau, cSig));
+  const bool identity = std::fabs(alpha) < 1.0E-6;
+  const double scale = (alpha < 0.0 ? k_Eps : -k_Eps) / tau;
+  ax0 = BatchMath::Select(identity, 0.0, scale * t * cDel);
+  ax1 = BatchMath::Select(identity, 0.0, scale * t * sDel);
+  ax2 = BatchMath::Select(identity, 1.0, scale * sSig);
+}
+
+template <typename T>
+inline void Om2QuKernel(const Block<9>& in, Block<4>& out, size_t i)
+{
+  constexpr double k_Threshold = sizeof(T) == 4 ? 1.0E-6 : 1.0E-10;
+  const double o0 = in[0][i];
+  const double o1 = in[1][i];
+  const double o2 = in[2][i];
+  const double o3 = in[3][i];
+  const double o4 = in[4][i];
+  const double o5 = in[5][i];
+  const double o6 = in[6][i];
+  const double o7 = in[7][i];
+  const double o8 = in[8][i];
+
+  double s = o0 + o4 + o8 + 1.0;
+  double s1 = o0 - o4 - o8 + 1.0;
+  double s2 = -o0 + o4 - o8 + 1.0;
+  double s3 = -o0 - o4 + o8 + 1.0;
+  s = std::sqrt(std::fabs(s) < k_Threshold ? 0.0 : s);
+  s1 = std::sqrt(std::fabs(s1) < k_Threshold ? 0.0 : s1);
+  s2 = std::sqrt(std::fabs(s2) < k_Threshold ? 0.0 : s2);
+  s3 = std::sqrt(std::fabs(s3) < k_Threshold ? 0.0 : s3);
+
+  double w = 0.5 * s;
+  double x = 0.5 * s1;
+  double y = 0.5 * s2;
+  double z = 0.5 * s3;
+  x = BatchMath::Select(o7 < o5, -k_Eps * x, x);
+  y = BatchMath::Select(o2 < o6, -k_Eps * y, y);
+  z = BatchMath::Select(o3 < o1, -k_Eps * z, z);
+
+  const double mag = std::sqrt(w * w + x * x + y * y + z * z);
+  const double invMag = BatchMath::Select(mag != 0.0, 1.0 / mag, 1.0);
+  w *= invMag;
+  x *= invMag;
+  y *= invMag;
+  z *= invMag;
+
+  double ax0 = 0.0;
+  double ax1 = 0.0;
+  double ax2 = 0.0;
+  Om2AxisDirection(o0, o1, o2, o5, o6, o7, o8, ax0, ax1, ax2);
+  out[0][i] = BatchMath::Select(ax0 * x < 0.0, -x, x);
+  out[1][i] = BatchMath::Select(ax1 * y < 0.0, -y, y);
+  out[2][i] = BatchMath::Select(ax2 * z < 0.0, -z, z);
+  out[3][i] = w;
+}
+
+inline void Qu2RoKernel(const Block<4>& in, Block<4>& out, size_t i)
+{
+  constexpr double k_Threshold = 1.0E-8;
+  const double x = in[0][i];
+  const double y = in[1][i];
+  const double z = in[2][i];
+  const double w = in[3][i];
+
+  const double s = std::sqrt(x * x + y * y + z * z);
+  const bool halfTurn = w < k_Threshold;
+  const bool identity = !halfTurn && s < k_Threshold;
+  const double invS = 1.0 / s;
+  out[0][i] = BatchMath::Select(halfTurn, x, BatchMath::Select(identity, 0.0, x * invS));
+  out[1][i] = BatchMath::Select(halfTurn, y, BatchMath::Select(identity, 0.0, y * invS));
+  out[2][i] = BatchMath::Select(halfTurn, z, BatchMath::Select(identity, k_Eps, z * invS));
+  // tan(acos(w)) without the trigonometry
+  out[3][i] = BatchMath::Select(halfTurn, std::numeric_limits<double>::infinity(), BatchMath::Select(identity, 0.0, std::sqrt((1.0 - w) * (1.0 + w)) / w));
+}
+
+inline void Ro2QuKernel(const Block<4>& in, Block<4>& out, size_t i)
+{
+  const double r0 = in[0][i];
+  const double r1 = in[1][i];
+  const double r2 = in[2][i];
+  const double ta = in[3][i];
+
+  // cos(atan(ta)) and sin(atan(ta)) without the trigonometry and without overflowing ta * ta
+  const bool large = std::fabs(ta) > 1.0;
+  const double u = BatchMath::Select(large, 1.0 / ta, ta);
+  const double k = 1.0 / std::sqrt(1.0 + u * u);
+  const double c = BatchMath::Select(large, std::fabs(u) * k, k);
+  const double s = BatchMath::Select(large, std::copysign(k, ta), ta * k);
+
+  // The scalar code does not normalize the axis of a 180 degree (infinite) Rodrigues vector
+  const double invLength = BatchMath::Select(ta == std::numeric_limits<double>::infinity(), 1.0, 1.0 / std::sqrt(r0 * r0 + r1 * r1 + r2 * r2));
+  const bool identity = std::fabs(ta) < 1.0E-6;
+  out[0][i] = BatchMath::Select(identity, 0.0, r0 * invLength * s);
+  out[1][i] = BatchMath::Select(identity, 0.0, r1 * invLength * s);
+  out[2][i] = BatchMath::Select(identity, 0.0, r2 * invLength * s);
+  out[3][i] = identity ? 1.0 : c;
+}
+
+inline void Qu2HoKernel(const Block<4>& in, Block<3>& out, size_t i)
+{
+  const double x = in[0][i];
+  const double y = in[1][i];
+  const double z = in[2][i];
+  const double w = in[3][i];
+
+  const double omega = 2.0 * BatchMath::Acos(w);
+  double sinOmega = 0.0;
+  double cosOmega = 0.0;
+  BatchMath::SinCos(omega, sinOmega, cosOmega);
+  const double f = BatchMath::HomochoricMagnitude(omega, sinOmega) / std::sqrt(x * x + y * y + z * z);
+  const bool identity = omega == 0.0;
+  out[0][i] = BatchMath::Select(identity, 0.0, x * f);
+  out[1][i] = BatchMath::Select(identity, 0.0, y * f);
+  out[2][i] = BatchMath::Select(identity, 0.0, z * f);
+}
+
+inline void Ho2QuKernel(const Block<3>& in, Block<4>& out, size_t i)
+{
+  namespace LPs = EbsdLib::LambertParametersType;
+  const double h0 = in[0][i];
+  const double h1 = in[1][i];
+  const double h2 = in[2][i];
+
+  const double hmag = h0 * h0 + h1 * h1 + h2 * h2;
+  double t = LPs::tfit[15];
+  for(int j = 14; j >= 0; j--)
+  {
+    t = t * hmag + LPs::tfit[j];
+  }
+  // t is cos(omega/2) of the axis angle pair the scalar code computes with 2 * acos(t)
+  t = std::min(std::max(t, -1.0), 1.0);
+  const bool halfTurn = std::fabs(t) < 5.0E-9;
+  const double c = halfTurn ? 0.0 : t;
+  const double s = BatchMath::Select(halfTurn, 1.0, std::sqrt((1.0 - t) * (1.0 + t)));
+  const double f = s / std::sqrt(hmag);
+  const bool identity = hmag == 0.0;
+  out[0][i] = BatchMath::Select(identity, 0.0, h0 * f);
+  out[1][i] = BatchMath::Select(identity, 0.0, h1 * f);
+  out[2][i] = BatchMath::Select(identity, 0.0, h2 * f);
+  out[3][i] = identity ? 1.0 : c;
+}
+
+/**
+ * @brief Converts 'count' tuples by copying blocks of the component arrays into double precision
+ * scratch arrays, running the kernel over the block and copying the results back out. The scratch
+ * arrays cannot alias so the kernel loop vectorizes without any runtime overlap checks.
+ */
+template <size_t NIn, size_t NOut, typename T, typename KernelType>
+inline void RunBlocks(const T* const* input, T* const* output, size_t count, KernelType kernel)
+{
+  alignas(64) Block<NIn> src;
+  alignas(64) Block<NOut> dst;
+  for(size_t start = 0; start < count; start += k_BlockSize)
+  {
+    const size_t numTuples = std::min(k_BlockSize, count - start);
+    for(size_t c = 0; c < NIn; c++)
+    {
+      const T* ptr = input[c] + start;
+      for(size_t i = 0; i < numTuples; i++)
+      {
+        src[c][i] = static_cast<double>(ptr[i]);
+      }
+    }
+    for(size_t i = 0; i < numTuples; i++)
+    {
+      kernel(src, dst, i);
+    }
+    for(size_t c = 0; c < NOut; c++)
+    {
+      T* ptr = output[c] + start;
+      for(size_t i = 0; i < numTuples; i++)
+      {
+        ptr[i] = static_cast<T>(dst[c][i]);
+      }
+    }
+  }
+}
+
+#define EBSD_BATCH_LOOP(NAME, KERNEL, NIN, NOUT)                                                                                                                                                       \
+  EBSD_BATCH_TARGET_CLONES void NAME(const float* const* input, float* const* output, size_t count)                                                                                                    \
+  {                                                                                                                                                                                                    \
+    RunBlocks<NIN, NOUT>(input, output, count, [](const auto& src, auto& dst, size_t i) { KERNEL(src, dst, i); });                                                                                     \
+  }                                                                                                                                                                                                    \
+  EBSD_BATCH_TARGET_CLONES void NAME(const double* const* input, double* const* output, size_t count)                                                                                                  \
+  {                                                                                                                                                                                                    \
+    RunBlocks<NIN, NOUT>(input, output, count, [](const auto& src, auto& dst, size_t i) { KERNEL(src, dst, i); });                                                                                     \
+  }
+
+EBSD_BATCH_LOOP(Eu2QuLoop, Eu2QuKernel, 3, 4)
+EBSD_BATCH_LOOP(Qu2EuLoop, Qu2EuKernel, 4, 3)
+EBSD_BATCH_LOOP(Qu2OmLoop, Qu2OmKernel, 4, 9)
+EBSD_BATCH_LOOP(Qu2RoLoop, Qu2RoKernel, 4, 4)
+EBSD_BATCH_LOOP(Ro2QuLoop, Ro2QuKernel, 4, 4)
+EBSD_BATCH_LOOP(Qu2HoLoop, Qu2HoKernel, 4, 3)
+EBSD_BATCH_LOOP(Ho2QuLoop, Ho2QuKernel, 3, 4)
+
+// om2qu uses a different threshold for float input, just like the scalar version
+EBSD_BATCH_TARGET_CLONES void Om2QuLoop(const float* const* input, float* const* output, size_t count)
+{
+  RunBlocks<9, 4>(input, output, count, [](const auto& src, auto& dst, size_t i) { Om2QuKernel<float>(src, dst, i); });
+}
+EBSD_BATCH_TARGET_CLONES void Om2QuLoop(const double* const* input, double* const* output, size_t count)
+{
+  RunBlocks<9, 4>(input, output, count, [](const auto& src, auto& dst, size_t i) { Om2QuKernel<double>(src, dst, i); });
+}
+
+template <typename T, size_t NIn, size_t NOut>
+size_t CheckSizes(const OrientationTransformation::Batch::SoASpan<const T, NIn>& input, const OrientationTransformation::Batch::SoASpan<T, NOut>& output, const char* name)
+{
+  if(input.size != output.size)
+  {
+    throw std::invalid_argument(std::string("OrientationTransformation::Batch::") + name + " input and output spans must have the same size.");
+  }
+  return input.size;
+}
+} // namespace
+
+namespace OrientationTransformation::Batch
+{
+// -----------------------------------------------------------------------------
+const char* InstructionSet()
+{
+#if EBSD_BATCH_DISPATCH
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx512f"))
+  {
+    return "AVX-512";
+  }
+  if(__builtin_cpu_supports("avx2"))
+  {
+    return "AVX2";
+  }
+#endif
+  return "Baseline";
+}
+
+#define EBSD_BATCH_ENTRY_POINT(NAME, LOOP, IN_SPAN, OUT_SPAN)                                                                                                                                          \
+  void NAME(const IN_SPAN<const float>& input, const OUT_SPAN<float>& output)                                                                                                                         \
+  {                                                                                                                                                                                                    \
+    LOOP(input.components.data(), output.components.data(), CheckSizes(input, output, #NAME));                                                                                                        \
+  }                                                                                                                                                                                                    \
+  void NAME(const IN_SPAN<const double>& input, const OUT_SPAN<double>& output)                                                                                                                       \
+  {                                                                                                                                                                                                    \
+    LOOP(input.components.data(), output.components.data(), CheckSizes(input, output, #NAME));                                                                                                        \
+  }
+
+EBSD_BATCH_ENTRY_POINT(eu2qu, Eu2QuLoop, EulerSpan, QuaternionSpan)
+EBSD_BATCH_ENTRY_POINT(qu2eu, Qu2EuLoop, QuaternionSpan, EulerSpan)
+EBSD_BATCH_ENTRY_POINT(om2qu, Om2QuLoop, OrientationMatrixSpan, QuaternionSpan)
+EBSD_BATCH_ENTRY_POINT(qu2ro, Qu2RoLoop, QuaternionSpan, RodriguesSpan)
+EBSD_BATCH_ENTRY_POINT(ro2qu, Ro2QuLoop, RodriguesSpan, QuaternionSpan)
+EBSD_BATCH_ENTRY_POINT(qu2ho, Qu2HoLoop, QuaternionSpan, HomochoricSpan)
+EBSD_BATCH_ENTRY_POINT(ho2qu, Ho2QuLoop, HomochoricSpan, QuaternionSpan)
+
+// -----------------------------------------------------------------------------
+void qu2om(const QuaternionSpan<const float>& input, const OrientationMatrixSpan<float>& output)
+{
+  OrientationMatrixSpan<float> om = output;
+  if(Rotations::Constants::epsijk != 1.0f)
+  {
+    // Active convention: write the transpose
+    std::swap(om.components[1], om.components[3]);
+    std::swap(om.components[2], om.components[6]);
+    std::swap(om.components[5], om.components[7]);
+  }
+  Qu2OmLoop(input.components.data(), om.components.data(), CheckSizes(input, output, "qu2om"));
+}
+
+// -----------------------------------------------------------------------------
+void qu2om(const QuaternionSpan<const double>& input, const OrientationMatrixSpan<double>& output)
+{
+  OrientationMatrixSpan<double> om = output;
+  if(Rotations::Constants::epsijk != 1.0f)
+  {
+    std::swap(om.components[1], om.components[3]);
+    std::swap(om.components[2], om.components[6]);
+    std::swap(om.components[5], om.components[7]);
+  }
+  Qu2OmLoop(input.components.data(), om.components.data(), CheckSizes(input, output, "qu2om"));
+}
+} // namespace OrientationTransformation::Batch
@@ -0,0 +1,352 @@
+/* ============================================================================
+ * Copyright (c) 2023-2023 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "EbsdSidecarCache.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+constexpr char k_Magic[8] = {'E', 'B', 'S', 'D', 'C', 'A', 'C', 'H'};
+constexpr uint32_t k_Version = 1;
+constexpr uint32_t k_ByteOrderMark = 0x01020304;
+constexpr size_t k_ColumnAlignment = 64;
+
+// -----------------------------------------------------------------------------
+size_t GetElementSize(EbsdLib::NumericTypes::Type type)
+{
+  switch(type)
+  {
+  case EbsdLib::NumericTypes::Type::Int8:
+  case EbsdLib::NumericTypes::Type::UInt8:
+  case EbsdLib::NumericTypes::Type::Bool:
+    return 1;
+  case EbsdLib::NumericTypes::Type::Int16:
+  case EbsdLib::NumericTypes::Type::UInt16:
+    return 2;
+  case EbsdLib::NumericTypes::Type::Int32:
+  case EbsdLib::NumericTypes::Type::UInt32:
+  case EbsdLib::NumericTypes::Type::Float:
+    return 4;
+  case EbsdLib::NumericTypes::Type::Int64:
+  case EbsdLib::NumericTypes::Type::UInt64:
+  case EbsdLib::NumericTypes::Type::Double:
+    return 8;
+  case EbsdLib::NumericTypes::Type::SizeT:
+    return sizeof(size_t);
+  default:
+    return 0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+size_t AlignOffset(size_t offset)
+{
+  return (offset + k_ColumnAlignment - 1) / k_ColumnAlignment * k_ColumnAlignment;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void AppendValue(std::string& out, T value)
+{
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// -----------------------------------------------------------------------------
+void AppendString(std::string& out, const std::string& value)
+{
+  AppendValue<uint64_t>(out, value.size());
+  out.append(value);
+}
+
+/**
+ * @brief Bounds checked reader over the mapped cache. Any read past the end clears 'ok'.
+ */
+struct CacheCursor
+{
+  const char* data = nullptr;
+  size_t size = 0;
+  size_t pos = 0;
+  bool ok = true;
+
+  template <typename T>
+  T read()
+  {
+    T value = {};
+    if(!ok || size - pos < sizeof(T))
+    {
+      ok = false;
+      return value;
+    }
+    ::memcpy(&value, data + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+  }
+
+  std::string readString()
+  {
+    uint64_t length = read<uint64_t>();
+    if(!ok || size - pos < length)
+    {
+      ok = false;
+      return {};
+    }
+    std::string value(data + pos, length);
+    pos += length;
+    return value;
+  }
+};
+
+// -----------------------------------------------------------------------------
+std::string SerializeMetaData(const EbsdSidecarCache::SourceStamp& stamp, const std::string& options, const std::string& header, const std::vector<std::string>& headerLines,
+                              const std::vector<EbsdSidecarCache::Column>& columns, const std::vector<uint64_t>& offsets)
+{
+  std::string out(k_Magic, sizeof(k_Magic));
+  AppendValue<uint32_t>(out, k_Version);
+  AppendValue<uint32_t>(out, k_ByteOrderMark);
+  AppendString(out, stamp.path);
+  AppendValue<uint64_t>(out, stamp.size);
+  AppendValue<int64_t>(out, stamp.modified);
+  AppendString(out, options);
+  AppendString(out, header);
+  AppendValue<uint64_t>(out, headerLines.size());
+  for(const auto& line : headerLines)
+  {
+    AppendString(out, line);
+  }
+  AppendValue<uint64_t>(out, columns.size());
+  for(size_t i = 0; i < columns.size(); i++)
+  {
+    AppendString(out, columns[i].name);
+    AppendValue<int32_t>(out, static_cast<int32_t>(columns[i].type));
+    AppendValue<int32_t>(out, columns[i].columnIndex);
+    AppendValue<uint64_t>(out, columns[i].numElements);
+    AppendValue<uint64_t>(out, offsets[i]);
+  }
+  return out;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+EbsdSidecarCache::EbsdSidecarCache() = default;
+
+// -----------------------------------------------------------------------------
+EbsdSidecarCache::~EbsdSidecarCache() = default;
+
+// -----------------------------------------------------------------------------
+std::string EbsdSidecarCache::GetCachePath(const std::string& sourcePath)
+{
+  return sourcePath + ".ebsdcache";
+}
+
+// -----------------------------------------------------------------------------
+bool EbsdSidecarCache::Stamp(const std::string& sourcePath, SourceStamp& stamp)
+{
+  std::error_code ec;
+  fs::path path = fs::absolute(fs::path(sourcePath), ec).lexically_normal();
+  if(ec)
+  {
+    return false;
+  }
+  uintmax_t size = fs::file_size(path, ec);
+  if(ec)
+  {
+    return false;
+  }
+  fs::file_time_type modified = fs::last_write_time(path, ec);
+  if(ec)
+  {
+    return false;
+  }
+  stamp.path = path.string();
+  stamp.size = static_cast<uint64_t>(size);
+  stamp.modified = static_cast<int64_t>(modified.time_since_epoch().count());
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+int EbsdSidecarCache::Write(const SourceStamp& stamp, const std::string& options, const std::string& header, const std::vector<std::string>& headerLines, const std::vector<Column>& columns)
+{
+  // The offsets do not change the size of the meta data so it is serialized twice
+  std::vector<uint64_t> offsets(columns.size(), 0);
+  size_t offset = SerializeMetaData(stamp, options, header, headerLines, columns, offsets).size();
+  for(size_t i = 0; i < columns.size(); i++)
+  {
+    size_t elementSize = GetElementSize(columns[i].type);
+    if(elementSize == 0 || (columns[i].data == nullptr && columns[i].numElements > 0))
+    {
+      return -1;
+    }
+    offset = AlignOffset(offset);
+    offsets[i] = offset;
+    offset += elementSize * columns[i].numElements;
+  }
+  std::string metaData = SerializeMetaData(stamp, options, header, headerLines, columns, offsets);
+
+  std::string cachePath = GetCachePath(stamp.path);
+  std::string tempPath = cachePath + ".tmp";
+  {
+    std::ofstream out(tempPath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if(!out.is_open())
+    {
+      return -2;
+    }
+    out.write(metaData.data(), static_cast<std::streamsize>(metaData.size()));
+    size_t written = metaData.size();
+    const char padding[k_ColumnAlignment] = {};
+    for(size_t i = 0; i < columns.size(); i++)
+    {
+      out.write(padding, static_cast<std::streamsize>(offsets[i] - written));
+      size_t numBytes = GetElementSize(columns[i].type) * columns[i].numElements;
+      out.write(static_cast<const char*>(columns[i].data), static_cast<std::streamsize>(numBytes));
+      written = offsets[i] + numBytes;
+    }
+    if(!out.good())
+    {
+      out.close();
+      std::error_code ec;
+      fs::remove(tempPath, ec);
+      return -3;
+    }
+  }
+
+  std::error_code ec;
+  fs::rename(tempPath, cachePath, ec);
+  if(ec)
+  {
+    fs::remove(tempPath, ec);
+    return -4;
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+bool EbsdSidecarCache::open(const std::string& sourcePath, const std::string& options)
+{
+  close();
+  SourceStamp stamp;
+  if(!Stamp(sourcePath, stamp) || !m_File.open(GetCachePath(stamp.path)))
+  {
+    return false;
+  }
+
+  CacheCursor cursor{m_File.data(), m_File.size()};
+  bool valid = cursor.size >= sizeof(k_Magic) && ::memcmp(cursor.data, k_Magic, sizeof(k_Magic)) == 0;
+  cursor.pos = sizeof(k_Magic);
+  valid = valid && cursor.read<uint32_t>() == k_Version;
+  valid = valid && cursor.read<uint32_t>() == k_ByteOrderMark;
+  valid = valid && cursor.readString() == stamp.path;
+  valid = valid && cursor.read<uint64_t>() == stamp.size;
+  valid = valid && cursor.read<int64_t>() == stamp.modified;
+  valid = valid && cursor.readString() == options;
+  if(valid)
+  {
+    m_Header = cursor.readString();
+    uint64_t numLines = cursor.read<uint64_t>();
+    for(uint64_t i = 0; i < numLines && cursor.ok; i++)
+    {
+      m_HeaderLines.push_back(cursor.readString());
+    }
+    uint64_t numColumns = cursor.read<uint64_t>();
+    for(uint64_t i = 0; i < numColumns && cursor.ok; i++)
+    {
+      Column column;
+      column.name = cursor.readString();
+      column.type = static_cast<EbsdLib::NumericTypes::Type>(cursor.read<int32_t>());
+      column.columnIndex = cursor.read<int32_t>();
+      column.numElements = cursor.read<uint64_t>();
+      uint64_t offset = cursor.read<uint64_t>();
+      size_t elementSize = GetElementSize(column.type);
+      // Reject columns that do not fit inside the file
+      if(elementSize == 0 || offset > cursor.size || column.numElements > (cursor.size - offset) / elementSize)
+      {
+        cursor.ok = false;
+        break;
+      }
+      column.data = cursor.data + offset;
+      m_Columns.push_back(column);
+    }
+    valid = cursor.ok;
+  }
+  if(!valid)
+  {
+    close();
+  }
+  return valid;
+}
+
+// -----------------------------------------------------------------------------
+void EbsdSidecarCache::close()
+{
+  m_File.close();
+  m_Header.clear();
+  m_HeaderLines.clear();
+  m_Columns.clear();
+}
+
+// -----------------------------------------------------------------------------
+bool EbsdSidecarCache::isOpen() const
+{
+  return m_File.isOpen();
+}
+
+// -----------------------------------------------------------------------------
+const std::string& EbsdSidecarCache::getHeader() const
+{
+  return m_Header;
+}
+
+// -----------------------------------------------------------------------------
+const std::vector<std::string>& EbsdSidecarCache::getHeaderLines() const
+{
+  return m_HeaderLines;
+}
+
+// -----------------------------------------------------------------------------
+const std::vector<EbsdSidecarCache::Column>& EbsdSidecarCache::getColumns() const
+{
+  return m_Columns;
+}
+
+// -----------------------------------------------------------------------------
+const EbsdSidecarCache::Column* EbsdSidecarCache::findColumn(const std::string& name, EbsdLib::NumericTypes::Type type, size_t numElements) const
+{
+  for(const auto& column : m_Columns)
+  {
+    if(column.name == name && column.type == type && column.numElements == numElements)
+    {
+      return &column;
+    }
+  }
+  return nullptr;
+}
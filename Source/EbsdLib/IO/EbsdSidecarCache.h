@@ -0,0 +1,146 @@
+/* ============================================================================
+ * Copyright (c) 2023-2023 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/IO/MemoryMappedFile.h"
+
+/**
+ * @class EbsdSidecarCache EbsdSidecarCache.h EbsdLib/IO/EbsdSidecarCache.h
+ * @brief Binary cache of a parsed scan file that is stored next to the source file
+ * (see GetCachePath()). The cache holds the header text, the header lines that were
+ * handed to the header parser and the raw column arrays in native (little endian) byte
+ * order. Each column starts on a 64 byte boundary so open() can memory map the cache
+ * and expose the columns without copying them.
+ *
+ * The cache is keyed on the absolute path, the size and the modification time of the
+ * source file plus an options string supplied by the reader for any setting that
+ * changes the parsed values. open() rejects a cache whose key does not match, so a
+ * cache becomes stale automatically when the source file changes; the next Write()
+ * replaces it.
+ */
+class EbsdLib_EXPORT EbsdSidecarCache
+{
+public:
+  /**
+   * @brief Identifies a version of the source file.
+   */
+  struct SourceStamp
+  {
+    std::string path;
+    uint64_t size = 0;
+    int64_t modified = 0;
+  };
+
+  /**
+   * @brief A single column of values. When returned from an opened cache 'data' points
+   * into the memory mapping and stays valid until the cache is closed.
+   */
+  struct Column
+  {
+    std::string name;
+    EbsdLib::NumericTypes::Type type = EbsdLib::NumericTypes::Type::UnknownNumType;
+    int32_t columnIndex = -1;
+    size_t numElements = 0;
+    const void* data = nullptr;
+  };
+
+  EbsdSidecarCache();
+  ~EbsdSidecarCache();
+
+  /**
+   * @brief Returns the path of the cache for the given source file.
+   */
+  static std::string GetCachePath(const std::string& sourcePath);
+
+  /**
+   * @brief Collects the key of the source file. Readers take the stamp before parsing so
+   * a file that changes while it is read never produces a valid cache.
+   * @return false if the file does not exist.
+   */
+  static bool Stamp(const std::string& sourcePath, SourceStamp& stamp);
+
+  /**
+   * @brief Writes the cache for a source file. The cache is written to a temporary file
+   * first and renamed so a concurrent open() never sees a partial cache.
+   * @param stamp The key of the source file taken before it was parsed
+   * @param options Reader settings that change the parsed values
+   * @param header The original header text
+   * @param headerLines The lines that were handed to the header parser
+   * @param columns The column arrays
+   * @return Zero on success or a negative value if the cache could not be written.
+   */
+  static int Write(const SourceStamp& stamp, const std::string& options, const std::string& header, const std::vector<std::string>& headerLines, const std::vector<Column>& columns);
+
+  /**
+   * @brief Maps the cache of the source file.
+   * @return true if a cache exists, is complete and matches the source file and options.
+   */
+  bool open(const std::string& sourcePath, const std::string& options);
+
+  /**
+   * @brief Unmaps the cache. Column data pointers are invalid afterwards.
+   */
+  void close();
+
+  bool isOpen() const;
+
+  const std::string& getHeader() const;
+
+  const std::vector<std::string>& getHeaderLines() const;
+
+  const std::vector<Column>& getColumns() const;
+
+  /**
+   * @brief Returns the named column or nullptr if the cache does not hold the column with
+   * the given type and number of values.
+   */
+  const Column* findColumn(const std::string& name, EbsdLib::NumericTypes::Type type, size_t numElements) const;
+
+private:
+  MemoryMappedFile m_File;
+  std::string m_Header;
+  std::vector<std::string> m_HeaderLines;
+  std::vector<Column> m_Columns;
+
+public:
+  EbsdSidecarCache(const EbsdSidecarCache&) = delete;            // Copy Constructor Not Implemented
+  EbsdSidecarCache(EbsdSidecarCache&&) = delete;                 // Move Constructor Not Implemented
+  EbsdSidecarCache& operator=(const EbsdSidecarCache&) = delete; // Copy Assignment Not Implemented
+  EbsdSidecarCache& operator=(EbsdSidecarCache&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,273 @@
+/* ============================================================================
+ * Copyright (c) 2023-2023 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "EbsdLib/IO/HKL/CtfConstants.h"
+#include "EbsdLib/IO/HKL/DataParser.hpp"
+#include "EbsdLib/Utilities/EbsdStringUtils.hpp"
+
+/**
+ * @brief A typed destination array for one column of a .ctf file. The parser is kept for
+ * values that the fast conversion does not accept so those still get the DataParser semantics.
+ */
+template <typename T>
+struct CtfColumnSink
+{
+  T* data = nullptr;
+  DataParser* parser = nullptr;
+};
+
+/**
+ * @class CtfColumnPlan CtfColumnPlan.hpp EbsdLib/IO/HKL/CtfColumnPlan.hpp
+ * @brief Decodes the data lines of a .ctf file into the arrays owned by the reader's
+ * DataParsers. The plan is resolved once from the column header. When the first columns
+ * are the standard HKL layout (Phase, X, Y, Bands, Error, Euler1-3, MAD, BC, BS) they are
+ * decoded through a fixed tuple of typed sinks, so a row is converted without virtual
+ * calls or temporary strings. Any remaining column is decoded through its DataParser.
+ * A column without a parser is skipped without any conversion.
+ *
+ * The plan only writes the arrays at the index it is given, so several threads may
+ * decode different rows with the same plan.
+ */
+class CtfColumnPlan
+{
+public:
+  template <typename T>
+  using Sink = CtfColumnSink<T>;
+  using StandardSinks = std::tuple<Sink<int32_t>, Sink<float>, Sink<float>, Sink<int32_t>, Sink<int32_t>, Sink<float>, Sink<float>, Sink<float>, Sink<float>, Sink<int32_t>, Sink<int32_t>>;
+  static constexpr size_t k_NumStandardColumns = std::tuple_size_v<StandardSinks>;
+
+  CtfColumnPlan() = default;
+
+  /**
+   * @brief Resolves the plan for the given columns.
+   * @param names The name of every column in the order the columns appear in the file
+   * @param columns The parser of every column in the same order. A nullptr skips the column.
+   */
+  CtfColumnPlan(const std::vector<std::string>& names, const std::vector<DataParser*>& columns)
+  : m_Columns(columns)
+  {
+    const std::array<const std::string*, k_NumStandardColumns> standardNames = {&EbsdLib::Ctf::Phase,  &EbsdLib::Ctf::X,      &EbsdLib::Ctf::Y,      &EbsdLib::Ctf::Bands,
+                                                                                &EbsdLib::Ctf::Error,  &EbsdLib::Ctf::Euler1, &EbsdLib::Ctf::Euler2, &EbsdLib::Ctf::Euler3,
+                                                                                &EbsdLib::Ctf::MAD,    &EbsdLib::Ctf::BC,     &EbsdLib::Ctf::BS};
+    m_UseStandardSinks = names.size() == columns.size() && columns.size() >= k_NumStandardColumns;
+    for(size_t i = 0; i < k_NumStandardColumns && m_UseStandardSinks; i++)
+    {
+      m_UseStandardSinks = (names[i] == *standardNames[i]);
+    }
+    if(m_UseStandardSinks)
+    {
+      m_UseStandardSinks = bindStandardSinks(std::make_index_sequence<k_NumStandardColumns>{});
+    }
+    m_FirstGenericColumn = m_UseStandardSinks ? k_NumStandardColumns : 0;
+  }
+
+  ~CtfColumnPlan() = default;
+
+  CtfColumnPlan(const CtfColumnPlan&) = default;
+  CtfColumnPlan(CtfColumnPlan&&) noexcept = default;
+  CtfColumnPlan& operator=(const CtfColumnPlan&) = default;
+  CtfColumnPlan& operator=(CtfColumnPlan&&) noexcept = default;
+
+  /**
+   * @brief Returns true if the standard columns are decoded through the typed sinks.
+   */
+  bool usesStandardLayout() const
+  {
+    return m_UseStandardSinks;
+  }
+
+  /**
+   * @brief Returns the number of columns each data line must have.
+   */
+  size_t getNumberOfColumns() const
+  {
+    return m_Columns.size();
+  }
+
+  /**
+   * @brief Decodes one data line. Leading and trailing whitespace is ignored and European
+   * style decimal commas are accepted.
+   * @param line The data line
+   * @param index The index of the data point the line belongs to
+   * @param scratch Buffer reused by the DataParser fall back
+   * @return 0 on success, -109 if the number of tab delimited values does not match the
+   * number of columns or -104 if a value could not be converted.
+   */
+  int decode(std::string_view line, size_t index, std::string& scratch) const
+  {
+    line = Trimmed(line);
+    int err = 0;
+    if(m_UseStandardSinks)
+    {
+      err = decodeStandard(line, index, std::make_index_sequence<k_NumStandardColumns>{});
+    }
+    for(size_t i = m_FirstGenericColumn; i < m_Columns.size() && err == 0; i++)
+    {
+      std::string_view token = EbsdStringUtils::nextToken(line, "\t");
+      if(token.empty())
+      {
+        return -109;
+      }
+      err = ParseWithParser(token, m_Columns[i], index, scratch);
+    }
+    if(err == 0 && !EbsdStringUtils::nextToken(line, "\t").empty())
+    {
+      return -109;
+    }
+    return err;
+  }
+
+  /**
+   * @brief Returns the number of tab delimited values in the line. Used for error messages.
+   */
+  static size_t CountTokens(std::string_view line)
+  {
+    line = Trimmed(line);
+    size_t count = 0;
+    while(!EbsdStringUtils::nextToken(line, "\t").empty())
+    {
+      count++;
+    }
+    return count;
+  }
+
+private:
+  std::vector<DataParser*> m_Columns;
+  StandardSinks m_Sinks;
+  bool m_UseStandardSinks = false;
+  size_t m_FirstGenericColumn = 0;
+
+  template <size_t... I>
+  bool bindStandardSinks(std::index_sequence<I...> /*unused*/)
+  {
+    return (bindSink(std::get<I>(m_Sinks), m_Columns[I]) && ...);
+  }
+
+  template <typename T>
+  static bool bindSink(Sink<T>& sink, DataParser* parser)
+  {
+    if(parser == nullptr)
+    {
+      return true;
+    }
+    using ParserType = std::conditional_t<std::is_same_v<T, int32_t>, Int32Parser, FloatParser>;
+    auto* typedParser = dynamic_cast<ParserType*>(parser);
+    if(typedParser == nullptr)
+    {
+      return false;
+    }
+    sink.data = typedParser->getPtr();
+    sink.parser = parser;
+    return true;
+  }
+
+  template <size_t... I>
+  int decodeStandard(std::string_view& line, size_t index, std::index_sequence<I...> /*unused*/) const
+  {
+    int err = 0;
+    static_cast<void>((((err = decodeSink(std::get<I>(m_Sinks), line, index)) == 0) && ...));
+    return err;
+  }
+
+  template <typename T>
+  static int decodeSink(const Sink<T>& sink, std::string_view& line, size_t index)
+  {
+    std::string_view token = EbsdStringUtils::nextToken(line, "\t");
+    if(token.empty())
+    {
+      return -109;
+    }
+    if(sink.data == nullptr)
+    {
+      return 0;
+    }
+    if(EbsdStringUtils::convert(token, sink.data[index]))
+    {
+      return 0;
+    }
+    // European style decimals use a comma
+    std::array<char, 64> buffer = {};
+    if(token.size() < buffer.size() && token.find(',') != std::string_view::npos)
+    {
+      std::memcpy(buffer.data(), token.data(), token.size());
+      std::replace(buffer.begin(), buffer.begin() + token.size(), ',', '.');
+      if(EbsdStringUtils::convert(std::string_view(buffer.data(), token.size()), sink.data[index]))
+      {
+        return 0;
+      }
+    }
+    std::string scratch;
+    return ParseWithParser(token, sink.parser, index, scratch);
+  }
+
+  static int ParseWithParser(std::string_view token, DataParser* parser, size_t index, std::string& scratch)
+  {
+    if(parser == nullptr)
+    {
+      return 0;
+    }
+    scratch.assign(token);
+    std::replace(scratch.begin(), scratch.end(), ',', '.');
+    try
+    {
+      parser->parse(scratch, index);
+    } catch(const std::exception&)
+    {
+      return -104;
+    }
+    return 0;
+  }
+
+  static std::string_view Trimmed(std::string_view line)
+  {
+    size_t front = line.find_first_not_of(EbsdStringUtils::k_Whitespaces);
+    if(front == std::string_view::npos)
+    {
+      return {};
+    }
+    size_t back = line.find_last_not_of(EbsdStringUtils::k_Whitespaces);
+    return line.substr(front, back - front + 1);
+  }
+};
@@ -40,10 +40,15 @@
 #include <iostream>
 #include <sstream>
 
+#include "CtfColumnPlan.hpp"
 #include "CtfPhase.h"
 #include "EbsdLib/Core/EbsdMacros.h"
+#include "EbsdLib/IO/EbsdSidecarCache.h"
+#include "EbsdLib/IO/LineChunker.h"
+#include "EbsdLib/IO/MemoryMappedFile.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
 #include "EbsdLib/Utilities/EbsdStringUtils.hpp"
+#include "EbsdLib/Utilities/ParallelDataAlgorithm.hpp"
 
 // #define PI_OVER_2f       90.0f
 // #define THREE_PI_OVER_2f 270.0f
@@ -87,6 +92,60 @@ std::istream& safeGetline(std::istream& is, std::string& t)
   }
 }
 
+/**
+ * @brief Parses each chunk of the data section. Only lines in [firstLine, endLine) are
+ * parsed, which is how a single slice of a 3D file is read. Parsing of a chunk stops at
+ * the first line that fails.
+ */
+class ParseCtfChunksImpl
+{
+public:
+  ParseCtfChunksImpl(const CtfColumnPlan& plan, std::vector<LineChunker::Chunk>& chunks, size_t firstLine, size_t endLine)
+  : m_Plan(plan)
+  , m_Chunks(chunks)
+  , m_FirstLine(firstLine)
+  , m_EndLine(endLine)
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    std::string scratch;
+    for(size_t c = start; c < end; c++)
+    {
+      LineChunker::Chunk& chunk = m_Chunks[c];
+      std::string_view text = chunk.text;
+      size_t lineIndex = chunk.firstLine;
+      while(lineIndex < m_EndLine)
+      {
+        // Blank lines are not data points, the chunk line indices do not count them either
+        std::string_view line = LineChunker::NextDataLine(text);
+        if(line.empty())
+        {
+          break;
+        }
+        if(lineIndex >= m_FirstLine)
+        {
+          chunk.errorCode = m_Plan.decode(line, lineIndex - m_FirstLine, scratch);
+          chunk.parsedLines++;
+          if(chunk.errorCode < 0)
+          {
+            chunk.errorLine = lineIndex;
+            break;
+          }
+        }
+        lineIndex++;
+      }
+    }
+  }
+
+private:
+  const CtfColumnPlan& m_Plan;
+  std::vector<LineChunker::Chunk>& m_Chunks;
+  size_t m_FirstLine = 0;
+  size_t m_EndLine = 0;
+};
+
 } // namespace
 
 // -----------------------------------------------------------------------------
@@ -121,6 +180,10 @@ CtfReader::CtfReader()
   setXCells(0);
   setYCells(0);
   setZCells(1);
+
+  m_UseMemoryMappedIO = false;
+  m_UseParallelParsing = false;
+  m_UseSidecarCache = false;
 }
 
 // -----------------------------------------------------------------------------
@@ -420,9 +483,31 @@ int CtfReader::readFile()
   setErrorCode(0);
   setErrorMessage("");
   std::string buf;
-  std::ifstream in(getFileName(), std::ios_base::in);
   setHeaderIsComplete(false);
-  if(!in.is_open())
+
+  EbsdSidecarCache::SourceStamp stamp;
+  bool useCache = m_UseSidecarCache && EbsdSidecarCache::Stamp(getFileName(), stamp);
+  if(useCache && readSidecarCache())
+  {
+    return 0;
+  }
+
+  bool useMappedFile = m_UseMemoryMappedIO || m_UseParallelParsing;
+  MemoryMappedFile mappedFile;
+  std::string_view mappedData;
+  std::ifstream in;
+  if(useMappedFile)
+  {
+    if(mappedFile.open(getFileName()))
+    {
+      mappedData = mappedFile.view();
+    }
+  }
+  else
+  {
+    in.open(getFileName(), std::ios_base::in);
+  }
+  if(useMappedFile ? !mappedFile.isOpen() : !in.is_open())
   {
     std::string msg = std::string("Ctf file could not be opened: ") + getFileName();
     setErrorCode(-100);
@@ -435,7 +520,7 @@ int CtfReader::readFile()
 
   // Parse the header
   std::vector<std::string> headerLines;
-  err = getHeaderLines(in, headerLines);
+  err = useMappedFile ? getHeaderLines(mappedData, headerLines) : getHeaderLines(in, headerLines);
   if(err < 0)
   {
     return err;
@@ -446,6 +531,110 @@ int CtfReader::readFile()
     return err;
   }
 
+  err = checkHeaderValues();
+  if(err < 0)
+  {
+    return err;
+  }
+
+  std::string header = getOriginalHeader();
+  err = useMappedFile ? readMappedData(mappedData) : readData(in);
+
+  if(err >= 0 && useCache)
+  {
+    // The line of column names was appended to the original header while reading the data
+    headerLines.push_back(getOriginalHeader().substr(header.size()));
+    writeSidecarCache(stamp, header, headerLines);
+  }
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::string CtfReader::getSidecarCacheOptions() const
+{
+  return "ctf slice=" + std::to_string(m_SingleSliceRead);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CtfReader::readSidecarCache()
+{
+  EbsdSidecarCache cache;
+  if(!cache.open(getFileName(), getSidecarCacheOptions()) || cache.getHeaderLines().empty())
+  {
+    return false;
+  }
+
+  std::vector<std::string> headerLines = cache.getHeaderLines();
+  std::string buf = headerLines.back();
+  headerLines.pop_back();
+  setOriginalHeader(cache.getHeader());
+  m_PhaseVector.clear();
+
+  std::vector<std::string> names;
+  std::vector<DataParser::Pointer> parsers;
+  bool loaded = parseHeaderLines(headerLines) >= 0 && checkHeaderValues() >= 0 && parseColumnHeader(buf, names) >= 0 && createColumnParsers(names, getNumberOfElements(), parsers) >= 0;
+  size_t numElements = getNumberOfElements();
+  for(size_t i = 0; loaded && i < parsers.size(); i++)
+  {
+    if(nullptr == parsers[i])
+    {
+      continue;
+    }
+    EbsdLib::NumericTypes::Type type = getPointerType(names[i]);
+    const EbsdSidecarCache::Column* column = cache.findColumn(names[i], type, numElements);
+    if(nullptr == column)
+    {
+      loaded = false;
+      break;
+    }
+    size_t elementSize = (type == EbsdLib::NumericTypes::Type::Int32) ? sizeof(int32_t) : sizeof(float);
+    ::memcpy(parsers[i]->getVoidPointer(), column->data, numElements * elementSize);
+  }
+
+  if(!loaded)
+  {
+    // Leave the reader as it was so the file is parsed instead
+    m_PhaseVector.clear();
+    setOriginalHeader("");
+    setErrorCode(0);
+    setErrorMessage("");
+    return false;
+  }
+
+  setHeaderIsComplete(true);
+  for(size_t i = 0; i < parsers.size(); i++)
+  {
+    if(nullptr != parsers[i])
+    {
+      m_NamePointerMap[names[i]] = parsers[i];
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CtfReader::writeSidecarCache(const EbsdSidecarCache::SourceStamp& stamp, const std::string& header, const std::vector<std::string>& headerLines)
+{
+  std::vector<EbsdSidecarCache::Column> columns;
+  for(const auto& entry : m_NamePointerMap)
+  {
+    columns.push_back({entry.first, getPointerType(entry.first), entry.second->getColumnIndex(), getNumberOfElements(), entry.second->getVoidPointer()});
+  }
+  // The cache is only an accelerator so a cache that can not be written is not an error
+  EbsdSidecarCache::Write(stamp, getSidecarCacheOptions(), header, headerLines, columns);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int CtfReader::checkHeaderValues()
+{
   if(getXStep() == 0.0 || getYStep() == 0.0f)
   {
     setErrorMessage("Either the X Step or Y Step was Zero (0.0) which is NOT allowed. Please update the CTF file header with appropriate values.");
@@ -457,10 +646,67 @@ int CtfReader::readFile()
     setErrorMessage("Either the X Cells or Y Cells was Zero (0) which is NOT allowed. Please update the CTF file header with appropriate values.");
     return -103;
   }
+  return 0;
+}
 
-  err = readData(in);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::unique_ptr<CtfDataStream> CtfReader::openStream(size_t rowsPerBlock)
+{
+  setErrorCode(0);
+  setErrorMessage("");
+  setHeaderIsComplete(false);
+  std::ifstream in(getFileName(), std::ios_base::in);
+  if(!in.is_open())
+  {
+    std::string msg = std::string("Ctf file could not be opened: ") + getFileName();
+    setErrorCode(-100);
+    setErrorMessage(msg);
+    return nullptr;
+  }
+  std::string origHeader;
+  setOriginalHeader(origHeader);
+  m_PhaseVector.clear();
 
-  return err;
+  // Parse the header
+  std::vector<std::string> headerLines;
+  int err = getHeaderLines(in, headerLines);
+  if(err >= 0)
+  {
+    err = parseHeaderLines(headerLines);
+  }
+  if(err >= 0)
+  {
+    err = checkHeaderValues();
+  }
+
+  // Every slice is streamed
+  int singleSliceRead = m_SingleSliceRead;
+  m_SingleSliceRead = -1;
+  std::string buf;
+  std::vector<std::string> names;
+  std::vector<DataParser::Pointer> parsers;
+  if(err >= 0)
+  {
+    std::getline(in, buf);
+    err = parseColumnHeader(buf, names);
+  }
+  m_SingleSliceRead = singleSliceRead;
+  rowsPerBlock = std::max<size_t>(rowsPerBlock, 1);
+  if(err >= 0)
+  {
+    err = createColumnParsers(names, rowsPerBlock, parsers);
+  }
+  if(err < 0)
+  {
+    if(getErrorCode() >= 0)
+    {
+      setErrorCode(err);
+    }
+    return nullptr;
+  }
+  return std::make_unique<CtfDataStream>(std::move(in), names, std::move(parsers), getNumberOfElements(), rowsPerBlock);
 }
 
 // -----------------------------------------------------------------------------
@@ -476,7 +722,77 @@ void CtfReader::readOnlySliceIndex(int slice)
 // -----------------------------------------------------------------------------
 int CtfReader::readData(std::ifstream& in)
 {
+  std::string buf;
+
+  // Read the column Headers and allocate the necessary arrays
+  std::getline(in, buf);
+  CtfColumnPlan plan;
+  int err = initializeDataArrays(buf, plan);
+  if(err < 0)
+  {
+    return err;
+  }
+
+  int32_t xCells = getXCells();
+  int32_t yCells = getYCells();
+  int32_t zStart = 0;
+  int32_t zEnd = getZCells();
+
+  std::string scratch;
+
+  // Now start reading the data line by line
+  size_t counter = 0;
+  for(int slice = zStart; slice < zEnd; ++slice)
+  {
+    for(size_t row = 0; row < yCells; ++row)
+    {
+      for(size_t col = 0; col < xCells; ++col)
+      {
+        // Blank lines are skipped the same way the memory mapped path skips them
+        if(!LineChunker::ReadDataLine(in, buf))
+        {
+          break;
+        }
+        buf = EbsdStringUtils::trimmed(buf); // Remove leading and trailing whitespace
+
+        if((m_SingleSliceRead < 0) || (m_SingleSliceRead >= 0 && slice == m_SingleSliceRead))
+        {
+          err = plan.decode(buf, counter, scratch);
+          if(err < 0)
+          {
+            return setDataLineError(err, buf, row, plan.getNumberOfColumns());
+          }
+          ++counter;
+        }
+      }
+      if(in.eof())
+      {
+        break;
+      }
+    }
+    //   std::cout << ".ctf Z Slice " << slice << " Reading complete." << std::endl;
+    if(m_SingleSliceRead >= 0 && slice == m_SingleSliceRead)
+    {
+      break;
+    }
+  }
+
+  if(counter != getNumberOfElements() && in.eof())
+  {
+    std::stringstream ss;
+    ss << "Premature End Of File reached.\n" << getFileName() << "\nNumRows=" << getNumberOfElements() << "\ncounter=" << counter << "\nTotal Data Points Read=" << counter << "\n";
+    setErrorMessage(ss.str());
+    setErrorCode(-105);
+    return -105;
+  }
+  return 0;
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int CtfReader::parseColumnHeader(std::string& buf, std::vector<std::string>& names)
+{
   // Initialize new pointers
   int32_t xCells = getXCells();
   if(xCells < 0)
@@ -500,9 +816,6 @@ int CtfReader::readData(std::ifstream& in)
   }
 
   int32_t zCells = getZCells();
-  int32_t zStart = 0;
-  int32_t zEnd = zCells;
-
   if(zCells < 0 || m_SingleSliceRead >= 0)
   {
     zCells = 1;
@@ -511,52 +824,62 @@ int CtfReader::readData(std::ifstream& in)
 
   setNumberOfElements(totalScanPoints);
 
-  std::string buf;
-
-  // Read the column Headers and allocate the necessary arrays
-  std::getline(in, buf);
   std::string originalHeader = getOriginalHeader();
   originalHeader = originalHeader + buf;
   setOriginalHeader(originalHeader);
   buf = EbsdStringUtils::trimmed(buf); // Remove leading and trailing whitespace
 
-  EbsdStringUtils::StringTokenType tokens = EbsdStringUtils::split(buf, '\t'); // Tokenize the array with a tab
+  names = EbsdStringUtils::split(buf, '\t'); // Tokenize the array with a tab
+  return 0;
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int CtfReader::createColumnParsers(const std::vector<std::string>& tokens, size_t numElements, std::vector<DataParser::Pointer>& parsers)
+{
   EbsdLib::NumericTypes::Type pType = EbsdLib::NumericTypes::Type::UnknownNumType;
   int32_t size = static_cast<int32_t>(tokens.size());
   bool didAllocate = false;
+  std::set<std::string> columnNames;
+  parsers.assign(tokens.size(), DataParser::NullPointer());
   for(int32_t i = 0; i < size; ++i)
   {
 
     std::string name = tokens[i];
     pType = getPointerType(name);
-    if(m_NamePointerMap.find(name) != m_NamePointerMap.end())
+    if(!columnNames.insert(name).second)
     {
       std::stringstream ss;
       ss << "Column Header '" << name << "' has been found multiple times in the Header Row. Please check the CTF file for mistakes.";
       setErrorMessage(ss.str());
       return -110;
     }
+    if(EbsdLib::NumericTypes::Type::UnknownNumType != pType && !isArrayRequested(name))
+    {
+      // The column is skipped by the plan so nothing is allocated for it
+      continue;
+    }
     if(EbsdLib::NumericTypes::Type::Int32 == pType)
     {
-      Int32Parser::Pointer dparser = Int32Parser::New(nullptr, totalScanPoints, name, i);
-      didAllocate = dparser->allocateArray(totalScanPoints);
+      Int32Parser::Pointer dparser = Int32Parser::New(nullptr, numElements, name, i);
+      didAllocate = dparser->allocateArray(numElements);
       // Q_ASSERT_X(dparser->getVoidPointer() != nullptr, __FILE__, "Could not allocate memory for Integer data in CTF File.");
       if(didAllocate)
       {
-        ::memset(dparser->getVoidPointer(), 0xAB, sizeof(int32_t) * totalScanPoints);
-        m_NamePointerMap[name] = dparser;
+        ::memset(dparser->getVoidPointer(), 0xAB, sizeof(int32_t) * numElements);
+        parsers[i] = dparser;
       }
     }
     else if(EbsdLib::NumericTypes::Type::Float == pType)
     {
-      FloatParser::Pointer dparser = FloatParser::New(nullptr, totalScanPoints, name, i);
-      didAllocate = dparser->allocateArray(totalScanPoints);
+      FloatParser::Pointer dparser = FloatParser::New(nullptr, numElements, name, i);
+      didAllocate = dparser->allocateArray(numElements);
       // Q_ASSERT_X(dparser->getVoidPointer() != nullptr, __FILE__, "Could not allocate memory for Integer data in CTF File.");
       if(didAllocate)
       {
-        ::memset(dparser->getVoidPointer(), 0xAB, sizeof(float) * totalScanPoints);
-        m_NamePointerMap[name] = dparser;
+        ::memset(dparser->getVoidPointer(), 0xAB, sizeof(float) * numElements);
+        parsers[i] = dparser;
       }
     }
     else
@@ -575,54 +898,117 @@ int CtfReader::readData(std::ifstream& in)
       ss << "\n X Cells: " << getXCells();
       ss << "\n Y Cells: " << getYCells();
       ss << "\n Z Cells: " << getZCells();
-      ss << "\n Total Scan Points: " << totalScanPoints;
+      ss << "\n Total Scan Points: " << numElements;
       setErrorMessage(ss.str());
       return -106; // Could not allocate the memory
     }
   }
 
-  // Now start reading the data line by line
-  int err = 0;
-  size_t counter = 0;
-  for(int slice = zStart; slice < zEnd; ++slice)
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int CtfReader::initializeDataArrays(std::string& buf, CtfColumnPlan& plan)
+{
+  std::vector<std::string> names;
+  int err = parseColumnHeader(buf, names);
+  if(err < 0)
   {
-    for(size_t row = 0; row < yCells; ++row)
+    return err;
+  }
+  std::vector<DataParser::Pointer> parsers;
+  err = createColumnParsers(names, getNumberOfElements(), parsers);
+  if(err < 0)
+  {
+    return err;
+  }
+
+  std::vector<DataParser*> columns(parsers.size(), nullptr);
+  for(size_t i = 0; i < parsers.size(); i++)
+  {
+    if(nullptr != parsers[i])
     {
-      for(size_t col = 0; col < xCells; ++col)
-      {
-        std::getline(in, buf);               // Read the line into a std:::string including the newline
-        buf = EbsdStringUtils::trimmed(buf); // Remove leading and trailing whitespace
+      m_NamePointerMap[names[i]] = parsers[i];
+      columns[i] = parsers[i].get();
+    }
+  }
+  plan = CtfColumnPlan(names, columns);
+  return 0;
+}
 
-        if((m_SingleSliceRead < 0) || (m_SingleSliceRead >= 0 && slice == m_SingleSliceRead))
-        {
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CtfReader::setArraysToRead(const std::set<std::string>& names)
+{
+  m_ArrayNames = names;
+}
 
-          if(in.eof() && buf.empty()) // We have to have read to the end of the file AND the buffer is empty
-                                      // otherwise we read EXACTLY the last line and we still need to parse the line.
-          {
-            //  ++counter; // We need to make sure this gets incremented before leaving
-            break;
-          }
-          err = parseDataLine(buf, row, col, counter, xCells, yCells);
-          if(err < 0)
-          {
-            return err;
-          }
-          ++counter;
-        }
-      }
-      if(in.eof())
-      {
-        break;
-      }
-    }
-    //   std::cout << ".ctf Z Slice " << slice << " Reading complete." << std::endl;
-    if(m_SingleSliceRead >= 0 && slice == m_SingleSliceRead)
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CtfReader::readAllArrays(bool b)
+{
+  m_ReadAllArrays = b;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CtfReader::isArrayRequested(const std::string& name) const
+{
+  return m_ReadAllArrays || m_ArrayNames.find(name) != m_ArrayNames.end();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int CtfReader::readMappedData(std::string_view data)
+{
+  // Read the column Headers and allocate the necessary arrays
+  std::string buf(EbsdStringUtils::nextLine(data));
+  CtfColumnPlan plan;
+  int err = initializeDataArrays(buf, plan);
+  if(err < 0)
+  {
+    return err;
+  }
+
+  size_t pointsPerSlice = static_cast<size_t>(getXCells()) * static_cast<size_t>(getYCells());
+  size_t firstLine = 0;
+  size_t endLine = getNumberOfElements();
+  if(m_SingleSliceRead >= 0)
+  {
+    firstLine = static_cast<size_t>(m_SingleSliceRead) * pointsPerSlice;
+    endLine = firstLine + pointsPerSlice;
+  }
+
+  size_t numChunks = m_UseParallelParsing ? LineChunker::SuggestedChunkCount(data.size()) : 1;
+  std::vector<LineChunker::Chunk> chunks = LineChunker::Split(data, numChunks, true);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, chunks.size());
+  dataAlg.execute(ParseCtfChunksImpl(plan, chunks, firstLine, endLine));
+
+  // Report the first failure in file order so the error matches a serial read
+  const LineChunker::Chunk* errorChunk = LineChunker::FirstError(chunks);
+  if(errorChunk != nullptr)
+  {
+    size_t row = (errorChunk->errorLine / getXCells()) % getYCells();
+    // Find the offending line again for the error message
+    std::string_view text = errorChunk->text;
+    std::string_view line;
+    for(size_t i = errorChunk->firstLine; i <= errorChunk->errorLine; i++)
     {
-      break;
+      line = LineChunker::NextDataLine(text);
     }
+    return setDataLineError(errorChunk->errorCode, line, row, plan.getNumberOfColumns());
   }
 
-  if(counter != getNumberOfElements() && in.eof())
+  size_t counter = LineChunker::ParsedLines(chunks);
+  if(counter != getNumberOfElements())
   {
     std::stringstream ss;
     ss << "Premature End Of File reached.\n" << getFileName() << "\nNumRows=" << getNumberOfElements() << "\ncounter=" << counter << "\nTotal Data Points Read=" << counter << "\n";
@@ -758,48 +1144,28 @@ int CtfReader::parseHeaderLines(std::vector<std::string>& headerLines)
 }
 
 // -----------------------------------------------------------------------------
-//  Read the data part of the .ctf file
+//
 // -----------------------------------------------------------------------------
-int CtfReader::parseDataLine(std::string& line, size_t row, size_t col, size_t offset, size_t xCells, size_t yCells)
+int CtfReader::setDataLineError(int err, std::string_view line, size_t row, size_t numColumns)
 {
-  /* When reading the data there should be at least 11 cols of data.
-   */
-  //  float x, y,  p1, p, p2, mad;
-  //  int phase, bCount, error, bc, bs;
-  //  size_t offset = i;
-
-  // Filter the line to convert European command style decimals to US/UK style points
-  //  std::vector<char> cLine(line.size()+1);
-  //  ::memcpy( &(cLine.front()), line.c_str(), line.size() + 1);
-  for(int c = 0; c < line.size(); ++c)
-  {
-    if(line.at(c) == ',')
-    {
-      line[c] = '.';
-    }
-  }
-
-  EbsdStringUtils::StringTokenType tokens = EbsdStringUtils::split(line, '\t');
-  if(tokens.size() != m_NamePointerMap.size())
+  std::stringstream ss;
+  if(err == -109)
   {
     setErrorCode(-107);
-    std::stringstream ss;
-    ss << "The number of tab delimited data columns (" << tokens.size() << ") does not match the number of tab delimited header columns (";
-    ss << m_NamePointerMap.size() << "). Please check the CTF file for mistakes, specifically the header line that labels each column of data.";
+    ss << "The number of tab delimited data columns (" << CtfColumnPlan::CountTokens(line) << ") does not match the number of tab delimited header columns (";
+    ss << numColumns << "). Please check the CTF file for mistakes, specifically the header line that labels each column of data.";
     ss << "The error occurred at data row " << row << " which is " << row << " past ";
     ss << "the column header row.";
     ss << "\nThe CTF Reader will now abort reading any further in the file.";
-
-    setErrorMessage(ss.str());
-    return -109;
   }
-
-  for(const auto& iter : m_NamePointerMap)
+  else
   {
-    DataParser::Pointer dparser = iter.second;
-    dparser->parse(tokens[dparser->getColumnIndex()], offset);
+    setErrorCode(err);
+    ss << "Error parsing the data line (Numeric conversion) at data row " << row << ".\n" << line;
+    ss << "\nThe CTF Reader will now abort reading any further in the file.";
   }
-  return 0;
+  setErrorMessage(ss.str());
+  return err;
 }
 
 #if 0
@@ -864,6 +1230,45 @@ int CtfReader::getHeaderLines(std::ifstream& reader, std::vector<std::string>& h
   return err;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int CtfReader::getHeaderLines(std::string_view& buffer, std::vector<std::string>& headerLines)
+{
+  int err = 0;
+
+  int numPhases = -1;
+  while(!buffer.empty() && !getHeaderIsComplete())
+  {
+    std::string buf(EbsdStringUtils::nextLine(buffer));
+    // Match safeGetline() which removes the carriage return as well
+    if(!buf.empty() && buf.back() == '\r')
+    {
+      buf.pop_back();
+    }
+    appendOriginalHeader(std::string(buf));
+    headerLines.push_back(buf);
+    if(buf.find("Phases") != std::string::npos)
+    {
+      std::vector<std::string> tokens = EbsdStringUtils::split(buf, '\t');
+      numPhases = std::stoi(tokens.at(1));
+      break; //
+    }
+  }
+  // Now read the phases line
+  for(int p = 0; p < numPhases; ++p)
+  {
+    std::string buf(EbsdStringUtils::nextLine(buffer));
+    appendOriginalHeader(std::string(buf));
+
+    // remove the newline at the end of the line
+    buf = EbsdStringUtils::chop(buf, 1);
+    headerLines.push_back(buf);
+  }
+  setHeaderIsComplete(true);
+  return err;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -1009,7 +1414,13 @@ int CtfReader::writeFile(const std::string& filepath)
     int aType = {0};
   };
 
-  std::vector<ColInfoType> colInfos(colNames.size());
+  // Columns that were not read leave a gap in the column indices
+  int32_t numColumns = 0;
+  for(const auto& entry : m_NamePointerMap)
+  {
+    numColumns = std::max(numColumns, entry.second->getColumnIndex() + 1);
+  }
+  std::vector<ColInfoType> colInfos(numColumns);
 
   for(const auto& name : colNames)
   {
@@ -1035,6 +1446,7 @@ int CtfReader::writeFile(const std::string& filepath)
 
     colInfos[dparser->getColumnIndex()] = colInfo;
   }
+  colInfos.erase(std::remove_if(colInfos.begin(), colInfos.end(), [](const ColInfoType& colInfo) { return colInfo.ptr == nullptr; }), colInfos.end());
 
   size_t counter = 0;
   for(int slice = zStart; slice < zEnd; ++slice)
@@ -1084,3 +1496,177 @@ std::string CtfReader::ClassName()
 {
   return std::string("CtfReader");
 }
+
+// -----------------------------------------------------------------------------
+CtfDataStream::Iterator::Iterator(CtfDataStream* stream)
+: m_Stream(stream)
+{
+}
+
+// -----------------------------------------------------------------------------
+CtfDataStream::Iterator::reference CtfDataStream::Iterator::operator*() const
+{
+  return m_Stream->getBlock();
+}
+
+// -----------------------------------------------------------------------------
+CtfDataStream::Iterator::pointer CtfDataStream::Iterator::operator->() const
+{
+  return &m_Stream->getBlock();
+}
+
+// -----------------------------------------------------------------------------
+CtfDataStream::Iterator& CtfDataStream::Iterator::operator++()
+{
+  if(!m_Stream->readNextBlock())
+  {
+    m_Stream = nullptr;
+  }
+  return *this;
+}
+
+// -----------------------------------------------------------------------------
+bool CtfDataStream::Iterator::operator==(const Iterator& other) const
+{
+  return m_Stream == other.m_Stream;
+}
+
+// -----------------------------------------------------------------------------
+bool CtfDataStream::Iterator::operator!=(const Iterator& other) const
+{
+  return m_Stream != other.m_Stream;
+}
+
+// -----------------------------------------------------------------------------
+CtfDataStream::CtfDataStream(std::ifstream&& in, const std::vector<std::string>& names, std::vector<DataParser::Pointer> parsers, size_t numElements, size_t rowsPerBlock)
+: m_InStream(std::move(in))
+, m_Names(names)
+, m_Parsers(std::move(parsers))
+, m_NumberOfElements(numElements)
+, m_RowsPerBlock(rowsPerBlock)
+{
+  std::vector<DataParser*> columns(m_Parsers.size(), nullptr);
+  for(size_t i = 0; i < m_Parsers.size(); i++)
+  {
+    columns[i] = m_Parsers[i].get();
+  }
+  m_Plan = CtfColumnPlan(m_Names, columns);
+
+  m_Block.phase = static_cast<const int32_t*>(getPointerByName(EbsdLib::Ctf::Phase));
+  m_Block.x = static_cast<const float*>(getPointerByName(EbsdLib::Ctf::X));
+  m_Block.y = static_cast<const float*>(getPointerByName(EbsdLib::Ctf::Y));
+  m_Block.bands = static_cast<const int32_t*>(getPointerByName(EbsdLib::Ctf::Bands));
+  m_Block.error = static_cast<const int32_t*>(getPointerByName(EbsdLib::Ctf::Error));
+  m_Block.euler1 = static_cast<const float*>(getPointerByName(EbsdLib::Ctf::Euler1));
+  m_Block.euler2 = static_cast<const float*>(getPointerByName(EbsdLib::Ctf::Euler2));
+  m_Block.euler3 = static_cast<const float*>(getPointerByName(EbsdLib::Ctf::Euler3));
+  m_Block.mad = static_cast<const float*>(getPointerByName(EbsdLib::Ctf::MAD));
+  m_Block.bc = static_cast<const int32_t*>(getPointerByName(EbsdLib::Ctf::BC));
+  m_Block.bs = static_cast<const int32_t*>(getPointerByName(EbsdLib::Ctf::BS));
+}
+
+// -----------------------------------------------------------------------------
+CtfDataStream::~CtfDataStream() = default;
+
+// -----------------------------------------------------------------------------
+bool CtfDataStream::readNextBlock()
+{
+  if(m_ErrorCode < 0 || m_RowsRead >= m_NumberOfElements)
+  {
+    return false;
+  }
+
+  size_t numRows = std::min(m_RowsPerBlock, m_NumberOfElements - m_RowsRead);
+  size_t row = 0;
+  for(; row < numRows; row++)
+  {
+    if(!LineChunker::ReadDataLine(m_InStream, m_Line))
+    {
+      break;
+    }
+    int err = m_Plan.decode(m_Line, row, m_Scratch);
+    if(err < 0)
+    {
+      m_ErrorCode = err;
+      std::stringstream ss;
+      if(err == -109)
+      {
+        ss << "The number of tab delimited data columns (" << CtfColumnPlan::CountTokens(m_Line) << ") does not match the number of tab delimited header columns (" << m_Plan.getNumberOfColumns()
+           << "). The error occurred at data point " << (m_RowsRead + row) << ".";
+      }
+      else
+      {
+        ss << "Error parsing the data line (Numeric conversion) at data point " << (m_RowsRead + row) << ".\n" << m_Line;
+      }
+      m_ErrorMessage = ss.str();
+      return false;
+    }
+  }
+
+  m_Block.firstRow = m_RowsRead;
+  m_Block.numRows = row;
+  m_RowsRead += row;
+  if(row < numRows)
+  {
+    std::stringstream ss;
+    ss << "Premature End Of File reached.\nNumRows=" << m_NumberOfElements << "\nTotal Data Points Read=" << m_RowsRead << "\n";
+    m_ErrorMessage = ss.str();
+    m_ErrorCode = -105;
+  }
+  return row > 0;
+}
+
+// -----------------------------------------------------------------------------
+const CtfRowBlock& CtfDataStream::getBlock() const
+{
+  return m_Block;
+}
+
+// -----------------------------------------------------------------------------
+const void* CtfDataStream::getPointerByName(const std::string& name) const
+{
+  for(size_t i = 0; i < m_Names.size(); i++)
+  {
+    if(m_Names[i] == name && nullptr != m_Parsers[i])
+    {
+      return m_Parsers[i]->getVoidPointer();
+    }
+  }
+  return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+size_t CtfDataStream::getNumberOfElements() const
+{
+  return m_NumberOfElements;
+}
+
+// -----------------------------------------------------------------------------
+size_t CtfDataStream::getRowsRead() const
+{
+  return m_RowsRead;
+}
+
+// -----------------------------------------------------------------------------
+int CtfDataStream::getErrorCode() const
+{
+  return m_ErrorCode;
+}
+
+// -----------------------------------------------------------------------------
+std::string CtfDataStream::getErrorMessage() const
+{
+  return m_ErrorMessage;
+}
+
+// -----------------------------------------------------------------------------
+CtfDataStream::Iterator CtfDataStream::begin()
+{
+  return readNextBlock() ? Iterator(this) : end();
+}
+
+// -----------------------------------------------------------------------------
+CtfDataStream::Iterator CtfDataStream::end()
+{
+  return Iterator();
+}
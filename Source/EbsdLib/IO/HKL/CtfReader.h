@@ -37,10 +37,15 @@
 
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "CtfColumnPlan.hpp"
 #include "CtfConstants.h"
 #include "CtfHeaderEntry.h"
 #include "CtfPhase.h"
@@ -49,6 +54,7 @@
 #include "EbsdLib/Core/EbsdSetGetMacros.h"
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/IO/EbsdReader.h"
+#include "EbsdLib/IO/EbsdSidecarCache.h"
 
 #define CTF_READER_PTR_PROP(name, var, type)                                                                                                                                                           \
   type* get##name##Pointer()                                                                                                                                                                           \
@@ -56,6 +62,116 @@
     return static_cast<type*>(getPointerByName(#var));                                                                                                                                                 \
   }
 
+/**
+ * @brief A block of consecutive data rows from a .ctf file stored as one array per
+ * column. Columns that were not requested, or that are not present in the file, are
+ * nullptr. The arrays are owned by the CtfDataStream and stay valid until the next
+ * block is read.
+ */
+struct CtfRowBlock
+{
+  size_t firstRow = 0;
+  size_t numRows = 0;
+  const int32_t* phase = nullptr;
+  const float* x = nullptr;
+  const float* y = nullptr;
+  const int32_t* bands = nullptr;
+  const int32_t* error = nullptr;
+  const float* euler1 = nullptr;
+  const float* euler2 = nullptr;
+  const float* euler3 = nullptr;
+  const float* mad = nullptr;
+  const int32_t* bc = nullptr;
+  const int32_t* bs = nullptr;
+};
+
+/**
+ * @class CtfDataStream CtfReader.h EbsdLib/IO/HKL/CtfReader.h
+ * @brief Reads the data section of a .ctf file in fixed size blocks of rows that are
+ * decoded into one reused set of column buffers, so the memory used does not depend on
+ * the size of the scan. Instances are created by CtfReader::openStream() after the header
+ * was parsed. All the slices of a 3D file are streamed in file order.
+ */
+class EbsdLib_EXPORT CtfDataStream
+{
+public:
+  class Iterator
+  {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = CtfRowBlock;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const CtfRowBlock*;
+    using reference = const CtfRowBlock&;
+
+    Iterator() = default;
+    explicit Iterator(CtfDataStream* stream);
+
+    reference operator*() const;
+    pointer operator->() const;
+    Iterator& operator++();
+    bool operator==(const Iterator& other) const;
+    bool operator!=(const Iterator& other) const;
+
+  private:
+    CtfDataStream* m_Stream = nullptr;
+  };
+
+  /**
+   * @param in The file positioned after the line of column names
+   * @param names The name of every column in file order
+   * @param parsers The parser of every column, sized for 'rowsPerBlock' rows. A nullptr skips the column.
+   * @param numElements The number of data rows given by the header
+   * @param rowsPerBlock The number of rows in each block
+   */
+  CtfDataStream(std::ifstream&& in, const std::vector<std::string>& names, std::vector<DataParser::Pointer> parsers, size_t numElements, size_t rowsPerBlock);
+  ~CtfDataStream();
+
+  /**
+   * @brief Decodes the next block of rows into the buffers.
+   * @return false when all rows were read or an error occurred
+   */
+  bool readNextBlock();
+
+  /**
+   * @brief Returns the block that was decoded by the last call to readNextBlock()
+   */
+  const CtfRowBlock& getBlock() const;
+
+  /**
+   * @brief Returns the buffer of the named column for the current block or nullptr
+   */
+  const void* getPointerByName(const std::string& name) const;
+
+  size_t getNumberOfElements() const;
+  size_t getRowsRead() const;
+  int getErrorCode() const;
+  std::string getErrorMessage() const;
+
+  Iterator begin();
+  Iterator end();
+
+private:
+  std::ifstream m_InStream;
+  std::string m_Line;
+  std::string m_Scratch;
+  std::vector<std::string> m_Names;
+  std::vector<DataParser::Pointer> m_Parsers;
+  CtfColumnPlan m_Plan;
+  size_t m_NumberOfElements = 0;
+  size_t m_RowsPerBlock = 0;
+  size_t m_RowsRead = 0;
+  CtfRowBlock m_Block;
+  int m_ErrorCode = 0;
+  std::string m_ErrorMessage;
+
+public:
+  CtfDataStream(const CtfDataStream&) = delete;            // Copy Constructor Not Implemented
+  CtfDataStream(CtfDataStream&&) = delete;                 // Move Constructor Not Implemented
+  CtfDataStream& operator=(const CtfDataStream&) = delete; // Copy Assignment Not Implemented
+  CtfDataStream& operator=(CtfDataStream&&) = delete;      // Move Assignment Not Implemented
+};
+
 /**
  * @class CtfReader CtfReader.h EbsdLib/IO/HKL/CtfReader.h
  * @brief This class is a self contained HKL .ctf file reader and will read a
@@ -103,6 +219,25 @@ public:
   EBSDHEADER_INSTANCE_PROPERTY(CtfIntHeaderType, int, NumPhases, EbsdLib::Ctf::NumPhases)
   EBSD_INSTANCE_PROPERTY(std::vector<CtfPhase::Pointer>, PhaseVector)
 
+  /**
+   * @brief When true, readFile() memory maps the .ctf file and parses the data section
+   * from the mapping instead of reading it line by line through a std::ifstream.
+   */
+  EBSD_INSTANCE_PROPERTY(bool, UseMemoryMappedIO)
+
+  /**
+   * @brief When true, readFile() splits the data section into newline aligned chunks and
+   * parses them concurrently. This implies the memory mapped read.
+   */
+  EBSD_INSTANCE_PROPERTY(bool, UseParallelParsing)
+
+  /**
+   * @brief When true, readFile() loads the arrays from the binary cache next to the .ctf
+   * file (see EbsdSidecarCache) when the cache matches the file, and writes the cache after
+   * the file was parsed otherwise.
+   */
+  EBSD_INSTANCE_PROPERTY(bool, UseSidecarCache)
+
   CTF_READER_PTR_PROP(Phase, Phase, int)
   CTF_READER_PTR_PROP(X, X, float)
   CTF_READER_PTR_PROP(Y, Y, float)
@@ -152,8 +287,32 @@ public:
    */
   int readHeaderOnly() override;
 
+  /**
+   * @brief Parses the header of the file and returns a stream over the data section that
+   * decodes 'rowsPerBlock' rows at a time. Only the arrays selected with setArraysToRead()
+   * are decoded. The header values of this reader are valid once the stream is returned.
+   * @param rowsPerBlock The number of rows decoded per block
+   * @return The stream or nullptr if the file could not be opened or the header is invalid.
+   * The error code and message are set on this reader in that case.
+   */
+  std::unique_ptr<CtfDataStream> openStream(size_t rowsPerBlock = 4096);
+
   void readOnlySliceIndex(int slice);
 
+  /**
+   * @brief Sets the names of the arrays to read out of the file. Columns that are not
+   * requested are skipped without being converted or allocated.
+   * @param names
+   */
+  void setArraysToRead(const std::set<std::string>& names);
+
+  /**
+   * @brief Over rides the setArraysToReads to tell the reader to load ALL the data from the file. If the
+   * ArrayNames to read is empty and this is true then all arrays will be read.
+   * @param b
+   */
+  void readAllArrays(bool b);
+
   int getXDimension() override;
   void setXDimension(int xdim) override;
   int getYDimension() override;
@@ -171,6 +330,8 @@ private:
   int m_SingleSliceRead = -1;
 
   std::map<std::string, DataParser::Pointer> m_NamePointerMap;
+  std::set<std::string> m_ArrayNames;
+  bool m_ReadAllArrays = true;
 
   /**
    * @brief
@@ -180,6 +341,14 @@ private:
    */
   int getHeaderLines(std::ifstream& reader, std::vector<std::string>& headerLines);
 
+  /**
+   * @brief Same as above but reads the header lines out of the memory mapped file.
+   * @param buffer The contents of the file. Updated to start at the column header line.
+   * @param headerLines
+   * @return
+   */
+  int getHeaderLines(std::string_view& buffer, std::vector<std::string>& headerLines);
+
   /**
    * Checks that the line is the header of the columns for the data.
    *
@@ -202,15 +371,76 @@ private:
   int readData(std::ifstream& in);
 
   /**
-   * @brief Reads a line of Data from the ASCII based file
+   * @brief Checks the header values that are required before the data section can be read.
+   * @return Zero on success or a negative error code
+   */
+  int checkHeaderValues();
+
+  /**
+   * @brief Checks the cell counts, sets the number of elements and splits the line of column names.
+   * @param buf The line of column names
+   * @param names Receives the name of each column
+   * @return Zero on success or a negative error code
+   */
+  int parseColumnHeader(std::string& buf, std::vector<std::string>& names);
+
+  /**
+   * @brief Creates a parser that holds 'numElements' values for each requested column.
+   * @param names The name of each column
+   * @param numElements The number of values each parser holds
+   * @param parsers Receives the parser of each column. Columns that were not requested are nullptr.
+   * @return Zero on success or a negative error code
+   */
+  int createColumnParsers(const std::vector<std::string>& names, size_t numElements, std::vector<DataParser::Pointer>& parsers);
+
+  /**
+   * @brief Parses the line of column names and allocates an array for each requested column.
+   * @param buf The line of column names
+   * @param plan Set to the plan that decodes the data lines into the arrays
+   * @return Zero on success or a negative error code
+   */
+  int initializeDataArrays(std::string& buf, CtfColumnPlan& plan);
+
+  /**
+   * @brief Returns true if the named array should be allocated and read
+   */
+  bool isArrayRequested(const std::string& name) const;
+
+  /**
+   * @brief Parses the data section out of the memory mapped file.
+   * @param data The bytes of the file starting at the line of column names
+   */
+  int readMappedData(std::string_view data);
+
+  /**
+   * @brief Returns the reader settings that change the values stored in the sidecar cache
+   */
+  std::string getSidecarCacheOptions() const;
+
+  /**
+   * @brief Loads the header and the requested arrays from the sidecar cache.
+   * @return true if the cache matched the file and held every requested array. Nothing
+   * is changed when false is returned.
+   */
+  bool readSidecarCache();
+
+  /**
+   * @brief Writes the header and the arrays that were read to the sidecar cache.
+   * @param stamp The key of the .ctf file taken before it was parsed
+   * @param header The original header without the line of column names
+   * @param headerLines The header lines followed by the line of column names
+   */
+  void writeSidecarCache(const EbsdSidecarCache::SourceStamp& stamp, const std::string& header, const std::vector<std::string>& headerLines);
+
+  /**
+   * @brief Sets the error code and message for a data line that could not be decoded
+   * @param err The error code returned by CtfColumnPlan::decode()
    * @param line The current line of data
    * @param row Current Row of Data
-   * @param i The current index into a flat array
-   * @param xCells Number of X Data Points
-   * @param yCells Number of Y Data Points
-   * @param col The current Column of Data
+   * @param numColumns The number of columns in the header
+   * @return The error code
    */
-  int parseDataLine(std::string& line, size_t row, size_t col, size_t i, size_t xCells, size_t yCells);
+  int setDataLineError(int err, std::string_view line, size_t row, size_t numColumns);
 
 public:
   CtfReader(const CtfReader&) = delete;            // Copy Constructor Not Implemented
@@ -6,6 +6,7 @@ set(HKL_SRCS
 )
 
 set(HKL_HDRS
+  ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/IO/HKL/CtfColumnPlan.hpp
   ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/IO/HKL/CtfConstants.h
   ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/IO/HKL/CtfHeaderEntry.h
   ${EbsdLibProj_SOURCE_DIR}/Source/EbsdLib/IO/HKL/CtfReader.h
@@ -0,0 +1,199 @@
+/* ============================================================================
+ * Copyright (c) 2023-2023 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "LineChunker.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "EbsdLib/Utilities/EbsdStringUtils.hpp"
+#include "EbsdLib/Utilities/ParallelDataAlgorithm.hpp"
+
+namespace
+{
+class CountLinesImpl
+{
+public:
+  CountLinesImpl(std::vector<LineChunker::Chunk>& chunks, bool skipBlankLines)
+  : m_Chunks(chunks)
+  , m_SkipBlankLines(skipBlankLines)
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      m_Chunks[i].numLines = m_SkipBlankLines ? LineChunker::CountDataLines(m_Chunks[i].text) : LineChunker::CountLines(m_Chunks[i].text);
+    }
+  }
+
+private:
+  std::vector<LineChunker::Chunk>& m_Chunks;
+  bool m_SkipBlankLines = false;
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+std::vector<LineChunker::Chunk> LineChunker::Split(std::string_view data, size_t numChunks, bool skipBlankLines)
+{
+  std::vector<Chunk> chunks;
+  if(data.empty())
+  {
+    return chunks;
+  }
+  numChunks = std::max<size_t>(numChunks, 1);
+  size_t chunkSize = std::max<size_t>(data.size() / numChunks, 1);
+
+  size_t start = 0;
+  while(start < data.size())
+  {
+    size_t end = data.size();
+    if(chunks.size() + 1 < numChunks && start + chunkSize < data.size())
+    {
+      size_t newline = data.find('\n', start + chunkSize);
+      end = (newline == std::string_view::npos) ? data.size() : newline + 1;
+    }
+    Chunk chunk;
+    chunk.text = data.substr(start, end - start);
+    chunks.push_back(chunk);
+    start = end;
+  }
+
+  // The first chunk always starts at line zero so a single chunk does not need to be counted.
+  if(chunks.size() > 1)
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, chunks.size());
+    dataAlg.execute(CountLinesImpl(chunks, skipBlankLines));
+
+    size_t firstLine = 0;
+    for(auto& chunk : chunks)
+    {
+      chunk.firstLine = firstLine;
+      firstLine += chunk.numLines;
+    }
+  }
+  return chunks;
+}
+
+// -----------------------------------------------------------------------------
+size_t LineChunker::SuggestedChunkCount(size_t numBytes)
+{
+  size_t numThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  size_t maxChunks = std::max<size_t>(numBytes / k_MinimumChunkSize, 1);
+  // Over subscribe a little so that the threads stay busy when the lines have different lengths
+  return std::min(numThreads * 4, maxChunks);
+}
+
+// -----------------------------------------------------------------------------
+size_t LineChunker::CountLines(std::string_view text)
+{
+  if(text.empty())
+  {
+    return 0;
+  }
+  size_t count = static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+  if(text.back() != '\n')
+  {
+    count++;
+  }
+  return count;
+}
+
+// -----------------------------------------------------------------------------
+size_t LineChunker::CountDataLines(std::string_view text)
+{
+  size_t count = 0;
+  while(!NextDataLine(text).empty())
+  {
+    count++;
+  }
+  return count;
+}
+
+// -----------------------------------------------------------------------------
+bool LineChunker::IsBlankLine(std::string_view line)
+{
+  return line.find_first_not_of(EbsdStringUtils::k_Whitespaces) == std::string_view::npos;
+}
+
+// -----------------------------------------------------------------------------
+std::string_view LineChunker::NextDataLine(std::string_view& text)
+{
+  while(!text.empty())
+  {
+    std::string_view line = EbsdStringUtils::nextLine(text);
+    if(!IsBlankLine(line))
+    {
+      return line;
+    }
+  }
+  return {};
+}
+
+// -----------------------------------------------------------------------------
+bool LineChunker::ReadDataLine(std::istream& in, std::string& line)
+{
+  while(std::getline(in, line))
+  {
+    if(!IsBlankLine(line))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+const LineChunker::Chunk* LineChunker::FirstError(const std::vector<Chunk>& chunks)
+{
+  for(const auto& chunk : chunks)
+  {
+    if(chunk.errorCode < 0)
+    {
+      return &chunk;
+    }
+  }
+  return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+size_t LineChunker::ParsedLines(const std::vector<Chunk>& chunks)
+{
+  size_t count = 0;
+  for(const auto& chunk : chunks)
+  {
+    count += chunk.parsedLines;
+  }
+  return count;
+}
@@ -0,0 +1,127 @@
+/* ============================================================================
+ * Copyright (c) 2023-2023 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "EbsdLib/EbsdLib.h"
+
+/**
+ * @class LineChunker LineChunker.h EbsdLib/IO/LineChunker.h
+ * @brief Splits the data section of a text based EBSD file into newline aligned byte
+ * ranges that can be parsed concurrently. The index of the first line of each chunk
+ * is found with a prefix scan of the per chunk line counts so that every chunk knows
+ * exactly which data point its lines belong to.
+ */
+class EbsdLib_EXPORT LineChunker
+{
+public:
+  /**
+   * @brief One newline aligned range of the data section. The error values are filled
+   * in by the parser that consumes the chunk.
+   */
+  struct Chunk
+  {
+    std::string_view text;
+    size_t firstLine = 0;
+    size_t numLines = 0;
+    size_t parsedLines = 0;
+    int errorCode = 0;
+    int errorColumn = 0;
+    size_t errorLine = 0;
+  };
+
+  /**
+   * @brief Splits the data into at most numChunks newline aligned chunks and computes
+   * the first line index of each chunk.
+   * @param data The text to split
+   * @param numChunks The requested number of chunks. Fewer chunks are returned for small inputs.
+   * @param skipBlankLines If true, blank lines are not counted so the line indices only
+   * advance on lines that hold data. The parser must then skip them with NextDataLine().
+   * @return The chunks in file order
+   */
+  static std::vector<Chunk> Split(std::string_view data, size_t numChunks, bool skipBlankLines = false);
+
+  /**
+   * @brief Returns the number of chunks that should be used for a data section of the given size
+   * when parsing in parallel.
+   */
+  static size_t SuggestedChunkCount(size_t numBytes);
+
+  /**
+   * @brief Counts the lines in the text the same way EbsdStringUtils::nextLine() would
+   * iterate them: a trailing line without a newline counts, a trailing newline does not
+   * start a new line.
+   */
+  static size_t CountLines(std::string_view text);
+
+  /**
+   * @brief Counts the lines in the text that are not blank (empty or only whitespace).
+   */
+  static size_t CountDataLines(std::string_view text);
+
+  /**
+   * @brief Returns true if the line is empty or only holds whitespace.
+   */
+  static bool IsBlankLine(std::string_view line);
+
+  /**
+   * @brief Returns the next line that is not blank and advances the text past it. An empty
+   * view is returned once the text is exhausted.
+   */
+  static std::string_view NextDataLine(std::string_view& text);
+
+  /**
+   * @brief Reads lines from the stream until one is not blank. This skips the same lines that
+   * NextDataLine() skips so the stream and the memory mapped readers agree.
+   * @return False if the stream ended before a line that holds data was found
+   */
+  static bool ReadDataLine(std::istream& in, std::string& line);
+
+  /**
+   * @brief Returns the first chunk, in file order, that recorded an error or nullptr.
+   */
+  static const Chunk* FirstError(const std::vector<Chunk>& chunks);
+
+  /**
+   * @brief Returns the total number of lines that were parsed over all the chunks.
+   */
+  static size_t ParsedLines(const std::vector<Chunk>& chunks);
+
+  /** @brief The smallest chunk (in bytes) that is worth handing to another thread */
+  static constexpr size_t k_MinimumChunkSize = 256 * 1024;
+};
@@ -0,0 +1,186 @@
+/* ============================================================================
+ * Copyright (c) 2023-2023 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "MemoryMappedFile.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// -----------------------------------------------------------------------------
+MemoryMappedFile::MemoryMappedFile() = default;
+
+// -----------------------------------------------------------------------------
+MemoryMappedFile::~MemoryMappedFile()
+{
+  close();
+}
+
+#if defined(_WIN32)
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::open(const std::string& filePath)
+{
+  close();
+  HANDLE file = ::CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if(file == INVALID_HANDLE_VALUE)
+  {
+    return false;
+  }
+  m_FileHandle = file;
+
+  LARGE_INTEGER fileSize;
+  if(::GetFileSizeEx(file, &fileSize) == 0 || fileSize.QuadPart == 0)
+  {
+    close();
+    return false;
+  }
+
+  HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if(mapping == nullptr)
+  {
+    close();
+    return false;
+  }
+  m_MappingHandle = mapping;
+
+  void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if(view == nullptr)
+  {
+    close();
+    return false;
+  }
+  m_Data = static_cast<const char*>(view);
+  m_Size = static_cast<size_t>(fileSize.QuadPart);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+void MemoryMappedFile::close()
+{
+  if(m_Data != nullptr)
+  {
+    ::UnmapViewOfFile(m_Data);
+  }
+  if(m_MappingHandle != nullptr)
+  {
+    ::CloseHandle(static_cast<HANDLE>(m_MappingHandle));
+  }
+  if(m_FileHandle != nullptr)
+  {
+    ::CloseHandle(static_cast<HANDLE>(m_FileHandle));
+  }
+  m_Data = nullptr;
+  m_Size = 0;
+  m_MappingHandle = nullptr;
+  m_FileHandle = nullptr;
+}
+
+#else
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::open(const std::string& filePath)
+{
+  close();
+  m_FileDescriptor = ::open(filePath.c_str(), O_RDONLY);
+  if(m_FileDescriptor < 0)
+  {
+    return false;
+  }
+
+  struct stat fileInfo = {};
+  if(::fstat(m_FileDescriptor, &fileInfo) != 0 || fileInfo.st_size == 0)
+  {
+    close();
+    return false;
+  }
+
+  void* mapping = ::mmap(nullptr, static_cast<size_t>(fileInfo.st_size), PROT_READ, MAP_PRIVATE, m_FileDescriptor, 0);
+  if(mapping == MAP_FAILED)
+  {
+    close();
+    return false;
+  }
+  // The data sections are always read from front to back
+  ::madvise(mapping, static_cast<size_t>(fileInfo.st_size), MADV_SEQUENTIAL);
+
+  m_Data = static_cast<const char*>(mapping);
+  m_Size = static_cast<size_t>(fileInfo.st_size);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+void MemoryMappedFile::close()
+{
+  if(m_Data != nullptr)
+  {
+    ::munmap(const_cast<char*>(m_Data), m_Size);
+  }
+  if(m_FileDescriptor >= 0)
+  {
+    ::close(m_FileDescriptor);
+  }
+  m_Data = nullptr;
+  m_Size = 0;
+  m_FileDescriptor = -1;
+}
+#endif
+
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::isOpen() const
+{
+  return m_Data != nullptr;
+}
+
+// -----------------------------------------------------------------------------
+const char* MemoryMappedFile::data() const
+{
+  return m_Data;
+}
+
+// -----------------------------------------------------------------------------
+size_t MemoryMappedFile::size() const
+{
+  return m_Size;
+}
+
+// -----------------------------------------------------------------------------
+std::string_view MemoryMappedFile::view() const
+{
+  return {m_Data, m_Size};
+}
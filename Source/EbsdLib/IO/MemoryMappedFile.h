@@ -0,0 +1,100 @@
+/* ============================================================================
+ * Copyright (c) 2023-2023 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "EbsdLib/EbsdLib.h"
+
+/**
+ * @class MemoryMappedFile MemoryMappedFile.h EbsdLib/IO/MemoryMappedFile.h
+ * @brief Read-only memory mapping of a complete file. The mapping is released when
+ * the object goes out of scope. The mapped bytes are NOT null terminated so callers
+ * must always honor size().
+ */
+class EbsdLib_EXPORT MemoryMappedFile
+{
+public:
+  MemoryMappedFile();
+  ~MemoryMappedFile();
+
+  /**
+   * @brief Maps the complete file into memory.
+   * @param filePath The file to map
+   * @return true if the file was mapped. An empty file can not be mapped and returns false.
+   */
+  bool open(const std::string& filePath);
+
+  /**
+   * @brief Unmaps the file and closes all handles. Safe to call multiple times.
+   */
+  void close();
+
+  /**
+   * @brief Returns true if a file is currently mapped.
+   */
+  bool isOpen() const;
+
+  /**
+   * @brief Returns the first byte of the mapping or nullptr if nothing is mapped.
+   */
+  const char* data() const;
+
+  /**
+   * @brief Returns the number of mapped bytes.
+   */
+  size_t size() const;
+
+  /**
+   * @brief Returns the complete mapping as a string_view.
+   */
+  std::string_view view() const;
+
+private:
+  const char* m_Data = nullptr;
+  size_t m_Size = 0;
+#if defined(_WIN32)
+  void* m_FileHandle = nullptr;
+  void* m_MappingHandle = nullptr;
+#else
+  int m_FileDescriptor = -1;
+#endif
+
+public:
+  MemoryMappedFile(const MemoryMappedFile&) = delete;            // Copy Constructor Not Implemented
+  MemoryMappedFile(MemoryMappedFile&&) = delete;                 // Move Constructor Not Implemented
+  MemoryMappedFile& operator=(const MemoryMappedFile&) = delete; // Copy Assignment Not Implemented
+  MemoryMappedFile& operator=(MemoryMappedFile&&) = delete;      // Move Assignment Not Implemented
+};
@@ -38,7 +38,12 @@
 
 #include "EbsdLib/Core/EbsdMacros.h"
 #include "EbsdLib/IO/EbsdReader.h"
+#include "EbsdLib/IO/EbsdSidecarCache.h"
+#include "EbsdLib/IO/LineChunker.h"
+#include "EbsdLib/IO/MemoryMappedFile.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
+#include "EbsdLib/Utilities/EbsdStringUtils.hpp"
+#include "EbsdLib/Utilities/ParallelDataAlgorithm.hpp"
 
 #include <algorithm>
 #include <fstream>
@@ -48,6 +53,13 @@
 
 namespace
 {
+const std::array<std::string, 10> k_AngArrayNames = {EbsdLib::Ang::Phi1,         EbsdLib::Ang::Phi,           EbsdLib::Ang::Phi2,
+                                                     EbsdLib::Ang::XPosition,    EbsdLib::Ang::YPosition,     EbsdLib::Ang::ImageQuality,
+                                                     EbsdLib::Ang::ConfidenceIndex, EbsdLib::Ang::PhaseData, EbsdLib::Ang::SEMSignal,
+                                                     EbsdLib::Ang::Fit};
+
+// Identifies the sidecar caches written by the AngReader
+const std::string k_AngCacheOptions("ang");
 
 using Vec3Type = std::array<float, 3>;
 using Size3Type = std::array<size_t, 3>;
@@ -89,6 +101,123 @@ std::optional<size_t> GetGridIndex(Vec3Type& coords, Vec3Type& m_Origin, Vec3Typ
 
   return (m_Dimensions[1] * m_Dimensions[0] * z) + (m_Dimensions[0] * y) + x;
 }
+
+/**
+ * @brief The destination arrays for each column of an .ang data line. The phase column
+ * (index 7) is stored separately because it is an integer column. A nullptr array means
+ * the column is skipped.
+ */
+struct AngDataColumns
+{
+  std::array<float*, 10> floatColumns = {};
+  int32_t* phase = nullptr;
+};
+
+/**
+ * @brief Parses a line of data without making any copies of the line. Only the data arrays
+ * at index 'i' are written so lines can be parsed from multiple threads at the same time.
+ * Columns that are missing from the end of the line keep their initial value.
+ * @param line The line of data
+ * @param i The index of the data point
+ * @param columns The destination arrays
+ * @param errorColumn The zero based column that failed to convert
+ * @return Zero or the negative error code
+ */
+int ParseAngDataLine(std::string_view line, size_t i, const AngDataColumns& columns, int& errorColumn)
+{
+  errorColumn = 0;
+  for(int column = 0; column < static_cast<int>(columns.floatColumns.size()); ++column)
+  {
+    std::string_view token = EbsdStringUtils::nextToken(line);
+    if(token.empty())
+    {
+      break;
+    }
+    if(column == 7)
+    {
+      if(columns.phase == nullptr)
+      {
+        continue;
+      }
+      int32_t ph = 0;
+      if(!EbsdStringUtils::convert(token, ph))
+      {
+        // Some have floats instead of integers so lets try that.
+        float f = 0.0f;
+        if(!EbsdStringUtils::convert(token, f))
+        {
+          errorColumn = column;
+          return -2588;
+        }
+        ph = static_cast<int32_t>(f);
+      }
+      columns.phase[i] = ph;
+      continue;
+    }
+
+    // Columns that were not requested are skipped without a conversion
+    if(columns.floatColumns[column] == nullptr)
+    {
+      continue;
+    }
+    float value = 0.0f;
+    if(!EbsdStringUtils::convert(token, value))
+    {
+      errorColumn = column;
+      return -2501 - column;
+    }
+    columns.floatColumns[column][i] = value;
+  }
+  return 0;
+}
+
+/**
+ * @brief Parses each chunk of the data section. Parsing of a chunk stops at the first
+ * line that fails to convert or when 'maxLines' lines have been parsed in total. Blank
+ * lines are skipped.
+ */
+class ParseAngChunksImpl
+{
+public:
+  ParseAngChunksImpl(const AngDataColumns& columns, std::vector<LineChunker::Chunk>& chunks, size_t maxLines)
+  : m_Columns(columns)
+  , m_Chunks(chunks)
+  , m_MaxLines(maxLines)
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t c = start; c < end; c++)
+    {
+      LineChunker::Chunk& chunk = m_Chunks[c];
+      std::string_view text = chunk.text;
+      size_t index = chunk.firstLine;
+      while(index < m_MaxLines)
+      {
+        // Blank lines are not data points, the chunk line indices do not count them either
+        std::string_view line = LineChunker::NextDataLine(text);
+        if(line.empty())
+        {
+          break;
+        }
+        chunk.errorCode = ParseAngDataLine(line, index, m_Columns, chunk.errorColumn);
+        chunk.parsedLines++;
+        if(chunk.errorCode < 0)
+        {
+          chunk.errorLine = index;
+          break;
+        }
+        index++;
+      }
+    }
+  }
+
+private:
+  AngDataColumns m_Columns;
+  std::vector<LineChunker::Chunk>& m_Chunks;
+  size_t m_MaxLines = 0;
+};
 } // namespace
 
 // -----------------------------------------------------------------------------
@@ -111,6 +240,9 @@ AngReader::AngReader()
   setNumFeatures(10);
 
   m_ReadHexGrid = false;
+  m_UseMemoryMappedIO = false;
+  m_UseParallelParsing = false;
+  m_UseSidecarCache = false;
 
   // Initialize the map of header key to header value
   m_HeaderMap[EbsdLib::Ang::TEMPIXPerUM] = AngHeaderEntry<float>::NewEbsdHeaderEntry(EbsdLib::Ang::TEMPIXPerUM);
@@ -334,11 +466,10 @@ int AngReader::readHeaderOnly()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int AngReader::readFile()
+std::unique_ptr<AngDataStream> AngReader::openStream(size_t rowsPerBlock)
 {
   setErrorCode(0);
   setErrorMessage("");
-  std::string buf;
   setHeaderIsComplete(false);
 
   std::ifstream in(getFileName(), std::ios_base::in);
@@ -347,9 +478,244 @@ int AngReader::readFile()
     std::string msg = "Ang file could not be opened:" + getFileName();
     setErrorCode(-100);
     setErrorMessage(msg);
-    return -100;
+    return nullptr;
+  }
+
+  std::string buf;
+  if(readStreamHeader(in, buf) < 0 || calculateNumberOfElements() < 0)
+  {
+    return nullptr;
+  }
+
+  std::array<bool, 10> columns = {isArrayRequested(EbsdLib::Ang::Phi1),
+                                  isArrayRequested(EbsdLib::Ang::Phi),
+                                  isArrayRequested(EbsdLib::Ang::Phi2),
+                                  isArrayRequested(EbsdLib::Ang::XPosition),
+                                  isArrayRequested(EbsdLib::Ang::YPosition),
+                                  isArrayRequested(EbsdLib::Ang::ImageQuality),
+                                  isArrayRequested(EbsdLib::Ang::ConfidenceIndex),
+                                  isArrayRequested(EbsdLib::Ang::PhaseData),
+                                  getNumFeatures() >= 9 && isArrayRequested(EbsdLib::Ang::SEMSignal),
+                                  getNumFeatures() >= 10 && isArrayRequested(EbsdLib::Ang::Fit)};
+  return std::make_unique<AngDataStream>(std::move(in), std::move(buf), getNumberOfElements(), rowsPerBlock, columns);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int AngReader::readFile()
+{
+  setErrorCode(0);
+  setErrorMessage("");
+  std::string buf;
+  setHeaderIsComplete(false);
+
+  EbsdSidecarCache::SourceStamp stamp;
+  bool useCache = m_UseSidecarCache && EbsdSidecarCache::Stamp(getFileName(), stamp);
+  if(useCache && readSidecarCache())
+  {
+    return getErrorCode();
   }
 
+  if(m_UseMemoryMappedIO || m_UseParallelParsing)
+  {
+    int err = readMappedFile();
+    if(err < 0)
+    {
+      return err;
+    }
+  }
+  else
+  {
+    std::ifstream in(getFileName(), std::ios_base::in);
+    if(!in.is_open())
+    {
+      std::string msg = "Ang file could not be opened:" + getFileName();
+      setErrorCode(-100);
+      setErrorMessage(msg);
+      return -100;
+    }
+
+    if(readStreamHeader(in, buf) < 0)
+    {
+      return getErrorCode();
+    }
+    // We need to pass in the buffer because it has the first line of data
+    readData(in, buf);
+    if(getErrorCode() < 0)
+    {
+      return getErrorCode();
+    }
+  }
+  std::vector<int64_t> indexMap;
+  std::string grid = getGrid();
+  if(grid.find(EbsdLib::Ang::SquareGrid) == 0)
+  {
+    std::pair<int, std::string> result = fixOrderOfData(indexMap);
+
+    if(result.first < 0)
+    {
+      setErrorCode(result.first);
+      setErrorMessage(result.second);
+      return result.first;
+    }
+
+    for(const auto& arrayName : k_AngArrayNames)
+    {
+      void* oldArray = getPointerByName(arrayName);
+      if(nullptr == oldArray)
+      {
+        continue;
+      }
+
+      if(getPointerType(arrayName) == EbsdLib::NumericTypes::Type::Float)
+      {
+        CopyTupleUsingIndexList<float>(oldArray, indexMap);
+      }
+      else if(getPointerType(arrayName) == EbsdLib::NumericTypes::Type::Int32)
+      {
+        CopyTupleUsingIndexList<int32_t>(oldArray, indexMap);
+      }
+      else
+      {
+        std::cout << "Type returned was not of Float or int32. The Array name probably isn't correct." << std::endl;
+      }
+    }
+  }
+
+  // The positions were only decoded to order the data
+  if(!isArrayRequested(EbsdLib::Ang::XPosition))
+  {
+    deallocateArrayData<float>(m_X);
+  }
+  if(!isArrayRequested(EbsdLib::Ang::YPosition))
+  {
+    deallocateArrayData<float>(m_Y);
+  }
+
+  if(useCache)
+  {
+    writeSidecarCache(stamp);
+  }
+  return getErrorCode();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool AngReader::readSidecarCache()
+{
+  EbsdSidecarCache cache;
+  if(!cache.open(getFileName(), k_AngCacheOptions))
+  {
+    return false;
+  }
+
+  m_PhaseVector.clear();
+  std::string_view header = cache.getHeader();
+  while(!header.empty())
+  {
+    std::string buf(EbsdStringUtils::nextLine(header));
+    parseHeaderLine(buf);
+  }
+  setHeaderIsComplete(true);
+  setOriginalHeader(cache.getHeader());
+
+  bool loaded = checkHeaderValues() >= 0 && allocateDataArrays() >= 0;
+  size_t numElements = getNumberOfElements();
+  for(const auto& arrayName : k_AngArrayNames)
+  {
+    void* ptr = getPointerByName(arrayName);
+    if(!loaded || nullptr == ptr || !isArrayRequested(arrayName))
+    {
+      continue;
+    }
+    EbsdLib::NumericTypes::Type type = getPointerType(arrayName);
+    const EbsdSidecarCache::Column* column = cache.findColumn(arrayName, type, numElements);
+    if(nullptr == column)
+    {
+      loaded = false;
+      continue;
+    }
+    size_t elementSize = (type == EbsdLib::NumericTypes::Type::Int32) ? sizeof(int32_t) : sizeof(float);
+    ::memcpy(ptr, column->data, numElements * elementSize);
+  }
+
+  if(!loaded)
+  {
+    // Leave the reader as it was so the file is parsed instead
+    for(float** ptr : {&m_Phi1, &m_Phi, &m_Phi2, &m_Iq, &m_Ci, &m_X, &m_Y, &m_SEMSignal, &m_Fit})
+    {
+      deallocateArrayData<float>(*ptr);
+    }
+    deallocateArrayData<int32_t>(m_PhaseData);
+    m_PhaseVector.clear();
+    setOriginalHeader("");
+    setHeaderIsComplete(false);
+    setErrorCode(0);
+    setErrorMessage("");
+    return false;
+  }
+
+  // The positions are only needed to order the data which the cache already is
+  if(!isArrayRequested(EbsdLib::Ang::XPosition))
+  {
+    deallocateArrayData<float>(m_X);
+  }
+  if(!isArrayRequested(EbsdLib::Ang::YPosition))
+  {
+    deallocateArrayData<float>(m_Y);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AngReader::writeSidecarCache(const EbsdSidecarCache::SourceStamp& stamp)
+{
+  std::vector<EbsdSidecarCache::Column> columns;
+  for(const auto& arrayName : k_AngArrayNames)
+  {
+    void* ptr = getPointerByName(arrayName);
+    if(nullptr != ptr)
+    {
+      columns.push_back({arrayName, getPointerType(arrayName), -1, getNumberOfElements(), ptr});
+    }
+  }
+  // The cache is only an accelerator so a cache that can not be written is not an error
+  EbsdSidecarCache::Write(stamp, k_AngCacheOptions, getOriginalHeader(), {}, columns);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AngReader::setArraysToRead(const std::set<std::string>& names)
+{
+  m_ArrayNames = names;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AngReader::readAllArrays(bool b)
+{
+  m_ReadAllArrays = b;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool AngReader::isArrayRequested(const std::string& name) const
+{
+  return m_ReadAllArrays || m_ArrayNames.find(name) != m_ArrayNames.end();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int AngReader::readStreamHeader(std::ifstream& in, std::string& buf)
+{
   std::string origHeader;
   setOriginalHeader(origHeader);
   m_PhaseVector.clear();
@@ -357,7 +723,7 @@ int AngReader::readFile()
   while(!in.eof() && !getHeaderIsComplete())
   {
     std::getline(in, buf);
-    if(buf.at(0) != '#')
+    if(buf.empty() || buf[0] != '#')
     {
       setHeaderIsComplete(true);
     }
@@ -370,6 +736,14 @@ int AngReader::readFile()
   // Update the Original Header variable
   setOriginalHeader(origHeader);
 
+  return checkHeaderValues();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int AngReader::checkHeaderValues()
+{
   if(getErrorCode() < 0)
   {
     return getErrorCode();
@@ -388,55 +762,64 @@ int AngReader::readFile()
     setErrorMessage("No phase was parsed in the header portion of the file. This possibly means that part of the header is missing.");
     return -150;
   }
-  // We need to pass in the buffer because it has the first line of data
-  readData(in, buf);
-  if(getErrorCode() < 0)
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int AngReader::readMappedFile()
+{
+  MemoryMappedFile mappedFile;
+  if(!mappedFile.open(getFileName()))
   {
-    return getErrorCode();
+    std::string msg = "Ang file could not be opened:" + getFileName();
+    setErrorCode(-100);
+    setErrorMessage(msg);
+    return -100;
   }
-  std::vector<int64_t> indexMap;
-  std::string grid = getGrid();
-  if(grid.find(EbsdLib::Ang::SquareGrid) == 0)
-  {
-    std::pair<int, std::string> result = fixOrderOfData(indexMap);
 
-    if(result.first < 0)
+  std::string origHeader;
+  setOriginalHeader(origHeader);
+  m_PhaseVector.clear();
+
+  // The header lines are copied because parseHeaderLine() modifies them. The data section is never copied.
+  std::string_view remaining = mappedFile.view();
+  std::string_view dataSection;
+  while(!remaining.empty() && !getHeaderIsComplete())
+  {
+    dataSection = remaining;
+    std::string buf(EbsdStringUtils::nextLine(remaining));
+    if(buf.empty() || buf[0] != '#')
     {
-      setErrorCode(result.first);
-      setErrorMessage(result.second);
-      return result.first;
+      setHeaderIsComplete(true);
     }
-
-    std::vector<std::string> arrayNames = {"Phi1", "Phi", "Phi2", "X Position", "Y Position", "Image Quality", "Confidence Index", "PhaseData", "SEM Signal", "Fit"};
-    for(const auto& arrayName : arrayNames)
+    else
     {
-      void* oldArray = getPointerByName(arrayName);
-
-      if(getPointerType(arrayName) == EbsdLib::NumericTypes::Type::Float)
-      {
-        CopyTupleUsingIndexList<float>(oldArray, indexMap);
-      }
-      else if(getPointerType(arrayName) == EbsdLib::NumericTypes::Type::Int32)
-      {
-        CopyTupleUsingIndexList<int32_t>(oldArray, indexMap);
-      }
-      else
-      {
-        std::cout << "Type returned was not of Float or int32. The Array name probably isn't correct." << std::endl;
-      }
+      origHeader.append(buf).append("\n");
+      parseHeaderLine(buf);
     }
   }
+  if(!getHeaderIsComplete())
+  {
+    dataSection = remaining;
+  }
+  // Update the Original Header variable
+  setOriginalHeader(origHeader);
+
+  if(checkHeaderValues() < 0)
+  {
+    return getErrorCode();
+  }
+  readMappedData(dataSection);
   return getErrorCode();
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void AngReader::readData(std::ifstream& in, std::string& buf)
+int AngReader::calculateNumberOfElements()
 {
-  std::string streamBuf;
-  std::stringstream ss(streamBuf);
-
   size_t totalDataPoints = 0;
 
   std::string grid = getGrid();
@@ -449,7 +832,7 @@ void AngReader::readData(std::ifstream& in, std::string& buf)
   {
     setErrorCode(-200);
     setErrorMessage("NumRows Sanity Check not correct. Check the entry for NROWS in the .ang file");
-    return;
+    return -200;
   }
   if(grid.find(EbsdLib::Ang::SquareGrid) == 0)
   {
@@ -470,7 +853,7 @@ void AngReader::readData(std::ifstream& in, std::string& buf)
   {
     setErrorCode(-400);
     setErrorMessage("Ang Files with Hex Grids Are NOT currently supported - Try converting them to Square Grid with the Hex2Sqr Converter filter.");
-    return;
+    return -400;
   }
   else if(grid.find(EbsdLib::Ang::HexGrid) == 0 && m_ReadHexGrid)
   {
@@ -494,44 +877,83 @@ void AngReader::readData(std::ifstream& in, std::string& buf)
   {
     setErrorMessage("Ang file is missing the 'GRID' header entry.");
     setErrorCode(-300);
-    return;
+    return -300;
   }
 
-  // Initialize all the pointers and allocate memory
   setNumberOfElements(totalDataPoints);
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int AngReader::allocateDataArrays()
+{
+  std::string streamBuf;
+  std::stringstream ss(streamBuf);
+
+  int err = calculateNumberOfElements();
+  if(err < 0)
+  {
+    return err;
+  }
+
+  // Initialize all the pointers and allocate memory
+  size_t totalDataPoints = getNumberOfElements();
   size_t numBytes = totalDataPoints * sizeof(float);
-  m_Phi1 = allocateArray<float>(totalDataPoints);
-  m_Phi = allocateArray<float>(totalDataPoints);
-  m_Phi2 = allocateArray<float>(totalDataPoints);
-  m_Iq = allocateArray<float>(totalDataPoints);
-  m_Ci = allocateArray<float>(totalDataPoints);
-  m_PhaseData = allocateArray<int>(totalDataPoints);
+  // The X and Y Positions are always needed to put the data of square grids in order
+  m_Phi1 = isArrayRequested(EbsdLib::Ang::Phi1) ? allocateArray<float>(totalDataPoints) : nullptr;
+  m_Phi = isArrayRequested(EbsdLib::Ang::Phi) ? allocateArray<float>(totalDataPoints) : nullptr;
+  m_Phi2 = isArrayRequested(EbsdLib::Ang::Phi2) ? allocateArray<float>(totalDataPoints) : nullptr;
+  m_Iq = isArrayRequested(EbsdLib::Ang::ImageQuality) ? allocateArray<float>(totalDataPoints) : nullptr;
+  m_Ci = isArrayRequested(EbsdLib::Ang::ConfidenceIndex) ? allocateArray<float>(totalDataPoints) : nullptr;
+  m_PhaseData = isArrayRequested(EbsdLib::Ang::PhaseData) ? allocateArray<int>(totalDataPoints) : nullptr;
   m_X = allocateArray<float>(totalDataPoints);
   m_Y = allocateArray<float>(totalDataPoints);
-  m_SEMSignal = allocateArray<float>(totalDataPoints);
-  m_Fit = allocateArray<float>(totalDataPoints);
-
-  ::memset(m_Phi1, 0, numBytes);
-  ::memset(m_Phi, 0, numBytes);
-  ::memset(m_Phi2, 0, numBytes);
-  ::memset(m_Iq, 0, numBytes);
-  ::memset(m_Ci, 0, numBytes);
-  ::memset(m_PhaseData, 0, numBytes);
-  ::memset(m_X, 0, numBytes);
-  ::memset(m_Y, 0, numBytes);
-  ::memset(m_SEMSignal, 0, numBytes);
-  ::memset(m_Fit, 0, numBytes);
-
-  if(nullptr == m_Phi1 || nullptr == m_Phi || nullptr == m_Phi2 || nullptr == m_Iq || nullptr == m_SEMSignal || nullptr == m_Ci || nullptr == m_PhaseData || m_X == nullptr || m_Y == nullptr)
+  m_SEMSignal = isArrayRequested(EbsdLib::Ang::SEMSignal) ? allocateArray<float>(totalDataPoints) : nullptr;
+  m_Fit = isArrayRequested(EbsdLib::Ang::Fit) ? allocateArray<float>(totalDataPoints) : nullptr;
+
+  for(void* ptr : {static_cast<void*>(m_Phi1), static_cast<void*>(m_Phi), static_cast<void*>(m_Phi2), static_cast<void*>(m_Iq), static_cast<void*>(m_Ci), static_cast<void*>(m_PhaseData),
+                   static_cast<void*>(m_X), static_cast<void*>(m_Y), static_cast<void*>(m_SEMSignal), static_cast<void*>(m_Fit)})
+  {
+    if(nullptr != ptr)
+    {
+      ::memset(ptr, 0, numBytes);
+    }
+  }
+
+  if(nullptr == m_X || nullptr == m_Y || (nullptr == m_Phi1 && isArrayRequested(EbsdLib::Ang::Phi1)) || (nullptr == m_Phi && isArrayRequested(EbsdLib::Ang::Phi)) ||
+     (nullptr == m_Phi2 && isArrayRequested(EbsdLib::Ang::Phi2)) || (nullptr == m_Iq && isArrayRequested(EbsdLib::Ang::ImageQuality)) ||
+     (nullptr == m_SEMSignal && isArrayRequested(EbsdLib::Ang::SEMSignal)) || (nullptr == m_Ci && isArrayRequested(EbsdLib::Ang::ConfidenceIndex)) ||
+     (nullptr == m_PhaseData && isArrayRequested(EbsdLib::Ang::PhaseData)))
   {
     ss.str("");
     ss << "Internal pointers were nullptr at " << __FILE__ << "(" << __LINE__ << ")\n";
     setErrorMessage(ss.str());
     setErrorCode(-2500);
+    return -2500;
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AngReader::readData(std::ifstream& in, std::string& buf)
+{
+  std::string streamBuf;
+  std::stringstream ss(streamBuf);
+
+  if(allocateDataArrays() < 0)
+  {
     return;
   }
+  size_t totalDataPoints = getNumberOfElements();
+  int nOddCols = getNumOddCols();
+  int nEvenCols = getNumEvenCols();
+  int numRows = getNumRows();
 
-  size_t counter = 1; // Because we are on the first line now.
+  size_t counter = 0;
 
   bool onEvenRow = false;
   int col = 0;
@@ -544,12 +966,12 @@ void AngReader::readData(std::ifstream& in, std::string& buf)
 
   for(size_t i = 0; i < totalDataPoints; ++i)
   {
-    if(i > 0)
+    // The buffer holds the first line after the header. Blank lines are skipped the same way the memory mapped path skips them.
+    if((i > 0 || LineChunker::IsBlankLine(buf)) && !LineChunker::ReadDataLine(in, buf))
     {
-      //  ::memset(buf, 0, bufSize); // Clear the buffer
-      std::getline(in, buf);
-      ++counter;
+      break;
     }
+    ++counter;
     parseDataLine(buf, i);
     if(getErrorCode() < 0)
     {
@@ -619,6 +1041,101 @@ void AngReader::readData(std::ifstream& in, std::string& buf)
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AngReader::readMappedData(std::string_view data)
+{
+  std::string streamBuf;
+  std::stringstream ss(streamBuf);
+
+  if(allocateDataArrays() < 0)
+  {
+    return;
+  }
+  size_t totalDataPoints = getNumberOfElements();
+  int nOddCols = getNumOddCols();
+  int nEvenCols = getNumEvenCols();
+  int numRows = getNumRows();
+
+  AngDataColumns columns;
+  columns.floatColumns = {m_Phi1, m_Phi, m_Phi2, m_X, m_Y, m_Iq, m_Ci, nullptr, m_SEMSignal, m_Fit};
+  columns.phase = m_PhaseData;
+
+  size_t numChunks = m_UseParallelParsing ? LineChunker::SuggestedChunkCount(data.size()) : 1;
+  std::vector<LineChunker::Chunk> chunks = LineChunker::Split(data, numChunks, true);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, chunks.size());
+  dataAlg.execute(ParseAngChunksImpl(columns, chunks, totalDataPoints));
+
+  // Find the first failure in file order so the error matches a serial read
+  const LineChunker::Chunk* errorChunk = LineChunker::FirstError(chunks);
+  size_t counter = (errorChunk != nullptr) ? errorChunk->errorLine + 1 : LineChunker::ParsedLines(chunks);
+
+  // Recreate the parsing position for the error messages. This is only needed when the file is bad.
+  int col = 0;
+  int yChange = 0;
+  auto findParsingPosition = [&](size_t numValidLines) {
+    float oldY = (totalDataPoints > 0) ? m_Y[0] : 0.0f;
+    for(size_t i = 0; i < numValidLines && i < totalDataPoints; ++i)
+    {
+      if(fabs(m_Y[i] - oldY) > 1e-6)
+      {
+        ++yChange;
+        oldY = m_Y[i];
+        col = 0;
+      }
+      else
+      {
+        col++;
+      }
+    }
+  };
+
+  if(errorChunk != nullptr)
+  {
+    findParsingPosition(errorChunk->errorLine);
+    // Find the offending line again for the error message
+    std::string_view text = errorChunk->text;
+    std::string_view line;
+    for(size_t i = errorChunk->firstLine; i <= errorChunk->errorLine; i++)
+    {
+      line = LineChunker::NextDataLine(text);
+    }
+    m_ErrorColumn = errorChunk->errorColumn;
+    setErrorCode(errorChunk->errorCode);
+    ss.str("");
+
+    ss << "Error parsing the data line (Numeric conversion). Error code is " << getErrorCode() << " and occurred at data column " << m_ErrorColumn << " (Zero Based)\n"
+       << line << "\n*** Header information ***\nRows=" << numRows << " EvenCols=" << nEvenCols << " OddCols=" << nOddCols << "  Calculated Data Points: " << totalDataPoints
+       << "\n***Parsing Position ***\nCurrent Row: " << yChange << "  Current Column Index: " << col << "  Current Data Point Count: " << counter << "\n";
+    setErrorMessage(ss.str());
+    return;
+  }
+
+  if(getNumFeatures() < 10)
+  {
+    deallocateArrayData<float>(m_Fit);
+  }
+  if(getNumFeatures() < 9)
+  {
+    deallocateArrayData<float>(m_SEMSignal);
+  }
+
+  if(counter != totalDataPoints)
+  {
+    findParsingPosition(counter);
+    ss.str("");
+
+    ss << "End of ANG file reached before all data was parsed.\n"
+       << getFileName() << "\n*** Header information ***\nRows=" << numRows << " EvenCols=" << nEvenCols << " OddCols=" << nOddCols << "  Calculated Data Points: " << totalDataPoints
+       << "\n***Parsing Position ***\nCurrent Row: " << yChange << "  Current Column Index: " << col << "  Current Data Point Count: " << counter << "\n";
+    setErrorMessage(ss.str());
+    setErrorCode(-600);
+  }
+}
+
 // -----------------------------------------------------------------------------
 //  Read the Header part of the ANG file
 // -----------------------------------------------------------------------------
@@ -840,7 +1357,7 @@ void AngReader::parseDataLine(std::string& line, size_t i)
   std::vector<std::string> tokens = EbsdStringUtils::split(line, ' ');
   bool ok = true;
   offset = i;
-  if(!tokens.empty())
+  if(!tokens.empty() && nullptr != m_Phi1)
   {
     p1 = std::stof(tokens[0]);
     if(!ok)
@@ -850,7 +1367,7 @@ void AngReader::parseDataLine(std::string& line, size_t i)
     }
     m_Phi1[offset] = p1;
   }
-  if(tokens.size() >= 2)
+  if(tokens.size() >= 2 && nullptr != m_Phi)
   {
     p = std::stof(tokens[1]);
     if(!ok)
@@ -860,7 +1377,7 @@ void AngReader::parseDataLine(std::string& line, size_t i)
     }
     m_Phi[offset] = p;
   }
-  if(tokens.size() >= 3)
+  if(tokens.size() >= 3 && nullptr != m_Phi2)
   {
     p2 = std::stof(tokens[2]);
     if(!ok)
@@ -870,7 +1387,7 @@ void AngReader::parseDataLine(std::string& line, size_t i)
     }
     m_Phi2[offset] = p2;
   }
-  if(tokens.size() >= 4)
+  if(tokens.size() >= 4 && nullptr != m_X)
   {
     x = std::stof(tokens[3]);
     if(!ok)
@@ -880,7 +1397,7 @@ void AngReader::parseDataLine(std::string& line, size_t i)
     }
     m_X[offset] = x;
   }
-  if(tokens.size() >= 5)
+  if(tokens.size() >= 5 && nullptr != m_Y)
   {
     y = std::stof(tokens[4]);
     if(!ok)
@@ -890,7 +1407,7 @@ void AngReader::parseDataLine(std::string& line, size_t i)
     }
     m_Y[offset] = y;
   }
-  if(tokens.size() >= 6)
+  if(tokens.size() >= 6 && nullptr != m_Iq)
   {
     iqual = std::stof(tokens[5]);
     if(!ok)
@@ -900,7 +1417,7 @@ void AngReader::parseDataLine(std::string& line, size_t i)
     }
     m_Iq[offset] = iqual;
   }
-  if(tokens.size() >= 7)
+  if(tokens.size() >= 7 && nullptr != m_Ci)
   {
     conf = std::stof(tokens[6]);
     if(!ok)
@@ -910,7 +1427,7 @@ void AngReader::parseDataLine(std::string& line, size_t i)
     }
     m_Ci[offset] = conf;
   }
-  if(tokens.size() >= 8)
+  if(tokens.size() >= 8 && nullptr != m_PhaseData)
   {
     try
     {
@@ -934,7 +1451,7 @@ void AngReader::parseDataLine(std::string& line, size_t i)
     m_PhaseData[offset] = ph;
   }
 
-  if(tokens.size() >= 9)
+  if(tokens.size() >= 9 && nullptr != m_SEMSignal)
   {
     semSignal = std::stof(tokens[8]);
     if(!ok)
@@ -944,7 +1461,7 @@ void AngReader::parseDataLine(std::string& line, size_t i)
     }
     m_SEMSignal[offset] = semSignal;
   }
-  if(tokens.size() >= 10)
+  if(tokens.size() >= 10 && nullptr != m_Fit)
   {
     fit = std::stof(tokens[9]);
     if(!ok)
@@ -1067,3 +1584,179 @@ void AngReader::setYDimension(int ydim)
 {
   setNumRows(ydim);
 }
+
+// -----------------------------------------------------------------------------
+AngDataStream::Iterator::Iterator(AngDataStream* stream)
+: m_Stream(stream)
+{
+}
+
+// -----------------------------------------------------------------------------
+AngDataStream::Iterator::reference AngDataStream::Iterator::operator*() const
+{
+  return m_Stream->getBlock();
+}
+
+// -----------------------------------------------------------------------------
+AngDataStream::Iterator::pointer AngDataStream::Iterator::operator->() const
+{
+  return &m_Stream->getBlock();
+}
+
+// -----------------------------------------------------------------------------
+AngDataStream::Iterator& AngDataStream::Iterator::operator++()
+{
+  if(!m_Stream->readNextBlock())
+  {
+    m_Stream = nullptr;
+  }
+  return *this;
+}
+
+// -----------------------------------------------------------------------------
+bool AngDataStream::Iterator::operator==(const Iterator& other) const
+{
+  return m_Stream == other.m_Stream;
+}
+
+// -----------------------------------------------------------------------------
+bool AngDataStream::Iterator::operator!=(const Iterator& other) const
+{
+  return m_Stream != other.m_Stream;
+}
+
+// -----------------------------------------------------------------------------
+AngDataStream::AngDataStream(std::ifstream&& in, std::string firstLine, size_t numElements, size_t rowsPerBlock, const std::array<bool, 10>& columns)
+: m_InStream(std::move(in))
+, m_Line(std::move(firstLine))
+, m_NumberOfElements(numElements)
+, m_RowsPerBlock(std::max<size_t>(rowsPerBlock, 1))
+{
+  size_t numFloatColumns = 0;
+  for(size_t c = 0; c < columns.size(); c++)
+  {
+    numFloatColumns += (columns[c] && c != 7) ? 1 : 0;
+  }
+  m_FloatBuffer.resize(numFloatColumns * m_RowsPerBlock);
+  if(columns[7])
+  {
+    m_PhaseBuffer.resize(m_RowsPerBlock);
+  }
+
+  float* next = m_FloatBuffer.data();
+  for(size_t c = 0; c < columns.size(); c++)
+  {
+    if(columns[c] && c != 7)
+    {
+      m_FloatColumns[c] = next;
+      next += m_RowsPerBlock;
+    }
+  }
+  m_Block.phi1 = m_FloatColumns[0];
+  m_Block.phi = m_FloatColumns[1];
+  m_Block.phi2 = m_FloatColumns[2];
+  m_Block.x = m_FloatColumns[3];
+  m_Block.y = m_FloatColumns[4];
+  m_Block.imageQuality = m_FloatColumns[5];
+  m_Block.confidenceIndex = m_FloatColumns[6];
+  m_Block.phase = m_PhaseBuffer.empty() ? nullptr : m_PhaseBuffer.data();
+  m_Block.semSignal = m_FloatColumns[8];
+  m_Block.fit = m_FloatColumns[9];
+}
+
+// -----------------------------------------------------------------------------
+AngDataStream::~AngDataStream() = default;
+
+// -----------------------------------------------------------------------------
+bool AngDataStream::readNextBlock()
+{
+  if(m_ErrorCode < 0 || m_RowsRead >= m_NumberOfElements)
+  {
+    return false;
+  }
+
+  AngDataColumns columns;
+  columns.floatColumns = m_FloatColumns;
+  columns.phase = m_PhaseBuffer.empty() ? nullptr : m_PhaseBuffer.data();
+
+  size_t numRows = std::min(m_RowsPerBlock, m_NumberOfElements - m_RowsRead);
+  // Rows that are missing from the end of a line keep their initial value
+  std::fill(m_FloatBuffer.begin(), m_FloatBuffer.end(), 0.0f);
+  std::fill(m_PhaseBuffer.begin(), m_PhaseBuffer.end(), 0);
+
+  size_t row = 0;
+  for(; row < numRows; row++)
+  {
+    if((!m_HasPendingLine || LineChunker::IsBlankLine(m_Line)) && !LineChunker::ReadDataLine(m_InStream, m_Line))
+    {
+      break;
+    }
+    m_HasPendingLine = false;
+
+    int errorColumn = 0;
+    int err = ParseAngDataLine(m_Line, row, columns, errorColumn);
+    if(err < 0)
+    {
+      m_ErrorCode = err;
+      std::stringstream ss;
+      ss << "Error parsing the data line (Numeric conversion). Error code is " << err << " and occurred at data column " << errorColumn << " (Zero Based)\n"
+         << m_Line << "\n  Current Data Point Count: " << (m_RowsRead + row + 1) << "\n";
+      m_ErrorMessage = ss.str();
+      return false;
+    }
+  }
+
+  m_Block.firstRow = m_RowsRead;
+  m_Block.numRows = row;
+  m_RowsRead += row;
+  if(row < numRows)
+  {
+    m_ErrorCode = -600;
+    std::stringstream ss;
+    ss << "End of ANG file reached before all data was parsed.\n  Calculated Data Points: " << m_NumberOfElements << "\n  Current Data Point Count: " << m_RowsRead << "\n";
+    m_ErrorMessage = ss.str();
+  }
+  return row > 0;
+}
+
+// -----------------------------------------------------------------------------
+const AngRowBlock& AngDataStream::getBlock() const
+{
+  return m_Block;
+}
+
+// -----------------------------------------------------------------------------
+size_t AngDataStream::getNumberOfElements() const
+{
+  return m_NumberOfElements;
+}
+
+// -----------------------------------------------------------------------------
+size_t AngDataStream::getRowsRead() const
+{
+  return m_RowsRead;
+}
+
+// -----------------------------------------------------------------------------
+int AngDataStream::getErrorCode() const
+{
+  return m_ErrorCode;
+}
+
+// -----------------------------------------------------------------------------
+std::string AngDataStream::getErrorMessage() const
+{
+  return m_ErrorMessage;
+}
+
+// -----------------------------------------------------------------------------
+AngDataStream::Iterator AngDataStream::begin()
+{
+  return readNextBlock() ? Iterator(this) : end();
+}
+
+// -----------------------------------------------------------------------------
+AngDataStream::Iterator AngDataStream::end()
+{
+  return Iterator();
+}
@@ -35,9 +35,14 @@
 
 #pragma once
 
+#include <array>
 #include <fstream>
+#include <iterator>
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "AngConstants.h"
@@ -48,6 +53,118 @@
 #include "EbsdLib/Core/EbsdSetGetMacros.h"
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/IO/EbsdReader.h"
+#include "EbsdLib/IO/EbsdSidecarCache.h"
+
+/**
+ * @brief A block of consecutive data rows from an .ang file stored as one array per
+ * column. Columns that were not requested, or that are not present in the file, are
+ * nullptr. The arrays are owned by the AngDataStream and stay valid until the next
+ * block is read.
+ */
+struct AngRowBlock
+{
+  size_t firstRow = 0;
+  size_t numRows = 0;
+  const float* phi1 = nullptr;
+  const float* phi = nullptr;
+  const float* phi2 = nullptr;
+  const float* x = nullptr;
+  const float* y = nullptr;
+  const float* imageQuality = nullptr;
+  const float* confidenceIndex = nullptr;
+  const int32_t* phase = nullptr;
+  const float* semSignal = nullptr;
+  const float* fit = nullptr;
+};
+
+/**
+ * @class AngDataStream AngReader.h EbsdLib/IO/TSL/AngReader.h
+ * @brief Reads the data section of an .ang file in fixed size blocks of rows that are
+ * decoded into one reused buffer, so the memory used does not depend on the size of the
+ * scan. Instances are created by AngReader::openStream() after the header was parsed.
+ * The rows are delivered in file order; unlike AngReader::readFile() square grids are not
+ * reordered. The stream can be iterated with a range based for loop:
+ * @code
+ *   std::unique_ptr<AngDataStream> stream = reader.openStream(4096);
+ *   for(const AngRowBlock& block : *stream) { ... }
+ *   if(stream->getErrorCode() < 0) { ... }
+ * @endcode
+ */
+class EbsdLib_EXPORT AngDataStream
+{
+public:
+  class Iterator
+  {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = AngRowBlock;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const AngRowBlock*;
+    using reference = const AngRowBlock&;
+
+    Iterator() = default;
+    explicit Iterator(AngDataStream* stream);
+
+    reference operator*() const;
+    pointer operator->() const;
+    Iterator& operator++();
+    bool operator==(const Iterator& other) const;
+    bool operator!=(const Iterator& other) const;
+
+  private:
+    AngDataStream* m_Stream = nullptr;
+  };
+
+  /**
+   * @param in The file positioned after the header
+   * @param firstLine The first line of data that was already read by the header parser
+   * @param numElements The number of data rows given by the header
+   * @param rowsPerBlock The number of rows in each block
+   * @param columns Which of the 10 columns to decode, in file order. Column 8 and 9 are
+   * the optional SEM Signal and Fit columns.
+   */
+  AngDataStream(std::ifstream&& in, std::string firstLine, size_t numElements, size_t rowsPerBlock, const std::array<bool, 10>& columns);
+  ~AngDataStream();
+
+  /**
+   * @brief Decodes the next block of rows into the buffer.
+   * @return false when all rows were read or an error occurred
+   */
+  bool readNextBlock();
+
+  /**
+   * @brief Returns the block that was decoded by the last call to readNextBlock()
+   */
+  const AngRowBlock& getBlock() const;
+
+  size_t getNumberOfElements() const;
+  size_t getRowsRead() const;
+  int getErrorCode() const;
+  std::string getErrorMessage() const;
+
+  Iterator begin();
+  Iterator end();
+
+private:
+  std::ifstream m_InStream;
+  std::string m_Line;
+  bool m_HasPendingLine = true;
+  size_t m_NumberOfElements = 0;
+  size_t m_RowsPerBlock = 0;
+  size_t m_RowsRead = 0;
+  std::vector<float> m_FloatBuffer;
+  std::vector<int32_t> m_PhaseBuffer;
+  std::array<float*, 10> m_FloatColumns = {};
+  AngRowBlock m_Block;
+  int m_ErrorCode = 0;
+  std::string m_ErrorMessage;
+
+public:
+  AngDataStream(const AngDataStream&) = delete;            // Copy Constructor Not Implemented
+  AngDataStream(AngDataStream&&) = delete;                 // Move Constructor Not Implemented
+  AngDataStream& operator=(const AngDataStream&) = delete; // Copy Assignment Not Implemented
+  AngDataStream& operator=(AngDataStream&&) = delete;      // Move Assignment Not Implemented
+};
 
 /**
  * @class AngReader AngReader.h EbsdLib/IO/TSL/AngReader.h
@@ -103,6 +220,25 @@ public:
 
   EBSD_INSTANCE_PROPERTY(bool, ReadHexGrid)
 
+  /**
+   * @brief When true, readFile() memory maps the .ang file and converts the data section
+   * in place instead of reading it line by line through a std::ifstream.
+   */
+  EBSD_INSTANCE_PROPERTY(bool, UseMemoryMappedIO)
+
+  /**
+   * @brief When true, readFile() splits the data section into newline aligned chunks and
+   * parses them concurrently. This implies the memory mapped read.
+   */
+  EBSD_INSTANCE_PROPERTY(bool, UseParallelParsing)
+
+  /**
+   * @brief When true, readFile() loads the arrays from the binary cache next to the .ang
+   * file (see EbsdSidecarCache) when the cache matches the file, and writes the cache after
+   * the file was parsed otherwise.
+   */
+  EBSD_INSTANCE_PROPERTY(bool, UseSidecarCache)
+
   EBSD_INSTANCE_PROPERTY(std::string, Notes)
   EBSD_INSTANCE_PROPERTY(std::string, ColumnNotes)
 
@@ -165,11 +301,37 @@ public:
    */
   int readHeaderOnly() override;
 
+  /**
+   * @brief Parses the header of the file and returns a stream over the data section that
+   * decodes 'rowsPerBlock' rows at a time. Only the arrays selected with setArraysToRead()
+   * are decoded. The header values of this reader are valid once the stream is returned.
+   * @param rowsPerBlock The number of rows decoded per block
+   * @return The stream or nullptr if the file could not be opened or the header is invalid.
+   * The error code and message are set on this reader in that case.
+   */
+  std::unique_ptr<AngDataStream> openStream(size_t rowsPerBlock = 4096);
+
   int getXDimension() override;
   void setXDimension(int xdim) override;
   int getYDimension() override;
   void setYDimension(int ydim) override;
 
+  /**
+   * @brief Sets the names of the arrays to read out of the file. Columns that are not
+   * requested are skipped without being converted or allocated. The X and Y Position
+   * columns are always decoded because they are needed to order the data of square
+   * grids; they are released after the read if they were not requested.
+   * @param names
+   */
+  void setArraysToRead(const std::set<std::string>& names);
+
+  /**
+   * @brief Over rides the setArraysToReads to tell the reader to load ALL the data from the file. If the
+   * ArrayNames to read is empty and this is true then all arrays will be read.
+   * @param b
+   */
+  void readAllArrays(bool b);
+
   std::pair<int, std::string> fixOrderOfData(std::vector<int64_t>& indexMap);
 
   /**
@@ -197,9 +359,70 @@ public:
 private:
   AngPhase::Pointer m_CurrentPhase;
   int m_ErrorColumn = 0;
+  std::set<std::string> m_ArrayNames;
+  bool m_ReadAllArrays = true;
+
+  /**
+   * @brief Returns true if the named array should be allocated and read
+   */
+  bool isArrayRequested(const std::string& name) const;
 
   void readData(std::ifstream& in, std::string& buf);
 
+  /**
+   * @brief Checks the header values that are required before the data section can be read.
+   * @return Zero on success or the (negative) error code that was set.
+   */
+  int checkHeaderValues();
+
+  /**
+   * @brief Reads and parses the header section and checks the header values. The first
+   * line of data is left in 'buf'.
+   * @param in The opened file
+   * @param buf Receives the first line after the header
+   * @return Zero on success or the (negative) error code that was set.
+   */
+  int readStreamHeader(std::ifstream& in, std::string& buf);
+
+  /**
+   * @brief Computes the number of data points from the header values and stores it
+   * in NumberOfElements.
+   * @return Zero on success or the (negative) error code that was set.
+   */
+  int calculateNumberOfElements();
+
+  /**
+   * @brief Computes the number of data points from the header values and allocates
+   * the requested data arrays. The number of data points is stored in NumberOfElements.
+   * @return Zero on success or the (negative) error code that was set.
+   */
+  int allocateDataArrays();
+
+  /**
+   * @brief Reads the complete file through a read-only memory mapping.
+   * @return Zero on success or the (negative) error code that was set.
+   */
+  int readMappedFile();
+
+  /**
+   * @brief Parses the data section of the memory mapped file.
+   * @param data The bytes of the file starting at the first line of data
+   */
+  void readMappedData(std::string_view data);
+
+  /**
+   * @brief Loads the header and the requested arrays from the sidecar cache.
+   * @return true if the cache matched the file and held every requested array. Nothing
+   * is changed when false is returned.
+   */
+  bool readSidecarCache();
+
+  /**
+   * @brief Writes the header and the arrays that were read to the sidecar cache.
+   * @param stamp The key of the .ang file taken before it was parsed
+   */
+  void writeSidecarCache(const EbsdSidecarCache::SourceStamp& stamp);
+
   /** @brief Parses the value from a single line of the header section of the TSL .ang file
    * @param line The line to parse
    */
@@ -40,16 +40,16 @@
 #include <tbb/parallel_for.h>
 #include <tbb/partitioner.h>
 #include <tbb/task.h>
-#include <tbb/task_group.h>
 #endif
 
 // Include this FIRST because there is a needed define for some compiles
 // to expose some of the constants needed below
 #include "EbsdLib/Core/EbsdMacros.h"
 #include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/LaueOps/LaueKernel.hpp"
+#include "EbsdLib/LaueOps/PoleFigureAccumulator.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
 #include "EbsdLib/Utilities/ColorTable.h"
-#include "EbsdLib/Utilities/ComputeStereographicProjection.h"
 #include "EbsdLib/Utilities/EbsdStringUtils.hpp"
 #include "EbsdLib/Utilities/ModifiedLambertProjection.h"
 
@@ -74,35 +74,11 @@ static const int k_NumMdfBins = 18;
 
 // Rotation Point Group: 23
 // clang-format off
-static const std::vector<QuatD> QuatSym ={
-    QuatD(0.0, 0.0, 0.0, 1.0),
-    QuatD(1.0, 0.0, 0.0, 0.0),
-    QuatD(0.0, 1.0, 0.0, 0.0),
-    QuatD(0.0, 0.0, 1.0, 0.0),
-    QuatD(0.5, 0.5, 0.5, 0.5),
-    QuatD(-0.5, -0.5, -0.5, 0.5),
-    QuatD(0.5, -0.5, 0.5, 0.5),
-    QuatD(-0.5, 0.5, -0.5, 0.5),
-    QuatD(-0.5, 0.5, 0.5, 0.5),
-    QuatD(0.5, -0.5, -0.5, 0.5),
-    QuatD(-0.5, -0.5, 0.5, 0.5),
-    QuatD(0.5, 0.5, -0.5, 0.5),
-};
+using Kernel = LaueKernel<LaueKernels::CubicLow>;
 
-static const std::vector<OrientationD> RodSym = {
-    {0.0, 0.0, 1.0, 0.0},
-    {1.0, 0.0, 0.0, 10000000000000.0},
-    {0.0, 1.0, 0.0, 10000000000000.0},
-    {0.0, 0.0, 1.0, 10000000000000.0},
-    {0.5773502691896258, 0.5773502691896258, 0.5773502691896258, 1.7320508075688767},
-    {-0.5773502691896258, -0.5773502691896258, -0.5773502691896258, 1.7320508075688767},
-    {0.5773502691896258, -0.5773502691896258, 0.5773502691896258, 1.7320508075688767},
-    {-0.5773502691896258, 0.5773502691896258, -0.5773502691896258, 1.7320508075688767},
-    {-0.5773502691896258, 0.5773502691896258, 0.5773502691896258, 1.7320508075688767},
-    {0.5773502691896258, -0.5773502691896258, -0.5773502691896258, 1.7320508075688767},
-    {-0.5773502691896258, -0.5773502691896258, 0.5773502691896258, 1.7320508075688767},
-    {0.5773502691896258, 0.5773502691896258, -0.5773502691896258, 1.7320508075688767},
-};
+static const std::vector<QuatD> QuatSym = Kernel::QuatSymTable();
+
+static const std::vector<OrientationD> RodSym = Kernel::RodSymTable();
 
 static const double MatSym[k_SymOpsCount][3][3] = {
     {{1.0, 0.0, 0.0},
@@ -155,8 +131,6 @@ static const double MatSym[k_SymOpsCount][3][3] = {
     
 };
 // clang-format on
-static const double k_EtaMin = 0.0;
-static const double k_EtaMax = 45.0;
 } // namespace CubicLow
 
 // -----------------------------------------------------------------------------
@@ -240,7 +214,7 @@ std::string CubicLowOps::getRotationPointGroup() const
 // -----------------------------------------------------------------------------
 OrientationD CubicLowOps::calculateMisorientation(const QuatD& q1, const QuatD& q2) const
 {
-  return calculateMisorientationInternal(CubicLow::QuatSym, q1, q2);
+  return CubicLow::Kernel::calculateMisorientation(q1, q2);
 }
 
 // -----------------------------------------------------------------------------
@@ -249,7 +223,7 @@ OrientationF CubicLowOps::calculateMisorientation(const QuatF& q1f, const QuatF&
 {
   QuatD q1 = q1f.to<double>();
   QuatD q2 = q2f.to<double>();
-  OrientationD axisAngle = calculateMisorientationInternal(CubicLow::QuatSym, q1, q2);
+  OrientationD axisAngle = CubicLow::Kernel::calculateMisorientation(q1, q2);
   return axisAngle;
 }
 
@@ -309,7 +283,7 @@ void CubicLowOps::getMatSymOp(int i, float g[3][3]) const
 // -----------------------------------------------------------------------------
 OrientationType CubicLowOps::getODFFZRod(const OrientationType& rod) const
 {
-  return _calcRodNearestOrigin(CubicLow::RodSym, rod);
+  return CubicLow::Kernel::getODFFZRod(rod);
 }
 
 // -----------------------------------------------------------------------------
@@ -320,8 +294,8 @@ OrientationType CubicLowOps::getMDFFZRod(const OrientationType& inRod) const
   double w = 0.0, n1 = 0.0, n2 = 0.0, n3 = 0.0;
   double FZn1 = 0.0, FZn2 = 0.0, FZn3 = 0.0, FZw = 0.0;
 
-  OrientationType rod = _calcRodNearestOrigin(CubicLow::RodSym, inRod);
-  OrientationType ax = OrientationTransformation::ro2ax<OrientationType, OrientationType>(rod);
+  OrientationType rod = CubicLow::Kernel::getODFFZRod(inRod);
+  AxisAngle<double> ax = OrientationTransformation::ro2ax<OrientationType, AxisAngle<double>>(rod);
 
   n1 = ax[0];
   n2 = ax[1], n3 = ax[2], w = ax[3];
@@ -369,7 +343,7 @@ OrientationType CubicLowOps::getMDFFZRod(const OrientationType& inRod) const
     }
   }
 
-  return OrientationTransformation::ax2ro<OrientationType, OrientationType>(OrientationType(FZn1, FZn2, FZn3, FZw));
+  return OrientationTransformation::ax2ro<AxisAngle<double>, OrientationType>(AxisAngle<double>(FZn1, FZn2, FZn3, FZw));
 }
 
 QuatD CubicLowOps::getNearestQuat(const QuatD& q1, const QuatD& q2) const
@@ -428,11 +402,11 @@ OrientationType CubicLowOps::determineEulerAngles(double random[3], int choose)
 
   _calcDetermineHomochoricValues(random, init, step, phi, h1, h2, h3);
 
-  OrientationType ho(h1, h2, h3);
-  OrientationType ro = OrientationTransformation::ho2ro<OrientationType, OrientationType>(ho);
+  Homochoric<double> ho(h1, h2, h3);
+  OrientationType ro = OrientationTransformation::ho2ro<Homochoric<double>, OrientationType>(ho);
   ro = getODFFZRod(ro);
-  OrientationType eu = OrientationTransformation::ro2eu<OrientationType, OrientationType>(ro);
-  return eu;
+  Euler<double> eu = OrientationTransformation::ro2eu<OrientationType, Euler<double>>(ro);
+  return {eu[0], eu[1], eu[2]};
 }
 
 // -----------------------------------------------------------------------------
@@ -467,8 +441,8 @@ OrientationType CubicLowOps::determineRodriguesVector(double random[3], int choo
   phi[2] = static_cast<int32_t>(choose / (CubicLow::OdfNumBins[0] * CubicLow::OdfNumBins[1]));
 
   _calcDetermineHomochoricValues(random, init, step, phi, h1, h2, h3);
-  OrientationType ho(h1, h2, h3);
-  OrientationType ro = OrientationTransformation::ho2ro<OrientationType, OrientationType>(ho);
+  Homochoric<double> ho(h1, h2, h3);
+  OrientationType ro = OrientationTransformation::ho2ro<Homochoric<double>, OrientationType>(ho);
   ro = getMDFFZRod(ro);
   return ro;
 }
@@ -872,19 +846,7 @@ void _TripletSort(T a, T b, T c, T& x, T& y, T& z)
 // -----------------------------------------------------------------------------
 std::array<double, 3> CubicLowOps::getIpfColorAngleLimits(double eta) const
 {
-  double etaDeg = eta * EbsdLib::Constants::k_180OverPiD;
-  double chiMax;
-  if(etaDeg > 45.0)
-  {
-    chiMax = sqrt(1.0 / (2.0 + tan(0.5 * EbsdLib::Constants::k_PiD - eta) * tan(0.5 * EbsdLib::Constants::k_PiD - eta)));
-  }
-  else
-  {
-    chiMax = sqrt(1.0 / (2.0 + tan(eta) * tan(eta)));
-  }
-  EbsdLibMath::bound(chiMax, -1.0, 1.0);
-  chiMax = acos(chiMax);
-  return {CubicLow::k_EtaMin * EbsdLib::Constants::k_DegToRadD, CubicLow::k_EtaMax * EbsdLib::Constants::k_DegToRadD, chiMax};
+  return CubicLow::Kernel::getIpfColorAngleLimits(eta);
 }
 
 // -----------------------------------------------------------------------------
@@ -892,19 +854,7 @@ std::array<double, 3> CubicLowOps::getIpfColorAngleLimits(double eta) const
 // -----------------------------------------------------------------------------
 bool CubicLowOps::inUnitTriangle(double eta, double chi) const
 {
-  double etaDeg = eta * EbsdLib::Constants::k_180OverPiD;
-  double chiMax;
-  if(etaDeg > 45.0)
-  {
-    chiMax = sqrt(1.0 / (2.0 + tan(0.5 * EbsdLib::Constants::k_PiD - eta) * tan(0.5 * EbsdLib::Constants::k_PiD - eta)));
-  }
-  else
-  {
-    chiMax = sqrt(1.0 / (2.0 + tan(eta) * tan(eta)));
-  }
-  EbsdLibMath::bound(chiMax, -1.0, 1.0);
-  chiMax = acos(chiMax);
-  return !(eta < CubicLow::k_EtaMin || eta > (CubicLow::k_EtaMax * EbsdLib::Constants::k_PiOver180D) || chi < 0.0 || chi > chiMax);
+  return CubicLow::Kernel::inUnitTriangle(eta, chi);
 }
 
 // -----------------------------------------------------------------------------
@@ -912,7 +862,7 @@ bool CubicLowOps::inUnitTriangle(double eta, double chi) const
 // -----------------------------------------------------------------------------
 EbsdLib::Rgb CubicLowOps::generateIPFColor(double* eulers, double* refDir, bool degToRad) const
 {
-  return computeIPFColor(eulers, refDir, degToRad);
+  return CubicLow::Kernel::generateIPFColor(eulers, refDir, degToRad);
 }
 
 // -----------------------------------------------------------------------------
@@ -922,7 +872,7 @@ EbsdLib::Rgb CubicLowOps::generateIPFColor(double phi1, double phi, double phi2,
 {
   double eulers[3] = {phi1, phi, phi2};
   double refDir[3] = {refDir0, refDir1, refDir2};
-  return computeIPFColor(eulers, refDir, degToRad);
+  return CubicLow::Kernel::generateIPFColor(eulers, refDir, degToRad);
 }
 
 // -----------------------------------------------------------------------------
@@ -959,158 +909,22 @@ std::array<std::string, 3> CubicLowOps::getDefaultPoleFigureNames() const
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-std::vector<EbsdLib::UInt8ArrayType::Pointer> CubicLowOps::generatePoleFigure(PoleFigureConfiguration_t& config) const
+std::array<size_t, 3> CubicLowOps::getPoleFigureFamilySizes() const
 {
-  std::array<std::string, 3> labels = getDefaultPoleFigureNames();
-  std::string label0 = labels[0];
-  std::string label1 = labels[1];
-  std::string label2 = labels[2];
-  if(!config.labels.empty())
-  {
-    label0 = config.labels.at(0);
-  }
-  if(config.labels.size() > 1)
-  {
-    label1 = config.labels.at(1);
-  }
-  if(config.labels.size() > 2)
-  {
-    label2 = config.labels.at(2);
-  }
-
-  size_t numOrientations = config.eulers->getNumberOfTuples();
-
-  // Create an Array to hold the XYZ Coordinates which are the coords on the sphere.
-  // this is size for CUBIC ONLY, <001> Family
-  std::vector<size_t> dims(1, 3);
-  EbsdLib::FloatArrayType::Pointer xyz001 = EbsdLib::FloatArrayType::CreateArray(numOrientations * CubicLow::symSize0, dims, label0 + std::string("xyzCoords"), true);
-  // this is size for CUBIC ONLY, <011> Family
-  EbsdLib::FloatArrayType::Pointer xyz011 = EbsdLib::FloatArrayType::CreateArray(numOrientations * CubicLow::symSize1, dims, label1 + std::string("xyzCoords"), true);
-  // this is size for CUBIC ONLY, <111> Family
-  EbsdLib::FloatArrayType::Pointer xyz111 = EbsdLib::FloatArrayType::CreateArray(numOrientations * CubicLow::symSize2, dims, label2 + std::string("xyzCoords"), true);
+  return {CubicLow::symSize0, CubicLow::symSize1, CubicLow::symSize2};
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<EbsdLib::UInt8ArrayType::Pointer> CubicLowOps::generatePoleFigure(PoleFigureConfiguration_t& config) const
+{
   config.sphereRadius = 1.0f;
 
-  // Generate the coords on the sphere **** Parallelized
-  generateSphereCoordsFromEulers(config.eulers, xyz001.get(), xyz011.get(), xyz111.get());
-
-  // These arrays hold the "intensity" images which eventually get converted to an actual Color RGB image
-  // Generate the modified Lambert projection images (Squares, 2 of them, 1 for northern hemisphere, 1 for southern hemisphere
-  EbsdLib::DoubleArrayType::Pointer intensity001 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label0 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity011 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label1 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity111 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label2 + "_Intensity_Image", true);
-#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
-  bool doParallel = true;
-
-  if(doParallel)
-  {
-    std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-    g->run(ComputeStereographicProjection(xyz001.get(), &config, intensity001.get()));
-    g->run(ComputeStereographicProjection(xyz011.get(), &config, intensity011.get()));
-    g->run(ComputeStereographicProjection(xyz111.get(), &config, intensity111.get()));
-    g->wait(); // Wait for all the threads to complete before moving on.
-  }
-  else
-#endif
-  {
-    ComputeStereographicProjection m001(xyz001.get(), &config, intensity001.get());
-    m001();
-    ComputeStereographicProjection m011(xyz011.get(), &config, intensity011.get());
-    m011();
-    ComputeStereographicProjection m111(xyz111.get(), &config, intensity111.get());
-    m111();
-  }
-
-  // Find the Max and Min values based on ALL 3 arrays so we can color scale them all the same
-  double max = std::numeric_limits<double>::min();
-  double min = std::numeric_limits<double>::max();
-
-  double* dPtr = intensity001->getPointer(0);
-  size_t count = intensity001->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity011->getPointer(0);
-  count = intensity011->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity111->getPointer(0);
-  count = intensity111->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  config.minScale = min;
-  config.maxScale = max;
-
-  dims[0] = 4;
-  EbsdLib::UInt8ArrayType::Pointer image001 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label0, true);
-  EbsdLib::UInt8ArrayType::Pointer image011 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label1, true);
-  EbsdLib::UInt8ArrayType::Pointer image111 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label2, true);
-
-  std::vector<EbsdLib::UInt8ArrayType::Pointer> poleFigures(3);
-  if(config.order.size() == 3)
-  {
-    poleFigures[config.order[0]] = image001;
-    poleFigures[config.order[1]] = image011;
-    poleFigures[config.order[2]] = image111;
-  }
-  else
-  {
-    poleFigures[0] = image001;
-    poleFigures[1] = image011;
-    poleFigures[2] = image111;
-  }
-
-#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
-
-  if(doParallel)
-  {
-    std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-    g->run(GeneratePoleFigureRgbaImageImpl(intensity001.get(), &config, image001.get()));
-    g->run(GeneratePoleFigureRgbaImageImpl(intensity011.get(), &config, image011.get()));
-    g->run(GeneratePoleFigureRgbaImageImpl(intensity111.get(), &config, image111.get()));
-    g->wait(); // Wait for all the threads to complete before moving on.
-  }
-  else
-#endif
-  {
-    GeneratePoleFigureRgbaImageImpl m001(intensity001.get(), &config, image001.get());
-    m001();
-    GeneratePoleFigureRgbaImageImpl m011(intensity011.get(), &config, image011.get());
-    m011();
-    GeneratePoleFigureRgbaImageImpl m111(intensity111.get(), &config, image111.get());
-    m111();
-  }
-
-  return poleFigures;
+  // Project the orientations a chunk at a time and render the three pole figures with one color scale **** Parallelized
+  PoleFigureAccumulator accumulator(*this, config);
+  accumulator.add(*config.eulers);
+  return accumulator.createPoleFigures(config.minScale, config.maxScale);
 }
 
 // -----------------------------------------------------------------------------
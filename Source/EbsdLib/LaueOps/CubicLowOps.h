@@ -233,6 +233,12 @@ public:
    */
   std::array<std::string, 3> getDefaultPoleFigureNames() const override;
 
+  /**
+   * @brief Returns the number of sphere directions that generateSphereCoordsFromEulers creates per orientation for each
+   * of the three pole figures
+   */
+  std::array<size_t, 3> getPoleFigureFamilySizes() const override;
+
   /**
    * @brief generateStandardTriangle Generates an RGBA array that is a color "Standard" IPF Triangle Legend used for IPF Color Maps.
    * @return
@@ -40,18 +40,18 @@
 #include <tbb/parallel_for.h>
 #include <tbb/partitioner.h>
 #include <tbb/task.h>
-#include <tbb/task_group.h>
 #endif
 
 // Include this FIRST because there is a needed define for some compiles
 // to expose some of the constants needed below
 #include "EbsdLib/Core/EbsdMacros.h"
 #include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/LaueOps/LaueKernel.hpp"
+#include "EbsdLib/LaueOps/PoleFigureAccumulator.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
 #include "EbsdLib/Math/GeometryMath.h"
 #include "EbsdLib/Utilities/ColorTable.h"
 #include "EbsdLib/Utilities/ColorUtilities.h"
-#include "EbsdLib/Utilities/ComputeStereographicProjection.h"
 #include "EbsdLib/Utilities/EbsdStringUtils.hpp"
 
 namespace CubicHigh
@@ -82,59 +82,11 @@ static const double SlipPlanes[12][3] = {{1.0, 1.0, 1.0},  {1.0, 1.0, 1.0},  {1.
 
 // Rotation Point Group: 432
 // clang-format off
-static const std::vector<QuatD> QuatSym ={
-    QuatD(0.0, 0.0, 0.0, 1.0),
-    QuatD(1.0, 0.0, 0.0, 0.0),
-    QuatD(0.0, 1.0, 0.0, 0.0),
-    QuatD(0.0, 0.0, 1.0, 0.0),
-    QuatD(0.7071067811865476, 0.0, 0.0, 0.7071067811865476),
-    QuatD(0.0, 0.7071067811865476, 0.0, 0.7071067811865476),
-    QuatD(0.0, 0.0, 0.7071067811865476, 0.7071067811865476),
-    QuatD(-0.7071067811865476, 0.0, 0.0, 0.7071067811865476),
-    QuatD(0.0, -0.7071067811865476, 0.0, 0.7071067811865476),
-    QuatD(0.0, 0.0, -0.7071067811865476, 0.7071067811865476),
-    QuatD(0.7071067811865476, 0.7071067811865476, 0.0, 0.0),
-    QuatD(-0.7071067811865476, 0.7071067811865476, 0.0, 0.0),
-    QuatD(0.0, 0.7071067811865476, 0.7071067811865476, 0.0),
-    QuatD(0.0, -0.7071067811865476, 0.7071067811865476, 0.0),
-    QuatD(0.7071067811865476, 0.0, 0.7071067811865476, 0.0),
-    QuatD(-0.7071067811865476, 0.0, 0.7071067811865476, 0.0),
-    QuatD(0.5, 0.5, 0.5, 0.5),
-    QuatD(-0.5, -0.5, -0.5, 0.5),
-    QuatD(0.5, -0.5, 0.5, 0.5),
-    QuatD(-0.5, 0.5, -0.5, 0.5),
-    QuatD(-0.5, 0.5, 0.5, 0.5),
-    QuatD(0.5, -0.5, -0.5, 0.5),
-    QuatD(-0.5, -0.5, 0.5, 0.5),
-    QuatD(0.5, 0.5, -0.5, 0.5),
-};
+using Kernel = LaueKernel<LaueKernels::CubicHigh>;
 
-static const std::vector<OrientationD> RodSym = {
-    {0.0, 0.0, 1.0, 0.0},
-    {1.0, 0.0, 0.0, 10000000000000.0},
-    {0.0, 1.0, 0.0, 10000000000000.0},
-    {0.0, 0.0, 1.0, 10000000000000.0},
-    {1.0, 0.0, 0.0, 1.0},
-    {0.0, 1.0, 0.0, 1.0},
-    {0.0, 0.0, 1.0, 1.0},
-    {-1.0, 0.0, 0.0, 1.0},
-    {0.0, -1.0, 0.0, 1.0},
-    {0.0, 0.0, -1.0, 1.0},
-    {0.7071067811865476, 0.7071067811865476, 0.0, 10000000000000.0},
-    {-0.7071067811865476, 0.7071067811865476, 0.0, 10000000000000.0},
-    {0.0, 0.7071067811865476, 0.7071067811865476, 10000000000000.0},
-    {0.0, -0.7071067811865476, 0.7071067811865476, 10000000000000.0},
-    {0.7071067811865476, 0.0, 0.7071067811865476, 10000000000000.0},
-    {-0.7071067811865476, 0.0, 0.7071067811865476, 10000000000000.0},
-    {0.5773502691896258, 0.5773502691896258, 0.5773502691896258, 1.7320508075688767},
-    {-0.5773502691896258, -0.5773502691896258, -0.5773502691896258, 1.7320508075688767},
-    {0.5773502691896258, -0.5773502691896258, 0.5773502691896258, 1.7320508075688767},
-    {-0.5773502691896258, 0.5773502691896258, -0.5773502691896258, 1.7320508075688767},
-    {-0.5773502691896258, 0.5773502691896258, 0.5773502691896258, 1.7320508075688767},
-    {0.5773502691896258, -0.5773502691896258, -0.5773502691896258, 1.7320508075688767},
-    {-0.5773502691896258, -0.5773502691896258, 0.5773502691896258, 1.7320508075688767},
-    {0.5773502691896258, 0.5773502691896258, -0.5773502691896258, 1.7320508075688767},
-};
+static const std::vector<QuatD> QuatSym = Kernel::QuatSymTable();
+
+static const std::vector<OrientationD> RodSym = Kernel::RodSymTable();
 
 static const double MatSym[k_SymOpsCount][3][3] = {
     {{1.0, 0.0, 0.0},
@@ -235,8 +187,6 @@ static const double MatSym[k_SymOpsCount][3][3] = {
     
 };
 // clang-format on
-static const double k_EtaMin = 0.0;
-static const double k_EtaMax = 45.0;
 
 } // namespace CubicHigh
 
@@ -321,7 +271,7 @@ std::string CubicOps::getRotationPointGroup() const
 // -----------------------------------------------------------------------------
 OrientationD CubicOps::calculateMisorientation(const QuatD& q1, const QuatD& q2) const
 {
-  return calculateMisorientationInternal(CubicHigh::QuatSym, q1, q2);
+  return CubicHigh::Kernel::calculateMisorientation(q1, q2);
 }
 
 // -----------------------------------------------------------------------------
@@ -330,265 +280,22 @@ OrientationF CubicOps::calculateMisorientation(const QuatF& q1f, const QuatF& q2
 {
   QuatD q1 = q1f.to<double>();
   QuatD q2 = q2f.to<double>();
-  OrientationD axisAngle = calculateMisorientationInternal(CubicHigh::QuatSym, q1, q2);
+  OrientationD axisAngle = CubicHigh::Kernel::calculateMisorientation(q1, q2);
   return axisAngle;
 }
 
+// -----------------------------------------------------------------------------
+bool CubicOps::hasClosedFormMisorientation() const
+{
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 OrientationD CubicOps::calculateMisorientationInternal(const std::vector<QuatD>& quatsym, const QuatD& q1, const QuatD& q2) const
 {
-  double wmin = 9999999.0f; //,na,nb,nc;
-  QuatD qco;
-  int type = 1;
-  double sin_wmin_over_2 = 0.0;
-
-  QuatD qc = q1 * (q2.conjugate());
-  qc.elementWiseAbs();
-
-  // if qc.x() is smallest
-  if(qc.x() <= qc.y() && qc.x() <= qc.z() && qc.x() <= qc.w())
-  {
-    qco.x() = qc.x();
-    // if qc.y() is next smallest
-    if(qc.y() <= qc.z() && qc.y() <= qc.w())
-    {
-      qco.y() = qc.y();
-      if(qc.z() <= qc.w())
-      {
-        qco.z() = qc.z(), qco.w() = qc.w();
-      }
-      else
-      {
-        qco.z() = qc.w(), qco.w() = qc.z();
-      }
-    }
-    // if qc.z() is next smallest
-    else if(qc.z() <= qc.y() && qc.z() <= qc.w())
-    {
-      qco.y() = qc.z();
-      if(qc.y() <= qc.w())
-      {
-        qco.z() = qc.y(), qco.w() = qc.w();
-      }
-      else
-      {
-        qco.z() = qc.w(), qco.w() = qc.y();
-      }
-    }
-    // if qc.w() is next smallest
-    else
-    {
-      qco.y() = qc.w();
-      if(qc.y() <= qc.z())
-      {
-        qco.z() = qc.y(), qco.w() = qc.z();
-      }
-      else
-      {
-        qco.z() = qc.z(), qco.w() = qc.y();
-      }
-    }
-  }
-  // if qc.y() is smallest
-  else if(qc.y() <= qc.x() && qc.y() <= qc.z() && qc.y() <= qc.w())
-  {
-    qco.x() = qc.y();
-    // if qc.x() is next smallest
-    if(qc.x() <= qc.z() && qc.x() <= qc.w())
-    {
-      qco.y() = qc.x();
-      if(qc.z() <= qc.w())
-      {
-        qco.z() = qc.z(), qco.w() = qc.w();
-      }
-      else
-      {
-        qco.z() = qc.w(), qco.w() = qc.z();
-      }
-    }
-    // if qc.z() is next smallest
-    else if(qc.z() <= qc.x() && qc.z() <= qc.w())
-    {
-      qco.y() = qc.z();
-      if(qc.x() <= qc.w())
-      {
-        qco.z() = qc.x(), qco.w() = qc.w();
-      }
-      else
-      {
-        qco.z() = qc.w(), qco.w() = qc.x();
-      }
-    }
-    // if qc.w() is next smallest
-    else
-    {
-      qco.y() = qc.w();
-      if(qc.x() <= qc.z())
-      {
-        qco.z() = qc.x(), qco.w() = qc.z();
-      }
-      else
-      {
-        qco.z() = qc.z(), qco.w() = qc.x();
-      }
-    }
-  }
-  // if qc.z() is smallest
-  else if(qc.z() <= qc.x() && qc.z() <= qc.y() && qc.z() <= qc.w())
-  {
-    qco.x() = qc.z();
-    // if qc.x() is next smallest
-    if(qc.x() <= qc.y() && qc.x() <= qc.w())
-    {
-      qco.y() = qc.x();
-      if(qc.y() <= qc.w())
-      {
-        qco.z() = qc.y(), qco.w() = qc.w();
-      }
-      else
-      {
-        qco.z() = qc.w(), qco.w() = qc.y();
-      }
-    }
-    // if qc.y() is next smallest
-    else if(qc.y() <= qc.x() && qc.y() <= qc.w())
-    {
-      qco.y() = qc.y();
-      if(qc.x() <= qc.w())
-      {
-        qco.z() = qc.x(), qco.w() = qc.w();
-      }
-      else
-      {
-        qco.z() = qc.w(), qco.w() = qc.x();
-      }
-    }
-    // if qc.w() is next smallest
-    else
-    {
-      qco.y() = qc.w();
-      if(qc.x() <= qc.y())
-      {
-        qco.z() = qc.x(), qco.w() = qc.y();
-      }
-      else
-      {
-        qco.z() = qc.y(), qco.w() = qc.x();
-      }
-    }
-  }
-  // if qc.w() is smallest
-  else
-  {
-    qco.x() = qc.w();
-    // if qc.x() is next smallest
-    if(qc.x() <= qc.y() && qc.x() <= qc.z())
-    {
-      qco.y() = qc.x();
-      if(qc.y() <= qc.z())
-      {
-        qco.z() = qc.y(), qco.w() = qc.z();
-      }
-      else
-      {
-        qco.z() = qc.z(), qco.w() = qc.y();
-      }
-    }
-    // if qc.y() is next smallest
-    else if(qc.y() <= qc.x() && qc.y() <= qc.z())
-    {
-      qco.y() = qc.y();
-      if(qc.x() <= qc.z())
-      {
-        qco.z() = qc.x(), qco.w() = qc.z();
-      }
-      else
-      {
-        qco.z() = qc.z(), qco.w() = qc.x();
-      }
-    }
-    // if qc.z() is next smallest
-    else
-    {
-      qco.y() = qc.z();
-      if(qc.x() <= qc.y())
-      {
-        qco.z() = qc.x(), qco.w() = qc.y();
-      }
-      else
-      {
-        qco.z() = qc.y(), qco.w() = qc.x();
-      }
-    }
-  }
-  wmin = qco.w();
-  if(((qco.z() + qco.w()) / (EbsdLib::Constants::k_Sqrt2D)) > wmin)
-  {
-    wmin = ((qco.z() + qco.w()) / (EbsdLib::Constants::k_Sqrt2D));
-    type = 2;
-  }
-  if(((qco.x() + qco.y() + qco.z() + qco.w()) / 2) > wmin)
-  {
-    wmin = ((qco.x() + qco.y() + qco.z() + qco.w()) / 2);
-    type = 3;
-  }
-  if(wmin < -1.0)
-  {
-    //  wmin = -1.0;
-    wmin = EbsdLib::Constants::k_ACosNeg1D;
-    sin_wmin_over_2 = std::sin(wmin);
-  }
-  else if(wmin > 1.0)
-  {
-    //   wmin = 1.0;
-    wmin = EbsdLib::Constants::k_ACos1D;
-    sin_wmin_over_2 = std::sin(wmin);
-  }
-  else
-  {
-    wmin = acos(wmin);
-    sin_wmin_over_2 = std::sin(wmin);
-  }
-
-  double n1 = 0.0;
-  double n2 = 0.0;
-  double n3 = 0.0;
-  if(type == 1)
-  {
-    n1 = qco.x() / sin_wmin_over_2;
-    n2 = qco.y() / sin_wmin_over_2;
-    n3 = qco.z() / sin_wmin_over_2;
-  }
-  if(type == 2)
-  {
-    n1 = ((qco.x() - qco.y()) / (EbsdLib::Constants::k_Sqrt2D)) / sin_wmin_over_2;
-    n2 = ((qco.x() + qco.y()) / (EbsdLib::Constants::k_Sqrt2D)) / sin_wmin_over_2;
-    n3 = ((qco.z() - qco.w()) / (EbsdLib::Constants::k_Sqrt2D)) / sin_wmin_over_2;
-  }
-  if(type == 3)
-  {
-    n1 = ((qco.x() - qco.y() + qco.z() - qco.w()) / (2.0)) / sin_wmin_over_2;
-    n2 = ((qco.x() + qco.y() - qco.z() - qco.w()) / (2.0)) / sin_wmin_over_2;
-    n3 = ((-qco.x() + qco.y() + qco.z() - qco.w()) / (2.0)) / sin_wmin_over_2;
-  }
-  double denom = sqrt((n1 * n1 + n2 * n2 + n3 * n3));
-  n1 = n1 / denom;
-  n2 = n2 / denom;
-  n3 = n3 / denom;
-  if(denom == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  if(wmin == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  wmin = 2.0f * wmin;
-
-  OrientationD axisAngle(n1, n2, n3, wmin);
-  return axisAngle;
+  return CubicHigh::Kernel::calculateMisorientation(q1, q2);
 }
 
 QuatD CubicOps::getQuatSymOp(int32_t i) const
@@ -647,7 +354,7 @@ void CubicOps::getMatSymOp(int i, float g[3][3]) const
 // -----------------------------------------------------------------------------
 OrientationType CubicOps::getODFFZRod(const OrientationType& rod) const
 {
-  return _calcRodNearestOrigin(CubicHigh::RodSym, rod);
+  return CubicHigh::Kernel::getODFFZRod(rod);
 }
 
 // -----------------------------------------------------------------------------
@@ -658,8 +365,8 @@ OrientationType CubicOps::getMDFFZRod(const OrientationType& inRod) const
   double w, n1, n2, n3;
   double FZw, FZn1, FZn2, FZn3;
 
-  OrientationType rod = _calcRodNearestOrigin(CubicHigh::RodSym, inRod);
-  OrientationType ax = OrientationTransformation::ro2ax<OrientationType, OrientationType>(rod);
+  OrientationType rod = CubicHigh::Kernel::getODFFZRod(inRod);
+  AxisAngle<double> ax = OrientationTransformation::ro2ax<OrientationType, AxisAngle<double>>(rod);
 
   n1 = ax[0];
   n2 = ax[1], n3 = ax[2], w = ax[3];
@@ -707,7 +414,7 @@ OrientationType CubicOps::getMDFFZRod(const OrientationType& inRod) const
     }
   }
 
-  return OrientationTransformation::ax2ro<OrientationType, OrientationType>(OrientationType(FZn1, FZn2, FZn3, FZw));
+  return OrientationTransformation::ax2ro<AxisAngle<double>, OrientationType>(AxisAngle<double>(FZn1, FZn2, FZn3, FZw));
 }
 
 QuatD CubicOps::getNearestQuat(const QuatD& q1, const QuatD& q2) const
@@ -722,7 +429,7 @@ QuatF CubicOps::getNearestQuat(const QuatF& q1f, const QuatF& q2f) const
 
 QuatD CubicOps::getFZQuat(const QuatD& qr) const
 {
-  return _calcQuatNearestOrigin(CubicHigh::QuatSym, qr);
+  return CubicHigh::Kernel::getFZQuat(qr);
 }
 
 // -----------------------------------------------------------------------------
@@ -771,11 +478,11 @@ OrientationType CubicOps::determineEulerAngles(double random[3], int choose) con
 
   _calcDetermineHomochoricValues(random, init, step, phi, h1, h2, h3);
 
-  OrientationType ho(h1, h2, h3);
-  OrientationType ro = OrientationTransformation::ho2ro<OrientationType, OrientationType>(ho);
+  Homochoric<double> ho(h1, h2, h3);
+  OrientationType ro = OrientationTransformation::ho2ro<Homochoric<double>, OrientationType>(ho);
   ro = getODFFZRod(ro);
-  OrientationType eu = OrientationTransformation::ro2eu<OrientationType, OrientationType>(ro);
-  return eu;
+  Euler<double> eu = OrientationTransformation::ro2eu<OrientationType, Euler<double>>(ro);
+  return {eu[0], eu[1], eu[2]};
 }
 
 // -----------------------------------------------------------------------------
@@ -810,8 +517,8 @@ OrientationType CubicOps::determineRodriguesVector(double random[3], int choose)
   phi[2] = static_cast<int32_t>(choose / (CubicHigh::OdfNumBins[0] * CubicHigh::OdfNumBins[1]));
 
   _calcDetermineHomochoricValues(random, init, step, phi, h1, h2, h3);
-  OrientationType ho(h1, h2, h3);
-  OrientationType ro = OrientationTransformation::ho2ro<OrientationType, OrientationType>(ho);
+  Homochoric<double> ho(h1, h2, h3);
+  OrientationType ro = OrientationTransformation::ho2ro<Homochoric<double>, OrientationType>(ho);
   ro = getMDFFZRod(ro);
   return ro;
 }
@@ -1683,19 +1390,7 @@ bool inUnitTriangleD(double eta, double chi)
 // -----------------------------------------------------------------------------
 std::array<double, 3> CubicOps::getIpfColorAngleLimits(double eta) const
 {
-  double etaDeg = eta * EbsdLib::Constants::k_180OverPiD;
-  double chiMax;
-  if(etaDeg > CubicHigh::k_EtaMax)
-  {
-    chiMax = std::sqrt(1.0 / (2.0 + std::tan(0.5 * EbsdLib::Constants::k_PiD - eta) * std::tan(0.5 * EbsdLib::Constants::k_PiD - eta)));
-  }
-  else
-  {
-    chiMax = std::sqrt(1.0 / (2.0 + std::tan(eta) * std::tan(eta)));
-  }
-  EbsdLibMath::bound(chiMax, -1.0, 1.0);
-  chiMax = std::acos(chiMax);
-  return {CubicHigh::k_EtaMin * EbsdLib::Constants::k_DegToRadD, CubicHigh::k_EtaMax * EbsdLib::Constants::k_DegToRadD, chiMax};
+  return CubicHigh::Kernel::getIpfColorAngleLimits(eta);
 }
 
 // -----------------------------------------------------------------------------
@@ -1703,19 +1398,7 @@ std::array<double, 3> CubicOps::getIpfColorAngleLimits(double eta) const
 // -----------------------------------------------------------------------------
 bool CubicOps::inUnitTriangle(double eta, double chi) const
 {
-  double etaDeg = eta * EbsdLib::Constants::k_180OverPiD;
-  double chiMax;
-  if(etaDeg > CubicHigh::k_EtaMax)
-  {
-    chiMax = std::sqrt(1.0 / (2.0 + std::tan(0.5 * EbsdLib::Constants::k_PiD - eta) * std::tan(0.5 * EbsdLib::Constants::k_PiD - eta)));
-  }
-  else
-  {
-    chiMax = std::sqrt(1.0 / (2.0 + std::tan(eta) * std::tan(eta)));
-  }
-  EbsdLibMath::bound(chiMax, -1.0, 1.0);
-  chiMax = acos(chiMax);
-  return !(eta < CubicHigh::k_EtaMin || eta > (CubicHigh::k_EtaMax * EbsdLib::Constants::k_PiOver180D) || chi < 0.0 || chi > chiMax);
+  return CubicHigh::Kernel::inUnitTriangle(eta, chi);
 }
 
 // -----------------------------------------------------------------------------
@@ -1723,7 +1406,7 @@ bool CubicOps::inUnitTriangle(double eta, double chi) const
 // -----------------------------------------------------------------------------
 EbsdLib::Rgb CubicOps::generateIPFColor(double* eulers, double* refDir, bool degToRad) const
 {
-  return computeIPFColor(eulers, refDir, degToRad);
+  return CubicHigh::Kernel::generateIPFColor(eulers, refDir, degToRad);
 }
 
 // -----------------------------------------------------------------------------
@@ -1733,7 +1416,7 @@ EbsdLib::Rgb CubicOps::generateIPFColor(double phi1, double phi, double phi2, do
 {
   double eulers[3] = {phi1, phi, phi2};
   double refDir[3] = {refDir0, refDir1, refDir2};
-  return computeIPFColor(eulers, refDir, degToRad);
+  return CubicHigh::Kernel::generateIPFColor(eulers, refDir, degToRad);
 }
 
 // -----------------------------------------------------------------------------
@@ -1765,170 +1448,22 @@ std::array<std::string, 3> CubicOps::getDefaultPoleFigureNames() const
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-std::vector<EbsdLib::UInt8ArrayType::Pointer> CubicOps::generatePoleFigure(PoleFigureConfiguration_t& config) const
+std::array<size_t, 3> CubicOps::getPoleFigureFamilySizes() const
 {
-  std::array<std::string, 3> labels = getDefaultPoleFigureNames();
-  std::string label0 = labels[0];
-  std::string label1 = labels[1];
-  std::string label2 = labels[2];
-
-  if(!config.labels.empty())
-  {
-    label0 = config.labels.at(0);
-  }
-  if(config.labels.size() > 1)
-  {
-    label1 = config.labels.at(1);
-  }
-  if(config.labels.size() > 2)
-  {
-    label2 = config.labels.at(2);
-  }
-
-  size_t numOrientations = config.eulers->getNumberOfTuples();
-
-  // Create an Array to hold the XYZ Coordinates which are the coords on the sphere.
-  // this is size for CUBIC ONLY, <001> Family
-  std::vector<size_t> dims(1, 3);
-  EbsdLib::FloatArrayType::Pointer xyz001 = EbsdLib::FloatArrayType::CreateArray(numOrientations * CubicHigh::symSize0, dims, label0 + std::string("xyzCoords"), true);
-  // this is size for CUBIC ONLY, <011> Family
-  EbsdLib::FloatArrayType::Pointer xyz011 = EbsdLib::FloatArrayType::CreateArray(numOrientations * CubicHigh::symSize1, dims, label1 + std::string("xyzCoords"), true);
-  // this is size for CUBIC ONLY, <111> Family
-  EbsdLib::FloatArrayType::Pointer xyz111 = EbsdLib::FloatArrayType::CreateArray(numOrientations * CubicHigh::symSize2, dims, label2 + std::string("xyzCoords"), true);
+  return {CubicHigh::symSize0, CubicHigh::symSize1, CubicHigh::symSize2};
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<EbsdLib::UInt8ArrayType::Pointer> CubicOps::generatePoleFigure(PoleFigureConfiguration_t& config) const
+{
   config.sphereRadius = 1.0f;
 
-  // Generate the coords on the sphere **** Parallelized
-  generateSphereCoordsFromEulers(config.eulers, xyz001.get(), xyz011.get(), xyz111.get());
-
-  // These arrays hold the "intensity" images which eventually get converted to an actual Color RGB image
-  // Generate the modified Lambert projection images (Squares, 2 of them, 1 for northern hemisphere, 1 for southern hemisphere
-  EbsdLib::DoubleArrayType::Pointer intensity001 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label0 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity011 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label1 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity111 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label2 + "_Intensity_Image", true);
-
-#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
-  bool doParallel = true;
-
-  if(doParallel)
-  {
-    std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-    g->run(ComputeStereographicProjection(xyz001.get(), &config, intensity001.get()));
-    g->run(ComputeStereographicProjection(xyz011.get(), &config, intensity011.get()));
-    g->run(ComputeStereographicProjection(xyz111.get(), &config, intensity111.get()));
-    g->wait(); // Wait for all the threads to complete before moving on.
-  }
-  else
-#endif
-  {
-    ComputeStereographicProjection m001(xyz001.get(), &config, intensity001.get());
-    m001();
-    ComputeStereographicProjection m011(xyz011.get(), &config, intensity011.get());
-    m011();
-    ComputeStereographicProjection m111(xyz111.get(), &config, intensity111.get());
-    m111();
-  }
-
-  // Find the Max and Min values based on ALL 3 arrays so we can color scale them all the same
-  double max = std::numeric_limits<double>::min();
-  double min = std::numeric_limits<double>::max();
-
-  double* dPtr = intensity001->getPointer(0);
-  size_t count = intensity001->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity011->getPointer(0);
-  count = intensity011->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity111->getPointer(0);
-  count = intensity111->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  config.minScale = min;
-  config.maxScale = max;
-
-  dims[0] = 4;
-  EbsdLib::UInt8ArrayType::Pointer image001 = EbsdLib::UInt8ArrayType::CreateArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label0, true);
-  EbsdLib::UInt8ArrayType::Pointer image011 = EbsdLib::UInt8ArrayType::CreateArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label1, true);
-  EbsdLib::UInt8ArrayType::Pointer image111 = EbsdLib::UInt8ArrayType::CreateArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label2, true);
-
-  std::vector<EbsdLib::UInt8ArrayType::Pointer> poleFigures(3);
-  if(config.order.size() == 3)
-  {
-    poleFigures[static_cast<int>(config.order[0])] = image001;
-    poleFigures[static_cast<int>(config.order[1])] = image011;
-    poleFigures[static_cast<int>(config.order[2])] = image111;
-  }
-  else
-  {
-    poleFigures[0] = image001;
-    poleFigures[1] = image011;
-    poleFigures[2] = image111;
-  }
-
-#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
-
-  if(doParallel)
-  {
-    std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-    g->run(GeneratePoleFigureRgbaImageImpl(intensity001.get(), &config, image001.get()));
-    g->run(GeneratePoleFigureRgbaImageImpl(intensity011.get(), &config, image011.get()));
-    g->run(GeneratePoleFigureRgbaImageImpl(intensity111.get(), &config, image111.get()));
-    g->wait(); // Wait for all the threads to complete before moving on.
-  }
-  else
-#endif
-  {
-    GeneratePoleFigureRgbaImageImpl m001(intensity001.get(), &config, image001.get());
-    m001();
-    GeneratePoleFigureRgbaImageImpl m011(intensity011.get(), &config, image011.get());
-    m011();
-    GeneratePoleFigureRgbaImageImpl m111(intensity111.get(), &config, image111.get());
-    m111();
-  }
-
-#if 0
-  size_t dim[3] = {config.imageDim, config.imageDim, 1};
-  FloatVec3Type res = {1.0, 1.0, 1.0};
-  VtkRectilinearGridWriter::WriteDataArrayToFile("/tmp/" + intensity001->getName() + ".vtk",
-                                                 intensity001.get(), dim, res, "double", true );
-  VtkRectilinearGridWriter::WriteDataArrayToFile("/tmp/" + intensity011->getName() + ".vtk",
-                                                 intensity011.get(), dim, res, "double", true );
-  VtkRectilinearGridWriter::WriteDataArrayToFile("/tmp/" + intensity111->getName() + ".vtk",
-                                                 intensity111.get(), dim, res, "double", true );
-#endif
-  return poleFigures;
+  // Project the orientations a chunk at a time and render the three pole figures with one color scale **** Parallelized
+  PoleFigureAccumulator accumulator(*this, config);
+  accumulator.add(*config.eulers);
+  return accumulator.createPoleFigures(config.minScale, config.maxScale);
 }
 
 // -----------------------------------------------------------------------------
@@ -280,6 +280,12 @@ public:
    */
   std::array<std::string, 3> getDefaultPoleFigureNames() const override;
 
+  /**
+   * @brief Returns the number of sphere directions that generateSphereCoordsFromEulers creates per orientation for each
+   * of the three pole figures
+   */
+  std::array<size_t, 3> getPoleFigureFamilySizes() const override;
+
   /**
    * @brief generateStandardTriangle Generates an RGBA array that is a color "Standard" IPF Triangle Legend used for IPF Color Maps.
    * @return
@@ -307,6 +313,8 @@ protected:
    */
   OrientationD calculateMisorientationInternal(const std::vector<QuatD>& quatsym, const QuatD& q1, const QuatD& q2) const override;
 
+  bool hasClosedFormMisorientation() const override;
+
   /**
    * @brief area preserving projection of volume preserving transformation (for C. Shuch and S. Patala coloring legend generation)
    * @param x
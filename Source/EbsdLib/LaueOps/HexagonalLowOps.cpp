@@ -40,16 +40,16 @@
 #include <tbb/parallel_for.h>
 #include <tbb/partitioner.h>
 #include <tbb/task.h>
-#include <tbb/task_group.h>
 #endif
 
 // Include this FIRST because there is a needed define for some compiles
 // to expose some of the constants needed below
 #include "EbsdLib/Core/EbsdMacros.h"
 #include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/LaueOps/LaueKernel.hpp"
+#include "EbsdLib/LaueOps/PoleFigureAccumulator.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
 #include "EbsdLib/Utilities/ColorTable.h"
-#include "EbsdLib/Utilities/ComputeStereographicProjection.h"
 #include "EbsdLib/Utilities/EbsdStringUtils.hpp"
 #include "EbsdLib/Utilities/PoleFigureUtilities.h"
 
@@ -76,23 +76,11 @@ static double sq32 = std::sqrt(3.0) / 2.0;
 
 // Rotation Point Group: 6
 // clang-format off
-static const std::vector<QuatD> QuatSym ={
-    QuatD(0.0, 0.0, 0.0, 1.0),
-    QuatD(0.0, 0.0, 0.5, sq32),
-    QuatD(0.0, 0.0, sq32, 0.5),
-    QuatD(0.0, 0.0, 1.0, 0.0),
-    QuatD(0.0, 0.0, sq32, -0.5),
-    QuatD(0.0, 0.0, 0.5, -sq32),
-};
+using Kernel = LaueKernel<LaueKernels::HexagonalLow>;
 
-static const std::vector<OrientationD> RodSym = {
-    {0.0, 0.0, 1.0, 0.0},
-    {0.0, 0.0, 1.0, 0.5773502691896258},
-    {0.0, 0.0, 1.0, 1.7320508075688767},
-    {0.0, 0.0, 1.0, 10000000000000.0},
-    {0.0, 0.0, sq32, 10000000000000.0},
-    {0.0, 0.0, 0.5, 10000000000000.0},
-};
+static const std::vector<QuatD> QuatSym = Kernel::QuatSymTable();
+
+static const std::vector<OrientationD> RodSym = Kernel::RodSymTable();
 
 static const double MatSym[k_SymOpsCount][3][3] = {
     {{1.0, 0.0, 0.0},
@@ -122,9 +110,6 @@ static const double MatSym[k_SymOpsCount][3][3] = {
 };
 // clang-format on
 
-static const double k_EtaMin = 0.0;
-static const double k_EtaMax = 60.0;
-static const double k_ChiMax = 90.0;
 } // namespace HexagonalLow
 
 // -----------------------------------------------------------------------------
@@ -205,7 +190,7 @@ std::string HexagonalLowOps::getRotationPointGroup() const
 
 OrientationD HexagonalLowOps::calculateMisorientation(const QuatD& q1, const QuatD& q2) const
 {
-  return calculateMisorientationInternal(HexagonalLow::QuatSym, q1, q2);
+  return HexagonalLow::Kernel::calculateMisorientation(q1, q2);
 }
 
 // -----------------------------------------------------------------------------
@@ -214,7 +199,7 @@ OrientationF HexagonalLowOps::calculateMisorientation(const QuatF& q1f, const Qu
 {
   QuatD q1 = q1f.to<double>();
   QuatD q2 = q2f.to<double>();
-  OrientationD axisAngle = calculateMisorientationInternal(HexagonalLow::QuatSym, q1, q2);
+  OrientationD axisAngle = HexagonalLow::Kernel::calculateMisorientation(q1, q2);
   return axisAngle;
 }
 
@@ -274,7 +259,7 @@ void HexagonalLowOps::getMatSymOp(int i, float g[3][3]) const
 // -----------------------------------------------------------------------------
 OrientationType HexagonalLowOps::getODFFZRod(const OrientationType& rod) const
 {
-  return _calcRodNearestOrigin(HexagonalLow::RodSym, rod);
+  return HexagonalLow::Kernel::getODFFZRod(rod);
 }
 
 // -----------------------------------------------------------------------------
@@ -286,9 +271,9 @@ OrientationType HexagonalLowOps::getMDFFZRod(const OrientationType& inRod) const
   double FZn1 = 0.0, FZn2 = 0.0, FZn3 = 0.0, FZw = 0.0;
   double n1n2mag = 0.0;
 
-  OrientationType rod = _calcRodNearestOrigin(HexagonalLow::RodSym, inRod);
+  OrientationType rod = HexagonalLow::Kernel::getODFFZRod(inRod);
 
-  OrientationType ax = OrientationTransformation::ro2ax<OrientationType, OrientationType>(rod);
+  AxisAngle<double> ax = OrientationTransformation::ro2ax<OrientationType, AxisAngle<double>>(rod);
 
   n1 = ax[0];
   n2 = ax[1], n3 = ax[2], w = ax[3];
@@ -329,7 +314,7 @@ OrientationType HexagonalLowOps::getMDFFZRod(const OrientationType& inRod) const
     }
   }
 
-  return OrientationTransformation::ax2ro<OrientationType, OrientationType>(OrientationType(FZn1, FZn2, FZn3, w));
+  return OrientationTransformation::ax2ro<AxisAngle<double>, OrientationType>(AxisAngle<double>(FZn1, FZn2, FZn3, w));
 }
 
 QuatD HexagonalLowOps::getNearestQuat(const QuatD& q1, const QuatD& q2) const
@@ -347,7 +332,7 @@ QuatF HexagonalLowOps::getNearestQuat(const QuatF& q1f, const QuatF& q2f) const
 // -----------------------------------------------------------------------------
 QuatD HexagonalLowOps::getFZQuat(const QuatD& qr) const
 {
-  return _calcQuatNearestOrigin(HexagonalLow::QuatSym, qr);
+  return HexagonalLow::Kernel::getFZQuat(qr);
 }
 
 // -----------------------------------------------------------------------------
@@ -396,11 +381,11 @@ OrientationType HexagonalLowOps::determineEulerAngles(double random[3], int choo
 
   _calcDetermineHomochoricValues(random, init, step, phi, h1, h2, h3);
 
-  OrientationType ho(h1, h2, h3);
-  OrientationType ro = OrientationTransformation::ho2ro<OrientationType, OrientationType>(ho);
+  Homochoric<double> ho(h1, h2, h3);
+  OrientationType ro = OrientationTransformation::ho2ro<Homochoric<double>, OrientationType>(ho);
   ro = getODFFZRod(ro);
-  OrientationType eu = OrientationTransformation::ro2eu<OrientationType, OrientationType>(ro);
-  return eu;
+  Euler<double> eu = OrientationTransformation::ro2eu<OrientationType, Euler<double>>(ro);
+  return {eu[0], eu[1], eu[2]};
 }
 
 // -----------------------------------------------------------------------------
@@ -435,8 +420,8 @@ OrientationType HexagonalLowOps::determineRodriguesVector(double random[3], int
   phi[2] = static_cast<int32_t>(choose / (HexagonalLow::OdfNumBins[0] * HexagonalLow::OdfNumBins[1]));
 
   _calcDetermineHomochoricValues(random, init, step, phi, h1, h2, h3);
-  OrientationType ho(h1, h2, h3);
-  OrientationType ro = OrientationTransformation::ho2ro<OrientationType, OrientationType>(ho);
+  Homochoric<double> ho(h1, h2, h3);
+  OrientationType ro = OrientationTransformation::ho2ro<Homochoric<double>, OrientationType>(ho);
   ro = getMDFFZRod(ro);
   return ro;
 }
@@ -1192,7 +1177,7 @@ void HexagonalLowOps::generateSphereCoordsFromEulers(EbsdLib::FloatArrayType* eu
 // -----------------------------------------------------------------------------
 std::array<double, 3> HexagonalLowOps::getIpfColorAngleLimits(double eta) const
 {
-  return {HexagonalLow::k_EtaMin * EbsdLib::Constants::k_DegToRadD, HexagonalLow::k_EtaMax * EbsdLib::Constants::k_DegToRadD, HexagonalLow::k_ChiMax * EbsdLib::Constants::k_DegToRadD};
+  return HexagonalLow::Kernel::getIpfColorAngleLimits(eta);
 }
 
 // -----------------------------------------------------------------------------
@@ -1200,8 +1185,7 @@ std::array<double, 3> HexagonalLowOps::getIpfColorAngleLimits(double eta) const
 // -----------------------------------------------------------------------------
 bool HexagonalLowOps::inUnitTriangle(double eta, double chi) const
 {
-  return !(eta < (HexagonalLow::k_EtaMin * EbsdLib::Constants::k_PiOver180D) || eta > (HexagonalLow::k_EtaMax * EbsdLib::Constants::k_PiOver180D) || chi < 0 ||
-           chi > (HexagonalLow::k_ChiMax * EbsdLib::Constants::k_PiOver180D));
+  return HexagonalLow::Kernel::inUnitTriangle(eta, chi);
 }
 
 // -----------------------------------------------------------------------------
@@ -1209,7 +1193,7 @@ bool HexagonalLowOps::inUnitTriangle(double eta, double chi) const
 // -----------------------------------------------------------------------------
 EbsdLib::Rgb HexagonalLowOps::generateIPFColor(double* eulers, double* refDir, bool degToRad) const
 {
-  return computeIPFColor(eulers, refDir, degToRad);
+  return HexagonalLow::Kernel::generateIPFColor(eulers, refDir, degToRad);
 }
 
 // -----------------------------------------------------------------------------
@@ -1219,7 +1203,7 @@ EbsdLib::Rgb HexagonalLowOps::generateIPFColor(double phi1, double phi, double p
 {
   double eulers[3] = {phi1, phi, phi2};
   double refDir[3] = {refDir0, refDir1, refDir2};
-  return computeIPFColor(eulers, refDir, degToRad);
+  return HexagonalLow::Kernel::generateIPFColor(eulers, refDir, degToRad);
 }
 
 // -----------------------------------------------------------------------------
@@ -1256,157 +1240,22 @@ std::array<std::string, 3> HexagonalLowOps::getDefaultPoleFigureNames() const
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-std::vector<EbsdLib::UInt8ArrayType::Pointer> HexagonalLowOps::generatePoleFigure(PoleFigureConfiguration_t& config) const
+std::array<size_t, 3> HexagonalLowOps::getPoleFigureFamilySizes() const
 {
-  std::array<std::string, 3> labels = getDefaultPoleFigureNames();
-  std::string label0 = labels[0];
-  std::string label1 = labels[1];
-  std::string label2 = labels[2];
-  if(!config.labels.empty())
-  {
-    label0 = config.labels.at(0);
-  }
-  if(config.labels.size() > 1)
-  {
-    label1 = config.labels.at(1);
-  }
-  if(config.labels.size() > 2)
-  {
-    label2 = config.labels.at(2);
-  }
-
-  size_t numOrientations = config.eulers->getNumberOfTuples();
-
-  // Create an Array to hold the XYZ Coordinates which are the coords on the sphere.
-  // this is size for CUBIC ONLY, <001> Family
-  std::vector<size_t> dims(1, 3);
-  EbsdLib::FloatArrayType::Pointer xyz001 = EbsdLib::FloatArrayType::CreateArray(numOrientations * HexagonalLow::symSize0, dims, label0 + std::string("xyzCoords"), true);
-  // this is size for CUBIC ONLY, <011> Family
-  EbsdLib::FloatArrayType::Pointer xyz011 = EbsdLib::FloatArrayType::CreateArray(numOrientations * HexagonalLow::symSize1, dims, label1 + std::string("xyzCoords"), true);
-  // this is size for CUBIC ONLY, <111> Family
-  EbsdLib::FloatArrayType::Pointer xyz111 = EbsdLib::FloatArrayType::CreateArray(numOrientations * HexagonalLow::symSize2, dims, label2 + std::string("xyzCoords"), true);
-
-  config.sphereRadius = 1.0;
-
-  // Generate the coords on the sphere **** Parallelized
-  generateSphereCoordsFromEulers(config.eulers, xyz001.get(), xyz011.get(), xyz111.get());
-
-  // These arrays hold the "intensity" images which eventually get converted to an actual Color RGB image
-  // Generate the modified Lambert projection images (Squares, 2 of them, 1 for northern hemisphere, 1 for southern hemisphere
-  EbsdLib::DoubleArrayType::Pointer intensity001 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label0 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity011 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label1 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity111 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label2 + "_Intensity_Image", true);
-#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
-  bool doParallel = true;
-
-  if(doParallel)
-  {
-    std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-    g->run(ComputeStereographicProjection(xyz001.get(), &config, intensity001.get()));
-    g->run(ComputeStereographicProjection(xyz011.get(), &config, intensity011.get()));
-    g->run(ComputeStereographicProjection(xyz111.get(), &config, intensity111.get()));
-    g->wait(); // Wait for all the threads to complete before moving on.
-  }
-  else
-#endif
-  {
-    ComputeStereographicProjection m001(xyz001.get(), &config, intensity001.get());
-    m001();
-    ComputeStereographicProjection m011(xyz011.get(), &config, intensity011.get());
-    m011();
-    ComputeStereographicProjection m111(xyz111.get(), &config, intensity111.get());
-    m111();
-  }
-
-  // Find the Max and Min values based on ALL 3 arrays so we can color scale them all the same
-  double max = std::numeric_limits<double>::min();
-  double min = std::numeric_limits<double>::max();
-
-  double* dPtr = intensity001->getPointer(0);
-  size_t count = intensity001->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity011->getPointer(0);
-  count = intensity011->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity111->getPointer(0);
-  count = intensity111->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  config.minScale = min;
-  config.maxScale = max;
-
-  dims[0] = 4;
-  EbsdLib::UInt8ArrayType::Pointer image001 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label0, true);
-  EbsdLib::UInt8ArrayType::Pointer image011 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label1, true);
-  EbsdLib::UInt8ArrayType::Pointer image111 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label2, true);
-
-  std::vector<EbsdLib::UInt8ArrayType::Pointer> poleFigures(3);
-  if(config.order.size() == 3)
-  {
-    poleFigures[config.order[0]] = image001;
-    poleFigures[config.order[1]] = image011;
-    poleFigures[config.order[2]] = image111;
-  }
-  else
-  {
-    poleFigures[0] = image001;
-    poleFigures[1] = image011;
-    poleFigures[2] = image111;
-  }
-#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  return {HexagonalLow::symSize0, HexagonalLow::symSize1, HexagonalLow::symSize2};
+}
 
-  if(doParallel)
-  {
-    std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-    g->run(GeneratePoleFigureRgbaImageImpl(intensity001.get(), &config, image001.get()));
-    g->run(GeneratePoleFigureRgbaImageImpl(intensity011.get(), &config, image011.get()));
-    g->run(GeneratePoleFigureRgbaImageImpl(intensity111.get(), &config, image111.get()));
-    g->wait(); // Wait for all the threads to complete before moving on.
-  }
-  else
-#endif
-  {
-    GeneratePoleFigureRgbaImageImpl m001(intensity001.get(), &config, image001.get());
-    m001();
-    GeneratePoleFigureRgbaImageImpl m011(intensity011.get(), &config, image011.get());
-    m011();
-    GeneratePoleFigureRgbaImageImpl m111(intensity111.get(), &config, image111.get());
-    m111();
-  }
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<EbsdLib::UInt8ArrayType::Pointer> HexagonalLowOps::generatePoleFigure(PoleFigureConfiguration_t& config) const
+{
+  config.sphereRadius = 1.0f;
 
-  return poleFigures;
+  // Project the orientations a chunk at a time and render the three pole figures with one color scale **** Parallelized
+  PoleFigureAccumulator accumulator(*this, config);
+  accumulator.add(*config.eulers);
+  return accumulator.createPoleFigures(config.minScale, config.maxScale);
 }
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,322 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "IPFColorEngine.h"
+
+#include <stdexcept>
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/LaueOps/LaueKernel.hpp"
+#include "EbsdLib/Utilities/ColorTable.h"
+#include "EbsdLib/Utilities/ParallelDataAlgorithm.hpp"
+
+namespace
+{
+/**
+ * @brief ComputeIPFColorsImpl colors a range of points. The points of the range are first sorted
+ * into one bucket per phase with a counting sort, then each bucket is colored by the LaueKernel of
+ * its phase so the Laue class is resolved once per bucket instead of once per point.
+ */
+template <typename T, bool IsQuaternion>
+class ComputeIPFColorsImpl
+{
+public:
+  ComputeIPFColorsImpl(const T* input, const int32_t* phases, const bool* mask, const std::vector<uint32_t>& phaseLaueIndices, const std::vector<EbsdLib::Matrix3X1D>& referenceDirections,
+                       bool degToRad, const std::vector<IPFColorLookupTable::ConstPointer>& lookupTables, const std::vector<uint8_t*>& outputs)
+  : m_Input(input)
+  , m_Phases(phases)
+  , m_Mask(mask)
+  , m_PhaseLaueIndices(phaseLaueIndices)
+  , m_ReferenceDirections(referenceDirections)
+  , m_DegToRad(degToRad)
+  , m_LookupTables(lookupTables)
+  , m_Outputs(outputs)
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    // The last bucket holds every point that is not colored
+    const size_t numPhases = m_PhaseLaueIndices.size();
+    const size_t blackBucket = numPhases;
+    std::vector<size_t> bucketOffsets(numPhases + 2, 0);
+    std::vector<size_t> buckets(end - start);
+
+    auto bucketOf = [&](size_t i) -> size_t {
+      int32_t phase = (nullptr == m_Phases) ? 0 : m_Phases[i];
+      if(phase < 0 || static_cast<size_t>(phase) >= numPhases || (nullptr != m_Mask && !m_Mask[i]) || m_PhaseLaueIndices[phase] >= EbsdLib::CrystalStructure::LaueGroupEnd)
+      {
+        return blackBucket;
+      }
+      return static_cast<size_t>(phase);
+    };
+
+    for(size_t i = start; i < end; i++)
+    {
+      bucketOffsets[bucketOf(i) + 1]++;
+    }
+    for(size_t b = 1; b < bucketOffsets.size(); b++)
+    {
+      bucketOffsets[b] += bucketOffsets[b - 1];
+    }
+    std::vector<size_t> fill(bucketOffsets.begin(), bucketOffsets.end() - 1);
+    for(size_t i = start; i < end; i++)
+    {
+      buckets[fill[bucketOf(i)]++] = i;
+    }
+
+    for(size_t phase = 0; phase < numPhases; phase++)
+    {
+      const size_t* first = buckets.data() + bucketOffsets[phase];
+      const size_t* last = buckets.data() + bucketOffsets[phase + 1];
+      if(first == last)
+      {
+        continue;
+      }
+      LaueKernels::visit(m_PhaseLaueIndices[phase], [&](auto kernel) {
+        for(const size_t* it = first; it != last; ++it)
+        {
+          colorPoint(kernel, m_LookupTables.empty() ? nullptr : m_LookupTables[phase].get(), *it);
+        }
+      });
+    }
+
+    for(size_t b = bucketOffsets[blackBucket]; b < bucketOffsets[blackBucket + 1]; b++)
+    {
+      for(uint8_t* output : m_Outputs)
+      {
+        output[buckets[b] * 3] = 0;
+        output[buckets[b] * 3 + 1] = 0;
+        output[buckets[b] * 3 + 2] = 0;
+      }
+    }
+  }
+
+private:
+  const T* m_Input = nullptr;
+  const int32_t* m_Phases = nullptr;
+  const bool* m_Mask = nullptr;
+  const std::vector<uint32_t>& m_PhaseLaueIndices;
+  const std::vector<EbsdLib::Matrix3X1D>& m_ReferenceDirections;
+  bool m_DegToRad = false;
+  const std::vector<IPFColorLookupTable::ConstPointer>& m_LookupTables;
+  const std::vector<uint8_t*>& m_Outputs;
+
+  template <typename KernelType>
+  void colorPoint(KernelType kernel, const IPFColorLookupTable* lookupTable, size_t i) const
+  {
+    QuatD q1;
+    if constexpr(IsQuaternion)
+    {
+      const T* q = m_Input + i * 4;
+      q1 = QuatD(static_cast<double>(q[0]), static_cast<double>(q[1]), static_cast<double>(q[2]), static_cast<double>(q[3]));
+    }
+    else
+    {
+      const T* e = m_Input + i * 3;
+      Euler<double> eu(static_cast<double>(e[0]), static_cast<double>(e[1]), static_cast<double>(e[2]));
+      if(m_DegToRad)
+      {
+        eu[0] = eu[0] * EbsdLib::Constants::k_DegToRadD;
+        eu[1] = eu[1] * EbsdLib::Constants::k_DegToRadD;
+        eu[2] = eu[2] * EbsdLib::Constants::k_DegToRadD;
+      }
+      q1 = OrientationTransformation::eu2qu<Euler<double>, QuatD>(eu);
+    }
+
+    if(nullptr != lookupTable)
+    {
+      EbsdLib::Matrix3X3D g(OrientationTransformation::qu2om<QuatD, OrientMatrix<double>>(q1).data());
+      for(size_t r = 0; r < m_ReferenceDirections.size(); r++)
+      {
+        uint8_t* rgb = m_Outputs[r] + i * 3;
+        if(lookupTable->lookup(g * m_ReferenceDirections[r], rgb))
+        {
+          continue;
+        }
+        EbsdLib::Rgb argb = kernel.generateIPFColor(q1, m_ReferenceDirections[r]);
+        rgb[0] = static_cast<uint8_t>(EbsdLib::RgbColor::dRed(argb));
+        rgb[1] = static_cast<uint8_t>(EbsdLib::RgbColor::dGreen(argb));
+        rgb[2] = static_cast<uint8_t>(EbsdLib::RgbColor::dBlue(argb));
+      }
+      return;
+    }
+
+    for(size_t r = 0; r < m_ReferenceDirections.size(); r++)
+    {
+      EbsdLib::Rgb argb = kernel.generateIPFColor(q1, m_ReferenceDirections[r]);
+      uint8_t* rgb = m_Outputs[r] + i * 3;
+      rgb[0] = static_cast<uint8_t>(EbsdLib::RgbColor::dRed(argb));
+      rgb[1] = static_cast<uint8_t>(EbsdLib::RgbColor::dGreen(argb));
+      rgb[2] = static_cast<uint8_t>(EbsdLib::RgbColor::dBlue(argb));
+    }
+  }
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+IPFColorEngine::IPFColorEngine() = default;
+
+// -----------------------------------------------------------------------------
+IPFColorEngine::~IPFColorEngine() = default;
+
+// -----------------------------------------------------------------------------
+void IPFColorEngine::setPhaseLaueIndices(const std::vector<uint32_t>& laueIndices)
+{
+  m_PhaseLaueIndices = laueIndices;
+}
+
+// -----------------------------------------------------------------------------
+std::vector<uint32_t> IPFColorEngine::getPhaseLaueIndices() const
+{
+  return m_PhaseLaueIndices;
+}
+
+// -----------------------------------------------------------------------------
+void IPFColorEngine::setReferenceDirections(const std::vector<std::array<double, 3>>& referenceDirections)
+{
+  if(referenceDirections.empty())
+  {
+    throw std::runtime_error("IPFColorEngine needs at least one reference direction.");
+  }
+  m_ReferenceDirections = referenceDirections;
+}
+
+// -----------------------------------------------------------------------------
+std::vector<std::array<double, 3>> IPFColorEngine::getReferenceDirections() const
+{
+  return m_ReferenceDirections;
+}
+
+// -----------------------------------------------------------------------------
+void IPFColorEngine::setConvertDegreesToRadians(bool value)
+{
+  m_ConvertDegreesToRadians = value;
+}
+
+// -----------------------------------------------------------------------------
+bool IPFColorEngine::getConvertDegreesToRadians() const
+{
+  return m_ConvertDegreesToRadians;
+}
+
+// -----------------------------------------------------------------------------
+void IPFColorEngine::setUseLookupTable(bool value)
+{
+  m_UseLookupTable = value;
+}
+
+// -----------------------------------------------------------------------------
+bool IPFColorEngine::getUseLookupTable() const
+{
+  return m_UseLookupTable;
+}
+
+// -----------------------------------------------------------------------------
+void IPFColorEngine::setLookupTableDimension(size_t value)
+{
+  m_LookupTableDimension = value;
+}
+
+// -----------------------------------------------------------------------------
+size_t IPFColorEngine::getLookupTableDimension() const
+{
+  return m_LookupTableDimension;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T, bool IsQuaternion>
+void IPFColorEngine::compute(const T* input, const int32_t* phases, const bool* mask, size_t count, const std::vector<uint8_t*>& outputs) const
+{
+  if(outputs.size() != m_ReferenceDirections.size())
+  {
+    throw std::runtime_error("IPFColorEngine needs one output array for each reference direction.");
+  }
+  for(const uint8_t* output : outputs)
+  {
+    if(nullptr == output)
+    {
+      throw std::runtime_error("IPFColorEngine was given a null output array.");
+    }
+  }
+
+  std::vector<EbsdLib::Matrix3X1D> referenceDirections;
+  referenceDirections.reserve(m_ReferenceDirections.size());
+  for(const auto& refDir : m_ReferenceDirections)
+  {
+    referenceDirections.emplace_back(refDir[0], refDir[1], refDir[2]);
+  }
+
+  // The tables are built (or fetched from the cache) before the parallel pass
+  std::vector<IPFColorLookupTable::ConstPointer> lookupTables;
+  if(m_UseLookupTable)
+  {
+    lookupTables.resize(m_PhaseLaueIndices.size());
+    for(size_t phase = 0; phase < m_PhaseLaueIndices.size(); phase++)
+    {
+      if(m_PhaseLaueIndices[phase] < EbsdLib::CrystalStructure::LaueGroupEnd)
+      {
+        lookupTables[phase] = IPFColorLookupTable::Get(m_PhaseLaueIndices[phase], m_LookupTableDimension);
+      }
+    }
+  }
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, count);
+  dataAlg.setGrain(4096);
+  dataAlg.execute(ComputeIPFColorsImpl<T, IsQuaternion>(input, phases, mask, m_PhaseLaueIndices, referenceDirections, m_ConvertDegreesToRadians, lookupTables, outputs));
+}
+
+// -----------------------------------------------------------------------------
+void IPFColorEngine::computeFromEulers(const float* eulers, const int32_t* phases, const bool* mask, size_t count, const std::vector<uint8_t*>& outputs) const
+{
+  compute<float, false>(eulers, phases, mask, count, outputs);
+}
+
+// -----------------------------------------------------------------------------
+void IPFColorEngine::computeFromEulers(const double* eulers, const int32_t* phases, const bool* mask, size_t count, const std::vector<uint8_t*>& outputs) const
+{
+  compute<double, false>(eulers, phases, mask, count, outputs);
+}
+
+// -----------------------------------------------------------------------------
+void IPFColorEngine::computeFromQuaternions(const float* quats, const int32_t* phases, const bool* mask, size_t count, const std::vector<uint8_t*>& outputs) const
+{
+  compute<float, true>(quats, phases, mask, count, outputs);
+}
+
+// -----------------------------------------------------------------------------
+void IPFColorEngine::computeFromQuaternions(const double* quats, const int32_t* phases, const bool* mask, size_t count, const std::vector<uint8_t*>& outputs) const
+{
+  compute<double, true>(quats, phases, mask, count, outputs);
+}
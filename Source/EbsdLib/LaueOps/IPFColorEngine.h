@@ -0,0 +1,133 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/LaueOps/IPFColorLookupTable.h"
+
+/**
+ * @class IPFColorEngine IPFColorEngine.h EbsdLib/LaueOps/IPFColorEngine.h
+ * @brief IPFColorEngine computes the IPF colors of a whole map in parallel. The points are
+ * grouped by phase inside each parallel chunk so that the Laue class of a phase is resolved
+ * once (see LaueKernels::visit) instead of through a virtual call per point. Several reference
+ * directions can be colored in the same pass so each orientation is converted only once.
+ *
+ * The colors are identical to LaueOps::generateIPFColor(). Points that are masked out, whose
+ * phase is outside of the phase to Laue class table or whose Laue class is not a valid
+ * EbsdLib::CrystalStructure (e.g. EbsdLib::CrystalStructure::UnknownCrystalStructure) are
+ * colored black.
+ *
+ * With setUseLookupTable(true) the colors are interpolated from the shared IPFColorLookupTable
+ * of each Laue class instead. They then differ from the exact colors by at most
+ * IPFColorLookupTable::k_MaxColorError in each channel.
+ */
+class EbsdLib_EXPORT IPFColorEngine
+{
+public:
+  IPFColorEngine();
+  ~IPFColorEngine();
+
+  IPFColorEngine(const IPFColorEngine&) = default;
+  IPFColorEngine(IPFColorEngine&&) noexcept = default;
+  IPFColorEngine& operator=(const IPFColorEngine&) = default;
+  IPFColorEngine& operator=(IPFColorEngine&&) noexcept = default;
+
+  /**
+   * @brief Sets the Laue class (EbsdLib::CrystalStructure) of each phase. The phase values of the
+   * input are used as the index into this vector.
+   */
+  void setPhaseLaueIndices(const std::vector<uint32_t>& laueIndices);
+  std::vector<uint32_t> getPhaseLaueIndices() const;
+
+  /**
+   * @brief Sets the sample reference directions. One RGB output is written per direction. The
+   * default is the single direction (0, 0, 1).
+   */
+  void setReferenceDirections(const std::vector<std::array<double, 3>>& referenceDirections);
+  std::vector<std::array<double, 3>> getReferenceDirections() const;
+
+  /**
+   * @brief If true the Euler angles are converted from degrees to radians. Default is false.
+   */
+  void setConvertDegreesToRadians(bool value);
+  bool getConvertDegreesToRadians() const;
+
+  /**
+   * @brief If true the colors are interpolated from an IPFColorLookupTable. Default is false.
+   */
+  void setUseLookupTable(bool value);
+  bool getUseLookupTable() const;
+
+  /**
+   * @brief Sets the dimension of the lookup tables. Default is IPFColorLookupTable::k_DefaultDimension.
+   */
+  void setLookupTableDimension(size_t value);
+  size_t getLookupTableDimension() const;
+
+  /**
+   * @brief Computes the IPF colors from Euler angles
+   * @param eulers Euler angles (phi1, Phi, phi2) for each point
+   * @param phases The phase of each point. If nullptr every point belongs to phase 0.
+   * @param mask Points whose mask value is false are colored black. May be nullptr.
+   * @param count The number of points
+   * @param outputs One RGB array (3 * count values) per reference direction
+   */
+  void computeFromEulers(const float* eulers, const int32_t* phases, const bool* mask, size_t count, const std::vector<uint8_t*>& outputs) const;
+  void computeFromEulers(const double* eulers, const int32_t* phases, const bool* mask, size_t count, const std::vector<uint8_t*>& outputs) const;
+
+  /**
+   * @brief Computes the IPF colors from quaternions stored as (x, y, z, w)
+   * @param quats Quaternion for each point
+   * @param phases The phase of each point. If nullptr every point belongs to phase 0.
+   * @param mask Points whose mask value is false are colored black. May be nullptr.
+   * @param count The number of points
+   * @param outputs One RGB array (3 * count values) per reference direction
+   */
+  void computeFromQuaternions(const float* quats, const int32_t* phases, const bool* mask, size_t count, const std::vector<uint8_t*>& outputs) const;
+  void computeFromQuaternions(const double* quats, const int32_t* phases, const bool* mask, size_t count, const std::vector<uint8_t*>& outputs) const;
+
+private:
+  std::vector<uint32_t> m_PhaseLaueIndices;
+  std::vector<std::array<double, 3>> m_ReferenceDirections = {{0.0, 0.0, 1.0}};
+  bool m_ConvertDegreesToRadians = false;
+  bool m_UseLookupTable = false;
+  size_t m_LookupTableDimension = IPFColorLookupTable::k_DefaultDimension;
+
+  template <typename T, bool IsQuaternion>
+  void compute(const T* input, const int32_t* phases, const bool* mask, size_t count, const std::vector<uint8_t*>& outputs) const;
+};
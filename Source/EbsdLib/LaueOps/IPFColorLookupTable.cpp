@@ -0,0 +1,360 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "IPFColorLookupTable.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <list>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/LaueOps/LaueKernel.hpp"
+#include "EbsdLib/Math/EbsdLibMath.h"
+#include "EbsdLib/Utilities/ColorTable.h"
+#include "EbsdLib/Utilities/ParallelDataAlgorithm.hpp"
+
+namespace
+{
+// Half the side length of the square Lambert grid
+const double k_L = std::sqrt(EbsdLib::Constants::k_PiD / 2.0);
+
+// Fractional positions inside a cell where the interpolation is checked against the exact color
+const std::array<std::array<double, 2>, 9> k_CellSamples = {
+    {{0.5, 0.5}, {1.0 / 6.0, 1.0 / 6.0}, {0.5, 1.0 / 6.0}, {5.0 / 6.0, 1.0 / 6.0}, {1.0 / 6.0, 0.5}, {5.0 / 6.0, 0.5}, {1.0 / 6.0, 5.0 / 6.0}, {0.5, 5.0 / 6.0}, {5.0 / 6.0, 5.0 / 6.0}}};
+
+/**
+ * @brief Maps a point of the square Lambert grid onto the upper unit hemisphere
+ */
+EbsdLib::Matrix3X1D SquareToHemisphere(double a, double b)
+{
+  if(a == 0.0 && b == 0.0)
+  {
+    return {0.0, 0.0, 1.0};
+  }
+  if(std::fabs(b) <= std::fabs(a))
+  {
+    double r = (2.0 * a / EbsdLib::Constants::k_PiD) * std::sqrt(EbsdLib::Constants::k_PiD - a * a);
+    double angle = b * EbsdLib::Constants::k_PiD / (4.0 * a);
+    return {r * std::cos(angle), r * std::sin(angle), 1.0 - 2.0 * a * a / EbsdLib::Constants::k_PiD};
+  }
+  double r = (2.0 * b / EbsdLib::Constants::k_PiD) * std::sqrt(EbsdLib::Constants::k_PiD - b * b);
+  double angle = a * EbsdLib::Constants::k_PiD / (4.0 * b);
+  return {r * std::sin(angle), r * std::cos(angle), 1.0 - 2.0 * b * b / EbsdLib::Constants::k_PiD};
+}
+
+/**
+ * @brief Converts an EbsdLib::Rgb into its red, green and blue values
+ */
+void ToRgbBytes(EbsdLib::Rgb argb, uint8_t* rgb)
+{
+  rgb[0] = static_cast<uint8_t>(EbsdLib::RgbColor::dRed(argb));
+  rgb[1] = static_cast<uint8_t>(EbsdLib::RgbColor::dGreen(argb));
+  rgb[2] = static_cast<uint8_t>(EbsdLib::RgbColor::dBlue(argb));
+}
+
+/**
+ * @brief BuildIPFColorLookupTableImpl computes the exact IPF color of a range of rows of grid nodes
+ */
+class BuildIPFColorLookupTableImpl
+{
+public:
+  BuildIPFColorLookupTableImpl(uint32_t laueIndex, size_t dimension, double stepSize, uint8_t* colors)
+  : m_LaueIndex(laueIndex)
+  , m_Dimension(dimension)
+  , m_StepSize(stepSize)
+  , m_Colors(colors)
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    LaueKernels::visit(m_LaueIndex, [&](auto kernel) {
+      for(size_t row = start; row < end; row++)
+      {
+        double b = -k_L + static_cast<double>(row) * m_StepSize;
+        for(size_t col = 0; col < m_Dimension; col++)
+        {
+          double a = -k_L + static_cast<double>(col) * m_StepSize;
+          ToRgbBytes(kernel.generateIPFColorFromDirection(SquareToHemisphere(a, b)), m_Colors + (row * m_Dimension + col) * 3);
+        }
+      }
+    });
+  }
+
+private:
+  uint32_t m_LaueIndex = 0;
+  size_t m_Dimension = 0;
+  double m_StepSize = 0.0;
+  uint8_t* m_Colors = nullptr;
+};
+
+/**
+ * @brief FlagExactCellsImpl flags the cells of a range of rows that can not be interpolated: either
+ * the corner colors are too far apart, which happens where the cell straddles an edge of the color
+ * key, or the exact color somewhere inside the cell is too far from the interpolated one.
+ */
+class FlagExactCellsImpl
+{
+public:
+  FlagExactCellsImpl(uint32_t laueIndex, size_t dimension, double stepSize, const uint8_t* colors, uint8_t* exactCells)
+  : m_LaueIndex(laueIndex)
+  , m_Dimension(dimension)
+  , m_StepSize(stepSize)
+  , m_Colors(colors)
+  , m_ExactCells(exactCells)
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    const size_t numCells = m_Dimension - 1;
+    LaueKernels::visit(m_LaueIndex, [&](auto kernel) {
+      for(size_t row = start; row < end; row++)
+      {
+        for(size_t col = 0; col < numCells; col++)
+        {
+          const uint8_t* c00 = m_Colors + (row * m_Dimension + col) * 3;
+          const uint8_t* c10 = c00 + 3;
+          const uint8_t* c01 = c00 + m_Dimension * 3;
+          const uint8_t* c11 = c01 + 3;
+          bool exact = false;
+          for(size_t c = 0; c < 3; c++)
+          {
+            int32_t minValue = std::min({c00[c], c10[c], c01[c], c11[c]});
+            int32_t maxValue = std::max({c00[c], c10[c], c01[c], c11[c]});
+            exact = exact || (maxValue - minValue > IPFColorLookupTable::k_MaxCornerSpread);
+          }
+          // Compares the interpolated and exact colors on a 3 x 3 grid of points inside the cell. This
+          // catches the cells that a triangle edge passes through, where a color channel goes to zero
+          // like a square root and the interpolation overshoots.
+          for(size_t sample = 0; sample < k_CellSamples.size() && !exact; sample++)
+          {
+            double fu = k_CellSamples[sample][0];
+            double fv = k_CellSamples[sample][1];
+            double a = -k_L + (static_cast<double>(col) + fu) * m_StepSize;
+            double b = -k_L + (static_cast<double>(row) + fv) * m_StepSize;
+            uint8_t expected[3] = {0, 0, 0};
+            ToRgbBytes(kernel.generateIPFColorFromDirection(SquareToHemisphere(a, b)), expected);
+            for(size_t c = 0; c < 3; c++)
+            {
+              double interpolated = (1.0 - fv) * ((1.0 - fu) * c00[c] + fu * c10[c]) + fv * ((1.0 - fu) * c01[c] + fu * c11[c]);
+              exact = exact || (std::fabs(interpolated - expected[c]) > IPFColorLookupTable::k_MaxSampleError);
+            }
+          }
+          m_ExactCells[row * numCells + col] = exact ? 1 : 0;
+        }
+      }
+    });
+  }
+
+private:
+  uint32_t m_LaueIndex = 0;
+  size_t m_Dimension = 0;
+  double m_StepSize = 0.0;
+  const uint8_t* m_Colors = nullptr;
+  uint8_t* m_ExactCells = nullptr;
+};
+
+/**
+ * @brief IPFColorLookupTableCache keeps the most recently used tables. The default dimension of every
+ * Laue class fits, so the tables of a multi phase scan are not rebuilt.
+ */
+struct IPFColorLookupTableCache
+{
+  static constexpr size_t k_MaxTables = 16;
+
+  std::mutex mutex;
+  std::list<std::pair<std::pair<uint32_t, size_t>, IPFColorLookupTable::ConstPointer>> tables; // most recent first
+};
+
+// -----------------------------------------------------------------------------
+IPFColorLookupTableCache& GetIPFColorLookupTableCache()
+{
+  static IPFColorLookupTableCache s_Cache;
+  return s_Cache;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+IPFColorLookupTable::IPFColorLookupTable(uint32_t laueIndex, size_t dimension)
+: m_LaueIndex(laueIndex)
+, m_Dimension(dimension)
+{
+  if(laueIndex >= EbsdLib::CrystalStructure::LaueGroupEnd)
+  {
+    throw std::out_of_range("IPFColorLookupTable: Laue class index " + std::to_string(laueIndex) + " is not a valid Laue class.");
+  }
+  if(dimension < 2)
+  {
+    throw std::runtime_error("IPFColorLookupTable needs a dimension of at least 2.");
+  }
+  m_StepSize = 2.0 * k_L / static_cast<double>(dimension - 1);
+  m_Colors.resize(dimension * dimension * 3);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, dimension);
+  dataAlg.setGrain(8);
+  dataAlg.execute(BuildIPFColorLookupTableImpl(laueIndex, dimension, m_StepSize, m_Colors.data()));
+
+  const size_t numCells = dimension - 1;
+  m_ExactCells.resize(numCells * numCells, 0);
+  dataAlg.setRange(0, numCells);
+  dataAlg.execute(FlagExactCellsImpl(laueIndex, dimension, m_StepSize, m_Colors.data(), m_ExactCells.data()));
+}
+
+// -----------------------------------------------------------------------------
+IPFColorLookupTable::~IPFColorLookupTable() = default;
+
+// -----------------------------------------------------------------------------
+IPFColorLookupTable::ConstPointer IPFColorLookupTable::Get(uint32_t laueIndex, size_t dimension)
+{
+  IPFColorLookupTableCache& cache = GetIPFColorLookupTableCache();
+  const std::pair<uint32_t, size_t> key(laueIndex, dimension);
+  auto findTable = [&cache, &key]() {
+    return std::find_if(cache.tables.begin(), cache.tables.end(), [&key](const auto& entry) { return entry.first == key; });
+  };
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto iter = findTable();
+    if(iter != cache.tables.end())
+    {
+      cache.tables.splice(cache.tables.begin(), cache.tables, iter);
+      return iter->second;
+    }
+  }
+  // Build outside of the lock. Building runs parallel loops, and a thread waiting in them may pick up
+  // another task that calls Get() again. If another thread got there first its table is kept, they are identical.
+  ConstPointer table = std::make_shared<const IPFColorLookupTable>(laueIndex, dimension);
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  auto iter = findTable();
+  if(iter != cache.tables.end())
+  {
+    return iter->second;
+  }
+  cache.tables.emplace_front(key, table);
+  if(cache.tables.size() > IPFColorLookupTableCache::k_MaxTables)
+  {
+    cache.tables.pop_back();
+  }
+  return table;
+}
+
+// -----------------------------------------------------------------------------
+void IPFColorLookupTable::ClearCache()
+{
+  IPFColorLookupTableCache& cache = GetIPFColorLookupTableCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.tables.clear();
+}
+
+// -----------------------------------------------------------------------------
+size_t IPFColorLookupTable::GetCachedTableCount()
+{
+  IPFColorLookupTableCache& cache = GetIPFColorLookupTableCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  return cache.tables.size();
+}
+
+// -----------------------------------------------------------------------------
+uint32_t IPFColorLookupTable::getLaueIndex() const
+{
+  return m_LaueIndex;
+}
+
+// -----------------------------------------------------------------------------
+size_t IPFColorLookupTable::getDimension() const
+{
+  return m_Dimension;
+}
+
+// -----------------------------------------------------------------------------
+bool IPFColorLookupTable::lookup(const EbsdLib::Matrix3X1D& crystalDirection, uint8_t* rgb) const
+{
+  double norm = std::sqrt(crystalDirection[0] * crystalDirection[0] + crystalDirection[1] * crystalDirection[1] + crystalDirection[2] * crystalDirection[2]);
+  double x = crystalDirection[0] / norm;
+  double y = crystalDirection[1] / norm;
+  double z = crystalDirection[2] / norm;
+  // The colors have inversion symmetry so the lower hemisphere is folded onto the upper one
+  if(z < 0.0)
+  {
+    x = -x;
+    y = -y;
+    z = -z;
+  }
+
+  // Square Lambert projection of the upper hemisphere
+  double r = std::sqrt(std::max(2.0 * (1.0 - z), 0.0));
+  double a = 0.0;
+  double b = 0.0;
+  if(std::fabs(y) <= std::fabs(x))
+  {
+    if(x != 0.0)
+    {
+      a = std::copysign(r * EbsdLib::Constants::k_SqrtPiD / 2.0, x);
+      b = std::copysign(r * 2.0 / EbsdLib::Constants::k_SqrtPiD, x) * std::atan(y / x);
+    }
+  }
+  else
+  {
+    b = std::copysign(r * EbsdLib::Constants::k_SqrtPiD / 2.0, y);
+    a = std::copysign(r * 2.0 / EbsdLib::Constants::k_SqrtPiD, y) * std::atan(x / y);
+  }
+
+  const double maxNode = static_cast<double>(m_Dimension - 1);
+  double u = std::clamp((a + k_L) / m_StepSize, 0.0, maxNode);
+  double v = std::clamp((b + k_L) / m_StepSize, 0.0, maxNode);
+  size_t col = std::min(static_cast<size_t>(u), m_Dimension - 2);
+  size_t row = std::min(static_cast<size_t>(v), m_Dimension - 2);
+  if(m_ExactCells[row * (m_Dimension - 1) + col] != 0)
+  {
+    return false;
+  }
+
+  double fu = u - static_cast<double>(col);
+  double fv = v - static_cast<double>(row);
+  const uint8_t* c00 = &m_Colors[(row * m_Dimension + col) * 3];
+  const uint8_t* c10 = c00 + 3;
+  const uint8_t* c01 = c00 + m_Dimension * 3;
+  const uint8_t* c11 = c01 + 3;
+  for(size_t c = 0; c < 3; c++)
+  {
+    double value = (1.0 - fv) * ((1.0 - fu) * c00[c] + fu * c10[c]) + fv * ((1.0 - fu) * c01[c] + fu * c11[c]);
+    rgb[c] = static_cast<uint8_t>(value + 0.5);
+  }
+  return true;
+}
@@ -0,0 +1,120 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/Math/Matrix3X1.hpp"
+
+/**
+ * @class IPFColorLookupTable IPFColorLookupTable.h EbsdLib/LaueOps/IPFColorLookupTable.h
+ * @brief IPFColorLookupTable holds precomputed IPF colors of one Laue class. The IPF color of an
+ * orientation g and a sample reference direction r only depends on the crystal direction g * r and,
+ * because every Laue class has inversion symmetry, the upper hemisphere of crystal directions is
+ * enough. The table stores the exact colors at the nodes of an equal area (square Lambert) grid of
+ * that hemisphere, so a single table serves every reference direction. A lookup bilinearly
+ * interpolates the four surrounding nodes. The default dimension is odd so that grid nodes fall on
+ * the [001] pole and on the (100) and (010) planes.
+ *
+ * Interpolation is not used for a cell whose corner colors differ by more than k_MaxCornerSpread in
+ * any channel, which happens where the cell straddles an edge of the color key (for example
+ * eta = 0 / eta = 180 for Triclinic), or whose interpolated color is more than k_MaxSampleError
+ * away from the exact color at any of 9 points inside the cell, which happens along the edges of
+ * the standard triangle. lookup() returns false for those cells (roughly 1 to 6 % of the directions
+ * depending on the Laue class) and the caller uses the exact path. For every other cell the
+ * interpolated color differs from the exact color by at most k_MaxColorError in each channel at the
+ * default dimension. This bound was measured with 3 million random directions per Laue class.
+ */
+class EbsdLib_EXPORT IPFColorLookupTable
+{
+public:
+  using Self = IPFColorLookupTable;
+  using Pointer = std::shared_ptr<Self>;
+  using ConstPointer = std::shared_ptr<const Self>;
+
+  static constexpr size_t k_DefaultDimension = 513;
+  static constexpr int32_t k_MaxCornerSpread = 16;
+  static constexpr int32_t k_MaxSampleError = 2;
+  static constexpr int32_t k_MaxColorError = 3;
+
+  /**
+   * @brief Builds the table for a Laue class
+   * @param laueIndex The Laue class (EbsdLib::CrystalStructure)
+   * @param dimension The number of grid nodes along each side of the square Lambert grid
+   */
+  IPFColorLookupTable(uint32_t laueIndex, size_t dimension);
+  ~IPFColorLookupTable();
+
+  IPFColorLookupTable(const IPFColorLookupTable&) = delete;            // Copy Constructor Not Implemented
+  IPFColorLookupTable(IPFColorLookupTable&&) = delete;                 // Move Constructor Not Implemented
+  IPFColorLookupTable& operator=(const IPFColorLookupTable&) = delete; // Copy Assignment Not Implemented
+  IPFColorLookupTable& operator=(IPFColorLookupTable&&) = delete;      // Move Assignment Not Implemented
+
+  /**
+   * @brief Returns the shared table for a Laue class and dimension, building it on first use.
+   * Only the 16 most recently used tables are kept, see ClearCache(). This function is thread safe.
+   */
+  static ConstPointer Get(uint32_t laueIndex, size_t dimension = k_DefaultDimension);
+
+  /**
+   * @brief ClearCache Releases every cached table. Callers that hold a table keep it.
+   */
+  static void ClearCache();
+
+  /**
+   * @brief GetCachedTableCount Returns the number of tables that are currently cached.
+   */
+  static size_t GetCachedTableCount();
+
+  uint32_t getLaueIndex() const;
+  size_t getDimension() const;
+
+  /**
+   * @brief Interpolates the color of a crystal direction
+   * @param crystalDirection The direction in the crystal frame. It does not need to be normalized.
+   * @param rgb [output] The red, green and blue values
+   * @return false if the direction falls in a cell that must be colored with the exact path. rgb is not written in that case.
+   */
+  bool lookup(const EbsdLib::Matrix3X1D& crystalDirection, uint8_t* rgb) const;
+
+private:
+  uint32_t m_LaueIndex = 0;
+  size_t m_Dimension = 0;
+  double m_StepSize = 0.0;
+  std::vector<uint8_t> m_Colors;
+  std::vector<uint8_t> m_ExactCells;
+};
@@ -0,0 +1,1098 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/FixedOrientation.hpp"
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/Math/EbsdLibMath.h"
+#include "EbsdLib/Math/Matrix3X1.hpp"
+#include "EbsdLib/Math/Matrix3X3.hpp"
+#include "EbsdLib/Utilities/ColorTable.h"
+
+/**
+ * @brief The LaueKernels namespace holds the symmetry data of each Laue class as compile time
+ * tables. Each struct is used as the Group argument of LaueKernel. The quaternion operators are
+ * stored as {x, y, z, w} and the Rodrigues operators as {n1, n2, n3, tan(w/2)}, in the same order
+ * as the LaueOps subclasses return them from getQuatSymOp() and getRodSymOp().
+ */
+namespace LaueKernels
+{
+inline constexpr double k_Sqrt3Over2 = 0.86602540378443864676;
+
+/**
+ * @brief Symmetry data for the Hexagonal 6/mmm (D6h) Laue class (Rotation Point Group 622)
+ */
+struct HexagonalHigh
+{
+  static constexpr uint32_t k_LaueIndex = EbsdLib::CrystalStructure::Hexagonal_High;
+  static constexpr bool k_ClosedFormMisorientation = false;
+  static constexpr bool k_CubicIpfTriangle = false;
+  static constexpr double k_EtaMin = 0.0;
+  static constexpr double k_EtaMax = 30.0;
+  static constexpr double k_ChiMax = 90.0;
+
+  // clang-format off
+  static constexpr std::array<std::array<double, 4>, 12> QuatSym = {{
+      {0.0, 0.0, 0.0, 1.0},
+      {0.0, 0.0, 0.5, k_Sqrt3Over2},
+      {0.0, 0.0, k_Sqrt3Over2, 0.5},
+      {0.0, 0.0, 1.0, 0.0},
+      {0.0, 0.0, k_Sqrt3Over2, -0.5},
+      {0.0, 0.0, 0.5, -k_Sqrt3Over2},
+      {1.0, 0.0, 0.0, 0.0},
+      {k_Sqrt3Over2, 0.5, 0.0, 0.0},
+      {0.5, k_Sqrt3Over2, 0.0, 0.0},
+      {0.0, 1.0, 0.0, 0.0},
+      {-0.5, k_Sqrt3Over2, 0.0, 0.0},
+      {-k_Sqrt3Over2, 0.5, 0.0, 0.0},
+  }};
+
+  static constexpr std::array<std::array<double, 4>, 12> RodSym = {{
+      {0.0, 0.0, 1.0, 0.0},
+      {0.0, 0.0, 1.0, 0.5773502691896258},
+      {0.0, 0.0, 1.0, 1.7320508075688767},
+      {0.0, 0.0, 1.0, 10000000000000.0},
+      {0.0, 0.0, k_Sqrt3Over2, 10000000000000.0},
+      {0.0, 0.0, 0.5, 10000000000000.0},
+      {1.0, 0.0, 0.0, 10000000000000.0},
+      {k_Sqrt3Over2, 0.5, 0.0, 10000000000000.0},
+      {0.5, k_Sqrt3Over2, 0.0, 10000000000000.0},
+      {0.0, 1.0, 0.0, 10000000000000.0},
+      {-0.5, k_Sqrt3Over2, 0.0, 10000000000000.0},
+      {-k_Sqrt3Over2, 0.5, 0.0, 10000000000000.0},
+  }};
+  // clang-format on
+};
+
+/**
+ * @brief Symmetry data for the Cubic m-3m (Oh) Laue class (Rotation Point Group 432)
+ */
+struct CubicHigh
+{
+  static constexpr uint32_t k_LaueIndex = EbsdLib::CrystalStructure::Cubic_High;
+  static constexpr bool k_ClosedFormMisorientation = true;
+  static constexpr bool k_CubicIpfTriangle = true;
+  static constexpr double k_EtaMin = 0.0;
+  static constexpr double k_EtaMax = 45.0;
+
+  // clang-format off
+  static constexpr std::array<std::array<double, 4>, 24> QuatSym = {{
+      {0.0, 0.0, 0.0, 1.0},
+      {1.0, 0.0, 0.0, 0.0},
+      {0.0, 1.0, 0.0, 0.0},
+      {0.0, 0.0, 1.0, 0.0},
+      {0.7071067811865476, 0.0, 0.0, 0.7071067811865476},
+      {0.0, 0.7071067811865476, 0.0, 0.7071067811865476},
+      {0.0, 0.0, 0.7071067811865476, 0.7071067811865476},
+      {-0.7071067811865476, 0.0, 0.0, 0.7071067811865476},
+      {0.0, -0.7071067811865476, 0.0, 0.7071067811865476},
+      {0.0, 0.0, -0.7071067811865476, 0.7071067811865476},
+      {0.7071067811865476, 0.7071067811865476, 0.0, 0.0},
+      {-0.7071067811865476, 0.7071067811865476, 0.0, 0.0},
+      {0.0, 0.7071067811865476, 0.7071067811865476, 0.0},
+      {0.0, -0.7071067811865476, 0.7071067811865476, 0.0},
+      {0.7071067811865476, 0.0, 0.7071067811865476, 0.0},
+      {-0.7071067811865476, 0.0, 0.7071067811865476, 0.0},
+      {0.5, 0.5, 0.5, 0.5},
+      {-0.5, -0.5, -0.5, 0.5},
+      {0.5, -0.5, 0.5, 0.5},
+      {-0.5, 0.5, -0.5, 0.5},
+      {-0.5, 0.5, 0.5, 0.5},
+      {0.5, -0.5, -0.5, 0.5},
+      {-0.5, -0.5, 0.5, 0.5},
+      {0.5, 0.5, -0.5, 0.5},
+  }};
+
+  static constexpr std::array<std::array<double, 4>, 24> RodSym = {{
+      {0.0, 0.0, 1.0, 0.0},
+      {1.0, 0.0, 0.0, 10000000000000.0},
+      {0.0, 1.0, 0.0, 10000000000000.0},
+      {0.0, 0.0, 1.0, 10000000000000.0},
+      {1.0, 0.0, 0.0, 1.0},
+      {0.0, 1.0, 0.0, 1.0},
+      {0.0, 0.0, 1.0, 1.0},
+      {-1.0, 0.0, 0.0, 1.0},
+      {0.0, -1.0, 0.0, 1.0},
+      {0.0, 0.0, -1.0, 1.0},
+      {0.7071067811865476, 0.7071067811865476, 0.0, 10000000000000.0},
+      {-0.7071067811865476, 0.7071067811865476, 0.0, 10000000000000.0},
+      {0.0, 0.7071067811865476, 0.7071067811865476, 10000000000000.0},
+      {0.0, -0.7071067811865476, 0.7071067811865476, 10000000000000.0},
+      {0.7071067811865476, 0.0, 0.7071067811865476, 10000000000000.0},
+      {-0.7071067811865476, 0.0, 0.7071067811865476, 10000000000000.0},
+      {0.5773502691896258, 0.5773502691896258, 0.5773502691896258, 1.7320508075688767},
+      {-0.5773502691896258, -0.5773502691896258, -0.5773502691896258, 1.7320508075688767},
+      {0.5773502691896258, -0.5773502691896258, 0.5773502691896258, 1.7320508075688767},
+      {-0.5773502691896258, 0.5773502691896258, -0.5773502691896258, 1.7320508075688767},
+      {-0.5773502691896258, 0.5773502691896258, 0.5773502691896258, 1.7320508075688767},
+      {0.5773502691896258, -0.5773502691896258, -0.5773502691896258, 1.7320508075688767},
+      {-0.5773502691896258, -0.5773502691896258, 0.5773502691896258, 1.7320508075688767},
+      {0.5773502691896258, 0.5773502691896258, -0.5773502691896258, 1.7320508075688767},
+  }};
+  // clang-format on
+
+  /**
+   * @brief Closed form misorientation for the 432 rotation group that sorts |q1 * q2^-1| instead of
+   * searching all 24 operators.
+   */
+  static inline OrientationD calculateMisorientation(const QuatD& q1, const QuatD& q2);
+};
+
+/**
+ * @brief Symmetry data for the Hexagonal 6/m (C6h) Laue class (Rotation Point Group 6)
+ */
+struct HexagonalLow
+{
+  static constexpr uint32_t k_LaueIndex = EbsdLib::CrystalStructure::Hexagonal_Low;
+  static constexpr bool k_ClosedFormMisorientation = false;
+  static constexpr bool k_CubicIpfTriangle = false;
+  static constexpr double k_EtaMin = 0.0;
+  static constexpr double k_EtaMax = 60.0;
+  static constexpr double k_ChiMax = 90.0;
+
+  // clang-format off
+  static constexpr std::array<std::array<double, 4>, 6> QuatSym = {{
+      {0.0, 0.0, 0.0, 1.0},
+      {0.0, 0.0, 0.5, k_Sqrt3Over2},
+      {0.0, 0.0, k_Sqrt3Over2, 0.5},
+      {0.0, 0.0, 1.0, 0.0},
+      {0.0, 0.0, k_Sqrt3Over2, -0.5},
+      {0.0, 0.0, 0.5, -k_Sqrt3Over2},
+  }};
+
+  static constexpr std::array<std::array<double, 4>, 6> RodSym = {{
+      {0.0, 0.0, 1.0, 0.0},
+      {0.0, 0.0, 1.0, 0.5773502691896258},
+      {0.0, 0.0, 1.0, 1.7320508075688767},
+      {0.0, 0.0, 1.0, 10000000000000.0},
+      {0.0, 0.0, k_Sqrt3Over2, 10000000000000.0},
+      {0.0, 0.0, 0.5, 10000000000000.0},
+  }};
+  // clang-format on
+};
+
+/**
+ * @brief Symmetry data for the Cubic m-3 (Th) Laue class (Rotation Point Group 23)
+ */
+struct CubicLow
+{
+  static constexpr uint32_t k_LaueIndex = EbsdLib::CrystalStructure::Cubic_Low;
+  static constexpr bool k_ClosedFormMisorientation = false;
+  static constexpr bool k_CubicIpfTriangle = true;
+  static constexpr double k_EtaMin = 0.0;
+  static constexpr double k_EtaMax = 45.0;
+
+  // clang-format off
+  static constexpr std::array<std::array<double, 4>, 12> QuatSym = {{
+      {0.0, 0.0, 0.0, 1.0},
+      {1.0, 0.0, 0.0, 0.0},
+      {0.0, 1.0, 0.0, 0.0},
+      {0.0, 0.0, 1.0, 0.0},
+      {0.5, 0.5, 0.5, 0.5},
+      {-0.5, -0.5, -0.5, 0.5},
+      {0.5, -0.5, 0.5, 0.5},
+      {-0.5, 0.5, -0.5, 0.5},
+      {-0.5, 0.5, 0.5, 0.5},
+      {0.5, -0.5, -0.5, 0.5},
+      {-0.5, -0.5, 0.5, 0.5},
+      {0.5, 0.5, -0.5, 0.5},
+  }};
+
+  static constexpr std::array<std::array<double, 4>, 12> RodSym = {{
+      {0.0, 0.0, 1.0, 0.0},
+      {1.0, 0.0, 0.0, 10000000000000.0},
+      {0.0, 1.0, 0.0, 10000000000000.0},
+      {0.0, 0.0, 1.0, 10000000000000.0},
+      {0.5773502691896258, 0.5773502691896258, 0.5773502691896258, 1.7320508075688767},
+      {-0.5773502691896258, -0.5773502691896258, -0.5773502691896258, 1.7320508075688767},
+      {0.5773502691896258, -0.5773502691896258, 0.5773502691896258, 1.7320508075688767},
+      {-0.5773502691896258, 0.5773502691896258, -0.5773502691896258, 1.7320508075688767},
+      {-0.5773502691896258, 0.5773502691896258, 0.5773502691896258, 1.7320508075688767},
+      {0.5773502691896258, -0.5773502691896258, -0.5773502691896258, 1.7320508075688767},
+      {-0.5773502691896258, -0.5773502691896258, 0.5773502691896258, 1.7320508075688767},
+      {0.5773502691896258, 0.5773502691896258, -0.5773502691896258, 1.7320508075688767},
+  }};
+  // clang-format on
+};
+
+/**
+ * @brief Symmetry data for the Triclinic -1 (Ci) Laue class (Rotation Point Group 1)
+ */
+struct Triclinic
+{
+  static constexpr uint32_t k_LaueIndex = EbsdLib::CrystalStructure::Triclinic;
+  static constexpr bool k_ClosedFormMisorientation = false;
+  static constexpr bool k_CubicIpfTriangle = false;
+  static constexpr double k_EtaMin = 0.0;
+  static constexpr double k_EtaMax = 180.0;
+  static constexpr double k_ChiMax = 90.0;
+
+  // clang-format off
+  static constexpr std::array<std::array<double, 4>, 1> QuatSym = {{
+      {0.0, 0.0, 0.0, 1.0},
+  }};
+
+  static constexpr std::array<std::array<double, 4>, 1> RodSym = {{
+      {0.0, 0.0, 1.0, 0.0},
+  }};
+  // clang-format on
+};
+
+/**
+ * @brief Symmetry data for the Monoclinic 2/m (C2h) Laue class (Rotation Point Group 2)
+ */
+struct Monoclinic
+{
+  static constexpr uint32_t k_LaueIndex = EbsdLib::CrystalStructure::Monoclinic;
+  static constexpr bool k_ClosedFormMisorientation = false;
+  static constexpr bool k_CubicIpfTriangle = false;
+  static constexpr double k_EtaMin = 0.0;
+  static constexpr double k_EtaMax = 180.0;
+  static constexpr double k_ChiMax = 90.0;
+
+  // clang-format off
+  static constexpr std::array<std::array<double, 4>, 2> QuatSym = {{
+      {0.0, 0.0, 0.0, 1.0},
+      {0.0, 1.0, 0.0, 0.0},
+  }};
+
+  static constexpr std::array<std::array<double, 4>, 2> RodSym = {{
+      {0.0, 0.0, 1.0, 0.0},
+      {0.0, 1.0, 0.0, 10000000000000.0},
+  }};
+  // clang-format on
+};
+
+/**
+ * @brief Symmetry data for the Orthorhombic mmm (D2h) Laue class (Rotation Point Group 222)
+ */
+struct OrthoRhombic
+{
+  static constexpr uint32_t k_LaueIndex = EbsdLib::CrystalStructure::OrthoRhombic;
+  static constexpr bool k_ClosedFormMisorientation = false;
+  static constexpr bool k_CubicIpfTriangle = false;
+  static constexpr double k_EtaMin = 0.0;
+  static constexpr double k_EtaMax = 90.0;
+  static constexpr double k_ChiMax = 90.0;
+
+  // clang-format off
+  static constexpr std::array<std::array<double, 4>, 4> QuatSym = {{
+      {0.0, 0.0, 0.0, 1.0},
+      {1.0, 0.0, 0.0, 0.0},
+      {0.0, 1.0, 0.0, 0.0},
+      {0.0, 0.0, 1.0, 0.0},
+  }};
+
+  static constexpr std::array<std::array<double, 4>, 4> RodSym = {{
+      {0.0, 0.0, 1.0, 0.0},
+      {1.0, 0.0, 0.0, 10000000000000.0},
+      {0.0, 1.0, 0.0, 10000000000000.0},
+      {0.0, 0.0, 1.0, 10000000000000.0},
+  }};
+  // clang-format on
+};
+
+/**
+ * @brief Symmetry data for the Tetragonal 4/m (C4h) Laue class (Rotation Point Group 4)
+ */
+struct TetragonalLow
+{
+  static constexpr uint32_t k_LaueIndex = EbsdLib::CrystalStructure::Tetragonal_Low;
+  static constexpr bool k_ClosedFormMisorientation = false;
+  static constexpr bool k_CubicIpfTriangle = false;
+  static constexpr double k_EtaMin = 0.0;
+  static constexpr double k_EtaMax = 90.0;
+  static constexpr double k_ChiMax = 90.0;
+
+  // clang-format off
+  static constexpr std::array<std::array<double, 4>, 4> QuatSym = {{
+      {0.0, 0.0, 0.0, 1.0},
+      {0.0, 0.0, 1.0, 0.0},
+      {0.0, 0.0, 0.7071067811865476, 0.7071067811865476},
+      {0.0, 0.0, -0.7071067811865476, 0.7071067811865476},
+  }};
+
+  static constexpr std::array<std::array<double, 4>, 4> RodSym = {{
+      {0.0, 0.0, 1.0, 0.0},
+      {0.0, 0.0, 1.0, 10000000000000.0},
+      {0.0, 0.0, 1.0, 1.0},
+      {0.0, 0.0, -1.0, 1.0},
+  }};
+  // clang-format on
+};
+
+/**
+ * @brief Symmetry data for the Tetragonal 4/mmm (D4h) Laue class (Rotation Point Group 422)
+ */
+struct TetragonalHigh
+{
+  static constexpr uint32_t k_LaueIndex = EbsdLib::CrystalStructure::Tetragonal_High;
+  static constexpr bool k_ClosedFormMisorientation = false;
+  static constexpr bool k_CubicIpfTriangle = false;
+  static constexpr double k_EtaMin = 0.0;
+  static constexpr double k_EtaMax = 45.0;
+  static constexpr double k_ChiMax = 90.0;
+
+  // clang-format off
+  static constexpr std::array<std::array<double, 4>, 8> QuatSym = {{
+      {0.0, 0.0, 0.0, 1.0},
+      {0.0, 0.0, 1.0, 0.0},
+      {0.0, 0.0, 0.7071067811865476, 0.7071067811865476},
+      {0.0, 0.0, -0.7071067811865476, 0.7071067811865476},
+      {1.0, 0.0, 0.0, 0.0},
+      {0.0, 1.0, 0.0, 0.0},
+      {0.7071067811865476, 0.7071067811865476, 0.0, 0.0},
+      {-0.7071067811865476, 0.7071067811865476, 0.0, 0.0},
+  }};
+
+  static constexpr std::array<std::array<double, 4>, 8> RodSym = {{
+      {0.0, 0.0, 1.0, 0.0},
+      {0.0, 0.0, 1.0, 10000000000000.0},
+      {0.0, 0.0, 1.0, 1.0},
+      {0.0, 0.0, -1.0, 1.0},
+      {1.0, 0.0, 0.0, 10000000000000.0},
+      {0.0, 1.0, 0.0, 10000000000000.0},
+      {0.7071067811865476, 0.7071067811865476, 0.0, 10000000000000.0},
+      {-0.7071067811865476, 0.7071067811865476, 0.0, 10000000000000.0},
+  }};
+  // clang-format on
+};
+
+/**
+ * @brief Symmetry data for the Trigonal -3 (C3i) Laue class (Rotation Point Group 3)
+ */
+struct TrigonalLow
+{
+  static constexpr uint32_t k_LaueIndex = EbsdLib::CrystalStructure::Trigonal_Low;
+  static constexpr bool k_ClosedFormMisorientation = false;
+  static constexpr bool k_CubicIpfTriangle = false;
+  static constexpr double k_EtaMin = -120.0;
+  static constexpr double k_EtaMax = 0.0;
+  static constexpr double k_ChiMax = 90.0;
+
+  // clang-format off
+  static constexpr std::array<std::array<double, 4>, 3> QuatSym = {{
+      {0.0, 0.0, 0.0, 1.0},
+      {0.0, 0.0, k_Sqrt3Over2, 0.5},
+      {0.0, 0.0, k_Sqrt3Over2, -0.5},
+  }};
+
+  static constexpr std::array<std::array<double, 4>, 3> RodSym = {{
+      {0.0, 0.0, 1.0, 0.0},
+      {0.0, 0.0, 1.0, 1.7320508075688767},
+      {0.0, 0.0, k_Sqrt3Over2, 10000000000000.0},
+  }};
+  // clang-format on
+};
+
+/**
+ * @brief Symmetry data for the Trigonal -3m (D3d) Laue class (Rotation Point Group 32)
+ */
+struct TrigonalHigh
+{
+  static constexpr uint32_t k_LaueIndex = EbsdLib::CrystalStructure::Trigonal_High;
+  static constexpr bool k_ClosedFormMisorientation = false;
+  static constexpr bool k_CubicIpfTriangle = false;
+  static constexpr double k_EtaMin = -90.0;
+  static constexpr double k_EtaMax = -30.0;
+  static constexpr double k_ChiMax = 90.0;
+
+  // clang-format off
+  static constexpr std::array<std::array<double, 4>, 6> QuatSym = {{
+      {0.0, 0.0, 0.0, 1.0},
+      {0.0, 0.0, k_Sqrt3Over2, 0.5},
+      {0.0, 0.0, k_Sqrt3Over2, -0.5},
+      {1.0, 0.0, 0.0, 0.0},
+      {0.5, k_Sqrt3Over2, 0.0, 0.0},
+      {-0.5, k_Sqrt3Over2, 0.0, 0.0},
+  }};
+
+  static constexpr std::array<std::array<double, 4>, 6> RodSym = {{
+      {0.0, 0.0, 1.0, 0.0},
+      {0.0, 0.0, 1.0, 1.7320508075688767},
+      {0.0, 0.0, k_Sqrt3Over2, 10000000000000.0},
+      {1.0, 0.0, 0.0, 10000000000000.0},
+      {0.5, k_Sqrt3Over2, 0.0, 10000000000000.0},
+      {-0.5, k_Sqrt3Over2, 0.0, 10000000000000.0},
+  }};
+  // clang-format on
+};
+// -----------------------------------------------------------------------------
+inline OrientationD CubicHigh::calculateMisorientation(const QuatD& q1, const QuatD& q2)
+{
+  double wmin = 9999999.0f; //,na,nb,nc;
+  QuatD qco;
+  int type = 1;
+  double sin_wmin_over_2 = 0.0;
+
+  QuatD qc = q1 * (q2.conjugate());
+  qc.elementWiseAbs();
+
+  // if qc.x() is smallest
+  if(qc.x() <= qc.y() && qc.x() <= qc.z() && qc.x() <= qc.w())
+  {
+    qco.x() = qc.x();
+    // if qc.y() is next smallest
+    if(qc.y() <= qc.z() && qc.y() <= qc.w())
+    {
+      qco.y() = qc.y();
+      if(qc.z() <= qc.w())
+      {
+        qco.z() = qc.z(), qco.w() = qc.w();
+      }
+      else
+      {
+        qco.z() = qc.w(), qco.w() = qc.z();
+      }
+    }
+    // if qc.z() is next smallest
+    else if(qc.z() <= qc.y() && qc.z() <= qc.w())
+    {
+      qco.y() = qc.z();
+      if(qc.y() <= qc.w())
+      {
+        qco.z() = qc.y(), qco.w() = qc.w();
+      }
+      else
+      {
+        qco.z() = qc.w(), qco.w() = qc.y();
+      }
+    }
+    // if qc.w() is next smallest
+    else
+    {
+      qco.y() = qc.w();
+      if(qc.y() <= qc.z())
+      {
+        qco.z() = qc.y(), qco.w() = qc.z();
+      }
+      else
+      {
+        qco.z() = qc.z(), qco.w() = qc.y();
+      }
+    }
+  }
+  // if qc.y() is smallest
+  else if(qc.y() <= qc.x() && qc.y() <= qc.z() && qc.y() <= qc.w())
+  {
+    qco.x() = qc.y();
+    // if qc.x() is next smallest
+    if(qc.x() <= qc.z() && qc.x() <= qc.w())
+    {
+      qco.y() = qc.x();
+      if(qc.z() <= qc.w())
+      {
+        qco.z() = qc.z(), qco.w() = qc.w();
+      }
+      else
+      {
+        qco.z() = qc.w(), qco.w() = qc.z();
+      }
+    }
+    // if qc.z() is next smallest
+    else if(qc.z() <= qc.x() && qc.z() <= qc.w())
+    {
+      qco.y() = qc.z();
+      if(qc.x() <= qc.w())
+      {
+        qco.z() = qc.x(), qco.w() = qc.w();
+      }
+      else
+      {
+        qco.z() = qc.w(), qco.w() = qc.x();
+      }
+    }
+    // if qc.w() is next smallest
+    else
+    {
+      qco.y() = qc.w();
+      if(qc.x() <= qc.z())
+      {
+        qco.z() = qc.x(), qco.w() = qc.z();
+      }
+      else
+      {
+        qco.z() = qc.z(), qco.w() = qc.x();
+      }
+    }
+  }
+  // if qc.z() is smallest
+  else if(qc.z() <= qc.x() && qc.z() <= qc.y() && qc.z() <= qc.w())
+  {
+    qco.x() = qc.z();
+    // if qc.x() is next smallest
+    if(qc.x() <= qc.y() && qc.x() <= qc.w())
+    {
+      qco.y() = qc.x();
+      if(qc.y() <= qc.w())
+      {
+        qco.z() = qc.y(), qco.w() = qc.w();
+      }
+      else
+      {
+        qco.z() = qc.w(), qco.w() = qc.y();
+      }
+    }
+    // if qc.y() is next smallest
+    else if(qc.y() <= qc.x() && qc.y() <= qc.w())
+    {
+      qco.y() = qc.y();
+      if(qc.x() <= qc.w())
+      {
+        qco.z() = qc.x(), qco.w() = qc.w();
+      }
+      else
+      {
+        qco.z() = qc.w(), qco.w() = qc.x();
+      }
+    }
+    // if qc.w() is next smallest
+    else
+    {
+      qco.y() = qc.w();
+      if(qc.x() <= qc.y())
+      {
+        qco.z() = qc.x(), qco.w() = qc.y();
+      }
+      else
+      {
+        qco.z() = qc.y(), qco.w() = qc.x();
+      }
+    }
+  }
+  // if qc.w() is smallest
+  else
+  {
+    qco.x() = qc.w();
+    // if qc.x() is next smallest
+    if(qc.x() <= qc.y() && qc.x() <= qc.z())
+    {
+      qco.y() = qc.x();
+      if(qc.y() <= qc.z())
+      {
+        qco.z() = qc.y(), qco.w() = qc.z();
+      }
+      else
+      {
+        qco.z() = qc.z(), qco.w() = qc.y();
+      }
+    }
+    // if qc.y() is next smallest
+    else if(qc.y() <= qc.x() && qc.y() <= qc.z())
+    {
+      qco.y() = qc.y();
+      if(qc.x() <= qc.z())
+      {
+        qco.z() = qc.x(), qco.w() = qc.z();
+      }
+      else
+      {
+        qco.z() = qc.z(), qco.w() = qc.x();
+      }
+    }
+    // if qc.z() is next smallest
+    else
+    {
+      qco.y() = qc.z();
+      if(qc.x() <= qc.y())
+      {
+        qco.z() = qc.x(), qco.w() = qc.y();
+      }
+      else
+      {
+        qco.z() = qc.y(), qco.w() = qc.x();
+      }
+    }
+  }
+  wmin = qco.w();
+  if(((qco.z() + qco.w()) / (EbsdLib::Constants::k_Sqrt2D)) > wmin)
+  {
+    wmin = ((qco.z() + qco.w()) / (EbsdLib::Constants::k_Sqrt2D));
+    type = 2;
+  }
+  if(((qco.x() + qco.y() + qco.z() + qco.w()) / 2) > wmin)
+  {
+    wmin = ((qco.x() + qco.y() + qco.z() + qco.w()) / 2);
+    type = 3;
+  }
+  if(wmin < -1.0)
+  {
+    //  wmin = -1.0;
+    wmin = EbsdLib::Constants::k_ACosNeg1D;
+    sin_wmin_over_2 = std::sin(wmin);
+  }
+  else if(wmin > 1.0)
+  {
+    //   wmin = 1.0;
+    wmin = EbsdLib::Constants::k_ACos1D;
+    sin_wmin_over_2 = std::sin(wmin);
+  }
+  else
+  {
+    wmin = acos(wmin);
+    sin_wmin_over_2 = std::sin(wmin);
+  }
+
+  double n1 = 0.0;
+  double n2 = 0.0;
+  double n3 = 0.0;
+  if(type == 1)
+  {
+    n1 = qco.x() / sin_wmin_over_2;
+    n2 = qco.y() / sin_wmin_over_2;
+    n3 = qco.z() / sin_wmin_over_2;
+  }
+  if(type == 2)
+  {
+    n1 = ((qco.x() - qco.y()) / (EbsdLib::Constants::k_Sqrt2D)) / sin_wmin_over_2;
+    n2 = ((qco.x() + qco.y()) / (EbsdLib::Constants::k_Sqrt2D)) / sin_wmin_over_2;
+    n3 = ((qco.z() - qco.w()) / (EbsdLib::Constants::k_Sqrt2D)) / sin_wmin_over_2;
+  }
+  if(type == 3)
+  {
+    n1 = ((qco.x() - qco.y() + qco.z() - qco.w()) / (2.0)) / sin_wmin_over_2;
+    n2 = ((qco.x() + qco.y() - qco.z() - qco.w()) / (2.0)) / sin_wmin_over_2;
+    n3 = ((-qco.x() + qco.y() + qco.z() - qco.w()) / (2.0)) / sin_wmin_over_2;
+  }
+  double denom = sqrt((n1 * n1 + n2 * n2 + n3 * n3));
+  n1 = n1 / denom;
+  n2 = n2 / denom;
+  n3 = n3 / denom;
+  if(denom == 0)
+  {
+    n1 = 0.0, n2 = 0.0, n3 = 1.0;
+  }
+  if(wmin == 0)
+  {
+    n1 = 0.0, n2 = 0.0, n3 = 1.0;
+  }
+  wmin = 2.0f * wmin;
+
+  OrientationD axisAngle(n1, n2, n3, wmin);
+  return axisAngle;
+}
+} // namespace LaueKernels
+
+/**
+ * @brief LaueKernel implements the symmetry dependent functions of a single Laue class
+ * with the operators known at compile time. Every function is static and inline so a
+ * loop over many orientations that has picked its kernel once (see LaueKernels::visit)
+ * runs without any virtual dispatch. The LaueOps subclasses forward to these functions
+ * so both paths give identical results.
+ */
+template <typename Group>
+class LaueKernel
+{
+public:
+  using GroupType = Group;
+
+  static constexpr uint32_t k_LaueIndex = Group::k_LaueIndex;
+  static constexpr size_t k_SymOpsCount = Group::QuatSym.size();
+
+  /**
+   * @brief Returns the i'th symmetry operator as a Quaternion
+   */
+  static inline QuatD getQuatSymOp(size_t i)
+  {
+    const std::array<double, 4>& q = Group::QuatSym[i];
+    return QuatD(q[0], q[1], q[2], q[3]);
+  }
+
+  /**
+   * @brief Returns the quaternion symmetry operators as the runtime table that LaueOps uses
+   */
+  static std::vector<QuatD> QuatSymTable()
+  {
+    std::vector<QuatD> table;
+    table.reserve(k_SymOpsCount);
+    for(const auto& q : Group::QuatSym)
+    {
+      table.emplace_back(q[0], q[1], q[2], q[3]);
+    }
+    return table;
+  }
+
+  /**
+   * @brief Returns the Rodrigues symmetry operators as the runtime table that LaueOps uses
+   */
+  static std::vector<OrientationD> RodSymTable()
+  {
+    std::vector<OrientationD> table;
+    table.reserve(Group::RodSym.size());
+    for(const auto& r : Group::RodSym)
+    {
+      table.emplace_back(r[0], r[1], r[2], r[3]);
+    }
+    return table;
+  }
+
+  /**
+   * @brief Returns the symmetrically equivalent quaternion that lies in the Fundamental Zone,
+   * which is the one with the largest |w|. Mirrors LaueOps::_calcQuatNearestOrigin.
+   */
+  static inline QuatD getFZQuat(const QuatD& qr)
+  {
+    double smallestdist = 1000000.0f;
+    QuatD qmax;
+    for(size_t i = 0; i < k_SymOpsCount; i++)
+    {
+      QuatD qc = getQuatSymOp(i) * qr;
+      double dist = 1 - (qc.w() * qc.w());
+      if(dist < smallestdist)
+      {
+        smallestdist = dist;
+        qmax = qc;
+      }
+    }
+    if(qmax.w() < 0)
+    {
+      qmax.negate();
+    }
+    return qmax;
+  }
+
+  /**
+   * @brief Returns the symmetrically equivalent Rodrigues vector closest to the origin of
+   * the ODF. Mirrors LaueOps::_calcRodNearestOrigin.
+   */
+  static inline OrientationType getODFFZRod(const OrientationType& inRod)
+  {
+    double smallestdist = 100000000.0f;
+    OrientationType outRod(4, 0.0f);
+    // Turn into an actual 3 Comp Rodrigues Vector
+    Rodrigues<double> rod(inRod.data());
+    rod[0] *= rod[3];
+    rod[1] *= rod[3];
+    rod[2] *= rod[3];
+    for(const auto& rodsym : Group::RodSym)
+    {
+      double denom = 1 - (rod[0] * rodsym[0] + rod[1] * rodsym[1] + rod[2] * rodsym[2]);
+      double rc1 = (rod[0] + rodsym[0] - (rod[1] * rodsym[2] - rod[2] * rodsym[1])) / denom;
+      double rc2 = (rod[1] + rodsym[1] - (rod[2] * rodsym[0] - rod[0] * rodsym[2])) / denom;
+      double rc3 = (rod[2] + rodsym[2] - (rod[0] * rodsym[1] - rod[1] * rodsym[0])) / denom;
+      double dist = rc1 * rc1 + rc2 * rc2 + rc3 * rc3;
+      if(dist < smallestdist)
+      {
+        smallestdist = dist;
+        outRod[0] = rc1;
+        outRod[1] = rc2;
+        outRod[2] = rc3;
+      }
+    }
+    double mag = std::sqrt(outRod[0] * outRod[0] + outRod[1] * outRod[1] + outRod[2] * outRod[2]);
+    if(mag == 0.0f)
+    {
+      outRod[3] = std::numeric_limits<double>::infinity();
+    }
+    else
+    {
+      outRod[3] = mag;
+      outRod[0] = outRod[0] / outRod[3];
+      outRod[1] = outRod[1] / outRod[3];
+      outRod[2] = outRod[2] / outRod[3];
+    }
+    return outRod;
+  }
+
+  /**
+   * @brief Returns the misorientation between two quaternions as an Axis Angle. Groups with a
+   * closed form solution use it, all others search the symmetry operators the same way as
+   * LaueOps::calculateMisorientationInternal.
+   */
+  static inline OrientationD calculateMisorientation(const QuatD& q1, const QuatD& q2)
+  {
+    if constexpr(Group::k_ClosedFormMisorientation)
+    {
+      return Group::calculateMisorientation(q1, q2);
+    }
+    else
+    {
+      OrientationD axisAngleMin(0.0, 0.0, 0.0, std::numeric_limits<double>::max());
+      QuatD qr = q1 * (q2.conjugate());
+      for(size_t i = 0; i < k_SymOpsCount; i++)
+      {
+        QuatD qc = getQuatSymOp(i) * qr;
+        if(qc.w() < -1)
+        {
+          qc.w() = -1.0;
+        }
+        else if(qc.w() > 1)
+        {
+          qc.w() = 1.0;
+        }
+
+        OrientationD axisAngle = OrientationTransformation::qu2ax<QuatD, OrientationType>(qc);
+        if(axisAngle[3] > EbsdLib::Constants::k_PiD)
+        {
+          axisAngle[3] = EbsdLib::Constants::k_2PiD - axisAngle[3];
+        }
+        if(axisAngle[3] < axisAngleMin[3])
+        {
+          axisAngleMin = axisAngle;
+        }
+      }
+      double denom = std::sqrt((axisAngleMin[0] * axisAngleMin[0] + axisAngleMin[1] * axisAngleMin[1] + axisAngleMin[2] * axisAngleMin[2]));
+      axisAngleMin[0] = axisAngleMin[0] / denom;
+      axisAngleMin[1] = axisAngleMin[1] / denom;
+      axisAngleMin[2] = axisAngleMin[2] / denom;
+      if(denom == 0.0 || axisAngleMin[3] == 0.0)
+      {
+        axisAngleMin[0] = 0.0;
+        axisAngleMin[1] = 0.0;
+        axisAngleMin[2] = 1.0;
+      }
+      return axisAngleMin;
+    }
+  }
+
+  /**
+   * @brief Returns the largest chi of the cubic standard triangle for the given eta (radians)
+   */
+  static inline double cubicChiMax(double eta)
+  {
+    double etaDeg = eta * EbsdLib::Constants::k_180OverPiD;
+    double chiMax;
+    if(etaDeg > Group::k_EtaMax)
+    {
+      chiMax = std::sqrt(1.0 / (2.0 + std::tan(0.5 * EbsdLib::Constants::k_PiD - eta) * std::tan(0.5 * EbsdLib::Constants::k_PiD - eta)));
+    }
+    else
+    {
+      chiMax = std::sqrt(1.0 / (2.0 + std::tan(eta) * std::tan(eta)));
+    }
+    EbsdLibMath::bound(chiMax, -1.0, 1.0);
+    return std::acos(chiMax);
+  }
+
+  /**
+   * @brief Returns the eta min, eta max and chi max (radians) used to color an IPF direction
+   */
+  static inline std::array<double, 3> getIpfColorAngleLimits(double eta)
+  {
+    if constexpr(Group::k_CubicIpfTriangle)
+    {
+      return {Group::k_EtaMin * EbsdLib::Constants::k_DegToRadD, Group::k_EtaMax * EbsdLib::Constants::k_DegToRadD, cubicChiMax(eta)};
+    }
+    else
+    {
+      return {Group::k_EtaMin * EbsdLib::Constants::k_DegToRadD, Group::k_EtaMax * EbsdLib::Constants::k_DegToRadD, Group::k_ChiMax * EbsdLib::Constants::k_DegToRadD};
+    }
+  }
+
+  /**
+   * @brief Returns true if the direction given by eta and chi (radians) lies in the standard triangle
+   */
+  static inline bool inUnitTriangle(double eta, double chi)
+  {
+    if constexpr(Group::k_CubicIpfTriangle)
+    {
+      return !(eta < Group::k_EtaMin || eta > (Group::k_EtaMax * EbsdLib::Constants::k_PiOver180D) || chi < 0.0 || chi > cubicChiMax(eta));
+    }
+    else
+    {
+      return !(eta < (Group::k_EtaMin * EbsdLib::Constants::k_PiOver180D) || eta > (Group::k_EtaMax * EbsdLib::Constants::k_PiOver180D) || chi < 0 ||
+               chi > (Group::k_ChiMax * EbsdLib::Constants::k_PiOver180D));
+    }
+  }
+
+  /**
+   * @brief Returns the IPF color of an orientation for a reference direction. Mirrors LaueOps::computeIPFColor.
+   * @param eulers The Euler angles
+   * @param refDir The sample reference direction
+   * @param degToRad If true the Euler angles are converted from degrees to radians
+   */
+  static inline EbsdLib::Rgb generateIPFColor(const double* eulers, const double* refDir, bool degToRad)
+  {
+    Euler<double> eu(eulers);
+    if(degToRad)
+    {
+      eu[0] = eu[0] * EbsdLib::Constants::k_DegToRadD;
+      eu[1] = eu[1] * EbsdLib::Constants::k_DegToRadD;
+      eu[2] = eu[2] * EbsdLib::Constants::k_DegToRadD;
+    }
+    QuatD q1 = OrientationTransformation::eu2qu<Euler<double>, QuatD>(eu);
+    return generateIPFColor(q1, EbsdLib::Matrix3X1D(refDir[0], refDir[1], refDir[2]));
+  }
+
+  /**
+   * @brief Returns the IPF color of an orientation given as a quaternion
+   * @param q1 The orientation
+   * @param refDirection The sample reference direction
+   */
+  static inline EbsdLib::Rgb generateIPFColor(const QuatD& q1, const EbsdLib::Matrix3X1D& refDirection)
+  {
+    double chi = 0.0f;
+    double eta = 0.0f;
+    for(size_t j = 0; j < k_SymOpsCount; j++)
+    {
+      QuatD qu = getQuatSymOp(j) * q1;
+      EbsdLib::Matrix3X3D g(OrientationTransformation::qu2om<QuatD, OrientMatrix<double>>(qu).data());
+      if(toStandardTriangle((g * refDirection).normalize(), eta, chi))
+      {
+        break;
+      }
+    }
+    return ipfColorFromAngles(eta, chi);
+  }
+
+  /**
+   * @brief Returns the IPF color of a crystal direction, i.e. a sample reference direction that has
+   * already been rotated into the crystal frame (g * refDir). The color only depends on this direction
+   * so it is what IPF lookup tables are built from. Matches generateIPFColor up to round off.
+   * @param crystalDirection The direction in the crystal frame
+   */
+  static inline EbsdLib::Rgb generateIPFColorFromDirection(const EbsdLib::Matrix3X1D& crystalDirection)
+  {
+    double chi = 0.0f;
+    double eta = 0.0f;
+    for(size_t j = 0; j < k_SymOpsCount; j++)
+    {
+      EbsdLib::Matrix3X3D s(OrientationTransformation::qu2om<QuatD, OrientMatrix<double>>(getQuatSymOp(j)).data());
+      if(toStandardTriangle((s * crystalDirection).normalize(), eta, chi))
+      {
+        break;
+      }
+    }
+    return ipfColorFromAngles(eta, chi);
+  }
+
+private:
+  /**
+   * @brief Computes eta and chi (radians) of a unit direction and returns true if it lies in the standard triangle
+   */
+  static inline bool toStandardTriangle(EbsdLib::Matrix3X1D p, double& eta, double& chi)
+  {
+    // Every Laue class has inversion symmetry
+    if(p[2] < 0)
+    {
+      p = p * -1.0;
+    }
+    chi = std::acos(p[2]);
+    eta = std::atan2(p[1], p[0]);
+    return inUnitTriangle(eta, chi);
+  }
+
+  /**
+   * @brief Converts the eta and chi (radians) of a direction in the standard triangle into its IPF color
+   */
+  static inline EbsdLib::Rgb ipfColorFromAngles(double eta, double chi)
+  {
+    double _rgb[3] = {0.0, 0.0, 0.0};
+    std::array<double, 3> angleLimits = getIpfColorAngleLimits(eta);
+
+    _rgb[0] = 1.0 - chi / angleLimits[2];
+    _rgb[2] = std::fabs(eta - angleLimits[0]) / (angleLimits[1] - angleLimits[0]);
+    _rgb[1] = 1 - _rgb[2];
+    _rgb[1] *= chi / angleLimits[2];
+    _rgb[2] *= chi / angleLimits[2];
+    _rgb[0] = std::sqrt(_rgb[0]);
+    _rgb[1] = std::sqrt(_rgb[1]);
+    _rgb[2] = std::sqrt(_rgb[2]);
+
+    double max = _rgb[0];
+    if(_rgb[1] > max)
+    {
+      max = _rgb[1];
+    }
+    if(_rgb[2] > max)
+    {
+      max = _rgb[2];
+    }
+
+    _rgb[0] = _rgb[0] / max;
+    _rgb[1] = _rgb[1] / max;
+    _rgb[2] = _rgb[2] / max;
+
+    return EbsdLib::RgbColor::dRgb(static_cast<int32_t>(_rgb[0] * 255), static_cast<int32_t>(_rgb[1] * 255), static_cast<int32_t>(_rgb[2] * 255), 255);
+  }
+};
+
+namespace LaueKernels
+{
+/**
+ * @brief Calls f with the LaueKernel for the given Laue class index, so the symmetry is resolved once
+ * for a whole batch instead of once per orientation. The index follows LaueOps::GetAllOrientationOps().
+ * @code
+ *   LaueKernels::visit(laueIndex, [&](auto kernel) {
+ *     for(size_t i = 0; i < count; i++) { fzQuats[i] = kernel.getFZQuat(quats[i]); }
+ *   });
+ * @endcode
+ * @param laueIndex The Laue class index, i.e. EbsdLib::CrystalStructure
+ * @param f A callable that accepts any LaueKernel<Group> by value. All instantiations must return the same type.
+ */
+template <typename Function>
+decltype(auto) visit(uint32_t laueIndex, Function&& f)
+{
+  switch(laueIndex)
+  {
+  case EbsdLib::CrystalStructure::Hexagonal_High:
+    return f(LaueKernel<HexagonalHigh>{});
+  case EbsdLib::CrystalStructure::Cubic_High:
+    return f(LaueKernel<CubicHigh>{});
+  case EbsdLib::CrystalStructure::Hexagonal_Low:
+    return f(LaueKernel<HexagonalLow>{});
+  case EbsdLib::CrystalStructure::Cubic_Low:
+    return f(LaueKernel<CubicLow>{});
+  case EbsdLib::CrystalStructure::Triclinic:
+    return f(LaueKernel<Triclinic>{});
+  case EbsdLib::CrystalStructure::Monoclinic:
+    return f(LaueKernel<Monoclinic>{});
+  case EbsdLib::CrystalStructure::OrthoRhombic:
+  case EbsdLib::CrystalStructure::LaueGroupEnd: // Axis OrthoRhombic, see LaueOps::GetAllOrientationOps()
+    return f(LaueKernel<OrthoRhombic>{});
+  case EbsdLib::CrystalStructure::Tetragonal_Low:
+    return f(LaueKernel<TetragonalLow>{});
+  case EbsdLib::CrystalStructure::Tetragonal_High:
+    return f(LaueKernel<TetragonalHigh>{});
+  case EbsdLib::CrystalStructure::Trigonal_Low:
+    return f(LaueKernel<TrigonalLow>{});
+  case EbsdLib::CrystalStructure::Trigonal_High:
+    return f(LaueKernel<TrigonalHigh>{});
+  default:
+    break;
+  }
+  throw std::out_of_range("LaueKernels::visit: Laue class index " + std::to_string(laueIndex) + " is not a valid Laue class.");
+}
+} // namespace LaueKernels
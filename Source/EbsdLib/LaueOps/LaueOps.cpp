@@ -35,7 +35,8 @@
 
 #include "LaueOps.h"
 
-#include <chrono>
+#include <algorithm>
+#include <cmath>
 #include <exception>
 #include <limits>
 #include <random>
@@ -54,7 +55,10 @@
 #include "EbsdLib/LaueOps/TrigonalLowOps.h"
 #include "EbsdLib/LaueOps/TrigonalOps.h"
 #include "EbsdLib/Math/EbsdLibRandom.h"
+#include "EbsdLib/Math/Philox.hpp"
+#include "EbsdLib/Math/RandomService.h"
 #include "EbsdLib/Utilities/ColorTable.h"
+#include "EbsdLib/Utilities/ParallelDataAlgorithm.hpp"
 
 /**
 | Index | Verified | Class           | Group | Num Sym Ops |
@@ -117,13 +121,12 @@ EbsdLib::Rgb LaueOps::computeIPFColor(double* eulers, double* refDir, bool degTo
     eu[1] = eu[1] * EbsdLib::Constants::k_DegToRadD;
     eu[2] = eu[2] * EbsdLib::Constants::k_DegToRadD;
   }
-  OrientationType om(9); // Reusable for the loop
   QuatD q1 = OrientationTransformation::eu2qu<OrientationType, QuatD>(eu);
 
   for(int j = 0; j < getNumSymOps(); j++)
   {
     QuatD qu = getQuatSymOp(j) * q1;
-    EbsdLib::Matrix3X3D g(OrientationTransformation::qu2om<QuatD, OrientationType>(qu).data());
+    EbsdLib::Matrix3X3D g(OrientationTransformation::qu2om<QuatD, OrientMatrix<double>>(qu).data());
     EbsdLib::Matrix3X1D p = (g * refDirection).normalize();
 
     if(!getHasInversion() && p[2] < 0)
@@ -224,6 +227,249 @@ OrientationD LaueOps::calculateMisorientationInternal(const std::vector<QuatD>&
   return axisAngleMin;
 }
 
+namespace
+{
+/**
+ * @brief CalculateMisorientationsImpl computes the misorientation for a range of quaternion pairs. The
+ * symmetry operators are held as separate x, y, z and w arrays so that the w component of every
+ * symmetrically equivalent misorientation can be computed in a single vectorized loop. Only the
+ * operator with the smallest misorientation angle (largest |w|) is then converted to an Axis Angle,
+ * with the same steps as LaueOps::calculateMisorientationInternal.
+ */
+template <typename T>
+class CalculateMisorientationsImpl
+{
+public:
+  CalculateMisorientationsImpl(const LaueOps* ops, bool closedForm, const T* q1, const T* q2, T* axisAngles)
+  : m_Ops(ops)
+  , m_ClosedForm(closedForm)
+  , m_Q1(q1)
+  , m_Q2(q2)
+  , m_AxisAngles(axisAngles)
+  {
+    const size_t numSym = static_cast<size_t>(ops->getNumSymOps());
+    m_SymX.resize(numSym);
+    m_SymY.resize(numSym);
+    m_SymZ.resize(numSym);
+    m_SymW.resize(numSym);
+    for(size_t i = 0; i < numSym; i++)
+    {
+      QuatD sym = ops->getQuatSymOp(static_cast<int>(i));
+      m_SymX[i] = sym.x();
+      m_SymY[i] = sym.y();
+      m_SymZ[i] = sym.z();
+      m_SymW[i] = sym.w();
+    }
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    const size_t numSym = m_SymW.size();
+    std::vector<double> absW(numSym, 0.0);
+    const double* symX = m_SymX.data();
+    const double* symY = m_SymY.data();
+    const double* symZ = m_SymZ.data();
+    const double* symW = m_SymW.data();
+    double* absWPtr = absW.data();
+
+    for(size_t i = start; i < end; i++)
+    {
+      const T* a = m_Q1 + i * 4;
+      const T* b = m_Q2 + i * 4;
+      T* out = m_AxisAngles + i * 4;
+      QuatD q1(a[0], a[1], a[2], a[3]);
+      QuatD q2(b[0], b[1], b[2], b[3]);
+
+      if(m_ClosedForm)
+      {
+        OrientationD axisAngle = m_Ops->calculateMisorientation(q1, q2);
+        for(size_t c = 0; c < 4; c++)
+        {
+          out[c] = static_cast<T>(axisAngle[c]);
+        }
+        continue;
+      }
+
+      const QuatD qr = q1 * (q2.conjugate());
+      const double rx = qr.x();
+      const double ry = qr.y();
+      const double rz = qr.z();
+      const double rw = qr.w();
+      // w of (symmetry operator * qr) for every operator; the angle is 2 * acos(min(|w|, 1))
+      for(size_t s = 0; s < numSym; s++)
+      {
+        absWPtr[s] = std::min(std::fabs(rw * symW[s] - rx * symX[s] - ry * symY[s] - rz * symZ[s]), 1.0);
+      }
+      size_t best = 0;
+      for(size_t s = 1; s < numSym; s++)
+      {
+        if(absWPtr[s] > absWPtr[best])
+        {
+          best = s;
+        }
+      }
+
+      QuatD qc = QuatD(symX[best], symY[best], symZ[best], symW[best]) * qr;
+      if(qc.w() < -1)
+      {
+        qc.w() = -1.0;
+      }
+      else if(qc.w() > 1)
+      {
+        qc.w() = 1.0;
+      }
+      AxisAngle<double> axisAngle = OrientationTransformation::qu2ax<QuatD, AxisAngle<double>>(qc);
+      if(axisAngle[3] > EbsdLib::Constants::k_PiD)
+      {
+        axisAngle[3] = EbsdLib::Constants::k_2PiD - axisAngle[3];
+      }
+      double denom = sqrt((axisAngle[0] * axisAngle[0] + axisAngle[1] * axisAngle[1] + axisAngle[2] * axisAngle[2]));
+      axisAngle[0] = axisAngle[0] / denom;
+      axisAngle[1] = axisAngle[1] / denom;
+      axisAngle[2] = axisAngle[2] / denom;
+      if(denom == 0.0 || axisAngle[3] == 0.0)
+      {
+        axisAngle[0] = 0.0;
+        axisAngle[1] = 0.0;
+        axisAngle[2] = 1.0;
+      }
+      for(size_t c = 0; c < 4; c++)
+      {
+        out[c] = static_cast<T>(axisAngle[c]);
+      }
+    }
+  }
+
+private:
+  const LaueOps* m_Ops = nullptr;
+  bool m_ClosedForm = false;
+  const T* m_Q1 = nullptr;
+  const T* m_Q2 = nullptr;
+  T* m_AxisAngles = nullptr;
+  std::vector<double> m_SymX;
+  std::vector<double> m_SymY;
+  std::vector<double> m_SymZ;
+  std::vector<double> m_SymW;
+};
+
+/**
+ * @brief RandomizeEulerAnglesImpl applies a random symmetry operator to a range of Euler angles,
+ * drawing like the samples of EbsdLib::RandomService::k_SampleBlockSize.
+ */
+template <typename T>
+class RandomizeEulerAnglesImpl
+{
+public:
+  RandomizeEulerAnglesImpl(const LaueOps* ops, const T* eulers, T* output, uint64_t seed)
+  : m_Eulers(eulers)
+  , m_Output(output)
+  , m_Seed(seed)
+  {
+    const int numSym = ops->getNumSymOps();
+    m_SymOps.reserve(static_cast<size_t>(numSym));
+    for(int i = 0; i < numSym; i++)
+    {
+      m_SymOps.push_back(ops->getQuatSymOp(i));
+    }
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      EbsdLib::PhiloxEngine generator(m_Seed, i);
+      const T* e = m_Eulers + i * 3;
+      Euler<double> eu(static_cast<double>(e[0]), static_cast<double>(e[1]), static_cast<double>(e[2]));
+      QuatD qc = m_SymOps[generator.nextIndex(m_SymOps.size())] * OrientationTransformation::eu2qu<Euler<double>, QuatD>(eu);
+      eu = OrientationTransformation::qu2eu<QuatD, Euler<double>>(qc);
+      T* out = m_Output + i * 3;
+      out[0] = static_cast<T>(eu[0]);
+      out[1] = static_cast<T>(eu[1]);
+      out[2] = static_cast<T>(eu[2]);
+    }
+  }
+
+private:
+  const T* m_Eulers = nullptr;
+  T* m_Output = nullptr;
+  uint64_t m_Seed = 0;
+  std::vector<QuatD> m_SymOps;
+};
+
+template <typename T>
+void RandomizeEulerAnglesBatch(const LaueOps* ops, const T* eulers, T* output, size_t count, uint64_t seed)
+{
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, count);
+  dataAlg.setGrain(EbsdLib::RandomService::k_SampleBlockSize);
+  dataAlg.execute(RandomizeEulerAnglesImpl<T>(ops, eulers, output, seed));
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+void LaueOps::calculateMisorientations(const double* q1, const double* q2, double* axisAngles, size_t count) const
+{
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, count);
+  dataAlg.setGrain(1024);
+  dataAlg.execute(CalculateMisorientationsImpl<double>(this, hasClosedFormMisorientation(), q1, q2, axisAngles));
+}
+
+// -----------------------------------------------------------------------------
+void LaueOps::calculateMisorientations(const float* q1, const float* q2, float* axisAngles, size_t count) const
+{
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, count);
+  dataAlg.setGrain(1024);
+  dataAlg.execute(CalculateMisorientationsImpl<float>(this, hasClosedFormMisorientation(), q1, q2, axisAngles));
+}
+
+// -----------------------------------------------------------------------------
+void LaueOps::randomizeEulerAnglesBatch(const double* eulers, double* output, size_t count, uint64_t seed) const
+{
+  RandomizeEulerAnglesBatch(this, eulers, output, count, seed);
+}
+
+// -----------------------------------------------------------------------------
+void LaueOps::randomizeEulerAnglesBatch(const float* eulers, float* output, size_t count, uint64_t seed) const
+{
+  RandomizeEulerAnglesBatch(this, eulers, output, count, seed);
+}
+
+// -----------------------------------------------------------------------------
+void LaueOps::randomizeEulerAnglesBatch(const double* eulers, double* output, size_t count) const
+{
+  RandomizeEulerAnglesBatch(this, eulers, output, count, EbsdLib::RandomService::GetThreadEngine()());
+}
+
+// -----------------------------------------------------------------------------
+void LaueOps::randomizeEulerAnglesBatch(const float* eulers, float* output, size_t count) const
+{
+  RandomizeEulerAnglesBatch(this, eulers, output, count, EbsdLib::RandomService::GetThreadEngine()());
+}
+
+// -----------------------------------------------------------------------------
+std::array<size_t, 3> LaueOps::getPoleFigureFamilySizes() const
+{
+  std::vector<size_t> cDims(1, 3);
+  EbsdLib::FloatArrayType::Pointer eulers = EbsdLib::FloatArrayType::CreateArray(1, cDims, "Eulers", true);
+  eulers->initializeWithZeros();
+  std::array<EbsdLib::FloatArrayType::Pointer, 3> xyz;
+  for(auto& coords : xyz)
+  {
+    coords = EbsdLib::FloatArrayType::CreateArray(0, cDims, "xyzCoords", true);
+  }
+  generateSphereCoordsFromEulers(eulers.get(), xyz[0].get(), xyz[1].get(), xyz[2].get());
+  // generateSphereCoordsFromEulers resizes each array to 3 tuples per direction, see CubicOps
+  return {xyz[0]->getNumberOfTuples() / 3, xyz[1]->getNumberOfTuples() / 3, xyz[2]->getNumberOfTuples() / 3};
+}
+
+// -----------------------------------------------------------------------------
+bool LaueOps::hasClosedFormMisorientation() const
+{
+  return false;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -234,7 +480,7 @@ OrientationType LaueOps::_calcRodNearestOrigin(const std::vector<OrientationD>&
   double rc1 = 0.0f, rc2 = 0.0f, rc3 = 0.0f;
   OrientationType outRod(4, 0.0f);
   // Turn into an actual 3 Comp Rodrigues Vector
-  OrientationType rod = inRod;
+  Rodrigues<double> rod(inRod.data());
   rod[0] *= rod[3];
   rod[1] *= rod[3];
   rod[2] *= rod[3];
@@ -502,16 +748,16 @@ std::vector<std::string> LaueOps::GetLaueNames()
 // -----------------------------------------------------------------------------
 size_t LaueOps::getRandomSymmetryOperatorIndex(int numSymOps) const
 {
+  return getRandomSymmetryOperatorIndex(numSymOps, EbsdLib::RandomService::GetThreadEngine());
+}
 
+// -----------------------------------------------------------------------------
+size_t LaueOps::getRandomSymmetryOperatorIndex(int numSymOps, EbsdLib::RandomService::EngineType& generator) const
+{
   using SizeTDistributionType = std::uniform_int_distribution<size_t>;
 
   const SizeTDistributionType::result_type rangeMin = 0;
   const SizeTDistributionType::result_type rangeMax = static_cast<SizeTDistributionType::result_type>(numSymOps - 1);
-
-  std::random_device randomDevice;           // Will be used to obtain a seed for the random number engine
-  std::mt19937_64 generator(randomDevice()); // Standard mersenne_twister_engine seeded with rd()
-  std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-  generator.seed(seed);
   SizeTDistributionType distribution(rangeMin, rangeMax);
 
   size_t symOp = distribution(generator); // Random remaining position.
@@ -34,17 +34,20 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #pragma once
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "EbsdLib/Core/EbsdDataArray.hpp"
+#include "EbsdLib/Core/FixedOrientation.hpp"
 #include "EbsdLib/Core/Orientation.hpp"
 #include "EbsdLib/Core/OrientationTransformation.hpp"
 #include "EbsdLib/Core/Quaternion.hpp"
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/Math/Matrix3X1.hpp"
 #include "EbsdLib/Math/Matrix3X3.hpp"
+#include "EbsdLib/Math/RandomService.h"
 #include "EbsdLib/Utilities/PoleFigureUtilities.h"
 
 /*
@@ -162,6 +165,18 @@ public:
    */
   virtual OrientationF calculateMisorientation(const QuatF& q1, const QuatF& q2) const = 0;
 
+  /**
+   * @brief calculateMisorientations Finds the misorientation between each pair of quaternions q1[i], q2[i].
+   * The pairs are processed in parallel and, for each pair, all of the symmetry operators are evaluated
+   * together in one vectorized loop. The results match calculateMisorientation() for every pair.
+   * @param q1 count packed quaternions <x,y,z,w>
+   * @param q2 count packed quaternions <x,y,z,w>
+   * @param axisAngles [output] count packed Axis Angles <x,y,z,angle>
+   * @param count The number of pairs
+   */
+  void calculateMisorientations(const double* q1, const double* q2, double* axisAngles, size_t count) const;
+  void calculateMisorientations(const float* q1, const float* q2, float* axisAngles, size_t count) const;
+
   /**
    * @brief getQuatSymOp Returns the symmetry operator at index i
    * @param i The index into the Symmetry operators array
@@ -223,8 +238,36 @@ public:
 
   virtual OrientationType randomizeEulerAngles(const OrientationType& euler) const = 0;
 
+  /**
+   * @brief randomizeEulerAnglesBatch Applies a randomly chosen symmetry operator to each Euler angle
+   * triplet, like randomizeEulerAngles(). The points are processed in parallel and each point draws
+   * from its own stream of the seed (see EbsdLib::PhiloxEngine), so the result only depends on the
+   * seed and the index of the point and not on the number of threads.
+   * @param eulers count packed Euler angles (radians)
+   * @param output [output] count packed Euler angles. May be the same array as eulers.
+   * @param count The number of Euler angle triplets
+   * @param seed The seed of the random operator choice
+   */
+  void randomizeEulerAnglesBatch(const double* eulers, double* output, size_t count, uint64_t seed) const;
+  void randomizeEulerAnglesBatch(const float* eulers, float* output, size_t count, uint64_t seed) const;
+
+  /**
+   * @brief Same as above with a seed drawn from the engine of the calling thread (see EbsdLib::RandomService)
+   */
+  void randomizeEulerAnglesBatch(const double* eulers, double* output, size_t count) const;
+  void randomizeEulerAnglesBatch(const float* eulers, float* output, size_t count) const;
+
+  /**
+   * @brief getRandomSymmetryOperatorIndex Returns a random index in [0, numSymOps) drawn from the
+   * engine of the calling thread (see EbsdLib::RandomService)
+   */
   virtual size_t getRandomSymmetryOperatorIndex(int numSymOps) const;
 
+  /**
+   * @brief getRandomSymmetryOperatorIndex Returns a random index in [0, numSymOps) drawn from a caller owned engine
+   */
+  size_t getRandomSymmetryOperatorIndex(int numSymOps, EbsdLib::RandomService::EngineType& generator) const;
+
   virtual OrientationType determineRodriguesVector(double random[3], int choose) const = 0;
 
   virtual int getOdfBin(const OrientationType& rod) const = 0;
@@ -306,6 +349,13 @@ public:
    */
   virtual std::array<std::string, 3> getDefaultPoleFigureNames() const = 0;
 
+  /**
+   * @brief Returns the number of sphere directions that generateSphereCoordsFromEulers creates per orientation for each
+   * of the three pole figures. The default implementation measures them by generating the directions of one orientation;
+   * subclasses that know their sizes return them directly.
+   */
+  virtual std::array<size_t, 3> getPoleFigureFamilySizes() const;
+
   /**
    * @brief generateStandardTriangle Generates an RGBA array that is a color "Standard" IPF Triangle Legend used for IPF Color Maps.
    * @return
@@ -325,6 +375,13 @@ protected:
    */
   virtual OrientationD calculateMisorientationInternal(const std::vector<QuatD>& quatsym, const QuatD& q1, const QuatD& q2) const;
 
+  /**
+   * @brief hasClosedFormMisorientation Returns true if the subclass overrides calculateMisorientationInternal
+   * with a closed form that does not search the symmetry operators. calculateMisorientations then uses
+   * that closed form for every pair.
+   */
+  virtual bool hasClosedFormMisorientation() const;
+
   OrientationType _calcRodNearestOrigin(const std::vector<OrientationD>& rodsym, const OrientationType& rod) const;
 
   QuatD _calcNearestQuat(const std::vector<QuatD>& quatsym, const QuatD& q1, const QuatD& q2) const;
@@ -39,16 +39,16 @@
 #include <tbb/parallel_for.h>
 #include <tbb/partitioner.h>
 #include <tbb/task.h>
-#include <tbb/task_group.h>
 #endif
 
 // Include this FIRST because there is a needed define for some compiles
 // to expose some of the constants needed below
 #include "EbsdLib/Core/EbsdMacros.h"
 #include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/LaueOps/LaueKernel.hpp"
+#include "EbsdLib/LaueOps/PoleFigureAccumulator.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
 #include "EbsdLib/Utilities/ColorTable.h"
-#include "EbsdLib/Utilities/ComputeStereographicProjection.h"
 #include "EbsdLib/Utilities/EbsdStringUtils.hpp"
 #include "EbsdLib/Utilities/PoleFigureUtilities.h"
 
@@ -72,19 +72,11 @@ static const int k_SymOpsCount = 4;
 static const int k_NumMdfBins = 36;
 // Rotation Point Group: 222
 // clang-format off
-static const std::vector<QuatD> QuatSym ={
-    QuatD(0.0, 0.0, 0.0, 1.0),
-    QuatD(1.0, 0.0, 0.0, 0.0),
-    QuatD(0.0, 1.0, 0.0, 0.0),
-    QuatD(0.0, 0.0, 1.0, 0.0),
-};
+using Kernel = LaueKernel<LaueKernels::OrthoRhombic>;
 
-static const std::vector<OrientationD> RodSym = {
-    {0.0, 0.0, 1.0, 0.0},
-    {1.0, 0.0, 0.0, 10000000000000.0},
-    {0.0, 1.0, 0.0, 10000000000000.0},
-    {0.0, 0.0, 1.0, 10000000000000.0},
-};
+static const std::vector<QuatD> QuatSym = Kernel::QuatSymTable();
+
+static const std::vector<OrientationD> RodSym = Kernel::RodSymTable();
 
 static const double MatSym[k_SymOpsCount][3][3] = {
     {{1.0, 0.0, 0.0},
@@ -105,9 +97,6 @@ static const double MatSym[k_SymOpsCount][3][3] = {
     
 };
 // clang-format on
-static const double k_EtaMin = 0.0;
-static const double k_EtaMax = 90.0;
-static const double k_ChiMax = 90.0;
 } // namespace OrthoRhombic
 
 // -----------------------------------------------------------------------------
@@ -188,7 +177,7 @@ std::string OrthoRhombicOps::getRotationPointGroup() const
 
 OrientationD OrthoRhombicOps::calculateMisorientation(const QuatD& q1, const QuatD& q2) const
 {
-  return calculateMisorientationInternal(OrthoRhombic::QuatSym, q1, q2);
+  return OrthoRhombic::Kernel::calculateMisorientation(q1, q2);
 }
 
 // -----------------------------------------------------------------------------
@@ -197,7 +186,7 @@ OrientationF OrthoRhombicOps::calculateMisorientation(const QuatF& q1f, const Qu
 {
   QuatD q1 = q1f.to<double>();
   QuatD q2 = q2f.to<double>();
-  OrientationD axisAngle = calculateMisorientationInternal(OrthoRhombic::QuatSym, q1, q2);
+  OrientationD axisAngle = OrthoRhombic::Kernel::calculateMisorientation(q1, q2);
   return axisAngle;
 }
 
@@ -257,7 +246,7 @@ void OrthoRhombicOps::getMatSymOp(int i, float g[3][3]) const
 // -----------------------------------------------------------------------------
 OrientationType OrthoRhombicOps::getODFFZRod(const OrientationType& rod) const
 {
-  return _calcRodNearestOrigin(OrthoRhombic::RodSym, rod);
+  return OrthoRhombic::Kernel::getODFFZRod(rod);
 }
 
 // -----------------------------------------------------------------------------
@@ -269,8 +258,8 @@ OrientationType OrthoRhombicOps::getMDFFZRod(const OrientationType& inRod) const
 
   double FZn1 = 0.0f, FZn2 = 0.0f, FZn3 = 0.0f, FZw = 0.0f;
 
-  OrientationType rod = _calcRodNearestOrigin(OrthoRhombic::RodSym, inRod);
-  OrientationType ax = OrientationTransformation::ro2ax<OrientationType, OrientationType>(rod);
+  OrientationType rod = OrthoRhombic::Kernel::getODFFZRod(inRod);
+  AxisAngle<double> ax = OrientationTransformation::ro2ax<OrientationType, AxisAngle<double>>(rod);
   //  double n1 = ax[0];
   //  double n2 = ax[1];
   //  double n3 = ax[2];
@@ -278,7 +267,7 @@ OrientationType OrthoRhombicOps::getMDFFZRod(const OrientationType& inRod) const
 
   /// FIXME: Are we missing code for OrthoRhombic MDF FZ Rodrigues calculation?
 
-  return OrientationTransformation::ax2ro<OrientationType, OrientationType>(OrientationType(FZn1, FZn2, FZn3, FZw));
+  return OrientationTransformation::ax2ro<AxisAngle<double>, OrientationType>(AxisAngle<double>(FZn1, FZn2, FZn3, FZw));
 }
 
 // -----------------------------------------------------------------------------
@@ -296,7 +285,7 @@ QuatF OrthoRhombicOps::getNearestQuat(const QuatF& q1f, const QuatF& q2f) const
 
 QuatD OrthoRhombicOps::getFZQuat(const QuatD& qr) const
 {
-  return _calcQuatNearestOrigin(OrthoRhombic::QuatSym, qr);
+  return OrthoRhombic::Kernel::getFZQuat(qr);
 }
 
 // -----------------------------------------------------------------------------
@@ -344,11 +333,11 @@ OrientationType OrthoRhombicOps::determineEulerAngles(double random[3], int choo
 
   _calcDetermineHomochoricValues(random, init, step, phi, h1, h2, h3);
 
-  OrientationType ho(h1, h2, h3);
-  OrientationType ro = OrientationTransformation::ho2ro<OrientationType, OrientationType>(ho);
+  Homochoric<double> ho(h1, h2, h3);
+  OrientationType ro = OrientationTransformation::ho2ro<Homochoric<double>, OrientationType>(ho);
   ro = getODFFZRod(ro);
-  OrientationType eu = OrientationTransformation::ro2eu<OrientationType, OrientationType>(ro);
-  return eu;
+  Euler<double> eu = OrientationTransformation::ro2eu<OrientationType, Euler<double>>(ro);
+  return {eu[0], eu[1], eu[2]};
 }
 
 // -----------------------------------------------------------------------------
@@ -383,8 +372,8 @@ OrientationType OrthoRhombicOps::determineRodriguesVector(double random[3], int
   phi[2] = static_cast<int32_t>(choose / (OrthoRhombic::OdfNumBins[0] * OrthoRhombic::OdfNumBins[1]));
 
   _calcDetermineHomochoricValues(random, init, step, phi, h1, h2, h3);
-  OrientationType ho(h1, h2, h3);
-  OrientationType ro = OrientationTransformation::ho2ro<OrientationType, OrientationType>(ho);
+  Homochoric<double> ho(h1, h2, h3);
+  OrientationType ro = OrientationTransformation::ho2ro<Homochoric<double>, OrientationType>(ho);
   ro = getMDFFZRod(ro);
   return ro;
 }
@@ -593,7 +582,7 @@ void OrthoRhombicOps::generateSphereCoordsFromEulers(EbsdLib::FloatArrayType* eu
 // -----------------------------------------------------------------------------
 std::array<double, 3> OrthoRhombicOps::getIpfColorAngleLimits(double eta) const
 {
-  return {OrthoRhombic::k_EtaMin * EbsdLib::Constants::k_DegToRadD, OrthoRhombic::k_EtaMax * EbsdLib::Constants::k_DegToRadD, OrthoRhombic::k_ChiMax * EbsdLib::Constants::k_DegToRadD};
+  return OrthoRhombic::Kernel::getIpfColorAngleLimits(eta);
 }
 
 // -----------------------------------------------------------------------------
@@ -601,8 +590,7 @@ std::array<double, 3> OrthoRhombicOps::getIpfColorAngleLimits(double eta) const
 // -----------------------------------------------------------------------------
 bool OrthoRhombicOps::inUnitTriangle(double eta, double chi) const
 {
-  return !(eta < (OrthoRhombic::k_EtaMin * EbsdLib::Constants::k_PiOver180D) || eta > (OrthoRhombic::k_EtaMax * EbsdLib::Constants::k_PiOver180D) || chi < 0 ||
-           chi > (OrthoRhombic::k_ChiMax * EbsdLib::Constants::k_PiOver180D));
+  return OrthoRhombic::Kernel::inUnitTriangle(eta, chi);
 }
 
 // -----------------------------------------------------------------------------
@@ -610,7 +598,7 @@ bool OrthoRhombicOps::inUnitTriangle(double eta, double chi) const
 // -----------------------------------------------------------------------------
 EbsdLib::Rgb OrthoRhombicOps::generateIPFColor(double* eulers, double* refDir, bool degToRad) const
 {
-  return computeIPFColor(eulers, refDir, degToRad);
+  return OrthoRhombic::Kernel::generateIPFColor(eulers, refDir, degToRad);
 }
 
 // -----------------------------------------------------------------------------
@@ -620,7 +608,7 @@ EbsdLib::Rgb OrthoRhombicOps::generateIPFColor(double phi1, double phi, double p
 {
   double eulers[3] = {phi1, phi, phi2};
   double refDir[3] = {refDir0, refDir1, refDir2};
-  return computeIPFColor(eulers, refDir, degToRad);
+  return OrthoRhombic::Kernel::generateIPFColor(eulers, refDir, degToRad);
 }
 
 // -----------------------------------------------------------------------------
@@ -657,156 +645,22 @@ std::array<std::string, 3> OrthoRhombicOps::getDefaultPoleFigureNames() const
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-std::vector<EbsdLib::UInt8ArrayType::Pointer> OrthoRhombicOps::generatePoleFigure(PoleFigureConfiguration_t& config) const
+std::array<size_t, 3> OrthoRhombicOps::getPoleFigureFamilySizes() const
 {
-  std::array<std::string, 3> labels = getDefaultPoleFigureNames();
-  std::string label0 = labels[0];
-  std::string label1 = labels[1];
-  std::string label2 = labels[2];
-
-  if(!config.labels.empty())
-  {
-    label0 = config.labels.at(0);
-  }
-  if(config.labels.size() > 1)
-  {
-    label1 = config.labels.at(1);
-  }
-  if(config.labels.size() > 2)
-  {
-    label2 = config.labels.at(2);
-  }
-
-  size_t numOrientations = config.eulers->getNumberOfTuples();
-
-  // Create an Array to hold the XYZ Coordinates which are the coords on the sphere.
-  std::vector<size_t> dims(1, 3);
-  std::vector<EbsdLib::FloatArrayType::Pointer> coords(3);
-  coords[0] = EbsdLib::FloatArrayType::CreateArray(numOrientations * OrthoRhombic::symSize0, dims, label0 + std::string("001_Coords"), true);
-  coords[1] = EbsdLib::FloatArrayType::CreateArray(numOrientations * OrthoRhombic::symSize1, dims, label1 + std::string("100_Coords"), true);
-  coords[2] = EbsdLib::FloatArrayType::CreateArray(numOrientations * OrthoRhombic::symSize2, dims, label2 + std::string("010_Coords"), true);
-
-  config.sphereRadius = 1.0;
-
-  // Generate the coords on the sphere **** Parallelized
-  generateSphereCoordsFromEulers(config.eulers, coords[0].get(), coords[1].get(), coords[2].get());
-
-  // These arrays hold the "intensity" images which eventually get converted to an actual Color RGB image
-  // Generate the modified Lambert projection images (Squares, 2 of them, 1 for northern hemisphere, 1 for southern hemisphere
-  EbsdLib::DoubleArrayType::Pointer intensity001 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label0 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity100 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label1 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity010 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label2 + "_Intensity_Image", true);
-#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
-  bool doParallel = true;
-
-  if(doParallel)
-  {
-    std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-    g->run(ComputeStereographicProjection(coords[0].get(), &config, intensity001.get()));
-    g->run(ComputeStereographicProjection(coords[1].get(), &config, intensity100.get()));
-    g->run(ComputeStereographicProjection(coords[2].get(), &config, intensity010.get()));
-    g->wait(); // Wait for all the threads to complete before moving on.
-  }
-  else
-#endif
-  {
-    ComputeStereographicProjection m001(coords[0].get(), &config, intensity001.get());
-    m001();
-    ComputeStereographicProjection m011(coords[1].get(), &config, intensity100.get());
-    m011();
-    ComputeStereographicProjection m111(coords[2].get(), &config, intensity010.get());
-    m111();
-  }
-
-  // Find the Max and Min values based on ALL 3 arrays so we can color scale them all the same
-  double max = std::numeric_limits<double>::min();
-  double min = std::numeric_limits<double>::max();
-
-  double* dPtr = intensity001->getPointer(0);
-  size_t count = intensity001->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity100->getPointer(0);
-  count = intensity100->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity010->getPointer(0);
-  count = intensity010->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  config.minScale = min;
-  config.maxScale = max;
-
-  dims[0] = 4;
-  EbsdLib::UInt8ArrayType::Pointer image001 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label0, true);
-  EbsdLib::UInt8ArrayType::Pointer image100 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label1, true);
-  EbsdLib::UInt8ArrayType::Pointer image010 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label2, true);
-
-  std::vector<EbsdLib::UInt8ArrayType::Pointer> poleFigures(3);
-  if(config.order.size() == 3)
-  {
-    poleFigures[config.order[0]] = image001;
-    poleFigures[config.order[1]] = image100;
-    poleFigures[config.order[2]] = image010;
-  }
-  else
-  {
-    poleFigures[0] = image001;
-    poleFigures[1] = image100;
-    poleFigures[2] = image010;
-  }
+  return {OrthoRhombic::symSize0, OrthoRhombic::symSize1, OrthoRhombic::symSize2};
+}
 
-#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
-  if(doParallel)
-  {
-    std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-    g->run(GeneratePoleFigureRgbaImageImpl(intensity001.get(), &config, image001.get()));
-    g->run(GeneratePoleFigureRgbaImageImpl(intensity100.get(), &config, image100.get()));
-    g->run(GeneratePoleFigureRgbaImageImpl(intensity010.get(), &config, image010.get()));
-    g->wait(); // Wait for all the threads to complete before moving on.
-  }
-  else
-#endif
-  {
-    GeneratePoleFigureRgbaImageImpl m001(intensity001.get(), &config, image001.get());
-    m001();
-    GeneratePoleFigureRgbaImageImpl m011(intensity100.get(), &config, image100.get());
-    m011();
-    GeneratePoleFigureRgbaImageImpl m111(intensity010.get(), &config, image010.get());
-    m111();
-  }
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<EbsdLib::UInt8ArrayType::Pointer> OrthoRhombicOps::generatePoleFigure(PoleFigureConfiguration_t& config) const
+{
+  config.sphereRadius = 1.0f;
 
-  return poleFigures;
+  // Project the orientations a chunk at a time and render the three pole figures with one color scale **** Parallelized
+  PoleFigureAccumulator accumulator(*this, config);
+  accumulator.add(*config.eulers);
+  return accumulator.createPoleFigures(config.minScale, config.maxScale);
 }
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,475 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PoleFigureAccumulator.h"
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Utilities/ComputeStereographicProjection.h"
+#include "EbsdLib/Utilities/ParallelDataAlgorithm.hpp"
+
+namespace
+{
+/**
+ * @brief ProjectPoleFigureChunksImpl generates the sphere coordinates of a range of chunks of orientations
+ * and projects them into intensity grids owned by the task. The grids are added to the shared results
+ * once the range is done, so the coordinates of only one chunk per task are ever held. A task that was
+ * given every chunk is the only one and projects straight into the shared grids.
+ */
+class ProjectPoleFigureChunksImpl
+{
+public:
+  ProjectPoleFigureChunksImpl(const LaueOps* ops, const PoleFigureConfiguration_t& config, const float* eulers, size_t numOrientations, const std::array<size_t, 3>& symSizes,
+                              std::array<std::vector<double>, 3>& images, const std::array<ModifiedLambertProjection::Pointer, 3>& lambertSquares, std::mutex& mutex)
+  : m_Ops(ops)
+  , m_Config(config)
+  , m_Eulers(eulers)
+  , m_NumOrientations(numOrientations)
+  , m_SymSizes(symSizes)
+  , m_Images(images)
+  , m_LambertSquares(lambertSquares)
+  , m_Mutex(mutex)
+  {
+  }
+
+  size_t getNumberOfChunks() const
+  {
+    return (m_NumOrientations + PoleFigureAccumulator::k_ChunkSize - 1) / PoleFigureAccumulator::k_ChunkSize;
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    const bool direct = (start == 0 && end == getNumberOfChunks());
+    const size_t imageSize = static_cast<size_t>(m_Config.imageDim * m_Config.imageDim);
+    std::vector<size_t> cDims(1, 3);
+
+    // The grids of this task
+    std::array<std::vector<double>, 3> images;
+    std::array<double*, 3> imagePtrs = {nullptr, nullptr, nullptr};
+    std::array<ModifiedLambertProjection::Pointer, 3> squares;
+    for(size_t family = 0; family < 3; family++)
+    {
+      if(direct)
+      {
+        imagePtrs[family] = m_Images[family].data();
+        squares[family] = m_LambertSquares[family];
+      }
+      else if(m_Config.discrete)
+      {
+        images[family].assign(imageSize, 0.0);
+        imagePtrs[family] = images[family].data();
+      }
+      else
+      {
+        squares[family] = ModifiedLambertProjection::New();
+        squares[family]->initializeSquares(m_Config.lambertDim, m_Config.sphereRadius);
+      }
+    }
+
+    EbsdLib::FloatArrayType::Pointer eulers = EbsdLib::FloatArrayType::CreateArray(PoleFigureAccumulator::k_ChunkSize, cDims, "Eulers", true);
+    std::array<EbsdLib::FloatArrayType::Pointer, 3> xyz;
+    for(size_t family = 0; family < 3; family++)
+    {
+      xyz[family] = EbsdLib::FloatArrayType::CreateArray(PoleFigureAccumulator::k_ChunkSize * m_SymSizes[family], cDims, "xyzCoords", true);
+    }
+
+    for(size_t chunk = start; chunk < end; chunk++)
+    {
+      const size_t first = chunk * PoleFigureAccumulator::k_ChunkSize;
+      const size_t count = std::min(PoleFigureAccumulator::k_ChunkSize, m_NumOrientations - first);
+      if(eulers->getNumberOfTuples() != count)
+      {
+        eulers->resizeTuples(count);
+      }
+      std::copy(m_Eulers + first * 3, m_Eulers + (first + count) * 3, eulers->getPointer(0));
+      m_Ops->generateSphereCoordsFromEulers(eulers.get(), xyz[0].get(), xyz[1].get(), xyz[2].get());
+
+      for(size_t family = 0; family < 3; family++)
+      {
+        const size_t numCoords = count * m_SymSizes[family];
+        if(m_Config.discrete)
+        {
+          ComputeStereographicProjection::AddDiscreteCoordinates(xyz[family]->getPointer(0), numCoords, m_Config.imageDim, imagePtrs[family]);
+        }
+        else
+        {
+          squares[family]->addCoordinates(xyz[family]->getPointer(0), numCoords);
+        }
+      }
+    }
+    if(direct)
+    {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for(size_t family = 0; family < 3; family++)
+    {
+      if(m_Config.discrete)
+      {
+        std::vector<double>& intensity = m_Images[family];
+        for(size_t i = 0; i < imageSize; i++)
+        {
+          intensity[i] += images[family][i];
+        }
+      }
+      else
+      {
+        m_LambertSquares[family]->addProjection(*squares[family]);
+      }
+    }
+  }
+
+private:
+  const LaueOps* m_Ops = nullptr;
+  const PoleFigureConfiguration_t& m_Config;
+  const float* m_Eulers = nullptr;
+  size_t m_NumOrientations = 0;
+  std::array<size_t, 3> m_SymSizes = {0, 0, 0};
+  std::array<std::vector<double>, 3>& m_Images;
+  const std::array<ModifiedLambertProjection::Pointer, 3>& m_LambertSquares;
+  std::mutex& m_Mutex;
+};
+
+// -----------------------------------------------------------------------------
+LaueOps::Pointer GetLaueOps(uint32_t laueIndex)
+{
+  if(laueIndex >= EbsdLib::CrystalStructure::LaueGroupEnd)
+  {
+    throw std::out_of_range("PoleFigureAccumulator: The Laue index " + std::to_string(laueIndex) + " is not a valid Laue class.");
+  }
+  return LaueOps::GetAllOrientationOps()[laueIndex];
+}
+
+// -----------------------------------------------------------------------------
+uint32_t FindLaueIndex(const LaueOps& ops)
+{
+  std::vector<LaueOps::Pointer> allOps = LaueOps::GetAllOrientationOps();
+  for(uint32_t laueIndex = 0; laueIndex < EbsdLib::CrystalStructure::LaueGroupEnd; laueIndex++)
+  {
+    if(allOps[laueIndex]->getNameOfClass() == ops.getNameOfClass())
+    {
+      return laueIndex;
+    }
+  }
+  return EbsdLib::CrystalStructure::UnknownCrystalStructure;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+PoleFigureAccumulator::PoleFigureAccumulator(uint32_t laueIndex, const PoleFigureConfiguration_t& config)
+: m_OwnedOps(GetLaueOps(laueIndex))
+, m_LaueIndex(laueIndex)
+{
+  m_Ops = m_OwnedOps.get();
+  initialize(config);
+}
+
+// -----------------------------------------------------------------------------
+PoleFigureAccumulator::PoleFigureAccumulator(const LaueOps& ops, const PoleFigureConfiguration_t& config)
+: m_Ops(&ops)
+, m_LaueIndex(FindLaueIndex(ops))
+{
+  initialize(config);
+}
+
+// -----------------------------------------------------------------------------
+void PoleFigureAccumulator::initialize(const PoleFigureConfiguration_t& config)
+{
+  m_Config = config;
+  if(m_Config.imageDim <= 0 || (!m_Config.discrete && m_Config.lambertDim <= 0))
+  {
+    throw std::runtime_error("PoleFigureAccumulator: The image and Lambert dimensions must be positive.");
+  }
+  m_Config.eulers = nullptr;
+  // The pole figures are always generated on the unit sphere, see LaueOps::generatePoleFigure
+  m_Config.sphereRadius = 1.0f;
+  m_Labels = m_Ops->getDefaultPoleFigureNames();
+  for(size_t family = 0; family < 3 && family < m_Config.labels.size(); family++)
+  {
+    m_Labels[family] = m_Config.labels[family];
+  }
+  m_SymSizes = m_Ops->getPoleFigureFamilySizes();
+  reset();
+}
+
+// -----------------------------------------------------------------------------
+PoleFigureAccumulator::~PoleFigureAccumulator() = default;
+
+// -----------------------------------------------------------------------------
+size_t PoleFigureAccumulator::getGridSize() const
+{
+  if(m_Config.discrete)
+  {
+    return static_cast<size_t>(m_Config.imageDim) * static_cast<size_t>(m_Config.imageDim);
+  }
+  return 2 * static_cast<size_t>(m_Config.lambertDim) * static_cast<size_t>(m_Config.lambertDim);
+}
+
+// -----------------------------------------------------------------------------
+void PoleFigureAccumulator::checkCompatible(uint32_t laueIndex, bool discrete, int imageDim, int lambertDim, const std::string& caller) const
+{
+  if(laueIndex != m_LaueIndex)
+  {
+    throw std::runtime_error("PoleFigureAccumulator::" + caller + ": The Laue index " + std::to_string(laueIndex) + " does not match " + std::to_string(m_LaueIndex) + ".");
+  }
+  if(discrete != m_Config.discrete)
+  {
+    throw std::runtime_error("PoleFigureAccumulator::" + caller + ": Discrete and Lambert pole figures can not be merged.");
+  }
+  if(imageDim != m_Config.imageDim || lambertDim != m_Config.lambertDim)
+  {
+    throw std::runtime_error("PoleFigureAccumulator::" + caller + ": The image dimension " + std::to_string(imageDim) + " and Lambert dimension " + std::to_string(lambertDim) +
+                             " do not match " + std::to_string(m_Config.imageDim) + " and " + std::to_string(m_Config.lambertDim) + ".");
+  }
+}
+
+// -----------------------------------------------------------------------------
+void PoleFigureAccumulator::reset()
+{
+  m_NumOrientations = 0;
+  for(size_t family = 0; family < 3; family++)
+  {
+    if(m_Config.discrete)
+    {
+      m_Images[family].assign(getGridSize(), 0.0);
+    }
+    else
+    {
+      m_LambertSquares[family] = ModifiedLambertProjection::New();
+      m_LambertSquares[family]->initializeSquares(m_Config.lambertDim, m_Config.sphereRadius);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+void PoleFigureAccumulator::add(const float* eulers, size_t count)
+{
+  if(count == 0)
+  {
+    return;
+  }
+  std::mutex mutex;
+  ProjectPoleFigureChunksImpl impl(m_Ops, m_Config, eulers, count, m_SymSizes, m_Images, m_LambertSquares, mutex);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, impl.getNumberOfChunks());
+  dataAlg.setGrain(1);
+  dataAlg.execute(impl);
+  m_NumOrientations += count;
+}
+
+// -----------------------------------------------------------------------------
+void PoleFigureAccumulator::add(const EbsdLib::FloatArrayType& eulers)
+{
+  if(eulers.getNumberOfComponents() != 3)
+  {
+    throw std::runtime_error("PoleFigureAccumulator::add: The Euler angle array must have 3 components.");
+  }
+  add(eulers.getPointer(0), eulers.getNumberOfTuples());
+}
+
+// -----------------------------------------------------------------------------
+void PoleFigureAccumulator::merge(const PoleFigureAccumulator& other)
+{
+  checkCompatible(other.m_LaueIndex, other.m_Config.discrete, other.m_Config.imageDim, other.m_Config.lambertDim, "merge");
+  mergeState(other.getState());
+}
+
+// -----------------------------------------------------------------------------
+size_t PoleFigureAccumulator::getNumberOfOrientations() const
+{
+  return m_NumOrientations;
+}
+
+// -----------------------------------------------------------------------------
+std::vector<double> PoleFigureAccumulator::getState() const
+{
+  const size_t gridSize = getGridSize();
+  std::vector<double> state(k_StateHeaderSize + 3 * gridSize, 0.0);
+  state[0] = static_cast<double>(m_LaueIndex);
+  state[1] = m_Config.discrete ? 1.0 : 0.0;
+  state[2] = static_cast<double>(m_Config.imageDim);
+  state[3] = static_cast<double>(m_Config.lambertDim);
+  state[4] = static_cast<double>(m_NumOrientations);
+  for(size_t family = 0; family < 3; family++)
+  {
+    double* grid = state.data() + k_StateHeaderSize + family * gridSize;
+    if(m_Config.discrete)
+    {
+      std::copy(m_Images[family].begin(), m_Images[family].end(), grid);
+    }
+    else
+    {
+      const size_t squareSize = gridSize / 2;
+      const double* north = m_LambertSquares[family]->getNorthSquare()->getPointer(0);
+      const double* south = m_LambertSquares[family]->getSouthSquare()->getPointer(0);
+      std::copy(north, north + squareSize, grid);
+      std::copy(south, south + squareSize, grid + squareSize);
+    }
+  }
+  return state;
+}
+
+// -----------------------------------------------------------------------------
+void PoleFigureAccumulator::mergeState(const std::vector<double>& state)
+{
+  if(state.size() < k_StateHeaderSize)
+  {
+    throw std::runtime_error("PoleFigureAccumulator::mergeState: The state is too short to hold its header.");
+  }
+  checkCompatible(static_cast<uint32_t>(state[0]), state[1] != 0.0, static_cast<int>(state[2]), static_cast<int>(state[3]), "mergeState");
+  const size_t gridSize = getGridSize();
+  if(state.size() != k_StateHeaderSize + 3 * gridSize)
+  {
+    throw std::runtime_error("PoleFigureAccumulator::mergeState: The state does not match the grids of this accumulator.");
+  }
+  m_NumOrientations += static_cast<size_t>(state[4]);
+  for(size_t family = 0; family < 3; family++)
+  {
+    const double* grid = state.data() + k_StateHeaderSize + family * gridSize;
+    if(m_Config.discrete)
+    {
+      std::vector<double>& image = m_Images[family];
+      for(size_t i = 0; i < gridSize; i++)
+      {
+        image[i] += grid[i];
+      }
+    }
+    else
+    {
+      const size_t squareSize = gridSize / 2;
+      double* north = m_LambertSquares[family]->getNorthSquare()->getPointer(0);
+      double* south = m_LambertSquares[family]->getSouthSquare()->getPointer(0);
+      for(size_t i = 0; i < squareSize; i++)
+      {
+        north[i] += grid[i];
+        south[i] += grid[squareSize + i];
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+std::array<EbsdLib::DoubleArrayType::Pointer, 3> PoleFigureAccumulator::computeIntensities() const
+{
+  const size_t imageSize = static_cast<size_t>(m_Config.imageDim) * static_cast<size_t>(m_Config.imageDim);
+  std::array<EbsdLib::DoubleArrayType::Pointer, 3> intensities;
+  for(size_t family = 0; family < 3; family++)
+  {
+    intensities[family] = EbsdLib::DoubleArrayType::CreateArray(imageSize, m_Labels[family] + "_Intensity_Image", true);
+    if(m_Config.discrete)
+    {
+      std::copy(m_Images[family].begin(), m_Images[family].end(), intensities[family]->getPointer(0));
+    }
+    else if(m_NumOrientations == 0)
+    {
+      // Nothing to normalize yet
+      intensities[family]->initializeWithZeros();
+    }
+    else
+    {
+      // Normalizing changes the squares so it is done on a copy, more orientations may be added later
+      ModifiedLambertProjection::Pointer squares = ModifiedLambertProjection::New();
+      squares->initializeSquares(m_Config.lambertDim, m_Config.sphereRadius);
+      squares->addProjection(*m_LambertSquares[family]);
+      squares->normalizeSquaresToMRD();
+      squares->createStereographicProjection(m_Config.imageDim, *intensities[family]);
+    }
+  }
+  return intensities;
+}
+
+// -----------------------------------------------------------------------------
+std::array<EbsdLib::DoubleArrayType::Pointer, 3> PoleFigureAccumulator::computeIntensities(double& minScale, double& maxScale) const
+{
+  std::array<EbsdLib::DoubleArrayType::Pointer, 3> intensities = computeIntensities();
+
+  // Find the Max and Min values based on ALL 3 arrays so we can color scale them all the same
+  double max = std::numeric_limits<double>::min();
+  double min = std::numeric_limits<double>::max();
+  for(const auto& intensity : intensities)
+  {
+    PoleFigureUtilities::FindIntensityRange(*intensity, min, max);
+  }
+  minScale = min;
+  maxScale = max;
+  return intensities;
+}
+
+// -----------------------------------------------------------------------------
+std::vector<EbsdLib::UInt8ArrayType::Pointer> PoleFigureAccumulator::createPoleFigures(double& minScale, double& maxScale) const
+{
+  double min = 0.0;
+  double max = 0.0;
+  std::array<EbsdLib::DoubleArrayType::Pointer, 3> intensities = computeIntensities(min, max);
+  minScale = min;
+  maxScale = max;
+
+  PoleFigureConfiguration_t config = m_Config;
+  config.minScale = min;
+  config.maxScale = max;
+
+  std::vector<size_t> dims(1, 4);
+  const size_t imageSize = static_cast<size_t>(m_Config.imageDim) * static_cast<size_t>(m_Config.imageDim);
+  std::array<EbsdLib::UInt8ArrayType::Pointer, 3> images;
+  for(size_t family = 0; family < 3; family++)
+  {
+    images[family] = EbsdLib::UInt8ArrayType::CreateArray(imageSize, dims, m_Labels[family], true);
+  }
+
+  // The images are colored one after the other, CreateColorImage colors the rows of each image in parallel
+  for(size_t family = 0; family < 3; family++)
+  {
+    PoleFigureUtilities::CreateColorImage(intensities[family].get(), config, images[family].get());
+  }
+
+  std::vector<EbsdLib::UInt8ArrayType::Pointer> poleFigures(3);
+  for(size_t family = 0; family < 3; family++)
+  {
+    size_t position = (config.order.size() == 3) ? static_cast<size_t>(config.order[family]) : family;
+    poleFigures[position] = images[family];
+  }
+  return poleFigures;
+}
+
+// -----------------------------------------------------------------------------
+std::vector<EbsdLib::UInt8ArrayType::Pointer> PoleFigureAccumulator::createPoleFigures() const
+{
+  double minScale = 0.0;
+  double maxScale = 0.0;
+  return createPoleFigures(minScale, maxScale);
+}
@@ -0,0 +1,173 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdDataArray.hpp"
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/LaueOps/LaueOps.h"
+#include "EbsdLib/Utilities/ModifiedLambertProjection.h"
+#include "EbsdLib/Utilities/PoleFigureUtilities.h"
+
+/**
+ * @class PoleFigureAccumulator PoleFigureAccumulator.h EbsdLib/LaueOps/PoleFigureAccumulator.h
+ * @brief PoleFigureAccumulator builds the three pole figures of a Laue class incrementally. Batches of
+ * orientations are projected into the discrete images or Lambert squares of the configuration as they
+ * are added and the pole figures can be rendered at any time, so a pole figure can be updated live
+ * during acquisition or slice by slice during an import without projecting everything again.
+ *
+ * Each batch is processed in parallel in chunks of k_ChunkSize orientations: the sphere coordinates of
+ * a chunk are generated with LaueOps::generateSphereCoordsFromEulers and projected straight into grids
+ * private to the task, which are summed into the accumulator at the end. Accumulators of the same Laue
+ * class and configuration can be merged, e.g. one per thread, and getState()/mergeState() move the
+ * accumulated grids between processes.
+ *
+ * add() and merge() must not be called concurrently on the same accumulator. Rendering the same
+ * orientations gives the images of LaueOps::generatePoleFigure; the Lambert intensities may only differ
+ * by the order of the floating point sums.
+ */
+class EbsdLib_EXPORT PoleFigureAccumulator
+{
+public:
+  static constexpr size_t k_ChunkSize = 8192;
+  /** @brief The number of values in front of the grids of getState() */
+  static constexpr size_t k_StateHeaderSize = 5;
+
+  /**
+   * @brief Creates an empty accumulator for a Laue class
+   * @param laueIndex The Laue class (EbsdLib::CrystalStructure)
+   * @param config The pole figure configuration. The eulers, minScale and maxScale members are not used.
+   */
+  PoleFigureAccumulator(uint32_t laueIndex, const PoleFigureConfiguration_t& config);
+
+  /**
+   * @brief Creates an empty accumulator for the Laue class of ops. The ops must outlive the accumulator.
+   * @param ops The Laue class
+   * @param config The pole figure configuration. The eulers, minScale and maxScale members are not used.
+   */
+  PoleFigureAccumulator(const LaueOps& ops, const PoleFigureConfiguration_t& config);
+
+  ~PoleFigureAccumulator();
+
+  PoleFigureAccumulator(const PoleFigureAccumulator&) = delete;            // Copy Constructor Not Implemented
+  PoleFigureAccumulator(PoleFigureAccumulator&&) = delete;                 // Move Constructor Not Implemented
+  PoleFigureAccumulator& operator=(const PoleFigureAccumulator&) = delete; // Copy Assignment Not Implemented
+  PoleFigureAccumulator& operator=(PoleFigureAccumulator&&) = delete;      // Move Assignment Not Implemented
+
+  /**
+   * @brief Projects a batch of orientations into the pole figures
+   * @param eulers count Euler angle triplets (in radians)
+   * @param count The number of orientations
+   */
+  void add(const float* eulers, size_t count);
+
+  /**
+   * @brief Projects all the Euler angles (in radians) of a 3 component array into the pole figures
+   */
+  void add(const EbsdLib::FloatArrayType& eulers);
+
+  /**
+   * @brief Adds the orientations accumulated by another accumulator. Throws std::runtime_error if the
+   * accumulators differ in their Laue class, discrete flag, image dimension or Lambert dimension.
+   */
+  void merge(const PoleFigureAccumulator& other);
+
+  /**
+   * @brief Returns the number of orientations added so far, including merged ones
+   */
+  size_t getNumberOfOrientations() const;
+
+  /**
+   * @brief Returns the accumulated grids as one flat array that can be stored or sent to another
+   * process. The k_StateHeaderSize header holds the Laue index, the discrete flag (0 or 1), imageDim,
+   * lambertDim and the number of orientations. The grid of each family follows (the image for discrete
+   * pole figures, the north then the south square otherwise).
+   */
+  std::vector<double> getState() const;
+
+  /**
+   * @brief Adds a state returned by getState() of an accumulator with the same Laue class and
+   * configuration. Throws std::runtime_error if the header or the size of the state does not match.
+   */
+  void mergeState(const std::vector<double>& state);
+
+  /**
+   * @brief Clears the accumulated orientations
+   */
+  void reset();
+
+  /**
+   * @brief Returns the imageDim x imageDim intensity images of the three families. Lambert pole figures
+   * are normalized to MRD. The images are all zero before the first orientation is added.
+   */
+  std::array<EbsdLib::DoubleArrayType::Pointer, 3> computeIntensities() const;
+
+  /**
+   * @brief Returns the intensity images like computeIntensities() and then finds their common range with a
+   * separate parallel pass over each finished image.
+   * @param minScale [output] The smallest intensity of the three images
+   * @param maxScale [output] The largest intensity of the three images
+   */
+  std::array<EbsdLib::DoubleArrayType::Pointer, 3> computeIntensities(double& minScale, double& maxScale) const;
+
+  /**
+   * @brief Renders the RGBA pole figures like LaueOps::generatePoleFigure does, in config.order.
+   * @param minScale [output] The smallest intensity of the three pole figures
+   * @param maxScale [output] The largest intensity of the three pole figures
+   */
+  std::vector<EbsdLib::UInt8ArrayType::Pointer> createPoleFigures(double& minScale, double& maxScale) const;
+
+  std::vector<EbsdLib::UInt8ArrayType::Pointer> createPoleFigures() const;
+
+private:
+  LaueOps::Pointer m_OwnedOps;
+  const LaueOps* m_Ops = nullptr;
+  uint32_t m_LaueIndex = EbsdLib::CrystalStructure::UnknownCrystalStructure;
+  PoleFigureConfiguration_t m_Config;
+  std::array<std::string, 3> m_Labels;
+  std::array<size_t, 3> m_SymSizes = {0, 0, 0};
+  size_t m_NumOrientations = 0;
+
+  std::array<std::vector<double>, 3> m_Images;
+  std::array<ModifiedLambertProjection::Pointer, 3> m_LambertSquares;
+
+  void initialize(const PoleFigureConfiguration_t& config);
+  size_t getGridSize() const;
+  void checkCompatible(uint32_t laueIndex, bool discrete, int imageDim, int lambertDim, const std::string& caller) const;
+};
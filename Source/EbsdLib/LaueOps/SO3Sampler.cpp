@@ -31,11 +31,19 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "SO3Sampler.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/Core/EbsdMacros.h"
 #include "EbsdLib/Core/OrientationTransformation.hpp"
 #include "EbsdLib/Math/ArrayHelpers.hpp"
 #include "EbsdLib/Math/EbsdLibMath.h"
+#include "EbsdLib/Utilities/ParallelDataAlgorithm.hpp"
 
 using OrientationType = Orientation<double>;
 
@@ -95,6 +103,172 @@ static const int FZoarray[32] = {NoAxisOrder,        NoAxisOrder,        TwoFold
                                  ThreeFoldAxisOrder, ThreeFoldAxisOrder, ThreeFoldAxisOrder, ThreeFoldAxisOrder, SixFoldAxisOrder,  SixFoldAxisOrder,  SixFoldAxisOrder,  SixFoldAxisOrder,
                                  SixFoldAxisOrder,   SixFoldAxisOrder,   SixFoldAxisOrder,   NoAxisOrder,        NoAxisOrder,       NoAxisOrder,       NoAxisOrder,       NoAxisOrder};
 
+namespace
+{
+/**
+ * @brief SampleRFZImpl evaluates a range of slabs (fixed outer grid index) of the cubochoric grid
+ * and keeps the Rodrigues vectors that are inside the fundamental zone, in grid order.
+ */
+class SampleRFZImpl
+{
+public:
+  SampleRFZImpl(const SO3Sampler* sampler, int nsteps, double delta, int FZtype, int FZorder, size_t firstSlab, std::vector<std::vector<double>>& slabs)
+  : m_Sampler(sampler)
+  , m_NumSteps(nsteps)
+  , m_Delta(delta)
+  , m_FZtype(FZtype)
+  , m_FZorder(FZorder)
+  , m_FirstSlab(firstSlab)
+  , m_Slabs(slabs)
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t slab = start; slab < end; slab++)
+    {
+      std::vector<double>& rods = m_Slabs[slab];
+      rods.clear();
+      double x = static_cast<double>(static_cast<int>(m_FirstSlab + slab) - m_NumSteps) * m_Delta;
+      for(int j = -m_NumSteps; j < m_NumSteps; j++)
+      {
+        double y = static_cast<double>(j) * m_Delta;
+        for(int k = -m_NumSteps; k < m_NumSteps; k++)
+        {
+          double z = static_cast<double>(k) * m_Delta;
+
+          // convert to Rodrigues representation
+          Cubochoric<double> cu(x, y, z);
+          Rodrigues<double> rod = OrientationTransformation::cu2ro<Cubochoric<double>, Rodrigues<double>>(cu);
+          if(m_Sampler->IsinsideFZ(rod.data(), m_FZtype, m_FZorder))
+          {
+            rods.insert(rods.end(), rod.begin(), rod.end());
+          }
+        }
+      }
+    }
+  }
+
+private:
+  const SO3Sampler* m_Sampler = nullptr;
+  int m_NumSteps = 0;
+  double m_Delta = 0.0;
+  int m_FZtype = 0;
+  int m_FZorder = 0;
+  size_t m_FirstSlab = 0;
+  std::vector<std::vector<double>>& m_Slabs;
+};
+
+/**
+ * @brief MarkRFZImpl evaluates a range of slabs of the cubochoric grid and only records, one bit per
+ * grid point, which points are inside the fundamental zone along with the number of them per slab.
+ */
+class MarkRFZImpl
+{
+public:
+  MarkRFZImpl(const SO3Sampler* sampler, int nsteps, double delta, int FZtype, int FZorder, std::vector<std::vector<uint64_t>>& masks, std::vector<size_t>& counts)
+  : m_Sampler(sampler)
+  , m_NumSteps(nsteps)
+  , m_Delta(delta)
+  , m_FZtype(FZtype)
+  , m_FZorder(FZorder)
+  , m_Masks(masks)
+  , m_Counts(counts)
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    const size_t slabSize = static_cast<size_t>(2 * m_NumSteps) * static_cast<size_t>(2 * m_NumSteps);
+    for(size_t slab = start; slab < end; slab++)
+    {
+      std::vector<uint64_t>& mask = m_Masks[slab];
+      mask.assign((slabSize + 63) / 64, 0);
+      size_t count = 0;
+      size_t bit = 0;
+      double x = static_cast<double>(static_cast<int>(slab) - m_NumSteps) * m_Delta;
+      for(int j = -m_NumSteps; j < m_NumSteps; j++)
+      {
+        double y = static_cast<double>(j) * m_Delta;
+        for(int k = -m_NumSteps; k < m_NumSteps; k++, bit++)
+        {
+          double z = static_cast<double>(k) * m_Delta;
+          Cubochoric<double> cu(x, y, z);
+          Rodrigues<double> rod = OrientationTransformation::cu2ro<Cubochoric<double>, Rodrigues<double>>(cu);
+          if(m_Sampler->IsinsideFZ(rod.data(), m_FZtype, m_FZorder))
+          {
+            mask[bit / 64] |= (uint64_t(1) << (bit % 64));
+            count++;
+          }
+        }
+      }
+      m_Counts[slab] = count;
+    }
+  }
+
+private:
+  const SO3Sampler* m_Sampler = nullptr;
+  int m_NumSteps = 0;
+  double m_Delta = 0.0;
+  int m_FZtype = 0;
+  int m_FZorder = 0;
+  std::vector<std::vector<uint64_t>>& m_Masks;
+  std::vector<size_t>& m_Counts;
+};
+
+/**
+ * @brief WriteRFZImpl converts the grid points marked by MarkRFZImpl again and writes the Rodrigues
+ * vectors of each slab straight into the output, starting at the tuple offset of the slab.
+ */
+class WriteRFZImpl
+{
+public:
+  WriteRFZImpl(int nsteps, double delta, const std::vector<std::vector<uint64_t>>& masks, const std::vector<size_t>& offsets, double* output)
+  : m_NumSteps(nsteps)
+  , m_Delta(delta)
+  , m_Masks(masks)
+  , m_Offsets(offsets)
+  , m_Output(output)
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    const size_t edge = static_cast<size_t>(2 * m_NumSteps);
+    for(size_t slab = start; slab < end; slab++)
+    {
+      const std::vector<uint64_t>& mask = m_Masks[slab];
+      double* output = m_Output + m_Offsets[slab] * 4;
+      double x = static_cast<double>(static_cast<int>(slab) - m_NumSteps) * m_Delta;
+      for(size_t word = 0; word < mask.size(); word++)
+      {
+        uint64_t bits = mask[word];
+        for(size_t bit = 0; bits != 0; bit++, bits >>= 1)
+        {
+          if((bits & 1) == 0)
+          {
+            continue;
+          }
+          const size_t index = word * 64 + bit;
+          double y = static_cast<double>(static_cast<int>(index / edge) - m_NumSteps) * m_Delta;
+          double z = static_cast<double>(static_cast<int>(index % edge) - m_NumSteps) * m_Delta;
+          Cubochoric<double> cu(x, y, z);
+          Rodrigues<double> rod = OrientationTransformation::cu2ro<Cubochoric<double>, Rodrigues<double>>(cu);
+          output = std::copy(rod.begin(), rod.end(), output);
+        }
+      }
+    }
+  }
+
+private:
+  int m_NumSteps = 0;
+  double m_Delta = 0.0;
+  const std::vector<std::vector<uint64_t>>& m_Masks;
+  const std::vector<size_t>& m_Offsets;
+  double* m_Output = nullptr;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -177,7 +351,7 @@ SO3Sampler::~SO3Sampler() = default;
 //> @date 01/01/15 MDG 1.0 new routine, needed for dictionary indexing approach
 //> @date 06/04/15 MDG 1.1 corrected infty to inftyd (double precision infinity)
 //--------------------------------------------------------------------------
-bool SO3Sampler::IsinsideFZ(double* rod, int FZtype, int FZorder)
+bool SO3Sampler::IsinsideFZ(double* rod, int FZtype, int FZorder) const
 {
   bool insideFZ = false;
   // dealing with 180 rotations is needed only for
@@ -230,7 +404,7 @@ bool SO3Sampler::IsinsideFZ(double* rod, int FZtype, int FZorder)
 //> @date 10/02/14 MDG 2.0 rewrite
 //> @date 06/04/15 MDG 2.1 corrected infty to inftyd (double precision infinity)
 //--------------------------------------------------------------------------
-bool SO3Sampler::insideCyclicFZ(double* rod, int order)
+bool SO3Sampler::insideCyclicFZ(double* rod, int order) const
 {
 
   bool insideFZ = false;
@@ -264,7 +438,7 @@ bool SO3Sampler::insideCyclicFZ(double* rod, int order)
 //> @date 05/12/14  MDG 1.0 original
 //> @date 10/02/14  MDG 2.0 rewrite
 //--------------------------------------------------------------------------
-bool SO3Sampler::insideDihedralFZ(double* rod, int order)
+bool SO3Sampler::insideDihedralFZ(double* rod, int order) const
 {
 
   bool res = false, c1 = false, c2 = false;
@@ -325,13 +499,10 @@ bool SO3Sampler::insideDihedralFZ(double* rod, int order)
 //> @date 01/03/15 MDG 2.1 correction of boundary error; simplification of octahedral planes
 //> @date 06/04/15 MDG 2.2 simplified handling of components of r
 //--------------------------------------------------------------------------
-bool SO3Sampler::insideCubicFZ(double* rod, int ot)
+bool SO3Sampler::insideCubicFZ(double* rod, int ot) const
 {
   bool res = false, c1 = false, c2 = false;
-  std::vector<double> r(3);
-  r[0] = std::fabs(rod[0] * rod[3]);
-  r[1] = std::fabs(rod[1] * rod[3]);
-  r[2] = std::fabs(rod[2] * rod[3]);
+  std::array<double, 3> r = {std::fabs(rod[0] * rod[3]), std::fabs(rod[1] * rod[3]), std::fabs(rod[2] * rod[3])};
   const double r1 = 1.0;
 
   // primary cube planes (only needed for octahedral case)
@@ -412,49 +583,117 @@ bool SO3Sampler::insideCubicFZ(double* rod, int ot)
 //--------------------------------------------------------------------------
 SO3Sampler::OrientationListArrayType SO3Sampler::SampleRFZ(int nsteps, int pgnum)
 {
-
-  double x, y, z, delta;
   OrientationListArrayType FZlist;
-  int32_t FZtype, FZorder;
+  SampleRFZ(nsteps, pgnum, [&FZlist](const double* rods, size_t count) {
+    for(size_t i = 0; i < count; i++)
+    {
+      const double* rod = rods + i * 4;
+      FZlist.emplace_back(rod[0], rod[1], rod[2], rod[3]);
+    }
+  });
+  return FZlist;
+}
+
+// -----------------------------------------------------------------------------
+void SO3Sampler::SampleRFZ(int nsteps, int pgnum, const SampleBatchCallbackType& callback) const
+{
+  if(pgnum < 1 || pgnum > 32)
+  {
+    throw std::out_of_range("SO3Sampler::SampleRFZ: The point group number must be in the range 1 to 32.");
+  }
+  if(nsteps <= 0)
+  {
+    return;
+  }
 
   // step size for sampling of grid; total number of samples = (2*nsteps+1)**3
-  delta = (0.50 * LPs::ap) / static_cast<double>(nsteps);
+  double delta = (0.50 * LPs::ap) / static_cast<double>(nsteps);
 
   // determine which function we should call for this point group symmetry
-  FZtype = FZtarray[pgnum - 1];
-  FZorder = FZoarray[pgnum - 1];
+  int32_t FZtype = FZtarray[pgnum - 1];
+  int32_t FZorder = FZoarray[pgnum - 1];
 
   // loop over the cube of volume pi^2; note that we do not want to include
   // the opposite edges/facets of the cube, to avoid double counting rotations
   // with a rotation angle of 180 degrees.  This only affects the cyclic groups.
-  for(int i = -nsteps; i < nsteps; i++)
+  const size_t numSlabs = static_cast<size_t>(2 * nsteps);
+  const size_t slabsPerBatch = std::max<size_t>(4, 2 * std::thread::hardware_concurrency());
+  std::vector<std::vector<double>> slabs(std::min(slabsPerBatch, numSlabs));
+  for(size_t firstSlab = 0; firstSlab < numSlabs; firstSlab += slabs.size())
   {
-    x = static_cast<double>(i) * delta;
-
-    for(int j = -nsteps; j < nsteps; j++)
+    const size_t batchSize = std::min(slabs.size(), numSlabs - firstSlab);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, batchSize);
+    dataAlg.setGrain(1);
+    dataAlg.execute(SampleRFZImpl(this, nsteps, delta, FZtype, FZorder, firstSlab, slabs));
+    for(size_t slab = 0; slab < batchSize; slab++)
     {
-      y = static_cast<double>(j) * delta;
+      callback(slabs[slab].data(), slabs[slab].size() / 4);
+    }
+  }
+}
 
-      for(int k = -nsteps; k < nsteps; k++)
-      {
-        z = static_cast<double>(k) * delta;
+// -----------------------------------------------------------------------------
+EbsdLib::DoubleArrayType::Pointer SO3Sampler::SampleRFZArray(int nsteps, int pgnum) const
+{
+  EbsdLib::DoubleArrayType::Pointer rodArray = EbsdLib::DoubleArrayType::CreateArray(0, {4}, "Rodrigues", true);
+  SampleRFZArray(nsteps, pgnum, *rodArray);
+  return rodArray;
+}
 
-        // convert to Rodrigues representation
-        OrientationType cu(x, y, z);
-        OrientationType rod = OrientationTransformation::cu2ro<OrientationType, OrientationType>(cu);
+// -----------------------------------------------------------------------------
+void SO3Sampler::SampleRFZArray(int nsteps, int pgnum, EbsdLib::DoubleArrayType& rodArray) const
+{
+  if(pgnum < 1 || pgnum > 32)
+  {
+    throw std::out_of_range("SO3Sampler::SampleRFZArray: The point group number must be in the range 1 to 32.");
+  }
+  if(rodArray.getNumberOfComponents() != 4)
+  {
+    throw std::invalid_argument("SO3Sampler::SampleRFZArray: The output array must have 4 components.");
+  }
+  if(nsteps <= 0)
+  {
+    rodArray.resizeTuples(0);
+    return;
+  }
 
-        // If insideFZ=true, then add this point to the linked list FZlist and keep
-        // track of how many points there are on this list
-        bool b = IsinsideFZ(rod.data(), FZtype, FZorder);
-        if(b)
-        {
-          FZlist.push_back(rod);
-        }
-      }
-    }
+  double delta = (0.50 * LPs::ap) / static_cast<double>(nsteps);
+  int32_t FZtype = FZtarray[pgnum - 1];
+  int32_t FZorder = FZoarray[pgnum - 1];
+  const size_t numSlabs = static_cast<size_t>(2 * nsteps);
+
+  // The first pass only marks the grid points inside the fundamental zone so the output can be
+  // allocated once at its final size and every slab knows where its samples start.
+  std::vector<std::vector<uint64_t>> masks(numSlabs);
+  std::vector<size_t> offsets(numSlabs + 1, 0);
+  ParallelDataAlgorithm markAlg;
+  markAlg.setRange(0, numSlabs);
+  markAlg.setGrain(1);
+  markAlg.execute(MarkRFZImpl(this, nsteps, delta, FZtype, FZorder, masks, offsets));
+  size_t numSamples = 0;
+  for(size_t& offset : offsets)
+  {
+    const size_t count = offset;
+    offset = numSamples;
+    numSamples += count;
   }
 
-  return FZlist;
+  if(rodArray.getNumberOfTuples() != numSamples)
+  {
+    // Release the old values first so they are not copied into the new allocation
+    rodArray.resizeTuples(0);
+    rodArray.resizeTuples(numSamples);
+  }
+  if(numSamples == 0)
+  {
+    return;
+  }
+
+  ParallelDataAlgorithm writeAlg;
+  writeAlg.setRange(0, numSlabs);
+  writeAlg.setGrain(1);
+  writeAlg.execute(WriteRFZImpl(nsteps, delta, masks, offsets, rodArray.getPointer(0)));
 }
 
 // -----------------------------------------------------------------------------
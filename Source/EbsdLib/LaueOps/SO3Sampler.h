@@ -31,10 +31,12 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #pragma once
 
+#include <functional>
 #include <list>
 #include <memory>
 #include <string>
 
+#include "EbsdLib/Core/EbsdDataArray.hpp"
 #include "EbsdLib/Core/Orientation.hpp"
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
@@ -71,9 +73,44 @@ public:
    */
   using OrientationListArrayType = std::list<OrientationType>;
 
+  /**
+   * @brief SampleBatchCallbackType receives count consecutive Rodrigues vectors packed as 4 doubles each.
+   */
+  using SampleBatchCallbackType = std::function<void(const double* rods, size_t count)>;
+
   // sampler routine
   OrientationListArrayType SampleRFZ(int nsteps, int pgnum);
 
+  /**
+   * @brief SampleRFZ Streams the samples of the Rodrigues fundamental zone to a callback instead of
+   * collecting them. The cubochoric grid is evaluated in parallel a few slabs (outer grid index) at
+   * a time and the callback is invoked on the calling thread with one batch per slab, in grid order,
+   * so only a few slabs are ever held in memory.
+   * @param nsteps Number of steps along the semi-edge of the cubochoric grid
+   * @param pgnum Point group number (1-32) that selects the fundamental zone
+   * @param callback Receives the samples
+   */
+  void SampleRFZ(int nsteps, int pgnum, const SampleBatchCallbackType& callback) const;
+
+  /**
+   * @brief SampleRFZArray Returns the samples of the Rodrigues fundamental zone in one contiguous
+   * array of 4 component tuples, in the same order as SampleRFZ.
+   * @param nsteps Number of steps along the semi-edge of the cubochoric grid
+   * @param pgnum Point group number (1-32) that selects the fundamental zone
+   */
+  EbsdLib::DoubleArrayType::Pointer SampleRFZArray(int nsteps, int pgnum) const;
+
+  /**
+   * @brief SampleRFZArray Writes the samples of the Rodrigues fundamental zone into an array owned
+   * by the caller, in the same order as SampleRFZ. The grid is evaluated once to count the samples
+   * so the array is sized exactly once and the samples are written straight into it. The array is
+   * only reallocated when its number of tuples does not match.
+   * @param nsteps Number of steps along the semi-edge of the cubochoric grid
+   * @param pgnum Point group number (1-32) that selects the fundamental zone
+   * @param rodArray Destination array with 4 components
+   */
+  void SampleRFZArray(int nsteps, int pgnum, EbsdLib::DoubleArrayType& rodArray) const;
+
   /**
    * @brief IsinsideFZ
    * @param rod
@@ -81,7 +118,7 @@ public:
    * @param FZorder
    * @return
    */
-  bool IsinsideFZ(double* rod, int FZtype, int FZorder);
+  bool IsinsideFZ(double* rod, int FZtype, int FZorder) const;
 
   /**
    * @brief insideCubicFZ
@@ -89,7 +126,7 @@ public:
    * @param symType
    * @return
    */
-  bool insideCubicFZ(double* rod, int symType);
+  bool insideCubicFZ(double* rod, int symType) const;
 
   /**
    * @brief insideCyclicFZ
@@ -97,7 +134,7 @@ public:
    * @param order
    * @return
    */
-  bool insideCyclicFZ(double* rod, int order);
+  bool insideCyclicFZ(double* rod, int order) const;
 
   /**
    * @brief insideDihedralFZ
@@ -105,7 +142,7 @@ public:
    * @param order
    * @return
    */
-  bool insideDihedralFZ(double* rod, int order);
+  bool insideDihedralFZ(double* rod, int order) const;
 
 private:
 protected:
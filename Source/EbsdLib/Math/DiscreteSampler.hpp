@@ -0,0 +1,127 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+/**
+ * @class DiscreteSampler DiscreteSampler.hpp EbsdLib/Math/DiscreteSampler.hpp
+ * @brief DiscreteSampler picks bins of a discrete distribution such as an ODF or MDF. The
+ * cumulative weights are built once so each pick is a binary search, O(log n), instead of a scan
+ * over all of the bins. The cumulative weights are summed in the order of the bins with the value
+ * type T, so find() returns exactly the bin that a linear scan accumulating in T would choose.
+ * The weights must not be negative. The object is read only after construction and can be shared
+ * between threads.
+ */
+template <typename T>
+class DiscreteSampler
+{
+public:
+  DiscreteSampler() = default;
+  ~DiscreteSampler() = default;
+
+  DiscreteSampler(const DiscreteSampler&) = default;
+  DiscreteSampler(DiscreteSampler&&) noexcept = default;
+  DiscreteSampler& operator=(const DiscreteSampler&) = default;
+  DiscreteSampler& operator=(DiscreteSampler&&) noexcept = default;
+
+  /**
+   * @brief Builds the cumulative weights from the first count values of weights
+   * @param weights Any container or pointer that supports operator[]
+   * @param count The number of bins
+   */
+  template <typename Container>
+  DiscreteSampler(const Container& weights, size_t count)
+  : m_Cumulative(count)
+  {
+    T total = static_cast<T>(0);
+    for(size_t i = 0; i < count; i++)
+    {
+      total = total + static_cast<T>(weights[i]);
+      m_Cumulative[i] = total;
+    }
+  }
+
+  /**
+   * @brief Returns the number of bins
+   */
+  size_t size() const
+  {
+    return m_Cumulative.size();
+  }
+
+  /**
+   * @brief Returns the sum of all of the weights
+   */
+  T getTotalWeight() const
+  {
+    return m_Cumulative.empty() ? static_cast<T>(0) : m_Cumulative.back();
+  }
+
+  /**
+   * @brief Returns the bin j for which cumulative[j - 1] <= value < cumulative[j]. Values outside
+   * of [0, getTotalWeight()) return bin 0, which is what the linear scans in StatsGen and Texture
+   * have always done.
+   */
+  size_t find(T value) const
+  {
+    if(value < static_cast<T>(0))
+    {
+      return 0;
+    }
+    auto iter = std::upper_bound(m_Cumulative.begin(), m_Cumulative.end(), value);
+    if(iter == m_Cumulative.end())
+    {
+      return 0;
+    }
+    return static_cast<size_t>(iter - m_Cumulative.begin());
+  }
+
+  /**
+   * @brief Draws a bin with a probability proportional to its weight
+   * @param generator A random number engine
+   */
+  template <typename Engine>
+  size_t sample(Engine& generator) const
+  {
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    return find(static_cast<T>(distribution(generator) * static_cast<double>(getTotalWeight())));
+  }
+
+private:
+  std::vector<T> m_Cumulative;
+};
@@ -0,0 +1,148 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace EbsdLib
+{
+/**
+ * @class PhiloxEngine Philox.hpp EbsdLib/Math/Philox.hpp
+ * @brief PhiloxEngine is a counter based random number generator (Philox4x32-10, Salmon et al.,
+ * "Parallel random numbers: as easy as 1, 2, 3", SC11). Its output is a pure function of a key
+ * (the seed), a stream number and the position in the stream, so there is no state to carry from
+ * one sample to the next. Giving every sample its own stream (usually the sample index) makes the
+ * result of a parallel loop independent of the number of threads and of how the loop is split.
+ *
+ * The engine meets the UniformRandomBitGenerator requirements so it works with the standard
+ * distributions. Code that must give identical results on every platform should use
+ * nextDouble() instead, because the standard distributions are implementation defined.
+ */
+class PhiloxEngine
+{
+public:
+  using result_type = uint64_t;
+  using CounterType = std::array<uint32_t, 4>;
+  using KeyType = std::array<uint32_t, 2>;
+
+  /**
+   * @param seed The key of the generator
+   * @param stream The stream number, for example the index of the sample
+   */
+  PhiloxEngine(uint64_t seed, uint64_t stream)
+  : m_Key{{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}}
+  , m_Stream(stream)
+  {
+  }
+
+  static constexpr result_type min()
+  {
+    return 0;
+  }
+
+  static constexpr result_type max()
+  {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  /**
+   * @brief Returns the next 64 random bits of the stream
+   */
+  result_type operator()()
+  {
+    if(m_Available == 0)
+    {
+      CounterType counter = {{static_cast<uint32_t>(m_Position), static_cast<uint32_t>(m_Position >> 32), static_cast<uint32_t>(m_Stream), static_cast<uint32_t>(m_Stream >> 32)}};
+      m_Block = Generate(counter, m_Key);
+      m_Position++;
+      m_Available = 2;
+    }
+    m_Available--;
+    const size_t offset = (1 - m_Available) * 2;
+    return static_cast<uint64_t>(m_Block[offset]) | (static_cast<uint64_t>(m_Block[offset + 1]) << 32);
+  }
+
+  /**
+   * @brief Returns a double in [0, 1) made from the top 53 bits of the next value
+   */
+  double nextDouble()
+  {
+    return static_cast<double>((*this)() >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  /**
+   * @brief Returns an integer in [0, count)
+   */
+  uint64_t nextIndex(uint64_t count)
+  {
+    uint64_t index = static_cast<uint64_t>(nextDouble() * static_cast<double>(count));
+    return index < count ? index : count - 1;
+  }
+
+  /**
+   * @brief The Philox4x32-10 bijection of one counter under a key
+   */
+  static CounterType Generate(CounterType counter, KeyType key)
+  {
+    constexpr uint32_t k_Multiplier0 = 0xD2511F53;
+    constexpr uint32_t k_Multiplier1 = 0xCD9E8D57;
+    constexpr uint32_t k_Weyl0 = 0x9E3779B9;
+    constexpr uint32_t k_Weyl1 = 0xBB67AE85;
+
+    for(int round = 0; round < 10; round++)
+    {
+      if(round > 0)
+      {
+        key[0] += k_Weyl0;
+        key[1] += k_Weyl1;
+      }
+      const uint64_t product0 = static_cast<uint64_t>(k_Multiplier0) * counter[0];
+      const uint64_t product1 = static_cast<uint64_t>(k_Multiplier1) * counter[2];
+      counter = {{static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0], static_cast<uint32_t>(product1), static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                  static_cast<uint32_t>(product0)}};
+    }
+    return counter;
+  }
+
+private:
+  KeyType m_Key = {{0, 0}};
+  uint64_t m_Stream = 0;
+  uint64_t m_Position = 0;
+  CounterType m_Block = {{0, 0, 0, 0}};
+  size_t m_Available = 0;
+};
+} // namespace EbsdLib
@@ -0,0 +1,134 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "RandomService.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace
+{
+struct GlobalSeedState
+{
+  std::mutex mutex;
+  uint64_t seed = 0;
+  uint64_t nextStream = 0;
+  // Bumped on every change of the seed so the thread engines know when to reseed
+  std::atomic<uint64_t> generation = {1};
+
+  GlobalSeedState()
+  {
+    std::random_device randomDevice;
+    seed = (static_cast<uint64_t>(randomDevice()) << 32) ^ static_cast<uint64_t>(randomDevice());
+  }
+};
+
+GlobalSeedState& GetGlobalSeedState()
+{
+  static GlobalSeedState state;
+  return state;
+}
+
+struct ThreadEngine
+{
+  EbsdLib::RandomService::EngineType engine;
+  uint64_t generation = 0;
+};
+
+ThreadEngine& GetThreadEngineState()
+{
+  thread_local ThreadEngine threadEngine;
+  return threadEngine;
+}
+} // namespace
+
+namespace EbsdLib
+{
+// -----------------------------------------------------------------------------
+void RandomService::SetGlobalSeed(uint64_t seed)
+{
+  GlobalSeedState& state = GetGlobalSeedState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.seed = seed;
+  state.generation++;
+  // The calling thread always gets stream 0 so its sequence does not depend on other threads
+  ThreadEngine& threadEngine = GetThreadEngineState();
+  threadEngine.engine.seed(MixSeed(seed, 0));
+  threadEngine.generation = state.generation.load(std::memory_order_relaxed);
+  state.nextStream = 1;
+}
+
+// -----------------------------------------------------------------------------
+void RandomService::ResetGlobalSeed()
+{
+  std::random_device randomDevice;
+  SetGlobalSeed((static_cast<uint64_t>(randomDevice()) << 32) ^ static_cast<uint64_t>(randomDevice()));
+}
+
+// -----------------------------------------------------------------------------
+uint64_t RandomService::GetGlobalSeed()
+{
+  GlobalSeedState& state = GetGlobalSeedState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.seed;
+}
+
+// -----------------------------------------------------------------------------
+RandomService::EngineType& RandomService::GetThreadEngine()
+{
+  ThreadEngine& threadEngine = GetThreadEngineState();
+  GlobalSeedState& state = GetGlobalSeedState();
+  if(threadEngine.generation != state.generation.load(std::memory_order_acquire))
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    threadEngine.engine.seed(MixSeed(state.seed, state.nextStream++));
+    threadEngine.generation = state.generation.load(std::memory_order_relaxed);
+  }
+  return threadEngine.engine;
+}
+
+// -----------------------------------------------------------------------------
+RandomService::EngineType RandomService::CreateEngine(uint64_t seed, uint64_t stream)
+{
+  return EngineType(MixSeed(seed, stream));
+}
+
+// -----------------------------------------------------------------------------
+uint64_t RandomService::MixSeed(uint64_t seed, uint64_t stream)
+{
+  uint64_t z = seed + (stream + 1) * 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+} // namespace EbsdLib
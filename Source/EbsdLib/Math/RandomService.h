@@ -0,0 +1,105 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "EbsdLib/EbsdLib.h"
+
+namespace EbsdLib
+{
+/**
+ * @brief The RandomService namespace is the single source of random numbers for the library. Every
+ * thread draws from its own engine so there is no locking and no std::random_device per call.
+ *
+ * The thread engines are seeded from a global seed. Until SetGlobalSeed() is called the global seed
+ * comes from std::random_device, so results differ from run to run as they always have. After
+ * SetGlobalSeed() the engine of the calling thread is reseeded with stream 0 of the seed. Every other
+ * thread engine is reseeded the next time it is used with stream 1, 2 and so on in the order the
+ * threads first draw, which is not deterministic. Seeding is therefore only reproducible for the
+ * draws made on the thread that called SetGlobalSeed().
+ *
+ * The parallel algorithms of the library follow that rule: they draw one seed from the engine of
+ * the calling thread and give each sample its own Philox stream keyed by the sample index, so
+ * their results do not depend on the number of threads. Other code that must be reproducible no
+ * matter how work is spread over threads should do the same or create its own engines with
+ * CreateEngine() and a per-block stream number.
+ */
+namespace RandomService
+{
+using EngineType = std::mt19937_64;
+
+/**
+ * @brief The number of samples per block of the parallel sampling loops. Sample i draws its random
+ * numbers from stream i of a PhiloxEngine keyed by the seed, so the samples do not depend on the number
+ * of threads or on how the range is split. Per block results, such as the bin counts of an MDF, are
+ * summed in block order afterwards so they do not depend on the scheduling either.
+ */
+inline constexpr size_t k_SampleBlockSize = 4096;
+
+/**
+ * @brief Sets the global seed, reseeds the engine of the calling thread with stream 0 and reseeds
+ * the engines of all other threads the next time they are used
+ */
+EbsdLib_EXPORT void SetGlobalSeed(uint64_t seed);
+
+/**
+ * @brief Replaces the global seed with a new value from std::random_device
+ */
+EbsdLib_EXPORT void ResetGlobalSeed();
+
+EbsdLib_EXPORT uint64_t GetGlobalSeed();
+
+/**
+ * @brief Returns the engine of the calling thread. The reference stays valid for the life of the
+ * thread and must not be shared with other threads. Only the engine of the thread that called
+ * SetGlobalSeed() gives a reproducible sequence.
+ */
+EbsdLib_EXPORT EngineType& GetThreadEngine();
+
+/**
+ * @brief Creates an engine for stream number 'stream' of a seed. Different streams of the same seed
+ * give independent sequences.
+ */
+EbsdLib_EXPORT EngineType CreateEngine(uint64_t seed, uint64_t stream = 0);
+
+/**
+ * @brief Mixes a seed and a stream number into a well spread engine seed (SplitMix64)
+ */
+EbsdLib_EXPORT uint64_t MixSeed(uint64_t seed, uint64_t stream);
+
+} // namespace RandomService
+} // namespace EbsdLib
@@ -35,13 +35,17 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
 #include <vector>
 
 #include <string>
 
 #include "EbsdLib/Core/EbsdSetGetMacros.h"
+#include "EbsdLib/Core/FixedOrientation.hpp"
 #include "EbsdLib/Core/Orientation.hpp"
 #include "EbsdLib/Core/OrientationRepresentation.h"
 #include "EbsdLib/Core/OrientationTransformation.hpp"
@@ -56,6 +60,8 @@
 
 #define OC_CLASS_DEFINES(name)                                                                                                                                                                         \
   using DataArrayPointerType = typename DataArrayType::Pointer;                                                                                                                                        \
+  using TupleConverterType = typename OrientationConverter<DataArrayType, T>::TupleConverterType;                                                                                                      \
+  using TupleCheckerType = typename OrientationConverter<DataArrayType, T>::TupleCheckerType;                                                                                                          \
   using Self = name<DataArrayType, T>;                                                                                                                                                                 \
   using Pointer = std::shared_ptr<Self>;                                                                                                                                                               \
   static Pointer New()                                                                                                                                                                                 \
@@ -80,6 +86,24 @@ public:
   using Self = OrientationConverter<DataArrayType, T>;
   using Pointer = std::shared_ptr<Self>;
 
+  /**
+   * @brief Converts a single tuple from the input representation into one output representation
+   */
+  using TupleConverterType = void (*)(T* input, T* output);
+
+  /**
+   * @brief Checks a single input tuple and repairs it in place when possible. Returns one of
+   * the TupleCheck values.
+   */
+  using TupleCheckerType = int (*)(T* input);
+
+  enum TupleCheck : int
+  {
+    Invalid = -1,
+    Valid = 0,
+    Repaired = 1
+  };
+
   virtual ~OrientationConverter() = default;
 
   virtual std::string getNameOfClass() const
@@ -103,6 +127,15 @@ public:
    */
   void convertRepresentationTo(OrientationRepresentation::Type repType)
   {
+    if(m_FusedSanityCheck && nullptr != getTupleConverter(repType))
+    {
+      const size_t index = static_cast<size_t>(repType);
+      std::vector<size_t> cDims = {GetComponentCounts<std::vector<size_t>>()[index]};
+      DataArrayPointerType output = DataArrayType::CreateArray(this->getInputData()->getNumberOfTuples(), cDims, GetOrientationTypeStrings<std::vector<std::string>>()[index], true);
+      convertRepresentationTo(repType, *output);
+      this->setOutputData(output);
+      return;
+    }
     if(repType == OrientationRepresentation::Type::Euler)
     {
       toEulers();
@@ -137,6 +170,48 @@ public:
     }
   }
 
+  /**
+   * @brief convertRepresentationsTo Converts the data to several representations in a
+   * single pass over the input. The input is sanity checked once and every tuple is read
+   * once and then written to each of the outputs, which saves the extra sweeps that
+   * calling convertRepresentationTo() for each type would make. Each output holds exactly
+   * the values that convertRepresentationTo() would produce for that type. The output
+   * data of this converter is not changed.
+   * @param repTypes The types of representation to convert to.
+   * @return One array per entry in repTypes, in the same order
+   */
+  std::vector<DataArrayPointerType> convertRepresentationsTo(const std::vector<OrientationRepresentation::Type>& repTypes);
+
+  /**
+   * @brief convertRepresentationTo Converts the data to the desired type and writes it
+   * into an array owned by the caller instead of allocating a new output array. The same
+   * array can be reused across calls; it is resized when its number of tuples does not
+   * match the input. The output data of this converter is not changed.
+   * @param repType The type of representation to convert to.
+   * @param output The destination which must have the component count of repType
+   */
+  void convertRepresentationTo(OrientationRepresentation::Type repType, DataArrayType& output);
+
+  /**
+   * @brief convertRepresentationTo Converts the input tuples [start, end) to the desired
+   * type and writes them into a buffer owned by the caller. Input tuple 'start' is written
+   * to the beginning of the buffer so a small buffer can be reused for each chunk of a
+   * large input. Only the converted tuples are sanity checked.
+   * @param repType The type of representation to convert to.
+   * @param output Destination with room for (end - start) tuples of the repType component count
+   * @param start The first input tuple to convert
+   * @param end One past the last input tuple to convert
+   */
+  void convertRepresentationTo(OrientationRepresentation::Type repType, T* output, size_t start, size_t end);
+
+  /**
+   * @brief getTupleConverter Returns the function that converts one tuple of the input
+   * representation into the given representation.
+   * @param repType The type of representation to convert to.
+   * @return
+   */
+  virtual TupleConverterType getTupleConverter(OrientationRepresentation::Type repType) const = 0;
+
   /**
    * @brief toEulers Converts the input orientations to Euler Angles
    */
@@ -184,6 +259,58 @@ public:
    */
   virtual void sanityCheckInputData() = 0;
 
+  /**
+   * @brief sanityCheckInputRange Runs the same checks as sanityCheckInputData() on the
+   * input tuples [start, end) only.
+   * @param start The first tuple to check
+   * @param end One past the last tuple to check
+   */
+  virtual void sanityCheckInputRange(size_t /* start */, size_t /* end */)
+  {
+  }
+
+  /**
+   * @brief getTupleChecker Returns the function that checks and repairs one tuple of the
+   * input representation, or nullptr if the representation has no checks.
+   */
+  virtual TupleCheckerType getTupleChecker() const
+  {
+    return nullptr;
+  }
+
+  /**
+   * @brief Sets/Gets whether the input checks run inside the conversion pass instead of as
+   * a separate pass over the whole input before it. Each input tuple is then checked right
+   * before it is converted, so the input is only read once. Both modes change the input in
+   * exactly the same way: only Euler angles are wrapped into range in place. Only this mode
+   * counts the repaired and invalid tuples.
+   */
+  void setFusedSanityCheck(bool value)
+  {
+    m_FusedSanityCheck = value;
+  }
+  bool getFusedSanityCheck() const
+  {
+    return m_FusedSanityCheck;
+  }
+
+  /**
+   * @brief Returns the number of input tuples that the last fused conversion repaired
+   */
+  size_t getRepairedTupleCount() const
+  {
+    return m_RepairedTupleCount;
+  }
+
+  /**
+   * @brief Returns the number of input tuples that the last fused conversion found invalid
+   * and could not repair. Those tuples are still converted.
+   */
+  size_t getInvalidTupleCount() const
+  {
+    return m_InvalidTupleCount;
+  }
+
   /**
    * @brief printRepresentation Prints the values of a single representation to
    * an output stream;
@@ -294,6 +421,33 @@ public:
 protected:
   OrientationConverter() = default;
 
+  /**
+   * @brief Adapts one of the Convertors functors to a TupleConverterType
+   */
+  template <class Converter>
+  static void ConvertTuple(T* input, T* output)
+  {
+    Converter conv;
+    conv(input, output);
+  }
+
+  /**
+   * @brief SelectTupleConverter Picks the converter for repType out of one converter per
+   * representation, listed in the same order as GetOrientationTypes()
+   */
+  template <class... Converters>
+  static TupleConverterType SelectTupleConverter(OrientationRepresentation::Type repType)
+  {
+    static_assert(sizeof...(Converters) == static_cast<size_t>(OrientationRepresentation::Type::Unknown), "One converter is needed for each orientation representation");
+    const std::array<TupleConverterType, sizeof...(Converters)> converters = {&ConvertTuple<Converters>...};
+    const size_t index = static_cast<size_t>(repType);
+    if(index >= converters.size())
+    {
+      return nullptr;
+    }
+    return converters[index];
+  }
+
 public:
   OrientationConverter(const OrientationConverter&) = delete;            // Copy Constructor Not Implemented
   OrientationConverter(OrientationConverter&&) = delete;                 // Move Constructor Not Implemented
@@ -303,6 +457,16 @@ public:
 private:
   DataArrayPointerType m_InputData;
   DataArrayPointerType m_OutputData;
+  bool m_FusedSanityCheck = false;
+  size_t m_RepairedTupleCount = 0;
+  size_t m_InvalidTupleCount = 0;
+
+  /**
+   * @brief convertTuples Checks the input tuples [start, end), either up front or inside the
+   * conversion pass, and converts them into each of the outputs. Input tuple 'start' is
+   * written to the first tuple of each output.
+   */
+  void convertTuples(const std::vector<T*>& outPtrs, const std::vector<size_t>& outStrides, const std::vector<TupleConverterType>& converters, size_t start, size_t end);
 };
 
 /**
@@ -318,10 +482,10 @@ private:
     CLASSNAME() = default;                                                                                                                                                                             \
     void operator()(InputType* input, InputType* output)                                                                                                                                               \
     {                                                                                                                                                                                                  \
-      using OrientationInputType = Orientation<InputType>;                                                                                                                                             \
-      OrientationInputType inputOrientation(input, INSTRIDE);                                                                                                                                          \
-      OrientationInputType outputOrientation(output, OUTSTRIDE);                                                                                                                                       \
-      outputOrientation = OrientationTransformation::CONVERSION_METHOD<OrientationInputType, OrientationInputType>(inputOrientation);                                                                  \
+      using OrientationInputType = FixedOrientation<InputType, INSTRIDE>;                                                                                                                              \
+      using OrientationOutputType = FixedOrientation<InputType, OUTSTRIDE>;                                                                                                                            \
+      OrientationInputType inputOrientation(input);                                                                                                                                                    \
+      OrientationTransformation::CONVERSION_METHOD<OrientationInputType, OrientationOutputType>(inputOrientation).copyInto(output, OUTSTRIDE);                                                         \
     }                                                                                                                                                                                                  \
   };
 
@@ -333,9 +497,9 @@ private:
     CLASSNAME() = default;                                                                                                                                                                             \
     void operator()(NumericType* input, NumericType* output)                                                                                                                                           \
     {                                                                                                                                                                                                  \
-      using InputType = Orientation<NumericType>;                                                                                                                                                      \
+      using InputType = FixedOrientation<NumericType, INSTRIDE>;                                                                                                                                       \
       using OutputType = Quaternion<NumericType>;                                                                                                                                                      \
-      InputType inputOrientation(input, INSTRIDE);                                                                                                                                                     \
+      InputType inputOrientation(input);                                                                                                                                                               \
       OrientationTransformation::CONVERSION_METHOD<InputType, OutputType>(inputOrientation).copyInto(output, Quaternion<NumericType>::Order::VectorScalar);                                            \
     }                                                                                                                                                                                                  \
   };
@@ -349,7 +513,7 @@ private:
     void operator()(NumericType* input, NumericType* output)                                                                                                                                           \
     {                                                                                                                                                                                                  \
       using QuaternionType = Quaternion<NumericType>;                                                                                                                                                  \
-      using OutputType = Orientation<NumericType>;                                                                                                                                                     \
+      using OutputType = FixedOrientation<NumericType, OUTSTRIDE>;                                                                                                                                     \
       QuaternionType inputQuat(input[0], input[1], input[2], input[3]);                                                                                                                                \
       OutputType outputOrientation = OrientationTransformation::CONVERSION_METHOD<QuaternionType, OutputType>(inputQuat);                                                                              \
       outputOrientation.copyInto(output, OUTSTRIDE);                                                                                                                                                   \
@@ -362,6 +526,21 @@ private:
  */
 namespace Convertors
 {
+/* Copies the input when the output representation is the same as the input */
+template <typename NumericType, size_t N>
+class Identity
+{
+public:
+  Identity() = default;
+  void operator()(NumericType* input, NumericType* output)
+  {
+    for(size_t i = 0; i < N; i++)
+    {
+      output[i] = input[i];
+    }
+  }
+};
+
 /* Euler Functors  */
 OC_CONVERTOR_FUNCTOR(Eu2Om, 3, 9, eu2om)
 OC_CONVERTOR_FUNCTOR_2QU(Eu2Qu, 3, 4, eu2qu)
@@ -486,6 +665,216 @@ private:
   size_t m_OutStride = 0;
 };
 
+/**
+ * @brief This functor class is used by the TBB classes to convert each input tuple into
+ * several output representations at once
+ */
+template <typename T>
+class ConvertRepresentations
+{
+public:
+  using TupleConverterType = void (*)(T* input, T* output);
+  using TupleCheckerType = int (*)(T* input);
+
+  /**
+   * @param outputStart The input tuple that is written to the first tuple of each output
+   */
+  ConvertRepresentations(T* inPtr, size_t inStride, std::vector<T*> outPtrs, std::vector<size_t> outStrides, std::vector<TupleConverterType> converters, size_t outputStart = 0)
+  : m_InPtr(inPtr)
+  , m_InStride(inStride)
+  , m_OutPtrs(std::move(outPtrs))
+  , m_OutStrides(std::move(outStrides))
+  , m_Converters(std::move(converters))
+  , m_OutputStart(outputStart)
+  {
+  }
+
+  /**
+   * @brief Checks each tuple with 'checker' right before it is converted and adds the
+   * number of repaired (checker returned > 0) and invalid (< 0) tuples to the counters
+   */
+  void setTupleChecker(TupleCheckerType checker, std::atomic<size_t>* repairedCount, std::atomic<size_t>* invalidCount)
+  {
+    m_Checker = checker;
+    m_RepairedCount = repairedCount;
+    m_InvalidCount = invalidCount;
+  }
+  virtual ~ConvertRepresentations() = default;
+
+  /**
+   * @brief This is the main conversion routine
+   * @param start Starting index
+   * @param end Ending index
+   */
+  void convert(size_t start, size_t end) const
+  {
+    const size_t numOutputs = m_Converters.size();
+    size_t repaired = 0;
+    size_t invalid = 0;
+    T* input = m_InPtr + (start * m_InStride);
+    for(size_t i = start; i < end; ++i)
+    {
+      if(nullptr != m_Checker)
+      {
+        const int check = m_Checker(input);
+        repaired += static_cast<size_t>(check > 0);
+        invalid += static_cast<size_t>(check < 0);
+      }
+      for(size_t o = 0; o < numOutputs; o++)
+      {
+        m_Converters[o](input, m_OutPtrs[o] + ((i - m_OutputStart) * m_OutStrides[o]));
+      }
+      input = input + m_InStride; /* Increment input pointer */
+    }
+    if(nullptr != m_Checker)
+    {
+      *m_RepairedCount += repaired;
+      *m_InvalidCount += invalid;
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  T* m_InPtr = nullptr;
+  size_t m_InStride = 0;
+  std::vector<T*> m_OutPtrs;
+  std::vector<size_t> m_OutStrides;
+  std::vector<TupleConverterType> m_Converters;
+  size_t m_OutputStart = 0;
+  TupleCheckerType m_Checker = nullptr;
+  std::atomic<size_t>* m_RepairedCount = nullptr;
+  std::atomic<size_t>* m_InvalidCount = nullptr;
+};
+
+// -----------------------------------------------------------------------------
+template <class DataArrayType, typename T>
+void OrientationConverter<DataArrayType, T>::convertTuples(const std::vector<T*>& outPtrs, const std::vector<size_t>& outStrides, const std::vector<TupleConverterType>& converters, size_t start,
+                                                           size_t end)
+{
+  DataArrayPointerType input = this->getInputData();
+  ConvertRepresentations<T> body(input->getPointer(0), input->getNumberOfComponents(), outPtrs, outStrides, converters, start);
+
+  std::atomic<size_t> repairedCount(0);
+  std::atomic<size_t> invalidCount(0);
+  if(m_FusedSanityCheck)
+  {
+    body.setTupleChecker(getTupleChecker(), &repairedCount, &invalidCount);
+  }
+  else if(start == 0 && end == input->getNumberOfTuples())
+  {
+    sanityCheckInputData();
+  }
+  else
+  {
+    sanityCheckInputRange(start, end);
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(start, end), body, tbb::auto_partitioner());
+#else
+  body.convert(start, end);
+#endif
+  m_RepairedTupleCount = repairedCount;
+  m_InvalidTupleCount = invalidCount;
+}
+
+// -----------------------------------------------------------------------------
+template <class DataArrayType, typename T>
+std::vector<typename OrientationConverter<DataArrayType, T>::DataArrayPointerType>
+OrientationConverter<DataArrayType, T>::convertRepresentationsTo(const std::vector<OrientationRepresentation::Type>& repTypes)
+{
+  const auto componentCounts = GetComponentCounts<std::vector<size_t>>();
+  const auto typeStrings = GetOrientationTypeStrings<std::vector<std::string>>();
+
+  std::vector<TupleConverterType> converters;
+  for(const auto& repType : repTypes)
+  {
+    TupleConverterType converter = getTupleConverter(repType);
+    if(nullptr == converter)
+    {
+      throw std::runtime_error("OrientationConverter::convertRepresentationsTo was given an unknown orientation representation.");
+    }
+    converters.push_back(converter);
+  }
+
+  std::vector<DataArrayPointerType> outputs;
+  if(repTypes.empty())
+  {
+    return outputs;
+  }
+
+  DataArrayPointerType input = this->getInputData();
+  size_t nTuples = input->getNumberOfTuples();
+
+  std::vector<T*> outPtrs;
+  std::vector<size_t> outStrides;
+  for(const auto& repType : repTypes)
+  {
+    const size_t index = static_cast<size_t>(repType);
+    std::vector<size_t> cDims = {componentCounts[index]};
+    // Every value of the output is written by the conversion so it is not initialized with zeros first
+    DataArrayPointerType output = DataArrayType::CreateArray(nTuples, cDims, typeStrings[index], true);
+    outputs.push_back(output);
+    outPtrs.push_back(output->getPointer(0));
+    outStrides.push_back(componentCounts[index]);
+  }
+
+  convertTuples(outPtrs, outStrides, converters, 0, nTuples);
+  return outputs;
+}
+
+// -----------------------------------------------------------------------------
+template <class DataArrayType, typename T>
+void OrientationConverter<DataArrayType, T>::convertRepresentationTo(OrientationRepresentation::Type repType, DataArrayType& output)
+{
+  TupleConverterType converter = getTupleConverter(repType);
+  if(nullptr == converter)
+  {
+    throw std::runtime_error("OrientationConverter::convertRepresentationTo was given an unknown orientation representation.");
+  }
+  const size_t outStride = GetComponentCounts<std::vector<size_t>>()[static_cast<size_t>(repType)];
+  if(static_cast<size_t>(output.getNumberOfComponents()) != outStride)
+  {
+    throw std::runtime_error("OrientationConverter::convertRepresentationTo output array has the wrong number of components.");
+  }
+
+  size_t nTuples = this->getInputData()->getNumberOfTuples();
+  if(output.getNumberOfTuples() != nTuples)
+  {
+    output.resizeTuples(nTuples);
+  }
+  convertTuples({output.getPointer(0)}, {outStride}, {converter}, 0, nTuples);
+}
+
+// -----------------------------------------------------------------------------
+template <class DataArrayType, typename T>
+void OrientationConverter<DataArrayType, T>::convertRepresentationTo(OrientationRepresentation::Type repType, T* output, size_t start, size_t end)
+{
+  TupleConverterType converter = getTupleConverter(repType);
+  if(nullptr == converter)
+  {
+    throw std::runtime_error("OrientationConverter::convertRepresentationTo was given an unknown orientation representation.");
+  }
+  DataArrayPointerType input = this->getInputData();
+  if(start > end || end > input->getNumberOfTuples())
+  {
+    throw std::out_of_range("OrientationConverter::convertRepresentationTo tuple range is outside of the input data.");
+  }
+  if(start == end)
+  {
+    return;
+  }
+  const size_t outStride = GetComponentCounts<std::vector<size_t>>()[static_cast<size_t>(repType)];
+
+  convertTuples({output}, {outStride}, {converter}, start, end);
+}
+
 /**
  * @brief OC_CONVERT_BODY Generates the body of method that will perform the conversion
  */
@@ -500,7 +889,6 @@ private:
   size_t outStride = OUTSTRIDE;                                                                                                                                                                        \
   std::vector<size_t> cDims = {outStride};                                                                                                                                                             \
   DataArrayPointerType output = DataArrayType::CreateArray(nTuples, cDims, #OUT_ARRAY_NAME, true);                                                                                                     \
-  output->initializeWithZeros(); /* Intialize the array with Zeros */                                                                                                                                  \
   T* outPtr = output->getPointer(0);                                                                                                                                                                   \
   tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples), ConvertRepresentation<T, Convertors::FUNCTOR<T>>(inPtr, outPtr, inStride, outStride), tbb::auto_partitioner());                            \
   this->setOutputData(output);
@@ -516,7 +904,6 @@ private:
   size_t outStride = OUTSTRIDE;                                                                                                                                                                        \
   std::vector<size_t> cDims = {outStride}; /* Create the n component (nx1) based array.*/                                                                                                              \
   DataArrayPointerType output = DataArrayType::CreateArray(nTuples, cDims, #OUT_ARRAY_NAME, true);                                                                                                     \
-  output->initializeWithZeros(); /* Intialize the array with Zeros */                                                                                                                                  \
   T* outPtr = output->getPointer(0);                                                                                                                                                                   \
   ConvertRepresentation<T, Convertors::FUNCTOR<T>> serial(inPtr, outPtr, inStride, outStride);                                                                                                         \
   serial.convert(0, nTuples);                                                                                                                                                                          \
@@ -539,29 +926,43 @@ public:
   }
   virtual ~EulerSanityCheck() = default;
 
+  /**
+   * @brief Wraps the angles of one Euler tuple into range
+   * @return 1 if any angle was changed, 0 otherwise
+   */
+  static int CheckTuple(T* inPtr)
+  {
+    const T phi1 = inPtr[0];
+    const T phi = inPtr[1];
+    const T phi2 = inPtr[2];
+
+    inPtr[0] = static_cast<T>(std::fmod(inPtr[0], EbsdLib::Constants::k_2PiD));
+    inPtr[1] = static_cast<T>(std::fmod(inPtr[1], EbsdLib::Constants::k_PiD));
+    inPtr[2] = static_cast<T>(std::fmod(inPtr[2], EbsdLib::Constants::k_2PiD));
+
+    if(inPtr[0] < 0.0)
+    {
+      inPtr[0] *= static_cast<T>(-1.0);
+    }
+    if(inPtr[1] < 0.0)
+    {
+      inPtr[1] *= static_cast<T>(-1.0);
+    }
+    if(inPtr[2] < 0.0)
+    {
+      inPtr[2] *= static_cast<T>(-1.0);
+    }
+
+    return (phi1 != inPtr[0] || phi != inPtr[1] || phi2 != inPtr[2]) ? 1 : 0;
+  }
+
   void sanityCheck(size_t start, size_t end) const
   {
     T* inPtr = m_Input + (start * m_Stride);
 
     for(size_t i = start; i < end; ++i)
     {
-      inPtr[0] = static_cast<T>(std::fmod(inPtr[0], EbsdLib::Constants::k_2PiD));
-      inPtr[1] = static_cast<T>(std::fmod(inPtr[1], EbsdLib::Constants::k_PiD));
-      inPtr[2] = static_cast<T>(std::fmod(inPtr[2], EbsdLib::Constants::k_2PiD));
-
-      if(inPtr[0] < 0.0)
-      {
-        inPtr[0] *= static_cast<T>(-1.0);
-      }
-      if(inPtr[1] < 0.0)
-      {
-        inPtr[1] *= static_cast<T>(-1.0);
-      }
-      if(inPtr[2] < 0.0)
-      {
-        inPtr[2] *= static_cast<T>(-1.0);
-      }
-
+      CheckTuple(inPtr);
       inPtr = inPtr + m_Stride; // This is Pointer arithmetic!!
     }
   }
@@ -636,24 +1037,39 @@ public:
     OC_CONVERT_BODY(3, Stereographic, eu2st, Eu2St)
   }
 
+  TupleConverterType getTupleConverter(OrientationRepresentation::Type repType) const override
+  {
+    return this->template SelectTupleConverter<Convertors::Identity<T, 3>, Convertors::Eu2Om<T>, Convertors::Eu2Qu<T>, Convertors::Eu2Ax<T>, Convertors::Eu2Ro<T>, Convertors::Eu2Ho<T>,
+                                               Convertors::Eu2Cu<T>, Convertors::Eu2St<T>>(repType);
+  }
+
+  TupleCheckerType getTupleChecker() const override
+  {
+    return &EulerSanityCheck<T>::CheckTuple;
+  }
+
   void sanityCheckInputData() override
+  {
+    sanityCheckInputRange(0, this->getInputData()->getNumberOfTuples());
+  }
+
+  void sanityCheckInputRange(size_t start, size_t end) override
   {
     DataArrayPointerType input = this->getInputData();
     T* inPtr = input->getPointer(0);
-    size_t nTuples = input->getNumberOfTuples();
     int inStride = input->getNumberOfComponents();
 
 #ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
     bool doParallel = true;
     if(doParallel)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples), EulerSanityCheck<T>(inPtr, inStride), tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(start, end), EulerSanityCheck<T>(inPtr, inStride), tbb::auto_partitioner());
     }
     else
 #endif
     {
       EulerSanityCheck<T> serial(inPtr, inStride);
-      serial.sanityCheck(0, nTuples);
+      serial.sanityCheck(start, end);
     }
   }
 
@@ -723,24 +1139,31 @@ public:
   }
   virtual ~OrientationMatrixSanityCheck() = default;
 
+  /**
+   * @brief Checks that one orientation matrix is orthonormal with a determinant of +1 and
+   * prints the matrix if it is not. A matrix that fails cannot be repaired here and is left
+   * unchanged.
+   * @return -1 if the matrix is invalid, 0 otherwise
+   */
+  static int CheckTuple(T* inPtr)
+  {
+    OrientationTransformation::ResultType res = OrientationTransformation::om_check(FixedOrientation<T, 9>(inPtr));
+    if(res.result <= 0)
+    {
+      std::cout << res.msg << std::endl;
+      printRepresentation(std::cout, inPtr, std::string("Bad OM"));
+      return -1;
+    }
+    return 0;
+  }
+
   void sanityCheck(size_t start, size_t end) const
   {
     T* inPtr = m_Input + (start * m_Stride);
 
     for(size_t i = start; i < end; ++i)
     {
-      using Orientation_Type = Orientation<T>;
-      using ResultType = OrientationTransformation::ResultType;
-
-      Orientation_Type oaType(inPtr, 9);
-
-      ResultType res = OrientationTransformation::om_check(oaType);
-      if(res.result <= 0)
-      {
-        std::cout << res.msg << std::endl;
-        printRepresentation(std::cout, inPtr, std::string("Bad OM"));
-      }
-
+      CheckTuple(inPtr);
       inPtr = inPtr + m_Stride; // This is Pointer arithmetic!!
     }
   }
@@ -758,7 +1181,7 @@ public:
    * @param om
    * @param label
    */
-  void printRepresentation(std::ostream& out, T* om, const std::string& label = std::string("Om")) const
+  static void printRepresentation(std::ostream& out, T* om, const std::string& label = std::string("Om"))
   {
     out.precision(16);
     out << label << om[0] << '\t' << om[1] << '\t' << om[2] << std::endl;
@@ -832,24 +1255,39 @@ public:
     OC_CONVERT_BODY(3, Stereographic, om2st, Om2St)
   }
 
+  TupleConverterType getTupleConverter(OrientationRepresentation::Type repType) const override
+  {
+    return this->template SelectTupleConverter<Convertors::Om2Eu<T>, Convertors::Identity<T, 9>, Convertors::Om2Qu<T>, Convertors::Om2Ax<T>, Convertors::Om2Ro<T>, Convertors::Om2Ho<T>,
+                                               Convertors::Om2Cu<T>, Convertors::Om2St<T>>(repType);
+  }
+
+  TupleCheckerType getTupleChecker() const override
+  {
+    return &OrientationMatrixSanityCheck<T>::CheckTuple;
+  }
+
   void sanityCheckInputData() override
+  {
+    sanityCheckInputRange(0, this->getInputData()->getNumberOfTuples());
+  }
+
+  void sanityCheckInputRange(size_t start, size_t end) override
   {
     DataArrayPointerType input = this->getInputData();
     T* inPtr = input->getPointer(0);
-    size_t nTuples = input->getNumberOfTuples();
     int inStride = input->getNumberOfComponents();
 
 #ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
     bool doParallel = true;
     if(doParallel)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples), OrientationMatrixSanityCheck<T>(inPtr, inStride), tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(start, end), OrientationMatrixSanityCheck<T>(inPtr, inStride), tbb::auto_partitioner());
     }
     else
 #endif
     {
       OrientationMatrixSanityCheck<T> serial(inPtr, inStride);
-      serial.sanityCheck(0, nTuples);
+      serial.sanityCheck(start, end);
     }
   }
 
@@ -998,6 +1436,12 @@ public:
     OC_CONVERT_BODY(3, Stereographic, qu2st, Qu2St)
   }
 
+  TupleConverterType getTupleConverter(OrientationRepresentation::Type repType) const override
+  {
+    return this->template SelectTupleConverter<Convertors::Qu2Eu<T>, Convertors::Qu2Om<T>, Convertors::Identity<T, 4>, Convertors::Qu2Ax<T>, Convertors::Qu2Ro<T>, Convertors::Qu2Ho<T>,
+                                               Convertors::Qu2Cu<T>, Convertors::Qu2St<T>>(repType);
+  }
+
   void sanityCheckInputData() override
   {
     /* Apparently there is no sanity check for Quaternions, Odd. We place this
@@ -1161,6 +1605,12 @@ public:
     OC_CONVERT_BODY(3, Stereographic, ax2st, Ax2St)
   }
 
+  TupleConverterType getTupleConverter(OrientationRepresentation::Type repType) const override
+  {
+    return this->template SelectTupleConverter<Convertors::Ax2Eu<T>, Convertors::Ax2Om<T>, Convertors::Ax2Qu<T>, Convertors::Identity<T, 4>, Convertors::Ax2Ro<T>, Convertors::Ax2Ho<T>,
+                                               Convertors::Ax2Cu<T>, Convertors::Ax2St<T>>(repType);
+  }
+
   void sanityCheckInputData() override
   {
     /* Apparently there is no sanity check for AxisAngle, Odd. We place this
@@ -1325,6 +1775,12 @@ public:
     OC_CONVERT_BODY(3, Stereographic, ro2st, Ro2St)
   }
 
+  TupleConverterType getTupleConverter(OrientationRepresentation::Type repType) const override
+  {
+    return this->template SelectTupleConverter<Convertors::Ro2Eu<T>, Convertors::Ro2Om<T>, Convertors::Ro2Qu<T>, Convertors::Ro2Ax<T>, Convertors::Identity<T, 4>, Convertors::Ro2Ho<T>,
+                                               Convertors::Ro2Cu<T>, Convertors::Ro2St<T>>(repType);
+  }
+
   void sanityCheckInputData() override
   {
     /* Apparently there is no sanity check for Rodrigues, Odd. We place this
@@ -1489,6 +1945,12 @@ public:
     OC_CONVERT_BODY(3, Stereographic, ho2st, Ho2St)
   }
 
+  TupleConverterType getTupleConverter(OrientationRepresentation::Type repType) const override
+  {
+    return this->template SelectTupleConverter<Convertors::Ho2Eu<T>, Convertors::Ho2Om<T>, Convertors::Ho2Qu<T>, Convertors::Ho2Ax<T>, Convertors::Ho2Ro<T>, Convertors::Identity<T, 3>,
+                                               Convertors::Ho2Cu<T>, Convertors::Ho2St<T>>(repType);
+  }
+
   void sanityCheckInputData() override
   {
     /* Apparently there is no sanity check for Homochoric, Odd. We place this
@@ -1654,6 +2116,12 @@ public:
     OC_CONVERT_BODY(3, Stereographic, cu2st, Cu2St)
   }
 
+  TupleConverterType getTupleConverter(OrientationRepresentation::Type repType) const override
+  {
+    return this->template SelectTupleConverter<Convertors::Cu2Eu<T>, Convertors::Cu2Om<T>, Convertors::Cu2Qu<T>, Convertors::Cu2Ax<T>, Convertors::Cu2Ro<T>, Convertors::Cu2Ho<T>,
+                                               Convertors::Identity<T, 3>, Convertors::Cu2St<T>>(repType);
+  }
+
   void sanityCheckInputData() override
   {
     /* Apparently there is no sanity check for Cubochoric, Odd. We place this
@@ -1818,6 +2286,12 @@ public:
     this->setOutputData(output);
   }
 
+  TupleConverterType getTupleConverter(OrientationRepresentation::Type repType) const override
+  {
+    return this->template SelectTupleConverter<Convertors::St2Eu<T>, Convertors::St2Om<T>, Convertors::St2Qu<T>, Convertors::St2Ax<T>, Convertors::St2Ro<T>, Convertors::St2Ho<T>,
+                                               Convertors::St2Cu<T>, Convertors::Identity<T, 3>>(repType);
+  }
+
   void sanityCheckInputData() override
   {
     /* Apparently there is no sanity check for Spbochoric, Odd. We place this
@@ -176,6 +176,10 @@ LibraryProperties(${PROJECT_NAME} ${EXE_DEBUG_EXTENSION})
 
 if(EbsdLib_USE_PARALLEL_ALGORITHMS)
   target_link_libraries(${PROJECT_NAME} PUBLIC TBB::tbb TBB::tbbmalloc)
+else()
+  # ParallelDataAlgorithm falls back to std::thread
+  find_package(Threads REQUIRED)
+  target_link_libraries(${PROJECT_NAME} PUBLIC Threads::Threads)
 endif()
 
 # --------------------------------------------------------------------
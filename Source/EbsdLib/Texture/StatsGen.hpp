@@ -39,15 +39,125 @@
 #define WIN32_LEAN_AND_MEAN // Exclude rarely-used stuff from Windows headers
 #endif
 
-#include <chrono>
+#include <array>
+#include <iostream>
 #include <random>
+#include <vector>
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/LaueOps/LaueOps.h"
+#include "EbsdLib/Math/DiscreteSampler.hpp"
 #include "EbsdLib/Math/EbsdLibMath.h"
 #include "EbsdLib/Math/EbsdLibRandom.h"
+#include "EbsdLib/Math/Philox.hpp"
+#include "EbsdLib/Math/RandomService.h"
 #include "EbsdLib/Texture/Texture.hpp"
+#include "EbsdLib/Utilities/ParallelDataAlgorithm.hpp"
+
+namespace StatsGenDetail
+{
+// Samples are drawn in blocks of EbsdLib::RandomService::k_SampleBlockSize, see its documentation
+inline size_t NumSampleBlocks(size_t count)
+{
+  return (count + EbsdLib::RandomService::k_SampleBlockSize - 1) / EbsdLib::RandomService::k_SampleBlockSize;
+}
+
+/**
+ * @brief SampleODFImpl draws Euler angles from an ODF for a range of points
+ */
+template <typename T, typename DensityType, class LaueOpsType>
+class SampleODFImpl
+{
+public:
+  SampleODFImpl(const LaueOpsType& ops, const DiscreteSampler<DensityType>& sampler, T* eulers, uint64_t seed)
+  : m_Ops(ops)
+  , m_Sampler(sampler)
+  , m_Eulers(eulers)
+  , m_Seed(seed)
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    std::array<double, 3> randx3;
+    for(size_t i = start; i < end; i++)
+    {
+      EbsdLib::PhiloxEngine generator(m_Seed, i);
+      DensityType random = static_cast<DensityType>(generator.nextDouble());
+      int choose = static_cast<int>(m_Sampler.find(random));
+      randx3[0] = generator.nextDouble();
+      randx3[1] = generator.nextDouble();
+      randx3[2] = generator.nextDouble();
+      OrientationD eu = m_Ops.determineEulerAngles(randx3.data(), choose);
+      m_Eulers[3 * i + 0] = static_cast<T>(eu[0]);
+      m_Eulers[3 * i + 1] = static_cast<T>(eu[1]);
+      m_Eulers[3 * i + 2] = static_cast<T>(eu[2]);
+    }
+  }
+
+private:
+  const LaueOpsType& m_Ops;
+  const DiscreteSampler<DensityType>& m_Sampler;
+  T* m_Eulers = nullptr;
+  uint64_t m_Seed = 0;
+};
+
+/**
+ * @brief SampleMDFImpl draws misorientations from an MDF for a range of blocks of points and counts
+ * their angles into 5 degree bins. Every block has its own counts which are summed afterwards. The
+ * last entry of each block's counts holds the samples whose angle fell outside of the bins.
+ */
+template <class LaueOpsType>
+class SampleMDFImpl
+{
+public:
+  SampleMDFImpl(const LaueOpsType& ops, const DiscreteSampler<float>& sampler, size_t numSamples, uint64_t seed, std::vector<std::vector<size_t>>& blockCounts)
+  : m_Ops(ops)
+  , m_Sampler(sampler)
+  , m_NumSamples(numSamples)
+  , m_Seed(seed)
+  , m_BlockCounts(blockCounts)
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    const float radtodeg = 180.0f / static_cast<float>(M_PI);
+    std::array<double, 3> randx3;
+    for(size_t block = start; block < end; block++)
+    {
+      std::vector<size_t>& counts = m_BlockCounts[block];
+      const size_t last = std::min((block + 1) * EbsdLib::RandomService::k_SampleBlockSize, m_NumSamples);
+      for(size_t i = block * EbsdLib::RandomService::k_SampleBlockSize; i < last; i++)
+      {
+        EbsdLib::PhiloxEngine generator(m_Seed, i);
+        float random = static_cast<float>(generator.nextDouble());
+        int choose = static_cast<int>(m_Sampler.find(random));
+
+        // Create a random rod vector
+        randx3[0] = generator.nextDouble();
+        randx3[1] = generator.nextDouble();
+        randx3[2] = generator.nextDouble();
+
+        OrientationD rod = m_Ops.determineRodriguesVector(randx3.data(), choose);
+        OrientationD ax = OrientationTransformation::ro2ax<OrientationD, OrientationD>(rod);
+
+        float w = static_cast<float>(ax[3] * radtodeg);
+        size_t index = static_cast<size_t>(w * 0.2f);
+        counts[std::min(index, counts.size() - 1)]++;
+      }
+    }
+  }
+
+private:
+  const LaueOpsType& m_Ops;
+  const DiscreteSampler<float>& m_Sampler;
+  size_t m_NumSamples = 0;
+  uint64_t m_Seed = 0;
+  std::vector<std::vector<size_t>>& m_BlockCounts;
+};
+} // namespace StatsGenDetail
 
 /**
  * @brief This class contains static functions to generate ODF and MDF data as X,Y points. This data can be discretized
@@ -244,45 +354,14 @@ public:
   template <typename T, class LaueOpsType, class ContainerType>
   static int GenODFPlotData(const ContainerType& odf, T* eulers, size_t npoints)
   {
-    std::random_device randomDevice;           // Will be used to obtain a seed for the random number engine
-    std::mt19937_64 generator(randomDevice()); // Standard mersenne_twister_engine seeded with rd()
-    std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-    generator.seed(seed);
-    std::uniform_real_distribution<> distribution(0.0, 1.0);
-    std::array<double, 3> randx3;
-
-    int err = 0;
-    int choose = 0;
-    T totaldensity;
-    T random, density;
-
     LaueOpsType ops;
-    T td1;
-    for(size_t i = 0; i < npoints; i++)
-    {
-      random = distribution(generator);
-      choose = 0;
-      totaldensity = 0;
-      for(int j = 0; j < ops.getODFSize(); j++)
-      {
-        density = odf[j];
-        td1 = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random < totaldensity && random >= td1)
-        {
-          choose = static_cast<int>(j);
-          break;
-        }
-      }
-      randx3[0] = distribution(generator);
-      randx3[1] = distribution(generator);
-      randx3[2] = distribution(generator);
-      OrientationD eu = ops.determineEulerAngles(randx3.data(), choose);
-      eulers[3 * i + 0] = eu[0];
-      eulers[3 * i + 1] = eu[1];
-      eulers[3 * i + 2] = eu[2];
-    }
-    return err;
+    DiscreteSampler<T> sampler(odf, static_cast<size_t>(ops.getODFSize()));
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, npoints);
+    dataAlg.setGrain(EbsdLib::RandomService::k_SampleBlockSize);
+    dataAlg.execute(StatsGenDetail::SampleODFImpl<T, T, LaueOpsType>(ops, sampler, eulers, EbsdLib::RandomService::GetThreadEngine()()));
+    return 0;
   }
 #if 0
 
@@ -448,46 +527,15 @@ public:
   template <typename T>
   static int GenAxisODFPlotData(T* odf, T* eulers, int npoints)
   {
-
-    std::random_device randomDevice;           // Will be used to obtain a seed for the random number engine
-    std::mt19937_64 generator(randomDevice()); // Standard mersenne_twister_engine seeded with rd()
-    std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-    generator.seed(seed);
-    std::uniform_real_distribution<> distribution(0.0, 1.0);
-    std::array<double, 3> randx3;
-
-    int err = 0;
-    int choose;
-    float totaldensity;
-    float random, density;
     OrthoRhombicOps ops;
-
-    float td1;
-    for(int i = 0; i < npoints; i++)
-    {
-      random = distribution(generator);
-      choose = 0;
-      totaldensity = 0;
-      for(int j = 0; j < ops.getODFSize(); j++)
-      {
-        density = odf[j];
-        td1 = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random < totaldensity && random >= td1)
-        {
-          choose = static_cast<int>(j);
-          break;
-        }
-      }
-      randx3[0] = distribution(generator);
-      randx3[1] = distribution(generator);
-      randx3[2] = distribution(generator);
-      OrientationD eu = ops.determineEulerAngles(randx3.data(), choose);
-      eulers[3 * i + 0] = eu[0];
-      eulers[3 * i + 1] = eu[1];
-      eulers[3 * i + 2] = eu[2];
-    }
-    return err;
+    DiscreteSampler<float> sampler(odf, static_cast<size_t>(ops.getODFSize()));
+
+    const size_t numPoints = static_cast<size_t>(std::max(npoints, 0));
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numPoints);
+    dataAlg.setGrain(EbsdLib::RandomService::k_SampleBlockSize);
+    dataAlg.execute(StatsGenDetail::SampleODFImpl<T, float, OrthoRhombicOps>(ops, sampler, eulers, EbsdLib::RandomService::GetThreadEngine()()));
+    return 0;
   }
 
   /**
@@ -502,79 +550,40 @@ public:
   template <typename T, class LaueOpsType, class ContainerType>
   static int GenMDFPlotData(ContainerType& mdf, ContainerType& xval, ContainerType& yval, int size)
   {
-    float radtodeg = 180.0f / static_cast<float>(M_PI);
-
-    std::random_device randomDevice;           // Will be used to obtain a seed for the random number engine
-    std::mt19937_64 generator(randomDevice()); // Standard mersenne_twister_engine seeded with rd()
-    std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-    generator.seed(seed);
-    std::uniform_real_distribution<> distribution(0.0, 1.0);
-
-    int err = 0;
-    float density = 0.0f;
-    float totaldensity = 0.0f;
-    int choose = 0;
-    float random = 0.0f;
-
     LaueOpsType ops;
     xval.resize(ops.getMdfPlotBins());
     yval.resize(ops.getMdfPlotBins());
-    int32_t opsMdfSize = ops.getMDFSize();
-    std::array<double, 3> randx3;
+    DiscreteSampler<float> sampler(mdf, static_cast<size_t>(ops.getMDFSize()));
 
-    for(int i = 0; i < yval.size(); i++)
-    {
-      yval[i] = 0.0f;
-    }
+    const size_t numSamples = static_cast<size_t>(std::max(size, 0));
+    const size_t numBlocks = StatsGenDetail::NumSampleBlocks(numSamples);
+    // One extra bin per block counts the samples that fall outside of the plot
+    std::vector<std::vector<size_t>> blockCounts(numBlocks, std::vector<size_t>(yval.size() + 1, 0));
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numBlocks);
+    dataAlg.execute(StatsGenDetail::SampleMDFImpl<LaueOpsType>(ops, sampler, numSamples, EbsdLib::RandomService::GetThreadEngine()(), blockCounts));
 
-    float td1 = 0.0f;
-    for(int i = 0; i < size; i++)
+    for(size_t i = 0; i < yval.size(); i++)
     {
-      random = static_cast<float>(distribution(generator));
-      choose = 0;
-      totaldensity = 0;
-      for(int j = 0; j < opsMdfSize; j++)
+      size_t count = 0;
+      for(const auto& counts : blockCounts)
       {
-        density = mdf[j];
-        td1 = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random < totaldensity && random >= td1)
-        {
-          choose = static_cast<int>(j);
-          break;
-        }
+        count += counts[i];
       }
+      xval[i] = static_cast<T>(i * 5.0 + 2.5);
+      yval[i] = static_cast<float>(count) / static_cast<float>(size);
+    }
 
-      // Create a random rod vector
-      randx3 = {distribution(generator), distribution(generator), distribution(generator)};
-
-      OrientationD rod = ops.determineRodriguesVector(randx3.data(), choose);
-      OrientationD ax = OrientationTransformation::ro2ax<OrientationD, OrientationD>(rod);
-
-      float w = static_cast<float>(ax[3] * radtodeg);
-      size_t index = static_cast<size_t>(w * 0.2f);
-      if(index < yval.size())
-      {
-        yval[index]++;
-      }
-      else
-      {
-        // yval.resize(index + 1);
-        // yval[index] = 0.0f;
-        // xval.resize(index + 1);
-        std::cout << "yval[14]: " << yval[index] << std::endl;
-        std::cout << "w: " << w << "   choose: " << choose << std::endl;
-        std::cout << "randx3: " << randx3[0] << ", " << randx3[1] << ", " << randx3[2] << std::endl;
-        std::cout << "rod: " << rod[0] << ", " << rod[1] << ", " << rod[2] << ", " << rod[3] << std::endl;
-        std::cout << "ax: " << ax[0] << ", " << ax[1] << ", " << ax[2] << ", " << ax[3] << std::endl;
-      }
+    size_t outOfRange = 0;
+    for(const auto& counts : blockCounts)
+    {
+      outOfRange += counts.back();
     }
-    for(int i = 0; i < yval.size(); i++)
+    if(outOfRange > 0)
     {
-      xval[i] = static_cast<T>(i * 5.0 + 2.5);
-      yval[i] = yval[i] / static_cast<float>(size);
+      std::cout << "StatsGen::GenMDFPlotData: " << outOfRange << " of " << numSamples << " misorientation samples were outside of the " << yval.size() << " plot bins" << std::endl;
     }
-    return err;
+    return 0;
   }
 #if 0
   /**
@@ -35,8 +35,10 @@
 
 #pragma once
 
-#include <chrono>
+#include <array>
+#include <cmath>
 #include <fstream>
+#include <map>
 #include <random>
 #include <vector>
 
@@ -51,8 +53,196 @@
 #include "EbsdLib/LaueOps/HexagonalOps.h"
 #include "EbsdLib/LaueOps/LaueOps.h"
 #include "EbsdLib/LaueOps/OrthoRhombicOps.h"
+#include "EbsdLib/Math/DiscreteSampler.hpp"
 #include "EbsdLib/Math/EbsdLibMath.h"
 #include "EbsdLib/Math/EbsdLibRandom.h"
+#include "EbsdLib/Math/Philox.hpp"
+#include "EbsdLib/Math/RandomService.h"
+#include "EbsdLib/Utilities/ParallelDataAlgorithm.hpp"
+
+namespace TextureDetail
+{
+/**
+ * @brief SampleMisorientationsImpl draws pairs of orientations from an ODF for a range of blocks of
+ * samples and counts the MDF bins of their misorientations. A sample that lands in a bin whose value
+ * was fixed by the caller (a negative MDF value) is drawn again. Every block of
+ * EbsdLib::RandomService::k_SampleBlockSize samples has its own counts which are summed afterwards.
+ */
+template <class LaueOpsType, class Container>
+class SampleMisorientationsImpl
+{
+public:
+  SampleMisorientationsImpl(const LaueOpsType& ops, const DiscreteSampler<float>& sampler, const Container& mdf, size_t numSamples, uint64_t seed, std::vector<std::vector<size_t>>& blockCounts)
+  : m_Ops(ops)
+  , m_Sampler(sampler)
+  , m_Mdf(mdf)
+  , m_NumSamples(numSamples)
+  , m_Seed(seed)
+  , m_BlockCounts(blockCounts)
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t block = start; block < end; block++)
+    {
+      std::vector<size_t>& counts = m_BlockCounts[block];
+      const size_t last = std::min((block + 1) * EbsdLib::RandomService::k_SampleBlockSize, m_NumSamples);
+      for(size_t i = block * EbsdLib::RandomService::k_SampleBlockSize; i < last; i++)
+      {
+        // Draws that are rejected advance the stream of this sample only
+        EbsdLib::PhiloxEngine generator(m_Seed, i);
+        int mbin = 0;
+        do
+        {
+          int choose1 = static_cast<int>(m_Sampler.find(static_cast<float>(generator.nextDouble())));
+          int choose2 = static_cast<int>(m_Sampler.find(static_cast<float>(generator.nextDouble())));
+
+          // This is used to create a random Homochoric vector
+          std::array<double, 3> randx3 = {0.0, 0.0, 0.0};
+          randx3[0] = generator.nextDouble();
+          randx3[1] = generator.nextDouble();
+          randx3[2] = generator.nextDouble();
+          OrientationD eu = m_Ops.determineEulerAngles(randx3.data(), choose1);
+          QuatD q1 = OrientationTransformation::eu2qu<OrientationD, QuatD>(eu);
+
+          randx3[0] = generator.nextDouble();
+          randx3[1] = generator.nextDouble();
+          randx3[2] = generator.nextDouble();
+          eu = m_Ops.determineEulerAngles(randx3.data(), choose2);
+          QuatD q2 = OrientationTransformation::eu2qu<OrientationD, QuatD>(eu);
+          OrientationD ax = m_Ops.calculateMisorientation(q1, q2);
+          OrientationD ro = OrientationTransformation::ax2ro<OrientationD, OrientationD>(ax);
+
+          ro = m_Ops.getMDFFZRod(ro); // <==== THIS IS NOT IMPELMENTED FOR ALL LAUE CLASSES
+          mbin = m_Ops.getMisoBin(ro);
+        } while(m_Mdf[mbin] < 0);
+        counts[mbin]++;
+      }
+    }
+  }
+
+private:
+  const LaueOpsType& m_Ops;
+  const DiscreteSampler<float>& m_Sampler;
+  const Container& m_Mdf;
+  size_t m_NumSamples = 0;
+  uint64_t m_Seed = 0;
+  std::vector<std::vector<size_t>>& m_BlockCounts;
+};
+
+/**
+ * @brief ODFKernel holds the bin offsets that a texture component of a given radius (in bins) spreads
+ * its weight into together with the fraction of the weight that each offset receives. The offsets
+ * are grouped by their offset along the third bin axis.
+ */
+struct ODFKernel
+{
+  struct Offset
+  {
+    int j = 0;
+    int k = 0;
+    float fraction = 0.0f;
+  };
+
+  explicit ODFKernel(int kernelRadius)
+  : radius(kernelRadius)
+  , layers(static_cast<size_t>(2 * kernelRadius + 1))
+  {
+    for(int j = -radius; j <= radius; j++)
+    {
+      for(int k = -radius; k <= radius; k++)
+      {
+        for(int l = -radius; l <= radius; l++)
+        {
+          float dist = static_cast<float>(std::pow(static_cast<float>(j * j + k * k + l * l), 0.5));
+          if(dist <= radius)
+          {
+            float fraction = static_cast<float>(1.0 - (double(dist / radius) * double(dist / radius)));
+            layers[static_cast<size_t>(l + radius)].push_back({j, k, fraction});
+          }
+        }
+      }
+    }
+  }
+
+  int radius = 0;
+  std::vector<std::vector<Offset>> layers;
+};
+
+/**
+ * @brief ODFComponent is one weighted texture component reduced to its ODF bin and kernel
+ */
+template <typename T>
+struct ODFComponent
+{
+  int bin1 = 0;
+  int bin2 = 0;
+  int bin3 = 0;
+  const ODFKernel* kernel = nullptr;
+  T weight = static_cast<T>(0);
+  bool exact = false; // A sigma of exactly zero puts the whole weight into the bin
+};
+
+/**
+ * @brief SpreadODFComponentsImpl adds the kernels of all the components to a range of layers (third
+ * bin index) of the ODF and records the weight added to each layer.
+ */
+template <class Container>
+class SpreadODFComponentsImpl
+{
+public:
+  using ValueType = typename Container::value_type;
+
+  SpreadODFComponentsImpl(const std::vector<ODFComponent<ValueType>>& components, const std::array<size_t, 3>& numBins, Container& odf, std::vector<float>& layerWeights)
+  : m_Components(components)
+  , m_NumBins(numBins)
+  , m_Odf(odf)
+  , m_LayerWeights(layerWeights)
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    const int numBins1 = static_cast<int>(m_NumBins[0]);
+    const int numBins2 = static_cast<int>(m_NumBins[1]);
+    for(size_t layer = start; layer < end; layer++)
+    {
+      float layerWeight = 0.0f;
+      const size_t layerOffset = layer * m_NumBins[0] * m_NumBins[1];
+      for(const auto& component : m_Components)
+      {
+        const int radius = component.kernel->radius;
+        const int l = static_cast<int>(layer) - component.bin3;
+        if(l < -radius || l > radius)
+        {
+          continue;
+        }
+        for(const auto& offset : component.kernel->layers[static_cast<size_t>(l + radius)])
+        {
+          const int addbin1 = component.bin1 + offset.j;
+          const int addbin2 = component.bin2 + offset.k;
+          if(addbin1 < 0 || addbin1 >= numBins1 || addbin2 < 0 || addbin2 >= numBins2)
+          {
+            continue;
+          }
+          float addweight = component.exact ? static_cast<float>(component.weight) : static_cast<float>(component.weight * offset.fraction);
+          const size_t addbin = layerOffset + static_cast<size_t>(addbin2 * numBins1 + addbin1);
+          m_Odf[addbin] = m_Odf[addbin] + addweight;
+          layerWeight = layerWeight + addweight;
+        }
+      }
+      m_LayerWeights[layer] = layerWeight;
+    }
+  }
+
+private:
+  const std::vector<ODFComponent<ValueType>>& m_Components;
+  std::array<size_t, 3> m_NumBins = {0, 0, 0};
+  Container& m_Odf;
+  std::vector<float>& m_LayerWeights;
+};
+} // namespace TextureDetail
 
 /**
  * @brief This class holds default data for Orientation Distribution Function (ODF)
@@ -85,94 +275,63 @@ public:
   template <typename T, class LaueOps, class Container>
   static void CalculateODFData(Container& e1s, Container& e2s, Container& e3s, Container& weights, Container& sigmas, bool normalize, Container& odf, size_t numEntries)
   {
+    using ValueType = typename Container::value_type;
     LaueOps ops;
     std::array<size_t, 3> odfNumBins = ops.getOdfNumBins();
     odf.resize(ops.getODFSize());
-    EbsdLib::Int32ArrayType::Pointer textureBins = EbsdLib::Int32ArrayType::CreateArray(numEntries, "TextureBins", true);
-    int32_t* TextureBins = textureBins->getPointer(0);
 
-    float addweight = 0;
     float totaladdweight = 0;
     float totalweight = float(ops.getODFSize());
-    int bin, addbin;
-    int bin1, bin2, bin3;
-    int addbin1, addbin2, addbin3;
-    float dist, fraction;
-    // Use double precision for the calculations
+
+    // Each distinct radius gets its kernel built once
+    std::map<int, TextureDetail::ODFKernel> kernels;
+    std::vector<TextureDetail::ODFComponent<ValueType>> components;
+    components.reserve(numEntries);
     for(size_t i = 0; i < numEntries; i++)
     {
-      OrientationF eu(e1s[i], e2s[i], e3s[i]);
-      OrientationD rod = OrientationTransformation::eu2ro<OrientationF, OrientationD>(eu);
+      if(sigmas[i] < 0)
+      {
+        continue;
+      }
+      Orientation<ValueType> eu(e1s[i], e2s[i], e3s[i]);
+      OrientationD rod = OrientationTransformation::eu2ro<Orientation<ValueType>, OrientationD>(eu);
 
       rod = ops.getODFFZRod(rod);
-      bin = ops.getOdfBin(rod);
-      TextureBins[i] = static_cast<int>(bin);
+      int bin = ops.getOdfBin(rod);
+      int radius = static_cast<int>(sigmas[i]);
+      auto iter = kernels.find(radius);
+      if(iter == kernels.end())
+      {
+        iter = kernels.emplace(radius, TextureDetail::ODFKernel(radius)).first;
+      }
+
+      TextureDetail::ODFComponent<ValueType> component;
+      component.bin1 = static_cast<int>(bin % odfNumBins[0]);
+      component.bin2 = static_cast<int>((bin / odfNumBins[0]) % odfNumBins[1]);
+      component.bin3 = static_cast<int>(bin / (odfNumBins[0] * odfNumBins[1]));
+      component.kernel = &(iter->second);
+      component.weight = weights[i];
+      component.exact = (sigmas[i] == 0.0);
+      components.push_back(component);
     }
 
     for(int i = 0; i < ops.getODFSize(); i++)
     {
       odf[i] = 0;
     }
-    for(size_t i = 0; i < numEntries; i++)
+
+    // Every layer of the ODF is filled by one task so there is nothing to merge and each bin
+    // receives its contributions in the order of the entries.
+    std::vector<float> layerWeights(odfNumBins[2], 0.0f);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, odfNumBins[2]);
+    dataAlg.setGrain(1);
+    dataAlg.execute(TextureDetail::SpreadODFComponentsImpl<Container>(components, odfNumBins, odf, layerWeights));
+    for(float layerWeight : layerWeights)
     {
-      bin = TextureBins[i];
-      bin1 = bin % odfNumBins[0];
-      bin2 = static_cast<int32_t>((bin / odfNumBins[0]) % odfNumBins[1]);
-      bin3 = bin / static_cast<int32_t>((odfNumBins[0] * odfNumBins[1]));
-      for(int j = static_cast<int>(-sigmas[i]); j <= sigmas[i]; j++)
-      {
-        int jsqrd = j * j;
-        for(int k = static_cast<int>(-sigmas[i]); k <= sigmas[i]; k++)
-        {
-          int ksqrd = k * k;
-          for(int l = static_cast<int>(-sigmas[i]); l <= sigmas[i]; l++)
-          {
-            int lsqrd = l * l;
-            addbin1 = bin1 + int(j);
-            addbin2 = bin2 + int(k);
-            addbin3 = bin3 + int(l);
-            int good = 1;
-            if(addbin1 < 0)
-            {
-              good = 0;
-            }
-            if(addbin1 >= odfNumBins[0])
-            {
-              good = 0;
-            }
-            if(addbin2 < 0)
-            {
-              good = 0;
-            }
-            if(addbin2 >= odfNumBins[1])
-            {
-              good = 0;
-            }
-            if(addbin3 < 0)
-            {
-              good = 0;
-            }
-            if(addbin3 >= odfNumBins[2])
-            {
-              good = 0;
-            }
-            addbin = static_cast<int>((addbin3 * odfNumBins[0] * odfNumBins[1]) + (addbin2 * odfNumBins[0]) + (addbin1));
-            dist = static_cast<float>(std::pow(static_cast<float>(jsqrd + ksqrd + lsqrd), 0.5));
-            fraction = static_cast<float>(1.0 - (double(dist / int(sigmas[i])) * double(dist / int(sigmas[i]))));
-            if(dist <= int(sigmas[i]) && good == 1)
-            {
-              addweight = (weights[i] * fraction);
-              if(sigmas[i] == 0.0)
-              {
-                addweight = weights[i];
-              }
-              odf[addbin] = odf[addbin] + addweight;
-              totaladdweight = totaladdweight + addweight;
-            }
-          }
-        }
-      }
+      totaladdweight = totaladdweight + layerWeight;
     }
+
     // These next loops *look* like they can be parallelized but the arrays are not large enough
     // to see any benefit so don't go down that road. std::transform is also slower than the
     // manual loops that are coded.
@@ -223,17 +382,7 @@ public:
     const int mdfsize = orientationOps.getMDFSize();
     mdf.resize(orientationOps.getMDFSize());
 
-    // Create a Random Number generator
-    std::random_device randomDevice;           // Will be used to obtain a seed for the random number engine
-    std::mt19937_64 generator(randomDevice()); // Standard mersenne_twister_engine seeded with rd()
-    std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-    generator.seed(seed);
-    std::uniform_real_distribution<> distribution(0.0, 1.0);
-
     int mbin;
-    int choose1, choose2;
-    float totaldensity;
-    float random1, random2, density;
 
     for(int i = 0; i < mdfsize; i++)
     {
@@ -252,47 +401,21 @@ public:
       remainingcount = static_cast<int>(remainingcount + mdf[mbin]);
     }
 
-    for(int i = 0; i < remainingcount; i++)
+    if(remainingcount > 0)
     {
-      random1 = static_cast<float>(distribution(generator));
-      random2 = static_cast<float>(distribution(generator));
-      choose1 = 0;
-      choose2 = 0;
-      totaldensity = 0;
-      for(size_t j = 0; j < odfsize; j++)
+      DiscreteSampler<float> sampler(odf, odfsize);
+      const size_t numSamples = static_cast<size_t>(remainingcount);
+      const size_t numBlocks = (numSamples + EbsdLib::RandomService::k_SampleBlockSize - 1) / EbsdLib::RandomService::k_SampleBlockSize;
+      std::vector<std::vector<size_t>> blockCounts(numBlocks, std::vector<size_t>(static_cast<size_t>(mdfsize), 0));
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, numBlocks);
+      dataAlg.execute(TextureDetail::SampleMisorientationsImpl<LaueOps, Container>(orientationOps, sampler, mdf, numSamples, EbsdLib::RandomService::GetThreadEngine()(), blockCounts));
+      for(const auto& counts : blockCounts)
       {
-        density = odf[j];
-        float d = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random1 >= d && random1 < totaldensity)
+        for(size_t i = 0; i < counts.size(); i++)
         {
-          choose1 = static_cast<int>(j);
+          mdf[i] += static_cast<T>(counts[i]);
         }
-        if(random2 >= d && random2 < totaldensity)
-        {
-          choose2 = static_cast<int>(j);
-        }
-      }
-      // This is used to create a random Homochoric vector
-      std::array<double, 3> randx3 = {distribution(generator), distribution(generator), distribution(generator)};
-      OrientationD eu = orientationOps.determineEulerAngles(randx3.data(), choose1);
-      QuatD q1 = OrientationTransformation::eu2qu<OrientationD, QuatD>(eu);
-
-      randx3 = {distribution(generator), distribution(generator), distribution(generator)};
-      eu = orientationOps.determineEulerAngles(randx3.data(), choose2);
-      QuatD q2 = OrientationTransformation::eu2qu<OrientationD, QuatD>(eu);
-      OrientationD ax = orientationOps.calculateMisorientation(q1, q2);
-      OrientationD ro = OrientationTransformation::ax2ro<OrientationD, OrientationD>(ax);
-
-      ro = orientationOps.getMDFFZRod(ro); // <==== THIS IS NOT IMPELMENTED FOR ALL LAUE CLASSES
-      mbin = orientationOps.getMisoBin(ro);
-      if(mdf[mbin] >= 0)
-      {
-        mdf[mbin]++;
-      }
-      if(mdf[mbin] < 0)
-      {
-        i = i - 1;
       }
     }
     for(int i = 0; i < mdfsize; i++)
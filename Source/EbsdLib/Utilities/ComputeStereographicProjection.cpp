@@ -31,12 +31,52 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ComputeStereographicProjection.h"
 
+#include <vector>
+
 #define CSP_DEBUG_OUTPUT 0
 #ifdef EbsdLib_ENABLE_HDF5
 #include "H5Support/H5Lite.h"
 #include "H5Support/H5Utilities.h"
 #endif
 #include "EbsdLib/Utilities/ModifiedLambertProjection.h"
+#include "EbsdLib/Utilities/ParallelDataAlgorithm.hpp"
+#include "EbsdLib/Utilities/ParallelGridReduction.hpp"
+
+namespace
+{
+/**
+ * @brief AddDiscreteCoordinatesImpl bins each block of sphere coordinates into the private image of the block.
+ */
+class AddDiscreteCoordinatesImpl
+{
+public:
+  AddDiscreteCoordinatesImpl(const float* coords, size_t numCoords, int imageDim, std::vector<std::vector<double>>& images)
+  : m_Coords(coords)
+  , m_NumCoords(numCoords)
+  , m_ImageDim(imageDim)
+  , m_Images(images)
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    const size_t imageSize = static_cast<size_t>(m_ImageDim) * static_cast<size_t>(m_ImageDim);
+    for(size_t block = start; block < end; block++)
+    {
+      size_t first = ParallelGridReduction::BlockStart(block, m_NumCoords, m_Images.size());
+      size_t last = ParallelGridReduction::BlockStart(block + 1, m_NumCoords, m_Images.size());
+      m_Images[block].assign(imageSize, 0.0);
+      ComputeStereographicProjection::AddDiscreteCoordinates(m_Coords + first * 3, last - first, m_ImageDim, m_Images[block].data());
+    }
+  }
+
+private:
+  const float* m_Coords = nullptr;
+  size_t m_NumCoords = 0;
+  int m_ImageDim = 0;
+  std::vector<std::vector<double>>& m_Images;
+};
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -53,6 +93,31 @@ ComputeStereographicProjection::ComputeStereographicProjection(EbsdLib::FloatArr
 // -----------------------------------------------------------------------------
 ComputeStereographicProjection::~ComputeStereographicProjection() = default;
 
+// -----------------------------------------------------------------------------
+void ComputeStereographicProjection::AddDiscreteCoordinates(const float* coords, size_t count, int imageDim, double* intensity)
+{
+  int halfDim = imageDim / 2;
+  for(size_t i = 0; i < count; i++)
+  {
+    float xyz[3] = {coords[i * 3], coords[i * 3 + 1], coords[i * 3 + 2]};
+    if(xyz[2] < 0.0f)
+    {
+      xyz[0] *= -1.0f;
+      xyz[1] *= -1.0f;
+      xyz[2] *= -1.0f;
+    }
+    float x = xyz[0] / (1 + xyz[2]);
+    float y = xyz[1] / (1 + xyz[2]);
+
+    int xCoord = static_cast<int>(x * (halfDim - 1)) + halfDim;
+    int yCoord = static_cast<int>(y * (halfDim - 1)) + halfDim;
+
+    size_t index = static_cast<size_t>((yCoord * imageDim) + xCoord);
+
+    intensity[index]++;
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -63,27 +128,28 @@ void ComputeStereographicProjection::operator()() const
 
   if(m_Config->discrete)
   {
-    int halfDim = m_Config->imageDim / 2;
     double* intensity = m_Intensity->getPointer(0);
-    size_t numCoords = m_XYZCoords->getNumberOfTuples();
-    float* xyzPtr = m_XYZCoords->getPointer(0);
-    for(size_t i = 0; i < numCoords; i++)
+    const float* coords = m_XYZCoords->getPointer(0);
+    const size_t numCoords = m_XYZCoords->getNumberOfTuples();
+    const size_t imageSize = m_Intensity->getNumberOfTuples();
+    // The bins hold whole counts, so merging the per block images gives exactly the serial result.
+    const size_t numBlocks = ParallelGridReduction::SuggestedBlockCount(numCoords, imageSize);
+    if(numBlocks == 1)
+    {
+      AddDiscreteCoordinates(coords, numCoords, m_Config->imageDim, intensity);
+    }
+    else
     {
-      if(xyzPtr[i * 3 + 2] < 0.0f)
+      std::vector<std::vector<double>> images(numBlocks);
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, numBlocks);
+      dataAlg.execute(AddDiscreteCoordinatesImpl(coords, numCoords, m_Config->imageDim, images));
+      std::vector<const double*> grids;
+      for(const auto& image : images)
       {
-        xyzPtr[i * 3 + 0] *= -1.0f;
-        xyzPtr[i * 3 + 1] *= -1.0f;
-        xyzPtr[i * 3 + 2] *= -1.0f;
+        grids.push_back(image.data());
       }
-      float x = xyzPtr[i * 3] / (1 + xyzPtr[i * 3 + 2]);
-      float y = xyzPtr[i * 3 + 1] / (1 + xyzPtr[i * 3 + 2]);
-
-      int xCoord = static_cast<int>(x * (halfDim - 1)) + halfDim;
-      int yCoord = static_cast<int>(y * (halfDim - 1)) + halfDim;
-
-      size_t index = static_cast<size_t>((yCoord * m_Config->imageDim) + xCoord);
-
-      intensity[index]++;
+      ParallelGridReduction::Merge(grids, intensity, imageSize);
     }
 #if CSP_DEBUG_OUTPUT
     // This chunk is here for some debugging....
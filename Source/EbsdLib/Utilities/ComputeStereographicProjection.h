@@ -58,6 +58,16 @@ public:
    */
   void operator()() const;
 
+  /**
+   * @brief AddDiscreteCoordinates Adds 1 to the pixel of a discrete pole figure intensity image that each
+   * XYZ coordinate projects to. Coordinates on the southern hemisphere are inverted through the origin.
+   * @param coords count packed XYZ coordinates on the unit sphere
+   * @param count The number of coordinates
+   * @param imageDim The width and height of the image
+   * @param intensity [output] The imageDim x imageDim intensity image
+   */
+  static void AddDiscreteCoordinates(const float* coords, size_t count, int imageDim, double* intensity);
+
 protected:
   /**
    * @brief ComputeStereographicProjection
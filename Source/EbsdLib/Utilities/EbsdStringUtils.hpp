@@ -33,9 +33,14 @@
 
 #include <array>
 #include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
 #include <regex>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 /*' '(0x20)space(SPC)
@@ -320,4 +325,85 @@ inline std::string simplified(const std::string& text)
   }
   return finalString;
 }
+
+/**
+ * @brief Returns the next line from the buffer WITHOUT the trailing newline and advances
+ * the buffer past the newline. A trailing carriage return is left in place. No memory is
+ * allocated, the returned view points into the buffer.
+ * @param buffer The remaining text. Updated to start at the following line.
+ */
+inline std::string_view nextLine(std::string_view& buffer)
+{
+  std::string_view::size_type pos = buffer.find('\n');
+  std::string_view line = buffer.substr(0, pos);
+  buffer.remove_prefix(pos == std::string_view::npos ? buffer.size() : pos + 1);
+  return line;
+}
+
+/**
+ * @brief Returns the next token from the line, skipping any leading delimiters, and
+ * advances the line past the token. An empty view is returned when the line is exhausted.
+ * @param line The remaining text of the line.
+ * @param delimiters The characters that separate tokens
+ */
+inline std::string_view nextToken(std::string_view& line, std::string_view delimiters = k_Whitespaces)
+{
+  std::string_view::size_type start = line.find_first_not_of(delimiters);
+  if(start == std::string_view::npos)
+  {
+    line = {};
+    return {};
+  }
+  line.remove_prefix(start);
+  std::string_view::size_type end = line.find_first_of(delimiters);
+  std::string_view token = line.substr(0, end);
+  line.remove_prefix(end == std::string_view::npos ? line.size() : end);
+  return token;
+}
+
+/**
+ * @brief Converts the complete token into a number without allocating any memory.
+ * A leading '+' is accepted to match std::stoi/std::stof.
+ * @param token The text to convert
+ * @param value The converted value. Unchanged if the conversion fails
+ * @return true if the entire token was consumed by the conversion
+ */
+template <typename T>
+inline bool convert(std::string_view token, T& value)
+{
+  if(!token.empty() && token.front() == '+')
+  {
+    token.remove_prefix(1);
+  }
+  if(token.empty())
+  {
+    return false;
+  }
+  const char* last = token.data() + token.size();
+#if !defined(__cpp_lib_to_chars)
+  if constexpr(std::is_floating_point_v<T>)
+  {
+    // Some standard libraries do not implement std::from_chars for floating point types
+    std::array<char, 64> buffer = {};
+    if(token.size() >= buffer.size())
+    {
+      return false;
+    }
+    std::memcpy(buffer.data(), token.data(), token.size());
+    char* end = nullptr;
+    T result = static_cast<T>(std::strtod(buffer.data(), &end));
+    if(end != buffer.data() + token.size())
+    {
+      return false;
+    }
+    value = result;
+    return true;
+  }
+  else
+#endif
+  {
+    std::from_chars_result result = std::from_chars(token.data(), last, value);
+    return result.ec == std::errc() && result.ptr == last;
+  }
+}
 } // namespace EbsdStringUtils
@@ -35,28 +35,212 @@
 
 #include "ModifiedLambertProjection.h"
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
 
 #include "EbsdLib/Core/EbsdMacros.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
+#include "EbsdLib/Utilities/ParallelDataAlgorithm.hpp"
+#include "EbsdLib/Utilities/ParallelGridReduction.hpp"
 
 #define WRITE_LAMBERT_SQUARE_COORD_VTK 0
 
 namespace
 {
-double calcInterpolatedValue(const ModifiedLambertProjection& self, const std::array<float, 3>& xyz)
+/**
+ * @brief StereographicMapping holds, for every image pixel inside the projection circle, the square and the
+ * interpolation bins and weights of the point on the sphere and of its antipode.
+ */
+struct StereographicMapping
+{
+  std::vector<size_t> pixels;
+  std::vector<uint8_t> squares; // 2 per pixel
+  std::vector<int32_t> bins;    // 8 per pixel
+  std::vector<float> weights;   // 8 per pixel
+};
+
+enum class ProjectionKind
+{
+  Stereographic,
+  Circular
+};
+
+using StereographicMappingKey = std::tuple<int, float, int, ProjectionKind>;
+
+// -----------------------------------------------------------------------------
+void addMappingSample(const ModifiedLambertProjection& self, const std::array<float, 3>& xyz, StereographicMapping& mapping)
 {
   std::array<float, 2> sqCoord{};
-  if(self.getSquareCoord(xyz.data(), sqCoord.data()))
+  bool nhCheck = self.getSquareCoord(xyz.data(), sqCoord.data());
+  std::array<int32_t, 4> bins{};
+  std::array<float, 4> weights{};
+  self.getInterpolationBins(sqCoord.data(), bins.data(), weights.data());
+  mapping.squares.push_back(nhCheck ? ModifiedLambertProjection::NorthSquare : ModifiedLambertProjection::SouthSquare);
+  mapping.bins.insert(mapping.bins.end(), bins.begin(), bins.end());
+  mapping.weights.insert(mapping.weights.end(), weights.begin(), weights.end());
+}
+
+// -----------------------------------------------------------------------------
+std::shared_ptr<const StereographicMapping> createStereographicMapping(const ModifiedLambertProjection& self, int dim, ProjectionKind kind)
+{
+  auto mapping = std::make_shared<StereographicMapping>();
+  int xpoints = dim;
+  int ypoints = dim;
+
+  int xpointshalf = xpoints / 2;
+  int ypointshalf = ypoints / 2;
+
+  float unitRadius = (kind == ProjectionKind::Circular) ? std::sqrt(2.0f) : 1.0f;
+  float xres = 2.0f * unitRadius / static_cast<float>(xpoints);
+  float yres = 2.0f * unitRadius / static_cast<float>(ypoints);
+
+  for(int64_t y = 0; y < ypoints; y++)
   {
-    // get Value from North square
-    return self.getInterpolatedValue(ModifiedLambertProjection::Square::NorthSquare, sqCoord.data());
+    for(int64_t x = 0; x < xpoints; x++)
+    {
+      // get (x,y) for stereographic projection pixel
+      float xtmp = static_cast<float>(x - xpointshalf) * xres + (xres * 0.5f);
+      float ytmp = static_cast<float>(y - ypointshalf) * yres + (yres * 0.5f);
+      float q = xtmp * xtmp + ytmp * ytmp;
+      if(q > unitRadius * unitRadius)
+      {
+        continue;
+      }
+      std::array<float, 3> xyz{};
+      if(kind == ProjectionKind::Circular)
+      {
+        // project xy from the equal area projection to the unit sphere
+        float t = std::sqrt(1.0f - (q / 4.0f));
+        xyz = {xtmp * t, ytmp * t, (q / 2.0f) - 1.0f};
+      }
+      else
+      {
+        // project xy from stereo projection to the unit sphere
+        xyz[2] = -(q - 1) / (q + 1);
+        xyz[0] = xtmp * (1 + xyz[2]);
+        xyz[1] = ytmp * (1 + xyz[2]);
+      }
+      mapping->pixels.push_back(static_cast<size_t>(y * xpoints + x));
+      addMappingSample(self, xyz, *mapping);
+      for(auto& value : xyz)
+      {
+        value *= -1.0f;
+      }
+      addMappingSample(self, xyz, *mapping);
+    }
   }
-  else
+  return mapping;
+}
+
+/**
+ * @brief StereographicMappingCache keeps the most recently used mappings. A pole figure run only ever uses a
+ * couple of image sizes, so a few entries are enough and the memory of older sizes is released.
+ */
+struct StereographicMappingCache
+{
+  static constexpr size_t k_MaxMappings = 4;
+
+  std::mutex mutex;
+  std::list<std::pair<StereographicMappingKey, std::shared_ptr<const StereographicMapping>>> mappings; // most recent first
+};
+
+// -----------------------------------------------------------------------------
+StereographicMappingCache& getStereographicMappingCache()
+{
+  static StereographicMappingCache s_Cache;
+  return s_Cache;
+}
+
+// -----------------------------------------------------------------------------
+std::shared_ptr<const StereographicMapping> getStereographicMapping(const ModifiedLambertProjection& self, int dim, ProjectionKind kind)
+{
+  StereographicMappingCache& cache = getStereographicMappingCache();
+  StereographicMappingKey key(self.getDimension(), self.getSphereRadius(), dim, kind);
+  auto findMapping = [&cache, &key]() {
+    return std::find_if(cache.mappings.begin(), cache.mappings.end(), [&key](const auto& entry) { return entry.first == key; });
+  };
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto iter = findMapping();
+    if(iter != cache.mappings.end())
+    {
+      cache.mappings.splice(cache.mappings.begin(), cache.mappings, iter);
+      return iter->second;
+    }
+  }
+  // Build outside of the lock. If another thread got there first its mapping is kept, they are identical.
+  std::shared_ptr<const StereographicMapping> mapping = createStereographicMapping(self, dim, kind);
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  auto iter = findMapping();
+  if(iter != cache.mappings.end())
+  {
+    return iter->second;
+  }
+  cache.mappings.emplace_front(key, mapping);
+  if(cache.mappings.size() > StereographicMappingCache::k_MaxMappings)
+  {
+    cache.mappings.pop_back();
+  }
+  return mapping;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void gatherStereographicMapping(const StereographicMapping& mapping, const double* north, const double* south, T* stereoIntensity)
+{
+  const size_t numPixels = mapping.pixels.size();
+  const int32_t* bins = mapping.bins.data();
+  const float* weights = mapping.weights.data();
+  for(size_t p = 0; p < numPixels; p++)
+  {
+    std::array<float, 2> values{};
+    for(size_t sample = 0; sample < 2; sample++)
+    {
+      const double* square = (mapping.squares[p * 2 + sample] == ModifiedLambertProjection::NorthSquare) ? north : south;
+      const size_t offset = (p * 2 + sample) * 4;
+      for(size_t k = 0; k < 4; k++)
+      {
+        values[sample] += static_cast<float>(square[bins[offset + k]]) * weights[offset + k];
+      }
+    }
+    stereoIntensity[mapping.pixels[p]] = (static_cast<T>(values[0]) + static_cast<T>(values[1])) * static_cast<T>(0.5);
+  }
+}
+
+/**
+ * @brief LambertBallToSquareImpl projects each block of sphere coordinates into the private pair of squares
+ * of the block, so no two threads write the same bins.
+ */
+class LambertBallToSquareImpl
+{
+public:
+  LambertBallToSquareImpl(const float* coords, size_t numCoords, std::vector<ModifiedLambertProjection::Pointer>& projections)
+  : m_Coords(coords)
+  , m_NumCoords(numCoords)
+  , m_Projections(projections)
   {
-    // get Value from South square
-    return self.getInterpolatedValue(ModifiedLambertProjection::Square::SouthSquare, sqCoord.data());
   }
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t block = start; block < end; block++)
+    {
+      size_t first = ParallelGridReduction::BlockStart(block, m_NumCoords, m_Projections.size());
+      size_t last = ParallelGridReduction::BlockStart(block + 1, m_NumCoords, m_Projections.size());
+      m_Projections[block]->addCoordinates(m_Coords + first * 3, last - first);
+    }
+  }
+
+private:
+  const float* m_Coords = nullptr;
+  size_t m_NumCoords = 0;
+  std::vector<ModifiedLambertProjection::Pointer>& m_Projections;
 };
 } // namespace
 
@@ -84,13 +268,12 @@ ModifiedLambertProjection::Pointer ModifiedLambertProjection::LambertBallToSquar
 {
 
   size_t npoints = coords->getNumberOfTuples();
-  bool nhCheck = false;
-  float sqCoord[2];
-  // int sqIndex = 0;
   ModifiedLambertProjection::Pointer squareProj = ModifiedLambertProjection::New();
   squareProj->initializeSquares(dimension, sphereRadius);
 
 #if WRITE_LAMBERT_SQUARE_COORD_VTK
+  bool nhCheck = false;
+  float sqCoord[2];
   std::string ss;
   std::string filename("/tmp/");
   filename.append("ModifiedLambert_Square_Coords_").append(coords->getName()).append(".vtk");
@@ -110,7 +293,6 @@ ModifiedLambertProjection::Pointer ModifiedLambertProjection::LambertBallToSquar
   fprintf(f, "\n");
 
   fprintf(f, "DATASET UNSTRUCTURED_GRID\nPOINTS %lu float\n", coords->getNumberOfTuples());
-#endif
 
   for(size_t i = 0; i < npoints; ++i)
   {
@@ -118,27 +300,38 @@ ModifiedLambertProjection::Pointer ModifiedLambertProjection::LambertBallToSquar
     sqCoord[1] = 0.0;
     // get coordinates in square projection of crystal normal parallel to boundary normal
     nhCheck = squareProj->getSquareCoord(coords->getPointer(i * 3), sqCoord);
-#if WRITE_LAMBERT_SQUARE_COORD_VTK
     fprintf(f, "%f %f 0\n", sqCoord[0], sqCoord[1]);
-#endif
-
-    // Based on the XY coordinate, get the pointer index that the value corresponds to in the proper square
-    //    sqIndex = squareProj->getSquareIndex(sqCoord);
-    if(nhCheck)
-    {
-      // north increment by 1
-      //      squareProj->addValue(ModifiedLambertProjection::NorthSquare, sqIndex, 1.0);
-      squareProj->addInterpolatedValues(ModifiedLambertProjection::NorthSquare, sqCoord, 1.0);
-    }
-    else
-    {
-      // south increment by 1
-      //      squareProj->addValue(ModifiedLambertProjection::SouthSquare, sqIndex, 1.0);
-      squareProj->addInterpolatedValues(ModifiedLambertProjection::SouthSquare, sqCoord, 1.0);
-    }
+    squareProj->addInterpolatedValues(nhCheck ? ModifiedLambertProjection::NorthSquare : ModifiedLambertProjection::SouthSquare, sqCoord, 1.0);
   }
-#if WRITE_LAMBERT_SQUARE_COORD_VTK
   fclose(f);
+#else
+  // Each block projects into its own squares which are then summed bin by bin into the result
+  const size_t squareSize = squareProj->getNorthSquare()->getNumberOfTuples();
+  const size_t numBlocks = ParallelGridReduction::SuggestedBlockCount(npoints, 2 * squareSize);
+  if(numBlocks == 1)
+  {
+    squareProj->addCoordinates(coords->getPointer(0), npoints);
+    return squareProj;
+  }
+  std::vector<ModifiedLambertProjection::Pointer> projections(numBlocks);
+  for(auto& projection : projections)
+  {
+    projection = ModifiedLambertProjection::New();
+    projection->initializeSquares(dimension, sphereRadius);
+  }
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numBlocks);
+  dataAlg.execute(LambertBallToSquareImpl(coords->getPointer(0), npoints, projections));
+
+  std::vector<const double*> northSquares;
+  std::vector<const double*> southSquares;
+  for(const auto& projection : projections)
+  {
+    northSquares.push_back(projection->getNorthSquare()->getPointer(0));
+    southSquares.push_back(projection->getSouthSquare()->getPointer(0));
+  }
+  ParallelGridReduction::Merge(northSquares, squareProj->getNorthSquare()->getPointer(0), squareSize);
+  ParallelGridReduction::Merge(southSquares, squareProj->getSouthSquare()->getPointer(0), squareSize);
 #endif
 
   return squareProj;
@@ -197,6 +390,38 @@ int ModifiedLambertProjection::readHDF5Data(hid_t groupId)
 }
 
 #endif
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjection::addCoordinates(const float* coords, size_t count)
+{
+  float sqCoord[2] = {0.0f, 0.0f};
+  for(size_t i = 0; i < count; ++i)
+  {
+    sqCoord[0] = 0.0f;
+    sqCoord[1] = 0.0f;
+    bool nhCheck = getSquareCoord(coords + i * 3, sqCoord);
+    addInterpolatedValues(nhCheck ? NorthSquare : SouthSquare, sqCoord, 1.0);
+  }
+}
+
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjection::addProjection(const ModifiedLambertProjection& other)
+{
+  if(other.m_Dimension != m_Dimension)
+  {
+    throw std::runtime_error("ModifiedLambertProjection::addProjection: The projections must have the same dimension.");
+  }
+  size_t npoints = m_NorthSquare->getNumberOfTuples();
+  double* north = m_NorthSquare->getPointer(0);
+  double* south = m_SouthSquare->getPointer(0);
+  const double* otherNorth = other.m_NorthSquare->getPointer(0);
+  const double* otherSouth = other.m_SouthSquare->getPointer(0);
+  for(size_t i = 0; i < npoints; ++i)
+  {
+    north[i] += otherNorth[i];
+    south[i] += otherSouth[i];
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -339,6 +564,23 @@ double ModifiedLambertProjection::getValue(Square square, int index)
 //
 // -----------------------------------------------------------------------------
 double ModifiedLambertProjection::getInterpolatedValue(Square square, const float* sqCoord) const
+{
+  std::array<int32_t, 4> bins{};
+  std::array<float, 4> weights{};
+  getInterpolationBins(sqCoord, bins.data(), weights.data());
+  const double* values = (square == NorthSquare) ? m_NorthSquare->getPointer(0) : m_SouthSquare->getPointer(0);
+  float interpolatedIntensity = 0.0f;
+  for(size_t k = 0; k < 4; k++)
+  {
+    interpolatedIntensity += static_cast<float>(values[bins[k]]) * weights[k];
+  }
+  return interpolatedIntensity;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjection::getInterpolationBins(const float* sqCoord, int32_t* bins, float* weights) const
 {
   // float sqCoord[2] = { sqCoord0[0] - 0.5*m_StepSize, sqCoord0[1] - 0.5*m_StepSize};
   int abin1, bbin1;
@@ -400,22 +642,14 @@ double ModifiedLambertProjection::getInterpolatedValue(Square square, const floa
   }
   modX = fabs(modX);
   modY = fabs(modY);
-  if(square == NorthSquare)
-  {
-    float intensity1 = static_cast<float>(m_NorthSquare->getValue((abin1) + (bbin1 * m_Dimension)));
-    float intensity2 = static_cast<float>(m_NorthSquare->getValue((abin2) + (bbin2 * m_Dimension)));
-    float intensity3 = static_cast<float>(m_NorthSquare->getValue((abin3) + (bbin3 * m_Dimension)));
-    float intensity4 = static_cast<float>(m_NorthSquare->getValue((abin4) + (bbin4 * m_Dimension)));
-    float interpolatedIntensity = ((intensity1 * (1 - modX) * (1 - modY)) + (intensity2 * (modX) * (1 - modY)) + (intensity3 * (1 - modX) * (modY)) + (intensity4 * (modX) * (modY)));
-    return interpolatedIntensity;
-  }
-
-  float intensity1 = static_cast<float>(m_SouthSquare->getValue((abin1) + (bbin1 * m_Dimension)));
-  float intensity2 = static_cast<float>(m_SouthSquare->getValue((abin2) + (bbin2 * m_Dimension)));
-  float intensity3 = static_cast<float>(m_SouthSquare->getValue((abin3) + (bbin3 * m_Dimension)));
-  float intensity4 = static_cast<float>(m_SouthSquare->getValue((abin4) + (bbin4 * m_Dimension)));
-  float interpolatedIntensity = ((intensity1 * (1 - modX) * (1 - modY)) + (intensity2 * (modX) * (1 - modY)) + (intensity3 * (1 - modX) * (modY)) + (intensity4 * (modX) * (modY)));
-  return interpolatedIntensity;
+  bins[0] = abin1 + bbin1 * m_Dimension;
+  bins[1] = abin2 + bbin2 * m_Dimension;
+  bins[2] = abin3 + bbin3 * m_Dimension;
+  bins[3] = abin4 + bbin4 * m_Dimension;
+  weights[0] = (1 - modX) * (1 - modY);
+  weights[1] = modX * (1 - modY);
+  weights[2] = (1 - modX) * modY;
+  weights[3] = modX * modY;
 }
 
 // -----------------------------------------------------------------------------
@@ -543,46 +777,9 @@ void ModifiedLambertProjection::normalizeSquaresToMRD()
 // -----------------------------------------------------------------------------
 void ModifiedLambertProjection::createStereographicProjection(int dim, EbsdLib::DoubleArrayType& stereoIntensity)
 {
-  int xpoints = dim;
-  int ypoints = dim;
-
-  int xpointshalf = xpoints / 2;
-  int ypointshalf = ypoints / 2;
-
-  float xres = 2.0f / static_cast<float>(xpoints);
-  float yres = 2.0f / static_cast<float>(ypoints);
-
   stereoIntensity.initializeWithZeros();
-
-  for(int64_t y = 0; y < ypoints; y++)
-  {
-    for(int64_t x = 0; x < xpoints; x++)
-    {
-      // get (x,y) for stereographic projection pixel
-      float xtmp = static_cast<float>(x - xpointshalf) * xres + (xres * 0.5f);
-      float ytmp = static_cast<float>(y - ypointshalf) * yres + (yres * 0.5f);
-      int index = static_cast<int>(y * xpoints + x);
-      if((xtmp * xtmp + ytmp * ytmp) <= 1.0)
-      {
-        std::array<float, 3> xyz{};
-        // project xy from stereo projection to the unit spehere
-        xyz[2] = -((xtmp * xtmp + ytmp * ytmp) - 1) / ((xtmp * xtmp + ytmp * ytmp) + 1);
-        xyz[0] = xtmp * (1 + xyz[2]);
-        xyz[1] = ytmp * (1 + xyz[2]);
-
-        stereoIntensity[index] += calcInterpolatedValue(*this, xyz);
-
-        for(auto& value : xyz)
-        {
-          value *= -1.0f;
-        }
-
-        stereoIntensity[index] += calcInterpolatedValue(*this, xyz);
-
-        stereoIntensity[index] *= 0.5;
-      }
-    }
-  }
+  std::shared_ptr<const StereographicMapping> mapping = getStereographicMapping(*this, dim, ProjectionKind::Stereographic);
+  gatherStereographicMapping(*mapping, m_NorthSquare->getPointer(0), m_SouthSquare->getPointer(0), stereoIntensity.getPointer(0));
 }
 
 // -----------------------------------------------------------------------------
@@ -601,47 +798,8 @@ EbsdLib::DoubleArrayType::Pointer ModifiedLambertProjection::createStereographic
 std::vector<float> ModifiedLambertProjection::createCircularProjection(int dim)
 {
   std::vector<float> stereoIntensity(dim * dim, 0.0f);
-  int xpoints = dim;
-  int ypoints = dim;
-
-  int xpointshalf = xpoints / 2;
-  int ypointshalf = ypoints / 2;
-
-  float unitRadius = std::sqrt(2.0f);
-  float span = unitRadius - (-unitRadius);
-
-  float xres = span / static_cast<float>(xpoints);
-  float yres = span / static_cast<float>(ypoints);
-
-  for(int64_t y = 0; y < ypoints; y++)
-  {
-    for(int64_t x = 0; x < xpoints; x++)
-    {
-      // get (x,y) for stereographic projection pixel
-      float xtmp = static_cast<float>(x - xpointshalf) * xres + (xres * 0.5f);
-      float ytmp = static_cast<float>(y - ypointshalf) * yres + (yres * 0.5f);
-      size_t index = static_cast<size_t>(y * xpoints + x);
-      if((xtmp * xtmp + ytmp * ytmp) <= unitRadius * unitRadius)
-      {
-        // project xy from stereo projection to the unit sphere
-        float q = xtmp * xtmp + ytmp * ytmp;
-        float t = std::sqrt(1.0f - (q / 4.0f));
-
-        std::array<float, 3> xyz{xtmp * t, ytmp * t, (q / 2.0f) - 1.0f};
-
-        stereoIntensity[index] += static_cast<float>(calcInterpolatedValue(*this, xyz));
-
-        for(auto& value : xyz)
-        {
-          value *= -1.0f;
-        }
-
-        stereoIntensity[index] += static_cast<float>(calcInterpolatedValue(*this, xyz));
-
-        stereoIntensity[index] *= 0.5f;
-      }
-    }
-  }
+  std::shared_ptr<const StereographicMapping> mapping = getStereographicMapping(*this, dim, ProjectionKind::Circular);
+  gatherStereographicMapping(*mapping, m_NorthSquare->getPointer(0), m_SouthSquare->getPointer(0), stereoIntensity.data());
   return stereoIntensity;
 }
 
@@ -670,6 +828,22 @@ std::string ModifiedLambertProjection::ClassName()
   return std::string("ModifiedLambertProjection");
 }
 
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjection::ClearCache()
+{
+  StereographicMappingCache& cache = getStereographicMappingCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.mappings.clear();
+}
+
+// -----------------------------------------------------------------------------
+size_t ModifiedLambertProjection::GetCachedMappingCount()
+{
+  StereographicMappingCache& cache = getStereographicMappingCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  return cache.mappings.size();
+}
+
 // -----------------------------------------------------------------------------
 int ModifiedLambertProjection::getDimension() const
 {
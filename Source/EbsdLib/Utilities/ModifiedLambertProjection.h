@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 #include "EbsdLib/Core/EbsdDataArray.hpp"
@@ -152,6 +153,20 @@ public:
    */
   void addValue(Square square, int index, double value);
 
+  /**
+   * @brief addCoordinates Adds a value of 1 for each XYZ coordinate on the sphere, interpolated into the
+   * square of the hemisphere it lies on. This is what LambertBallToSquare does for a whole array.
+   * @param coords count packed XYZ coordinates
+   * @param count The number of coordinates
+   */
+  void addCoordinates(const float* coords, size_t count);
+
+  /**
+   * @brief addProjection Adds the north and south squares of another projection of the same dimension
+   * @param other The projection to add
+   */
+  void addProjection(const ModifiedLambertProjection& other);
+
   /**
    * @brief This function sets the value of a bin in the lambert projection
    * @param square The North or South Squares
@@ -176,6 +191,15 @@ public:
    */
   double getInterpolatedValue(Square square, const float* sqCoord) const;
 
+  /**
+   * @brief getInterpolationBins Computes the four bins of a square and their bilinear weights that getInterpolatedValue
+   * combines for a square coordinate.
+   * @param sqCoord The XY coordinate in the Modified Lambert Square
+   * @param bins [output] The four bin indices into a square
+   * @param weights [output] The weight of each bin
+   */
+  void getInterpolationBins(const float* sqCoord, int32_t* bins, float* weights) const;
+
   /**
    * @brief getSquareCoord
    * @param xyz The input XYZ coordinate on the unit sphere.
@@ -203,7 +227,8 @@ public:
   void normalizeSquaresToMRD();
 
   /**
-   * @brief createStereographicProjection
+   * @brief createStereographicProjection The pixel to square mapping of each (Lambert dimension, sphere radius, image dimension)
+   * is cached and reused by later calls. Only the few most recently used mappings are kept, see ClearCache().
    * @param stereoGraphicProjectionDims
    */
   EbsdLib::DoubleArrayType::Pointer createStereographicProjection(int dim);
@@ -211,12 +236,23 @@ public:
   void createStereographicProjection(int dim, EbsdLib::DoubleArrayType& stereoIntensity);
 
   /**
-   * @brief Creates a circular Projection
+   * @brief Creates a circular Projection. The pixel to square mapping is cached like the one of createStereographicProjection.
    * @param dim
    * @return stereoIntensity
    */
   std::vector<float> createCircularProjection(int dim);
 
+  /**
+   * @brief ClearCache Releases every cached pixel to square mapping of createStereographicProjection and
+   * createCircularProjection. Projections that are running keep the mapping they already use.
+   */
+  static void ClearCache();
+
+  /**
+   * @brief GetCachedMappingCount Returns the number of pixel to square mappings that are currently cached.
+   */
+  static size_t GetCachedMappingCount();
+
 protected:
   ModifiedLambertProjection();
 
@@ -31,7 +31,9 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/Core/EbsdSetGetMacros.h"
@@ -182,11 +184,8 @@ public:
     }
     else
     {
-      T temp(2);
-      temp[0] = XYZ[0];
-      temp[1] = XYZ[1];
       // intercept all the points along the z-axis
-      if(OMHelperType::maxval(OMHelperType::absValue(temp)) == 0.0)
+      if(std::max(std::fabs(XYZ[0]), std::fabs(XYZ[1])) == 0.0)
       {
         LamXYZ[0] = 0.0;
         LamXYZ[1] = 0.0;
@@ -0,0 +1,147 @@
+/* ============================================================================
+ * Copyright (c) 2023-2023 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "EbsdLib/EbsdLib.h"
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+/**
+ * @class ParallelDataAlgorithm ParallelDataAlgorithm.hpp EbsdLib/Utilities/ParallelDataAlgorithm.hpp
+ * @brief Runs a body over the index range [begin, end). The body must provide a
+ * 'void generate(size_t start, size_t end) const' method which is the same signature
+ * the existing *Impl classes use for their serial fall back. When EbsdLib is built with
+ * TBB the range is handed to tbb::parallel_for, otherwise the range is split into
+ * contiguous blocks that each run on a std::thread. In both cases an exception thrown by the
+ * body is rethrown from execute().
+ */
+class ParallelDataAlgorithm
+{
+public:
+  ParallelDataAlgorithm() = default;
+  ~ParallelDataAlgorithm() = default;
+
+  /**
+   * @brief Sets the index range that will be processed.
+   */
+  void setRange(size_t begin, size_t end)
+  {
+    m_Begin = begin;
+    m_End = end;
+  }
+
+  /**
+   * @brief Sets the smallest number of indices a single task will be given.
+   */
+  void setGrain(size_t grain)
+  {
+    m_Grain = std::max<size_t>(grain, 1);
+  }
+
+  /**
+   * @brief Allows the caller to force the body to run serially on the calling thread.
+   */
+  void setParallelizationEnabled(bool value)
+  {
+    m_ParallelizationEnabled = value;
+  }
+
+  template <typename Body>
+  void execute(const Body& body) const
+  {
+    if(m_Begin >= m_End)
+    {
+      return;
+    }
+    size_t count = m_End - m_Begin;
+    if(!m_ParallelizationEnabled || count <= m_Grain)
+    {
+      body.generate(m_Begin, m_End);
+      return;
+    }
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(m_Begin, m_End, m_Grain), [&body](const tbb::blocked_range<size_t>& r) { body.generate(r.begin(), r.end()); }, tbb::auto_partitioner());
+#else
+    size_t numThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    numThreads = std::min(numThreads, (count + m_Grain - 1) / m_Grain);
+    size_t blockSize = (count + numThreads - 1) / numThreads;
+
+    // The first exception thrown by any of the blocks is rethrown on the calling thread, like tbb::parallel_for does
+    std::vector<std::exception_ptr> exceptions((count + blockSize - 1) / blockSize);
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for(size_t start = m_Begin; start < m_End; start += blockSize)
+    {
+      size_t end = std::min(start + blockSize, m_End);
+      std::exception_ptr& exception = exceptions[threads.size()];
+      threads.emplace_back([&body, &exception, start, end]() {
+        try
+        {
+          body.generate(start, end);
+        } catch(...)
+        {
+          exception = std::current_exception();
+        }
+      });
+    }
+    for(auto& thread : threads)
+    {
+      thread.join();
+    }
+    for(const auto& exception : exceptions)
+    {
+      if(exception)
+      {
+        std::rethrow_exception(exception);
+      }
+    }
+#endif
+  }
+
+private:
+  size_t m_Begin = 0;
+  size_t m_End = 0;
+  size_t m_Grain = 1;
+  bool m_ParallelizationEnabled = true;
+};
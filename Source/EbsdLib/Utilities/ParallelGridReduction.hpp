@@ -0,0 +1,121 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "EbsdLib/Utilities/ParallelDataAlgorithm.hpp"
+
+/**
+ * @class ParallelGridReduction ParallelGridReduction.hpp EbsdLib/Utilities/ParallelGridReduction.hpp
+ * @brief Helpers for accumulating many items into one grid of bins from several threads. The items
+ * are split into a few blocks, at most one per thread, and each block is accumulated into a private
+ * grid. The private grids are then summed into the output in parallel over the bins, always in block
+ * order, so the result does not depend on how the blocks were scheduled.
+ */
+class ParallelGridReduction
+{
+public:
+  /** @brief The smallest number of items that is worth a block of its own */
+  static constexpr size_t k_MinItemsPerBlock = 16384;
+
+  /**
+   * @brief Returns the number of blocks to split numItems items into. Zeroing and merging a private
+   * grid costs about as much as accumulating gridSize items, so a block is never given fewer items
+   * than that. A single block means the items should be accumulated straight into the output.
+   * @param numItems The number of items to accumulate
+   * @param gridSize The number of bins of the grid
+   */
+  static size_t SuggestedBlockCount(size_t numItems, size_t gridSize)
+  {
+    size_t numThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    size_t minItems = std::max(gridSize, k_MinItemsPerBlock);
+    return std::max<size_t>(std::min(numThreads, numItems / minItems), 1);
+  }
+
+  /**
+   * @brief Returns the first item of a block when numItems items are split into numBlocks blocks.
+   * Block b covers the items [BlockStart(b), BlockStart(b + 1)).
+   */
+  static size_t BlockStart(size_t block, size_t numItems, size_t numBlocks)
+  {
+    return (numItems / numBlocks) * block + std::min(block, numItems % numBlocks);
+  }
+
+  /**
+   * @brief Adds the grids to the output bin by bin, in parallel over the bins.
+   * @param grids The private grids, each with at least gridSize bins
+   * @param output The destination with gridSize bins
+   * @param gridSize The number of bins to merge
+   */
+  template <typename T>
+  static void Merge(const std::vector<const T*>& grids, T* output, size_t gridSize)
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, gridSize);
+    dataAlg.setGrain(k_MinItemsPerBlock);
+    dataAlg.execute(MergeImpl<T>(grids, output));
+  }
+
+private:
+  template <typename T>
+  class MergeImpl
+  {
+  public:
+    MergeImpl(const std::vector<const T*>& grids, T* output)
+    : m_Grids(grids)
+    , m_Output(output)
+    {
+    }
+
+    void generate(size_t start, size_t end) const
+    {
+      for(const T* grid : m_Grids)
+      {
+        for(size_t i = start; i < end; i++)
+        {
+          m_Output[i] += grid[i];
+        }
+      }
+    }
+
+  private:
+    const std::vector<const T*>& m_Grids;
+    T* m_Output = nullptr;
+  };
+};
@@ -35,7 +35,10 @@
 
 #include "PoleFigureUtilities.h"
 
+#include <algorithm>
 #include <fstream>
+#include <limits>
+#include <mutex>
 #include <sstream>
 
 #include "EbsdLib/LaueOps/CubicOps.h"
@@ -43,10 +46,122 @@
 #include "EbsdLib/LaueOps/OrthoRhombicOps.h"
 #include "EbsdLib/Utilities/ColorTable.h"
 #include "EbsdLib/Utilities/ModifiedLambertProjection.h"
+#include "EbsdLib/Utilities/ParallelDataAlgorithm.hpp"
 
 #define WRITE_XYZ_SPHERE_COORD_VTK 0
 #define WRITE_LAMBERT_SQUARES 0
 
+namespace
+{
+/**
+ * @brief IntensityRangeImpl finds the smallest and largest value of a range of an intensity image and
+ * merges them into the shared range.
+ */
+class IntensityRangeImpl
+{
+public:
+  IntensityRangeImpl(const double* data, double& min, double& max, std::mutex& mutex)
+  : m_Data(data)
+  , m_Min(min)
+  , m_Max(max)
+  , m_Mutex(mutex)
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    // NaN values never compare so they are skipped like the comparisons of the serial scan skipped them
+    double min = std::numeric_limits<double>::max();
+    double max = std::numeric_limits<double>::lowest();
+    for(size_t i = start; i < end; i++)
+    {
+      min = (m_Data[i] < min) ? m_Data[i] : min;
+      max = (m_Data[i] > max) ? m_Data[i] : max;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Min = (min < m_Min) ? min : m_Min;
+    m_Max = (max > m_Max) ? max : m_Max;
+  }
+
+private:
+  const double* m_Data = nullptr;
+  double& m_Min;
+  double& m_Max;
+  std::mutex& m_Mutex;
+};
+
+/**
+ * @brief ColorPoleFigureRowsImpl colors a range of rows of a pole figure image
+ */
+class ColorPoleFigureRowsImpl
+{
+public:
+  ColorPoleFigureRowsImpl(const double* data, const PoleFigureConfiguration_t& config, const std::vector<uint32_t>& colors, uint32_t* rgba)
+  : m_Data(data)
+  , m_Config(config)
+  , m_Colors(colors)
+  , m_Rgba(rgba)
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    const int width = m_Config.imageDim;
+    const int height = m_Config.imageDim;
+    const int halfWidth = width / 2;
+    const int halfHeight = height / 2;
+    const float xres = 2.0f / static_cast<float>(width);
+    const float yres = 2.0f / static_cast<float>(height);
+
+    const double min = static_cast<float>(m_Config.minScale);
+    const double max = static_cast<float>(m_Config.maxScale);
+    const double numColors = static_cast<double>(m_Colors.size());
+    const int lastBin = static_cast<int>(m_Colors.size()) - 1;
+    const bool blackAndWhite = (!m_Config.discreteHeatMap && m_Config.discrete);
+    const uint32_t black = EbsdLib::RgbColor::dRgb(0, 0, 0, 255);
+    const uint32_t white = EbsdLib::RgbColor::dRgb(255, 255, 255, 255);
+
+    for(size_t y = start; y < end; y++)
+    {
+      const float ytmp = static_cast<float>(static_cast<int64_t>(y) - halfHeight) * yres + (yres * 0.5f);
+      const double* dataRow = m_Data + y * width;
+      uint32_t* rgbaRow = m_Rgba + y * width;
+      for(int x = 0; x < width; x++)
+      {
+        const float xtmp = static_cast<float>(x - halfWidth) * xres + (xres * 0.5f);
+        if((xtmp * xtmp + ytmp * ytmp) > 1.0f)
+        {
+          rgbaRow[x] = 0xFFFFFFFF; // Outside the Circle - Set pixel to White
+          continue;
+        }
+        const double value = (dataRow[x] - min) / (max - min);
+        const double scaled = value * numColors;
+        // Truncation toward zero puts values just below the minimum in the first bin; lower values and NaN are black
+        if(!(scaled > -1.0) || lastBin < 0)
+        {
+          rgbaRow[x] = black;
+        }
+        else if(blackAndWhite)
+        {
+          rgbaRow[x] = (value > 0.0) ? black : white;
+        }
+        else
+        {
+          rgbaRow[x] = m_Colors[(scaled >= static_cast<double>(lastBin)) ? lastBin : static_cast<int>(scaled)];
+        }
+      }
+    }
+  }
+
+private:
+  const double* m_Data = nullptr;
+  const PoleFigureConfiguration_t& m_Config;
+  const std::vector<uint32_t>& m_Colors;
+  uint32_t* m_Rgba = nullptr;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -108,81 +223,41 @@ EbsdLib::UInt8ArrayType::Pointer PoleFigureUtilities::CreateColorImage(EbsdLib::
 // -----------------------------------------------------------------------------
 void PoleFigureUtilities::CreateColorImage(EbsdLib::DoubleArrayType* data, PoleFigureConfiguration_t& config, EbsdLib::UInt8ArrayType* image)
 {
-  int width = config.imageDim;
-  int height = config.imageDim;
-
-  int halfWidth = width / 2;
-  int halfHeight = height / 2;
-
-  float xres = 2.0f / static_cast<float>(width);
-  float yres = 2.0f / static_cast<float>(height);
-  float xtmp, ytmp;
-
-  float max = static_cast<float>(config.maxScale);
-  float min = static_cast<float>(config.minScale);
-
-  // Initialize the image with all zeros
-  image->initializeWithZeros();
+  std::vector<uint32_t> colors = CreateColorLookupTable(config.numColors);
   uint32_t* rgbaPtr = reinterpret_cast<uint32_t*>(image->getPointer(0));
 
-  int numColors = config.numColors;
-  std::vector<float> colors(numColors * 3, 0.0f);
-  EbsdColorTable::GetColorTable(config.numColors, colors);
-
-  float r = 0.0f, g = 0.0f, b = 0.0f;
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, static_cast<size_t>(std::max(config.imageDim, 0)));
+  dataAlg.setGrain(std::max<size_t>(1, 16384 / static_cast<size_t>(std::max(config.imageDim, 1))));
+  dataAlg.execute(ColorPoleFigureRowsImpl(data->getPointer(0), config, colors, rgbaPtr));
+}
 
-  double* dataPtr = data->getPointer(0);
-  size_t idx = 0;
-  double value;
-  int bin;
-  for(int64_t y = 0; y < height; y++)
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<uint32_t> PoleFigureUtilities::CreateColorLookupTable(int numColors)
+{
+  std::vector<float> colors(static_cast<size_t>(std::max(numColors, 0)) * 3, 0.0f);
+  EbsdColorTable::GetColorTable(numColors, colors);
+  std::vector<uint32_t> lookupTable(colors.size() / 3);
+  for(size_t bin = 0; bin < lookupTable.size(); bin++)
   {
-    for(int64_t x = 0; x < width; x++)
-    {
-      xtmp = float(x - halfWidth) * xres + (xres * 0.5f);
-      ytmp = float(y - halfHeight) * yres + (yres * 0.5f);
-      idx = (width * y) + x;
-      if((xtmp * xtmp + ytmp * ytmp) <= 1.0) // Inside the circle
-      {
-        value = dataPtr[y * width + x];
-        value = (value - min) / (max - min);
-        bin = int(value * numColors);
-        if(bin > numColors - 1)
-        {
-          bin = numColors - 1;
-        }
-        if(bin < 0 || bin >= colors.size())
-        {
-          r = 0x00;
-          b = 0x00;
-          g = 0x00;
-        }
-        else if(!config.discreteHeatMap && config.discrete)
-        {
-          float frgb = 1.0f;
-          if(value > 0.0)
-          {
-            frgb = 0.0f;
-          }
-          r = frgb;
-          b = frgb;
-          g = frgb;
-        }
-        else
-        {
-          r = colors[3 * bin];
-          g = colors[3 * bin + 1];
-          b = colors[3 * bin + 2];
-        }
-
-        rgbaPtr[idx] = EbsdLib::RgbColor::dRgb(static_cast<int>(r * 255.0f), static_cast<int>(g * 255.0f), static_cast<int>(b * 255.0f), 255);
-      }
-      else // Outside the Circle - Set pixel to White
-      {
-        rgbaPtr[idx] = 0xFFFFFFFF; // White
-      }
-    }
+    lookupTable[bin] =
+        EbsdLib::RgbColor::dRgb(static_cast<int>(colors[3 * bin] * 255.0f), static_cast<int>(colors[3 * bin + 1] * 255.0f), static_cast<int>(colors[3 * bin + 2] * 255.0f), 255);
   }
+  return lookupTable;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PoleFigureUtilities::FindIntensityRange(const EbsdLib::DoubleArrayType& data, double& min, double& max)
+{
+  std::mutex mutex;
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, data.getNumberOfTuples() * data.getNumberOfComponents());
+  dataAlg.setGrain(65536);
+  dataAlg.execute(IntensityRangeImpl(data.getPointer(0), min, max, mutex));
 }
 
 // -----------------------------------------------------------------------------
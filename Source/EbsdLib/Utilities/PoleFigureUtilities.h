@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 #include <string>
@@ -102,13 +103,29 @@ public:
   static EbsdLib::UInt8ArrayType::Pointer CreateColorImage(EbsdLib::DoubleArrayType* data, int width, int height, int nColors, const std::string& name, double min, double max);
 
   /**
-   * @brief CreateColorImage
+   * @brief CreateColorImage Colors the pixels inside the pole figure circle by binning their intensity between
+   * config.minScale and config.maxScale into config.numColors colors. The rows are colored in parallel with the
+   * lookup table of CreateColorLookupTable.
    * @param data
    * @param config
    * @param image
    */
   static void CreateColorImage(EbsdLib::DoubleArrayType* data, PoleFigureConfiguration_t& config, EbsdLib::UInt8ArrayType* image);
 
+  /**
+   * @brief CreateColorLookupTable Returns the RGBA value of each of the numColors bins of the pole figure colors
+   */
+  static std::vector<uint32_t> CreateColorLookupTable(int numColors);
+
+  /**
+   * @brief FindIntensityRange Widens min and max to the smallest and largest value of an intensity image in one
+   * parallel pass, so the range of several images is found by calling it for each of them.
+   * @param data The intensity image
+   * @param min [input/output] The smallest value
+   * @param max [input/output] The largest value
+   */
+  static void FindIntensityRange(const EbsdLib::DoubleArrayType& data, double& min, double& max);
+
 private:
   /**
    * @brief GenerateHexPoleFigures
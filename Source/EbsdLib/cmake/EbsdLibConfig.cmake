@@ -8,6 +8,8 @@ endif()
 
 if(@EbsdLib_USE_PARALLEL_ALGORITHMS@)
   find_dependency(TBB)
+else()
+  find_dependency(Threads)
 endif()
 
 include("${CMAKE_CURRENT_LIST_DIR}/EbsdLibTargets.cmake")
@@ -33,11 +33,17 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <utility>
+#include <vector>
 
 #include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/IO/EbsdSidecarCache.h"
+#include "EbsdLib/IO/LineChunker.h"
 #include "EbsdLib/IO/TSL/AngReader.h"
 
 #ifdef EbsdLib_ENABLE_HDF5
@@ -58,6 +64,32 @@ public:
 
   EBSD_GET_NAME_OF_CLASS_DECL(AngImportTest)
 
+  /**
+   * @brief Copies an ANG file with blank lines after the header, between the data lines and at the
+   * end of the file.
+   */
+  static void CopyWithBlankLines(const std::string& source, const std::string& target)
+  {
+    std::ifstream in(source);
+    std::ofstream out(target, std::ios_base::binary);
+    std::string line;
+    size_t dataLine = 0;
+    while(std::getline(in, line))
+    {
+      bool isDataLine = !line.empty() && line[0] != '#';
+      if(isDataLine && dataLine == 0)
+      {
+        out << "\n";
+      }
+      out << line << "\n";
+      if(isDataLine && (dataLine++ % 7) == 0)
+      {
+        out << "\n  \t\r\n";
+      }
+    }
+    out << "\n\n";
+  }
+
   // -----------------------------------------------------------------------------
   void RemoveTestFiles()
   {
@@ -163,6 +195,427 @@ public:
     DREAM3D_REQUIRED(ptr[159], ==, 12.56637f)
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestMemoryMappedFile()
+  {
+    AngReader streamReader;
+    streamReader.setFileName(UnitTest::AngImportTest::TestFile1);
+    int err = streamReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+
+    AngReader mappedReader;
+    mappedReader.setFileName(UnitTest::AngImportTest::TestFile1);
+    mappedReader.setUseMemoryMappedIO(true);
+    err = mappedReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+
+    size_t numElements = mappedReader.getNumberOfElements();
+    DREAM3D_REQUIRED(numElements, ==, streamReader.getNumberOfElements())
+    DREAM3D_REQUIRED(mappedReader.getOriginalHeader(), ==, streamReader.getOriginalHeader())
+    DREAM3D_REQUIRED(mappedReader.getPhaseVector().size(), ==, streamReader.getPhaseVector().size())
+
+    std::vector<std::string> arrayNames = {"Phi1", "Phi", "Phi2", "X Position", "Y Position", "Image Quality", "Confidence Index", "SEM Signal", "Fit"};
+    for(const auto& arrayName : arrayNames)
+    {
+      float* expected = static_cast<float*>(streamReader.getPointerByName(arrayName));
+      float* actual = static_cast<float*>(mappedReader.getPointerByName(arrayName));
+      DREAM3D_REQUIRE_VALID_POINTER(actual)
+      DREAM3D_REQUIRE(std::equal(expected, expected + numElements, actual))
+    }
+    int* expectedPhase = streamReader.getPhaseDataPointer();
+    int* actualPhase = mappedReader.getPhaseDataPointer();
+    DREAM3D_REQUIRE(std::equal(expectedPhase, expectedPhase + numElements, actualPhase))
+
+    // The short file must still be detected
+    AngReader shortReader;
+    shortReader.setFileName(UnitTest::AngImportTest::ShortFile);
+    shortReader.setUseMemoryMappedIO(true);
+    err = shortReader.readFile();
+    DREAM3D_REQUIRED(err, ==, -600)
+
+    AngReader gridReader;
+    gridReader.setFileName(UnitTest::AngImportTest::GridMissing);
+    gridReader.setUseMemoryMappedIO(true);
+    err = gridReader.readFile();
+    DREAM3D_REQUIRED(err, ==, -300)
+  }
+
+  void TestParallelParsing()
+  {
+    // This file is large enough to be split into several chunks
+    AngReader streamReader;
+    streamReader.setFileName(UnitTest::AngImportTest::OutOfOrderFile);
+    int err = streamReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+
+    AngReader parallelReader;
+    parallelReader.setFileName(UnitTest::AngImportTest::OutOfOrderFile);
+    parallelReader.setUseParallelParsing(true);
+    err = parallelReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+
+    size_t numElements = parallelReader.getNumberOfElements();
+    DREAM3D_REQUIRED(numElements, ==, streamReader.getNumberOfElements())
+
+    std::vector<std::string> arrayNames = {"Phi1", "Phi", "Phi2", "X Position", "Y Position", "Image Quality", "Confidence Index", "SEM Signal", "Fit"};
+    for(const auto& arrayName : arrayNames)
+    {
+      float* expected = static_cast<float*>(streamReader.getPointerByName(arrayName));
+      float* actual = static_cast<float*>(parallelReader.getPointerByName(arrayName));
+      if(expected == nullptr)
+      {
+        DREAM3D_REQUIRE(actual == nullptr)
+        continue;
+      }
+      DREAM3D_REQUIRE_VALID_POINTER(actual)
+      DREAM3D_REQUIRE(std::equal(expected, expected + numElements, actual))
+    }
+    int* expectedPhase = streamReader.getPhaseDataPointer();
+    int* actualPhase = parallelReader.getPhaseDataPointer();
+    DREAM3D_REQUIRE(std::equal(expectedPhase, expectedPhase + numElements, actualPhase))
+
+    AngReader shortReader;
+    shortReader.setFileName(UnitTest::AngImportTest::ShortFile);
+    shortReader.setUseParallelParsing(true);
+    err = shortReader.readFile();
+    DREAM3D_REQUIRED(err, ==, -600)
+
+    // Every chunk must know the index of its first line
+    std::string text = "0\n1\n2\n3\n4\n5\n6\n7\n8\n9";
+    std::vector<LineChunker::Chunk> chunks = LineChunker::Split(text, 4);
+    DREAM3D_REQUIRED(chunks.size(), ==, 4)
+    size_t lineCount = 0;
+    for(const auto& chunk : chunks)
+    {
+      DREAM3D_REQUIRED(chunk.firstLine, ==, lineCount)
+      DREAM3D_REQUIRED(std::stoul(std::string(chunk.text.substr(0, 1))), ==, lineCount)
+      lineCount += chunk.numLines;
+    }
+    DREAM3D_REQUIRED(lineCount, ==, 10)
+  }
+
+  void TestSelectedArrays()
+  {
+    AngReader fullReader;
+    fullReader.setFileName(UnitTest::AngImportTest::TestFile1);
+    int err = fullReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    size_t numElements = fullReader.getNumberOfElements();
+
+    for(bool mapped : {false, true})
+    {
+      AngReader reader;
+      reader.setFileName(UnitTest::AngImportTest::TestFile1);
+      reader.setUseMemoryMappedIO(mapped);
+      reader.readAllArrays(false);
+      reader.setArraysToRead({EbsdLib::Ang::Phi1, EbsdLib::Ang::Phi, EbsdLib::Ang::Phi2, EbsdLib::Ang::PhaseData});
+      err = reader.readFile();
+      DREAM3D_REQUIRED(err, ==, 0)
+      DREAM3D_REQUIRED(reader.getNumberOfElements(), ==, numElements)
+
+      // The positions are only used to order the data and are released afterwards
+      DREAM3D_REQUIRE(reader.getXPositionPointer() == nullptr)
+      DREAM3D_REQUIRE(reader.getYPositionPointer() == nullptr)
+      DREAM3D_REQUIRE(reader.getImageQualityPointer() == nullptr)
+      DREAM3D_REQUIRE(reader.getConfidenceIndexPointer() == nullptr)
+      DREAM3D_REQUIRE(reader.getSEMSignalPointer() == nullptr)
+      DREAM3D_REQUIRE(reader.getFitPointer() == nullptr)
+
+      for(const auto& arrayName : {EbsdLib::Ang::Phi1, EbsdLib::Ang::Phi, EbsdLib::Ang::Phi2})
+      {
+        float* expected = static_cast<float*>(fullReader.getPointerByName(arrayName));
+        float* actual = static_cast<float*>(reader.getPointerByName(arrayName));
+        DREAM3D_REQUIRE_VALID_POINTER(actual)
+        DREAM3D_REQUIRE(std::equal(expected, expected + numElements, actual))
+      }
+      int* expectedPhase = fullReader.getPhaseDataPointer();
+      int* actualPhase = reader.getPhaseDataPointer();
+      DREAM3D_REQUIRE_VALID_POINTER(actualPhase)
+      DREAM3D_REQUIRE(std::equal(expectedPhase, expectedPhase + numElements, actualPhase))
+    }
+  }
+
+  void TestStreamRows()
+  {
+    AngReader fullReader;
+    fullReader.setFileName(UnitTest::AngImportTest::TestFile1);
+    int err = fullReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+
+    AngReader reader;
+    reader.setFileName(UnitTest::AngImportTest::TestFile1);
+    std::unique_ptr<AngDataStream> stream = reader.openStream(1000);
+    DREAM3D_REQUIRE_VALID_POINTER(stream.get())
+    DREAM3D_REQUIRED(stream->getNumberOfElements(), ==, fullReader.getNumberOfElements())
+    DREAM3D_REQUIRED(reader.getPhaseVector().size(), ==, fullReader.getPhaseVector().size())
+
+    // This file is already in grid order so the rows match what readFile() returns
+    size_t numRows = 0;
+    size_t numBlocks = 0;
+    for(const AngRowBlock& block : *stream)
+    {
+      DREAM3D_REQUIRED(block.firstRow, ==, numRows)
+      DREAM3D_REQUIRE(block.numRows <= 1000)
+      DREAM3D_REQUIRE(std::equal(block.phi1, block.phi1 + block.numRows, fullReader.getPhi1Pointer() + block.firstRow))
+      DREAM3D_REQUIRE(std::equal(block.imageQuality, block.imageQuality + block.numRows, fullReader.getImageQualityPointer() + block.firstRow))
+      DREAM3D_REQUIRE(std::equal(block.phase, block.phase + block.numRows, fullReader.getPhaseDataPointer() + block.firstRow))
+      numRows += block.numRows;
+      numBlocks++;
+    }
+    DREAM3D_REQUIRED(stream->getErrorCode(), ==, 0)
+    DREAM3D_REQUIRED(numRows, ==, fullReader.getNumberOfElements())
+    DREAM3D_REQUIRED(numBlocks, ==, (numRows + 999) / 1000)
+
+    // Only the requested columns are decoded
+    AngReader phaseReader;
+    phaseReader.setFileName(UnitTest::AngImportTest::TestFile1);
+    phaseReader.readAllArrays(false);
+    phaseReader.setArraysToRead({EbsdLib::Ang::PhaseData});
+    stream = phaseReader.openStream(1000);
+    DREAM3D_REQUIRE(stream->readNextBlock())
+    DREAM3D_REQUIRE(stream->getBlock().phi1 == nullptr)
+    DREAM3D_REQUIRE_VALID_POINTER(stream->getBlock().phase)
+
+    AngReader shortReader;
+    shortReader.setFileName(UnitTest::AngImportTest::ShortFile);
+    stream = shortReader.openStream(1000);
+    DREAM3D_REQUIRE_VALID_POINTER(stream.get())
+    while(stream->readNextBlock())
+    {
+    }
+    DREAM3D_REQUIRED(stream->getErrorCode(), ==, -600)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestBlankDataLines()
+  {
+    AngReader streamReader;
+    streamReader.setFileName(UnitTest::AngImportTest::TestFile1);
+    int err = streamReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    size_t numElements = streamReader.getNumberOfElements();
+
+    std::string angFile = UnitTest::TestTempDir + "/BlankLinesTest.ang";
+    CopyWithBlankLines(UnitTest::AngImportTest::TestFile1, angFile);
+
+    // The stream, memory mapped and parallel paths all skip the blank lines
+    std::vector<std::pair<bool, bool>> paths = {{false, false}, {true, false}, {true, true}};
+    for(const auto& [mapped, parallel] : paths)
+    {
+      AngReader blankReader;
+      blankReader.setFileName(angFile);
+      blankReader.setUseMemoryMappedIO(mapped);
+      blankReader.setUseParallelParsing(parallel);
+      err = blankReader.readFile();
+      DREAM3D_REQUIRED(err, ==, 0)
+      DREAM3D_REQUIRED(blankReader.getNumberOfElements(), ==, numElements)
+      for(const std::string arrayName : {"Phi1", "Y Position", "Confidence Index"})
+      {
+        float* expected = static_cast<float*>(streamReader.getPointerByName(arrayName));
+        float* actual = static_cast<float*>(blankReader.getPointerByName(arrayName));
+        DREAM3D_REQUIRE_VALID_POINTER(actual)
+        DREAM3D_REQUIRE(std::equal(expected, expected + numElements, actual))
+      }
+    }
+
+    // The large file is split into several chunks so the blank lines are spread over all of them
+    std::string largeFile = UnitTest::TestTempDir + "/BlankLinesLargeTest.ang";
+    CopyWithBlankLines(UnitTest::AngImportTest::OutOfOrderFile, largeFile);
+    DREAM3D_REQUIRE(LineChunker::SuggestedChunkCount(fs::file_size(largeFile)) > 1)
+    AngReader largeStreamReader;
+    largeStreamReader.setFileName(UnitTest::AngImportTest::OutOfOrderFile);
+    err = largeStreamReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    AngReader largeParallelReader;
+    largeParallelReader.setFileName(largeFile);
+    largeParallelReader.setUseParallelParsing(true);
+    err = largeParallelReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    size_t numLargeElements = largeStreamReader.getNumberOfElements();
+    DREAM3D_REQUIRED(largeParallelReader.getNumberOfElements(), ==, numLargeElements)
+    for(const std::string arrayName : {"Phi1", "Phi", "Phi2", "X Position", "Y Position", "Image Quality", "Confidence Index", "SEM Signal", "Fit"})
+    {
+      float* expected = static_cast<float*>(largeStreamReader.getPointerByName(arrayName));
+      float* actual = static_cast<float*>(largeParallelReader.getPointerByName(arrayName));
+      if(expected == nullptr)
+      {
+        DREAM3D_REQUIRE(actual == nullptr)
+        continue;
+      }
+      DREAM3D_REQUIRE_VALID_POINTER(actual)
+      DREAM3D_REQUIRE(std::equal(expected, expected + numLargeElements, actual))
+    }
+    DREAM3D_REQUIRE(std::equal(largeStreamReader.getPhaseDataPointer(), largeStreamReader.getPhaseDataPointer() + numLargeElements, largeParallelReader.getPhaseDataPointer()))
+
+    // So does the row block stream
+    AngReader rowReader;
+    rowReader.setFileName(angFile);
+    std::unique_ptr<AngDataStream> stream = rowReader.openStream(13);
+    DREAM3D_REQUIRE_VALID_POINTER(stream.get())
+    size_t numRows = 0;
+    for(const AngRowBlock& block : *stream)
+    {
+      DREAM3D_REQUIRE(std::equal(block.phi1, block.phi1 + block.numRows, streamReader.getPhi1Pointer() + block.firstRow))
+      DREAM3D_REQUIRE(std::equal(block.confidenceIndex, block.confidenceIndex + block.numRows, streamReader.getConfidenceIndexPointer() + block.firstRow))
+      numRows += block.numRows;
+    }
+    DREAM3D_REQUIRED(stream->getErrorCode(), ==, 0)
+    DREAM3D_REQUIRED(numRows, ==, numElements)
+
+    // Blank lines must not make up for missing data lines
+    std::string shortFile = UnitTest::TestTempDir + "/BlankLinesShortTest.ang";
+    fs::copy_file(UnitTest::AngImportTest::ShortFile, shortFile, fs::copy_options::overwrite_existing);
+    {
+      std::ofstream out(shortFile, std::ios_base::app | std::ios_base::binary);
+      for(size_t i = 0; i < numElements; i++)
+      {
+        out << "\n";
+      }
+    }
+    for(bool mapped : {false, true})
+    {
+      AngReader shortReader;
+      shortReader.setFileName(shortFile);
+      shortReader.setUseMemoryMappedIO(mapped);
+      err = shortReader.readFile();
+      DREAM3D_REQUIRED(err, ==, -600)
+    }
+    AngReader shortRowReader;
+    shortRowReader.setFileName(shortFile);
+    stream = shortRowReader.openStream(13);
+    DREAM3D_REQUIRE_VALID_POINTER(stream.get())
+    while(stream->readNextBlock())
+    {
+    }
+    DREAM3D_REQUIRED(stream->getErrorCode(), ==, -600)
+
+    // The chunk line indices only count the data lines
+    std::string text = "0\n\n1\n \n2\n3\n\n\n4\n5\n6\n\t\n7\n8\n9\n\n";
+    std::vector<LineChunker::Chunk> chunks = LineChunker::Split(text, 4, true);
+    size_t lineCount = 0;
+    for(const auto& chunk : chunks)
+    {
+      DREAM3D_REQUIRED(chunk.firstLine, ==, lineCount)
+      std::string_view chunkText = chunk.text;
+      std::string_view firstLine = LineChunker::NextDataLine(chunkText);
+      if(!firstLine.empty())
+      {
+        DREAM3D_REQUIRED(std::stoul(std::string(firstLine)), ==, lineCount)
+      }
+      lineCount += chunk.numLines;
+    }
+    DREAM3D_REQUIRED(lineCount, ==, 10)
+
+#if REMOVE_TEST_FILES
+    fs::remove(angFile);
+    fs::remove(largeFile);
+    fs::remove(shortFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestSidecarCache()
+  {
+    std::string angFile = UnitTest::TestTempDir + "/SidecarCacheTest.ang";
+    std::string cacheFile = EbsdSidecarCache::GetCachePath(angFile);
+    fs::copy_file(UnitTest::AngImportTest::TestFile1, angFile, fs::copy_options::overwrite_existing);
+    fs::remove(cacheFile);
+
+    AngReader streamReader;
+    streamReader.setFileName(angFile);
+    int err = streamReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    DREAM3D_REQUIRE(!fs::exists(cacheFile))
+
+    // The first read parses the file and writes the cache
+    AngReader writeReader;
+    writeReader.setFileName(angFile);
+    writeReader.setUseSidecarCache(true);
+    err = writeReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    DREAM3D_REQUIRE(fs::exists(cacheFile))
+
+    EbsdSidecarCache cache;
+    DREAM3D_REQUIRE(cache.open(angFile, "ang"))
+    DREAM3D_REQUIRED(cache.getHeader(), ==, streamReader.getOriginalHeader())
+    DREAM3D_REQUIRED(cache.getColumns().size(), ==, 10)
+    for(const auto& column : cache.getColumns())
+    {
+      // Every column is aligned so it can be used straight from the mapping
+      DREAM3D_REQUIRED(reinterpret_cast<uintptr_t>(column.data) % 64, ==, 0)
+    }
+    cache.close();
+
+    // The second read loads the cache
+    AngReader cacheReader;
+    cacheReader.setFileName(angFile);
+    cacheReader.setUseSidecarCache(true);
+    err = cacheReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    size_t numElements = cacheReader.getNumberOfElements();
+    DREAM3D_REQUIRED(numElements, ==, streamReader.getNumberOfElements())
+    DREAM3D_REQUIRED(cacheReader.getOriginalHeader(), ==, streamReader.getOriginalHeader())
+    DREAM3D_REQUIRED(cacheReader.getPhaseVector().size(), ==, streamReader.getPhaseVector().size())
+    DREAM3D_REQUIRED(cacheReader.getXStep(), ==, streamReader.getXStep())
+    DREAM3D_REQUIRED(cacheReader.getNumRows(), ==, streamReader.getNumRows())
+    std::vector<std::string> arrayNames = {"Phi1", "Phi", "Phi2", "X Position", "Y Position", "Image Quality", "Confidence Index", "SEM Signal", "Fit"};
+    for(const auto& arrayName : arrayNames)
+    {
+      float* expected = static_cast<float*>(streamReader.getPointerByName(arrayName));
+      float* actual = static_cast<float*>(cacheReader.getPointerByName(arrayName));
+      DREAM3D_REQUIRE_VALID_POINTER(actual)
+      DREAM3D_REQUIRE(std::equal(expected, expected + numElements, actual))
+    }
+    int* expectedPhase = streamReader.getPhaseDataPointer();
+    int* actualPhase = cacheReader.getPhaseDataPointer();
+    DREAM3D_REQUIRE(std::equal(expectedPhase, expectedPhase + numElements, actualPhase))
+
+    // Only the requested arrays are loaded from the cache
+    AngReader selectedReader;
+    selectedReader.setFileName(angFile);
+    selectedReader.setUseSidecarCache(true);
+    selectedReader.readAllArrays(false);
+    selectedReader.setArraysToRead({EbsdLib::Ang::Phi1});
+    err = selectedReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    DREAM3D_REQUIRE(std::equal(streamReader.getPhi1Pointer(), streamReader.getPhi1Pointer() + numElements, selectedReader.getPhi1Pointer()))
+    DREAM3D_REQUIRE(selectedReader.getXPositionPointer() == nullptr)
+    DREAM3D_REQUIRE(selectedReader.getPhaseDataPointer() == nullptr)
+
+    // Changing the source file invalidates the cache which is then rewritten
+    fs::last_write_time(angFile, fs::last_write_time(angFile) - std::chrono::hours(1));
+    DREAM3D_REQUIRE(!cache.open(angFile, "ang"))
+    AngReader staleReader;
+    staleReader.setFileName(angFile);
+    staleReader.setUseSidecarCache(true);
+    err = staleReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    DREAM3D_REQUIRE(std::equal(streamReader.getPhi1Pointer(), streamReader.getPhi1Pointer() + numElements, staleReader.getPhi1Pointer()))
+    DREAM3D_REQUIRE(cache.open(angFile, "ang"))
+    cache.close();
+
+    // A damaged cache is ignored
+    fs::resize_file(cacheFile, 100);
+    DREAM3D_REQUIRE(!cache.open(angFile, "ang"))
+    AngReader damagedReader;
+    damagedReader.setFileName(angFile);
+    damagedReader.setUseSidecarCache(true);
+    err = damagedReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    DREAM3D_REQUIRE(std::equal(streamReader.getPhi1Pointer(), streamReader.getPhi1Pointer() + numElements, damagedReader.getPhi1Pointer()))
+
+#if REMOVE_TEST_FILES
+    fs::remove(cacheFile);
+    fs::remove(angFile);
+#endif
+  }
+
   void operator()()
   {
     int err = EXIT_SUCCESS;
@@ -173,6 +626,12 @@ public:
     DREAM3D_REGISTER_TEST(TestHexGrid())
     DREAM3D_REGISTER_TEST(TestMissingGrid())
     DREAM3D_REGISTER_TEST(TestShortFile())
+    DREAM3D_REGISTER_TEST(TestMemoryMappedFile())
+    DREAM3D_REGISTER_TEST(TestParallelParsing())
+    DREAM3D_REGISTER_TEST(TestBlankDataLines())
+    DREAM3D_REGISTER_TEST(TestSelectedArrays())
+    DREAM3D_REGISTER_TEST(TestStreamRows())
+    DREAM3D_REGISTER_TEST(TestSidecarCache())
 
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
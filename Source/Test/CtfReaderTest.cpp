@@ -36,10 +36,20 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <set>
 #include <fstream>
+#include <iomanip>
+#include <random>
+#include <utility>
+#include <vector>
 
+#include "EbsdLib/IO/EbsdSidecarCache.h"
+#include "EbsdLib/IO/HKL/CtfColumnPlan.hpp"
 #include "EbsdLib/IO/HKL/CtfReader.h"
+#include "EbsdLib/IO/LineChunker.h"
 
 #include "UnitTestSupport.hpp"
 
@@ -53,6 +63,40 @@ public:
 
   EBSD_GET_NAME_OF_CLASS_DECL(CtfReaderTest)
 
+  /**
+   * @brief Copies a CTF file with blank lines before the first data line, between the data lines and
+   * at the end of the file.
+   */
+  static void CopyWithBlankLines(const std::string& source, const std::string& target, size_t trailingBlankLines)
+  {
+    std::ifstream in(source);
+    std::ofstream out(target, std::ios_base::binary);
+    std::string line;
+    bool inData = false;
+    size_t dataLine = 0;
+    while(std::getline(in, line))
+    {
+      out << line << "\n";
+      if(!inData)
+      {
+        // The column header line is the last line before the data
+        inData = line.find(EbsdLib::Ctf::Phase + "\t") == 0;
+        if(inData)
+        {
+          out << "\r\n";
+        }
+      }
+      else if((dataLine++ % 7) == 0)
+      {
+        out << "\n  \t\r\n";
+      }
+    }
+    for(size_t i = 0; i < trailingBlankLines; i++)
+    {
+      out << "\n";
+    }
+  }
+
   // -----------------------------------------------------------------------------
   void TestCtfReader()
   {
@@ -199,6 +243,448 @@ public:
     DREAM3D_REQUIRED(err, ==, -103)
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestMemoryMappedFile()
+  {
+    for(const auto& filePath : {UnitTest::CtfReaderTest::EuropeanInputFile1, UnitTest::CtfReaderTest::USInputFile2})
+    {
+      CtfReader streamReader;
+      streamReader.setFileName(filePath);
+      int err = streamReader.readFile();
+      DREAM3D_REQUIRED(err, >=, 0)
+
+      for(bool parallel : {false, true})
+      {
+        CtfReader mappedReader;
+        mappedReader.setFileName(filePath);
+        mappedReader.setUseMemoryMappedIO(true);
+        mappedReader.setUseParallelParsing(parallel);
+        err = mappedReader.readFile();
+        DREAM3D_REQUIRED(err, >=, 0)
+
+        size_t numElements = mappedReader.getNumberOfElements();
+        DREAM3D_REQUIRED(numElements, ==, streamReader.getNumberOfElements())
+        DREAM3D_REQUIRED(mappedReader.getOriginalHeader(), ==, streamReader.getOriginalHeader())
+        DREAM3D_REQUIRED(mappedReader.getNumPhases(), ==, streamReader.getNumPhases())
+        DREAM3D_REQUIRED(mappedReader.getPhaseVector().size(), ==, streamReader.getPhaseVector().size())
+
+        std::vector<std::string> columnNames = streamReader.getColumnNames();
+        DREAM3D_REQUIRE(mappedReader.getColumnNames() == columnNames)
+        for(const auto& name : columnNames)
+        {
+          // Both integer and float columns are 4 bytes so compare the raw bytes
+          const void* expected = streamReader.getPointerByName(name);
+          const void* actual = mappedReader.getPointerByName(name);
+          DREAM3D_REQUIRE_VALID_POINTER(actual)
+          DREAM3D_REQUIRE(::memcmp(expected, actual, numElements * 4) == 0)
+        }
+      }
+    }
+
+    CtfReader shortReader;
+    shortReader.setFileName(UnitTest::CtfReaderTest::ShortFile);
+    shortReader.setUseParallelParsing(true);
+    int err = shortReader.readFile();
+    DREAM3D_REQUIRED(err, ==, -105)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestBlankDataLines()
+  {
+    std::string ctfFile = UnitTest::TestTempDir + "/BlankLinesTest.ctf";
+    CopyWithBlankLines(UnitTest::CtfReaderTest::EuropeanInputFile2, ctfFile, 2);
+
+    // The stream, memory mapped and parallel paths all skip the blank lines, for every slice and a single slice
+    std::vector<std::pair<bool, bool>> paths = {{false, false}, {true, false}, {true, true}};
+    for(int slice : {-1, 2})
+    {
+      CtfReader streamReader;
+      streamReader.setFileName(UnitTest::CtfReaderTest::EuropeanInputFile2);
+      streamReader.readOnlySliceIndex(slice);
+      int err = streamReader.readFile();
+      DREAM3D_REQUIRED(err, >=, 0)
+      size_t numElements = streamReader.getNumberOfElements();
+
+      for(const auto& [mapped, parallel] : paths)
+      {
+        CtfReader blankReader;
+        blankReader.setFileName(ctfFile);
+        blankReader.setUseMemoryMappedIO(mapped);
+        blankReader.setUseParallelParsing(parallel);
+        blankReader.readOnlySliceIndex(slice);
+        err = blankReader.readFile();
+        DREAM3D_REQUIRED(err, >=, 0)
+        DREAM3D_REQUIRED(blankReader.getNumberOfElements(), ==, numElements)
+        for(const auto& name : streamReader.getColumnNames())
+        {
+          const void* expected = streamReader.getPointerByName(name);
+          const void* actual = blankReader.getPointerByName(name);
+          DREAM3D_REQUIRE_VALID_POINTER(actual)
+          DREAM3D_REQUIRE(::memcmp(expected, actual, numElements * 4) == 0)
+        }
+      }
+
+      // The row block stream always streams every slice
+      if(slice < 0)
+      {
+        CtfReader rowReader;
+        rowReader.setFileName(ctfFile);
+        std::unique_ptr<CtfDataStream> stream = rowReader.openStream(13);
+        DREAM3D_REQUIRE_VALID_POINTER(stream.get())
+        const auto* euler1 = static_cast<const float*>(streamReader.getPointerByName(EbsdLib::Ctf::Euler1));
+        const auto* bc = static_cast<const int32_t*>(streamReader.getPointerByName(EbsdLib::Ctf::BC));
+        size_t numRows = 0;
+        for(const CtfRowBlock& block : *stream)
+        {
+          DREAM3D_REQUIRE(std::equal(block.euler1, block.euler1 + block.numRows, euler1 + block.firstRow))
+          DREAM3D_REQUIRE(std::equal(block.bc, block.bc + block.numRows, bc + block.firstRow))
+          numRows += block.numRows;
+        }
+        DREAM3D_REQUIRED(stream->getErrorCode(), ==, 0)
+        DREAM3D_REQUIRED(numRows, ==, numElements)
+      }
+    }
+
+    // Blank lines must not make up for missing data lines
+    std::string shortFile = UnitTest::TestTempDir + "/BlankLinesShortTest.ctf";
+    CopyWithBlankLines(UnitTest::CtfReaderTest::ShortFile, shortFile, 1000);
+    for(const auto& [mapped, parallel] : paths)
+    {
+      CtfReader shortReader;
+      shortReader.setFileName(shortFile);
+      shortReader.setUseMemoryMappedIO(mapped);
+      shortReader.setUseParallelParsing(parallel);
+      int err = shortReader.readFile();
+      DREAM3D_REQUIRED(err, ==, -105)
+    }
+    CtfReader shortRowReader;
+    shortRowReader.setFileName(shortFile);
+    std::unique_ptr<CtfDataStream> stream = shortRowReader.openStream(13);
+    DREAM3D_REQUIRE_VALID_POINTER(stream.get())
+    while(stream->readNextBlock())
+    {
+    }
+    DREAM3D_REQUIRED(stream->getErrorCode(), ==, -105)
+
+#if REMOVE_TEST_FILES
+    fs::remove(ctfFile);
+    fs::remove(shortFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestLargeFile()
+  {
+    // Three slices of several MB so that the parallel reader splits every slice over chunk boundaries
+    const int32_t xCells = 400;
+    const int32_t yCells = 100;
+    const int32_t zCells = 3;
+    std::string ctfFile = UnitTest::TestTempDir + "/LargeFileTest.ctf";
+    {
+      std::ofstream out(ctfFile, std::ios_base::binary);
+      out << "Channel Text File\r\nPrj\tLargeFileTest.cpr\r\nAuthor\t[Unknown]\r\nJobMode\tGrid\r\n";
+      out << "XCells\t" << xCells << "\r\nYCells\t" << yCells << "\r\nZCells\t" << zCells << "\r\nXStep\t0.5\r\nYStep\t0.5\r\nZStep\t0.5\r\n";
+      out << "AcqE1\t0\r\nAcqE2\t0\r\nAcqE3\t0\r\n";
+      out << "Euler angles refer to Sample Coordinate system (CS0)!\tMag\t200\tCoverage\t100\tDevice\t0\tKV\t15\tTiltAngle\t70\tTiltAxis\t0\r\n";
+      out << "Phases\t2\r\n";
+      out << "3.231;3.231;5.148\t90;90;120\tZirc-alloy4\t9\t0\t0_5.0.6.0\t-67395467\t[Zr4.cry]\r\n";
+      out << "3.61;3.61;3.61\t90;90;90\tCopper\t11\t225\t\r\n";
+      out << "Phase\tX\tY\tBands\tError\tEuler1\tEuler2\tEuler3\tMAD\tBC\tBS\r\n";
+
+      std::mt19937 generator(5489u);
+      std::uniform_int_distribution<int32_t> phase(0, 2);
+      std::uniform_int_distribution<int32_t> bands(0, 12);
+      std::uniform_int_distribution<int32_t> pattern(0, 255);
+      std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+      std::uniform_real_distribution<float> mad(0.0f, 2.0f);
+      out << std::fixed;
+      size_t index = 0;
+      for(int32_t z = 0; z < zCells; z++)
+      {
+        for(int32_t y = 0; y < yCells; y++)
+        {
+          for(int32_t x = 0; x < xCells; x++)
+          {
+            out << phase(generator) << "\t" << std::setprecision(4) << x * 0.5f << "\t" << y * 0.5f << "\t" << bands(generator) << "\t" << (index % 5);
+            out << "\t" << std::setprecision(3) << angle(generator) << "\t" << angle(generator) * 0.5f << "\t" << angle(generator);
+            out << "\t" << std::setprecision(4) << mad(generator) << "\t" << pattern(generator) << "\t" << pattern(generator) << "\r\n";
+            if((index++ % 997) == 0)
+            {
+              out << "\r\n";
+            }
+          }
+        }
+      }
+    }
+    DREAM3D_REQUIRE(LineChunker::SuggestedChunkCount(fs::file_size(ctfFile)) > 1)
+
+    CtfReader streamReader;
+    streamReader.setFileName(ctfFile);
+    int err = streamReader.readFile();
+    DREAM3D_REQUIRED(err, >=, 0)
+    size_t numElements = streamReader.getNumberOfElements();
+    DREAM3D_REQUIRED(numElements, ==, static_cast<size_t>(xCells * yCells * zCells))
+    std::vector<std::string> columnNames = streamReader.getColumnNames();
+
+    CtfReader parallelReader;
+    parallelReader.setFileName(ctfFile);
+    parallelReader.setUseParallelParsing(true);
+    err = parallelReader.readFile();
+    DREAM3D_REQUIRED(err, >=, 0)
+    DREAM3D_REQUIRED(parallelReader.getNumberOfElements(), ==, numElements)
+    DREAM3D_REQUIRED(parallelReader.getOriginalHeader(), ==, streamReader.getOriginalHeader())
+    DREAM3D_REQUIRE(parallelReader.getColumnNames() == columnNames)
+    for(const auto& name : columnNames)
+    {
+      const void* expected = streamReader.getPointerByName(name);
+      const void* actual = parallelReader.getPointerByName(name);
+      DREAM3D_REQUIRE_VALID_POINTER(actual)
+      DREAM3D_REQUIRE(::memcmp(expected, actual, numElements * 4) == 0)
+    }
+
+    // A single slice starts and ends inside a chunk, it must match both the serial slice read and that part of the full read
+    size_t pointsPerSlice = static_cast<size_t>(xCells * yCells);
+    for(int slice = 0; slice < zCells; slice++)
+    {
+      CtfReader sliceReader;
+      sliceReader.setFileName(ctfFile);
+      sliceReader.readOnlySliceIndex(slice);
+      err = sliceReader.readFile();
+      DREAM3D_REQUIRED(err, >=, 0)
+
+      CtfReader parallelSliceReader;
+      parallelSliceReader.setFileName(ctfFile);
+      parallelSliceReader.setUseParallelParsing(true);
+      parallelSliceReader.readOnlySliceIndex(slice);
+      err = parallelSliceReader.readFile();
+      DREAM3D_REQUIRED(err, >=, 0)
+      DREAM3D_REQUIRED(parallelSliceReader.getNumberOfElements(), ==, pointsPerSlice)
+      for(const auto& name : columnNames)
+      {
+        const auto* full = static_cast<const char*>(streamReader.getPointerByName(name));
+        const void* expected = sliceReader.getPointerByName(name);
+        const void* actual = parallelSliceReader.getPointerByName(name);
+        DREAM3D_REQUIRE_VALID_POINTER(actual)
+        DREAM3D_REQUIRE(::memcmp(expected, actual, pointsPerSlice * 4) == 0)
+        DREAM3D_REQUIRE(::memcmp(full + slice * pointsPerSlice * 4, actual, pointsPerSlice * 4) == 0)
+      }
+    }
+
+#if REMOVE_TEST_FILES
+    fs::remove(ctfFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestColumnPlan()
+  {
+    const std::vector<std::string> names = {EbsdLib::Ctf::Phase,  EbsdLib::Ctf::X,      EbsdLib::Ctf::Y,   EbsdLib::Ctf::Bands, EbsdLib::Ctf::Error, EbsdLib::Ctf::Euler1,
+                                            EbsdLib::Ctf::Euler2, EbsdLib::Ctf::Euler3, EbsdLib::Ctf::MAD, EbsdLib::Ctf::BC,    EbsdLib::Ctf::BS,    EbsdLib::Ctf::GrainIndex};
+    CtfReader reader;
+    std::vector<DataParser::Pointer> parsers;
+    std::vector<DataParser*> columns;
+    for(size_t i = 0; i < names.size(); i++)
+    {
+      parsers.push_back(reader.getParser(names[i], nullptr, 2));
+      DREAM3D_REQUIRE(parsers.back()->allocateArray(2))
+      parsers.back()->setManageMemory(true);
+      columns.push_back(parsers.back().get());
+    }
+
+    // The standard columns use the typed sinks and the extra column uses its DataParser
+    CtfColumnPlan plan(names, columns);
+    DREAM3D_REQUIRE(plan.usesStandardLayout())
+    std::string scratch;
+    int err = plan.decode(" 1\t2.5\t3,25\t8\t0\t10.5\t20,25\t30\t0.5\t120\t200\t7\r", 1, scratch);
+    DREAM3D_REQUIRED(err, ==, 0)
+    DREAM3D_REQUIRED(static_cast<int32_t*>(columns[0]->getVoidPointer())[1], ==, 1)
+    DREAM3D_REQUIRED(static_cast<float*>(columns[2]->getVoidPointer())[1], ==, 3.25f)
+    DREAM3D_REQUIRED(static_cast<float*>(columns[6]->getVoidPointer())[1], ==, 20.25f)
+    DREAM3D_REQUIRED(static_cast<int32_t*>(columns[10]->getVoidPointer())[1], ==, 200)
+    DREAM3D_REQUIRED(static_cast<int32_t*>(columns[11]->getVoidPointer())[1], ==, 7)
+
+    err = plan.decode("1\t2.5\t3.25", 0, scratch);
+    DREAM3D_REQUIRED(err, ==, -109)
+    err = plan.decode("1\t2.5\t3,25\t8\t0\t10.5\t20,25\t30\t0.5\t120\t200\t7\t9", 0, scratch);
+    DREAM3D_REQUIRED(err, ==, -109)
+    err = plan.decode("1\t2.5\tabc\t8\t0\t10.5\t20,25\t30\t0.5\t120\t200\t7", 0, scratch);
+    DREAM3D_REQUIRED(err, ==, -104)
+
+    // Columns in a different order fall back to the DataParsers for every column
+    std::vector<std::string> swappedNames = names;
+    std::swap(swappedNames[1], swappedNames[2]);
+    std::swap(columns[1], columns[2]);
+    CtfColumnPlan genericPlan(swappedNames, columns);
+    DREAM3D_REQUIRE(!genericPlan.usesStandardLayout())
+    err = genericPlan.decode("1\t2.5\t3,25\t8\t0\t10.5\t20,25\t30\t0.5\t120\t200\t7", 0, scratch);
+    DREAM3D_REQUIRED(err, ==, 0)
+    DREAM3D_REQUIRED(static_cast<float*>(columns[1]->getVoidPointer())[0], ==, 2.5f)
+
+    // Columns without a parser are skipped but still counted
+    columns[2] = nullptr;
+    CtfColumnPlan skippingPlan(swappedNames, columns);
+    err = skippingPlan.decode("1\t2.5\tabc\t8\t0\t10.5\t20,25\t30\t0.5\t120\t200\t7", 0, scratch);
+    DREAM3D_REQUIRED(err, ==, 0)
+    err = skippingPlan.decode("1\t2.5", 0, scratch);
+    DREAM3D_REQUIRED(err, ==, -109)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestSelectedArrays()
+  {
+    CtfReader fullReader;
+    fullReader.setFileName(UnitTest::CtfReaderTest::USInputFile1);
+    int err = fullReader.readFile();
+    DREAM3D_REQUIRED(err, >=, 0)
+    size_t numElements = fullReader.getNumberOfElements();
+
+    const std::set<std::string> names = {EbsdLib::Ctf::Phase, EbsdLib::Ctf::Euler1, EbsdLib::Ctf::Euler2, EbsdLib::Ctf::Euler3};
+    for(bool mapped : {false, true})
+    {
+      CtfReader reader;
+      reader.setFileName(UnitTest::CtfReaderTest::USInputFile1);
+      reader.setUseMemoryMappedIO(mapped);
+      reader.readAllArrays(false);
+      reader.setArraysToRead(names);
+      err = reader.readFile();
+      DREAM3D_REQUIRED(err, >=, 0)
+      DREAM3D_REQUIRED(reader.getNumberOfElements(), ==, numElements)
+      DREAM3D_REQUIRED(reader.getColumnNames().size(), ==, names.size())
+      DREAM3D_REQUIRE(reader.getPointerByName(EbsdLib::Ctf::BC) == nullptr)
+      DREAM3D_REQUIRE(reader.getPointerByName(EbsdLib::Ctf::X) == nullptr)
+      for(const auto& name : names)
+      {
+        const void* expected = fullReader.getPointerByName(name);
+        const void* actual = reader.getPointerByName(name);
+        DREAM3D_REQUIRE_VALID_POINTER(actual)
+        DREAM3D_REQUIRE(::memcmp(expected, actual, numElements * 4) == 0)
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestStreamRows()
+  {
+    CtfReader fullReader;
+    fullReader.setFileName(UnitTest::CtfReaderTest::EuropeanInputFile1);
+    int err = fullReader.readFile();
+    DREAM3D_REQUIRED(err, >=, 0)
+
+    CtfReader reader;
+    reader.setFileName(UnitTest::CtfReaderTest::EuropeanInputFile1);
+    std::unique_ptr<CtfDataStream> stream = reader.openStream(7);
+    DREAM3D_REQUIRE_VALID_POINTER(stream.get())
+    DREAM3D_REQUIRED(stream->getNumberOfElements(), ==, fullReader.getNumberOfElements())
+    DREAM3D_REQUIRED(reader.getNumPhases(), ==, fullReader.getNumPhases())
+
+    const auto* phase = static_cast<const int32_t*>(fullReader.getPointerByName(EbsdLib::Ctf::Phase));
+    const auto* euler1 = static_cast<const float*>(fullReader.getPointerByName(EbsdLib::Ctf::Euler1));
+    const auto* bc = static_cast<const int32_t*>(fullReader.getPointerByName(EbsdLib::Ctf::BC));
+    size_t numRows = 0;
+    for(const CtfRowBlock& block : *stream)
+    {
+      DREAM3D_REQUIRED(block.firstRow, ==, numRows)
+      DREAM3D_REQUIRE(std::equal(block.phase, block.phase + block.numRows, phase + block.firstRow))
+      DREAM3D_REQUIRE(std::equal(block.euler1, block.euler1 + block.numRows, euler1 + block.firstRow))
+      DREAM3D_REQUIRE(std::equal(block.bc, block.bc + block.numRows, bc + block.firstRow))
+      numRows += block.numRows;
+    }
+    DREAM3D_REQUIRED(stream->getErrorCode(), ==, 0)
+    DREAM3D_REQUIRED(numRows, ==, fullReader.getNumberOfElements())
+
+    CtfReader shortReader;
+    shortReader.setFileName(UnitTest::CtfReaderTest::ShortFile);
+    stream = shortReader.openStream(7);
+    DREAM3D_REQUIRE_VALID_POINTER(stream.get())
+    while(stream->readNextBlock())
+    {
+    }
+    DREAM3D_REQUIRED(stream->getErrorCode(), ==, -105)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestSidecarCache()
+  {
+    std::string ctfFile = UnitTest::TestTempDir + "/SidecarCacheTest.ctf";
+    std::string cacheFile = EbsdSidecarCache::GetCachePath(ctfFile);
+    fs::copy_file(UnitTest::CtfReaderTest::EuropeanInputFile1, ctfFile, fs::copy_options::overwrite_existing);
+    fs::remove(cacheFile);
+
+    CtfReader streamReader;
+    streamReader.setFileName(ctfFile);
+    int err = streamReader.readFile();
+    DREAM3D_REQUIRED(err, >=, 0)
+
+    // The first read parses the file and writes the cache, the second read loads it
+    for(int pass = 0; pass < 2; pass++)
+    {
+      CtfReader cacheReader;
+      cacheReader.setFileName(ctfFile);
+      cacheReader.setUseSidecarCache(true);
+      err = cacheReader.readFile();
+      DREAM3D_REQUIRED(err, >=, 0)
+      DREAM3D_REQUIRE(fs::exists(cacheFile))
+
+      size_t numElements = cacheReader.getNumberOfElements();
+      DREAM3D_REQUIRED(numElements, ==, streamReader.getNumberOfElements())
+      DREAM3D_REQUIRED(cacheReader.getOriginalHeader(), ==, streamReader.getOriginalHeader())
+      DREAM3D_REQUIRED(cacheReader.getNumPhases(), ==, streamReader.getNumPhases())
+      DREAM3D_REQUIRED(cacheReader.getPhaseVector().size(), ==, streamReader.getPhaseVector().size())
+      DREAM3D_REQUIRED(cacheReader.getXCells(), ==, streamReader.getXCells())
+      DREAM3D_REQUIRE(cacheReader.getPhaseVector().back()->getLatticeConstants() == streamReader.getPhaseVector().back()->getLatticeConstants())
+
+      std::vector<std::string> columnNames = streamReader.getColumnNames();
+      DREAM3D_REQUIRE(cacheReader.getColumnNames() == columnNames)
+      for(const auto& name : columnNames)
+      {
+        const void* expected = streamReader.getPointerByName(name);
+        const void* actual = cacheReader.getPointerByName(name);
+        DREAM3D_REQUIRE_VALID_POINTER(actual)
+        DREAM3D_REQUIRE(::memcmp(expected, actual, numElements * 4) == 0)
+      }
+    }
+
+    // A single slice read does not use the cache of the complete file
+    EbsdSidecarCache cache;
+    DREAM3D_REQUIRE(cache.open(ctfFile, "ctf slice=-1"))
+    DREAM3D_REQUIRE(!cache.open(ctfFile, "ctf slice=0"))
+
+    // Only the requested arrays are loaded from the cache
+    CtfReader selectedReader;
+    selectedReader.setFileName(ctfFile);
+    selectedReader.setUseSidecarCache(true);
+    selectedReader.readAllArrays(false);
+    selectedReader.setArraysToRead({EbsdLib::Ctf::Euler1});
+    err = selectedReader.readFile();
+    DREAM3D_REQUIRED(err, >=, 0)
+    DREAM3D_REQUIRED(selectedReader.getColumnNames().size(), ==, 1)
+    size_t numElements = streamReader.getNumberOfElements();
+    DREAM3D_REQUIRE(std::equal(streamReader.getEuler1Pointer(), streamReader.getEuler1Pointer() + numElements, selectedReader.getEuler1Pointer()))
+
+    // Changing the source file invalidates the cache
+    fs::last_write_time(ctfFile, fs::last_write_time(ctfFile) - std::chrono::hours(1));
+    DREAM3D_REQUIRE(!cache.open(ctfFile, "ctf slice=-1"))
+
+#if REMOVE_TEST_FILES
+    fs::remove(cacheFile);
+    fs::remove(ctfFile);
+#endif
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -246,6 +732,13 @@ public:
     DREAM3D_REGISTER_TEST(TestCellCountToLarge())
     DREAM3D_REGISTER_TEST(TestShortFile())
     DREAM3D_REGISTER_TEST(TestZeroXYCells())
+    DREAM3D_REGISTER_TEST(TestMemoryMappedFile())
+    DREAM3D_REGISTER_TEST(TestBlankDataLines())
+    DREAM3D_REGISTER_TEST(TestLargeFile())
+    DREAM3D_REGISTER_TEST(TestColumnPlan())
+    DREAM3D_REGISTER_TEST(TestSelectedArrays())
+    DREAM3D_REGISTER_TEST(TestStreamRows())
+    DREAM3D_REGISTER_TEST(TestSidecarCache())
     DREAM3D_REGISTER_TEST(TestWriteCtfFile());
   }
 
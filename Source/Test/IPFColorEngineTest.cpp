@@ -0,0 +1,280 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/EbsdMacros.h"
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/LaueOps/IPFColorEngine.h"
+#include "EbsdLib/LaueOps/IPFColorLookupTable.h"
+#include "EbsdLib/LaueOps/LaueOps.h"
+#include "EbsdLib/Utilities/ColorTable.h"
+#include "EbsdLib/Utilities/ParallelDataAlgorithm.hpp"
+
+#include "UnitTestSupport.hpp"
+
+class IPFColorEngineTest
+{
+public:
+  IPFColorEngineTest() = default;
+  ~IPFColorEngineTest() = default;
+
+  IPFColorEngineTest(const IPFColorEngineTest&) = delete;            // Copy Constructor Not Implemented
+  IPFColorEngineTest(IPFColorEngineTest&&) = delete;                 // Move Constructor Not Implemented
+  IPFColorEngineTest& operator=(const IPFColorEngineTest&) = delete; // Copy Assignment Not Implemented
+  IPFColorEngineTest& operator=(IPFColorEngineTest&&) = delete;      // Move Assignment Not Implemented
+
+  EBSD_GET_NAME_OF_CLASS_DECL(IPFColorEngineTest)
+
+  // -----------------------------------------------------------------------------
+  void TestIPFColorEngine()
+  {
+    const size_t count = 20000;
+    std::mt19937_64 generator(2468);
+    std::uniform_real_distribution<float> angleDist(0.0F, 360.0F);
+    std::uniform_int_distribution<int32_t> phaseDist(-1, 6);
+
+    std::vector<float> eulers(count * 3);
+    std::vector<double> quats(count * 4);
+    std::vector<int32_t> phases(count);
+    std::unique_ptr<bool[]> mask(new bool[count]);
+    for(size_t i = 0; i < count; i++)
+    {
+      for(size_t c = 0; c < 3; c++)
+      {
+        eulers[i * 3 + c] = angleDist(generator);
+      }
+      Euler<double> eu(eulers[i * 3] * EbsdLib::Constants::k_DegToRadD, eulers[i * 3 + 1] * EbsdLib::Constants::k_DegToRadD, eulers[i * 3 + 2] * EbsdLib::Constants::k_DegToRadD);
+      QuatD q = OrientationTransformation::eu2qu<Euler<double>, QuatD>(eu);
+      quats[i * 4] = q.x();
+      quats[i * 4 + 1] = q.y();
+      quats[i * 4 + 2] = q.z();
+      quats[i * 4 + 3] = q.w();
+      phases[i] = phaseDist(generator);
+      mask[i] = (i % 7) != 0;
+    }
+
+    // Phase 0 is the unknown phase, phases -1, 5 and 6 are outside of the table
+    std::vector<uint32_t> laueIndices = {EbsdLib::CrystalStructure::UnknownCrystalStructure, EbsdLib::CrystalStructure::Cubic_High, EbsdLib::CrystalStructure::Hexagonal_High,
+                                         EbsdLib::CrystalStructure::Trigonal_Low, EbsdLib::CrystalStructure::OrthoRhombic};
+    std::vector<std::array<double, 3>> refDirs = {{0.0, 0.0, 1.0}, {1.0, 0.0, 0.0}, {0.0, 1.0, 1.0}};
+
+    IPFColorEngine engine;
+    engine.setPhaseLaueIndices(laueIndices);
+    engine.setReferenceDirections(refDirs);
+    engine.setConvertDegreesToRadians(true);
+
+    std::vector<std::vector<uint8_t>> eulerColors(refDirs.size(), std::vector<uint8_t>(count * 3, 255));
+    std::vector<std::vector<uint8_t>> quatColors(refDirs.size(), std::vector<uint8_t>(count * 3, 255));
+    std::vector<uint8_t*> eulerOutputs;
+    std::vector<uint8_t*> quatOutputs;
+    for(size_t r = 0; r < refDirs.size(); r++)
+    {
+      eulerOutputs.push_back(eulerColors[r].data());
+      quatOutputs.push_back(quatColors[r].data());
+    }
+    engine.computeFromEulers(eulers.data(), phases.data(), mask.get(), count, eulerOutputs);
+    engine.computeFromQuaternions(quats.data(), phases.data(), mask.get(), count, quatOutputs);
+
+    std::vector<LaueOps::Pointer> allOps = LaueOps::GetAllOrientationOps();
+    for(size_t i = 0; i < count; i++)
+    {
+      int32_t phase = phases[i];
+      bool colored = mask[i] && phase >= 0 && phase < static_cast<int32_t>(laueIndices.size()) && laueIndices[phase] < EbsdLib::CrystalStructure::LaueGroupEnd;
+      for(size_t r = 0; r < refDirs.size(); r++)
+      {
+        uint8_t expected[3] = {0, 0, 0};
+        if(colored)
+        {
+          double dEuler[3] = {eulers[i * 3], eulers[i * 3 + 1], eulers[i * 3 + 2]};
+          double refDir[3] = {refDirs[r][0], refDirs[r][1], refDirs[r][2]};
+          EbsdLib::Rgb argb = allOps[laueIndices[phase]]->generateIPFColor(dEuler, refDir, true);
+          expected[0] = static_cast<uint8_t>(EbsdLib::RgbColor::dRed(argb));
+          expected[1] = static_cast<uint8_t>(EbsdLib::RgbColor::dGreen(argb));
+          expected[2] = static_cast<uint8_t>(EbsdLib::RgbColor::dBlue(argb));
+        }
+        for(size_t c = 0; c < 3; c++)
+        {
+          DREAM3D_REQUIRE_EQUAL(eulerColors[r][i * 3 + c], expected[c])
+          DREAM3D_REQUIRE_EQUAL(quatColors[r][i * 3 + c], expected[c])
+        }
+      }
+    }
+
+    bool caught = false;
+    try
+    {
+      engine.computeFromEulers(eulers.data(), phases.data(), nullptr, count, {eulerOutputs[0]});
+    } catch(const std::runtime_error&)
+    {
+      caught = true;
+    }
+    DREAM3D_REQUIRE(caught)
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestIPFColorLookupTable()
+  {
+    // Triclinic has the fewest symmetry operators so its table is the quickest to build
+    IPFColorLookupTable::ConstPointer table = IPFColorLookupTable::Get(EbsdLib::CrystalStructure::Triclinic);
+    DREAM3D_REQUIRE(table == IPFColorLookupTable::Get(EbsdLib::CrystalStructure::Triclinic, IPFColorLookupTable::k_DefaultDimension))
+    DREAM3D_REQUIRE_EQUAL(table->getLaueIndex(), EbsdLib::CrystalStructure::Triclinic)
+    DREAM3D_REQUIRE_EQUAL(table->getDimension(), IPFColorLookupTable::k_DefaultDimension)
+
+    bool caught = false;
+    try
+    {
+      IPFColorLookupTable::Get(EbsdLib::CrystalStructure::UnknownCrystalStructure);
+    } catch(const std::out_of_range&)
+    {
+      caught = true;
+    }
+    DREAM3D_REQUIRE(caught)
+
+    const size_t count = 20000;
+    std::mt19937_64 generator(1357);
+    std::normal_distribution<double> normalDist(0.0, 1.0);
+    std::uniform_int_distribution<int32_t> phaseDist(0, 1);
+    std::vector<double> quats(count * 4);
+    std::vector<int32_t> phases(count);
+    for(size_t i = 0; i < count; i++)
+    {
+      QuatD q = QuatD(normalDist(generator), normalDist(generator), normalDist(generator), normalDist(generator)).unitQuaternion();
+      if(q.w() < 0.0)
+      {
+        q.negate();
+      }
+      quats[i * 4] = q.x();
+      quats[i * 4 + 1] = q.y();
+      quats[i * 4 + 2] = q.z();
+      quats[i * 4 + 3] = q.w();
+      phases[i] = phaseDist(generator);
+    }
+
+    // Phase 0 is the unknown phase and stays black in both modes
+    IPFColorEngine engine;
+    engine.setPhaseLaueIndices({EbsdLib::CrystalStructure::UnknownCrystalStructure, EbsdLib::CrystalStructure::Triclinic});
+    engine.setReferenceDirections({{0.0, 0.0, 1.0}, {0.0, 1.0, 1.0}});
+    DREAM3D_REQUIRE_EQUAL(engine.getUseLookupTable(), false)
+    DREAM3D_REQUIRE_EQUAL(engine.getLookupTableDimension(), IPFColorLookupTable::k_DefaultDimension)
+
+    std::vector<uint8_t> exactColors(count * 6, 255);
+    std::vector<uint8_t> tableColors(count * 6, 255);
+    engine.computeFromQuaternions(quats.data(), phases.data(), nullptr, count, {exactColors.data(), exactColors.data() + count * 3});
+    engine.setUseLookupTable(true);
+    engine.computeFromQuaternions(quats.data(), phases.data(), nullptr, count, {tableColors.data(), tableColors.data() + count * 3});
+
+    for(size_t i = 0; i < count * 6; i++)
+    {
+      int32_t error = std::abs(static_cast<int32_t>(exactColors[i]) - static_cast<int32_t>(tableColors[i]));
+      DREAM3D_REQUIRED(error, <=, IPFColorLookupTable::k_MaxColorError)
+    }
+  }
+
+  /**
+   * @brief GetTablesImpl fetches one of four tables for every index of a range
+   */
+  class GetTablesImpl
+  {
+  public:
+    explicit GetTablesImpl(std::vector<IPFColorLookupTable::ConstPointer>& tables)
+    : m_Tables(tables)
+    {
+    }
+
+    void generate(size_t start, size_t end) const
+    {
+      for(size_t i = start; i < end; i++)
+      {
+        m_Tables[i] = IPFColorLookupTable::Get(EbsdLib::CrystalStructure::Triclinic, 33 + i % 4);
+      }
+    }
+
+  private:
+    std::vector<IPFColorLookupTable::ConstPointer>& m_Tables;
+  };
+
+  // -----------------------------------------------------------------------------
+  void TestIPFColorLookupTableCache()
+  {
+    IPFColorLookupTable::ClearCache();
+    DREAM3D_REQUIRE_EQUAL(IPFColorLookupTable::GetCachedTableCount(), 0)
+
+    // Many small tables only ever keep a few of them
+    IPFColorLookupTable::ConstPointer first = IPFColorLookupTable::Get(EbsdLib::CrystalStructure::Triclinic, 9);
+    for(size_t dimension = 10; dimension < 40; dimension++)
+    {
+      IPFColorLookupTable::Get(EbsdLib::CrystalStructure::Triclinic, dimension);
+      DREAM3D_REQUIRED(IPFColorLookupTable::GetCachedTableCount(), <=, 16)
+    }
+    DREAM3D_REQUIRE_EQUAL(IPFColorLookupTable::GetCachedTableCount(), 16)
+    // The evicted table is rebuilt, the caller keeps the old one
+    IPFColorLookupTable::ConstPointer rebuilt = IPFColorLookupTable::Get(EbsdLib::CrystalStructure::Triclinic, 9);
+    DREAM3D_REQUIRE(rebuilt != first)
+    DREAM3D_REQUIRE(rebuilt == IPFColorLookupTable::Get(EbsdLib::CrystalStructure::Triclinic, 9))
+
+    IPFColorLookupTable::ClearCache();
+    DREAM3D_REQUIRE_EQUAL(IPFColorLookupTable::GetCachedTableCount(), 0)
+    DREAM3D_REQUIRE_EQUAL(first->getDimension(), 9)
+
+    // Tables requested from inside a parallel loop, while other tables are being built in parallel
+    std::vector<IPFColorLookupTable::ConstPointer> tables(64);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, tables.size());
+    dataAlg.setGrain(1);
+    dataAlg.execute(GetTablesImpl(tables));
+    for(size_t i = 0; i < tables.size(); i++)
+    {
+      DREAM3D_REQUIRE(tables[i] != nullptr)
+      DREAM3D_REQUIRE_EQUAL(tables[i]->getDimension(), 33 + i % 4)
+    }
+    IPFColorLookupTable::ClearCache();
+  }
+
+  void operator()()
+  {
+    std::cout << "<===== Start " << getNameOfClass() << std::endl;
+
+    int err = 0;
+    DREAM3D_REGISTER_TEST(TestIPFColorEngine());
+    DREAM3D_REGISTER_TEST(TestIPFColorLookupTable());
+    DREAM3D_REGISTER_TEST(TestIPFColorLookupTableCache());
+  }
+};
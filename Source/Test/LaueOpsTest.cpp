@@ -0,0 +1,271 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/EbsdMacros.h"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/LaueOps/LaueKernel.hpp"
+#include "EbsdLib/LaueOps/LaueOps.h"
+
+#include "UnitTestSupport.hpp"
+
+class LaueOpsTest
+{
+public:
+  LaueOpsTest() = default;
+  ~LaueOpsTest() = default;
+
+  LaueOpsTest(const LaueOpsTest&) = delete;            // Copy Constructor Not Implemented
+  LaueOpsTest(LaueOpsTest&&) = delete;                 // Move Constructor Not Implemented
+  LaueOpsTest& operator=(const LaueOpsTest&) = delete; // Copy Assignment Not Implemented
+  LaueOpsTest& operator=(LaueOpsTest&&) = delete;      // Move Assignment Not Implemented
+
+  EBSD_GET_NAME_OF_CLASS_DECL(LaueOpsTest)
+
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  std::vector<T> RandomQuaternions(size_t count, std::mt19937_64& generator)
+  {
+    std::normal_distribution<double> distribution(0.0, 1.0);
+    std::vector<T> quats(count * 4);
+    for(size_t i = 0; i < count; i++)
+    {
+      double q[4] = {distribution(generator), distribution(generator), distribution(generator), distribution(generator)};
+      double norm = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+      for(size_t c = 0; c < 4; c++)
+      {
+        quats[i * 4 + c] = static_cast<T>(q[c] / norm);
+      }
+    }
+    // Include a pair with no misorientation
+    for(size_t c = 0; c < 4; c++)
+    {
+      quats[c] = static_cast<T>(c == 3 ? 1.0 : 0.0);
+    }
+    return quats;
+  }
+
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void TestCalculateMisorientations()
+  {
+    const size_t count = 5000;
+    std::mt19937_64 generator(12345);
+    std::vector<T> q1 = RandomQuaternions<T>(count, generator);
+    std::vector<T> q2 = RandomQuaternions<T>(count, generator);
+    std::vector<T> axisAngles(count * 4);
+
+    const double tolerance = std::is_same<T, float>::value ? 1.0E-6 : 1.0E-12;
+    for(const auto& ops : LaueOps::GetAllOrientationOps())
+    {
+      ops->calculateMisorientations(q1.data(), q2.data(), axisAngles.data(), count);
+      for(size_t i = 0; i < count; i++)
+      {
+        Quaternion<T> a(q1[i * 4], q1[i * 4 + 1], q1[i * 4 + 2], q1[i * 4 + 3]);
+        Quaternion<T> b(q2[i * 4], q2[i * 4 + 1], q2[i * 4 + 2], q2[i * 4 + 3]);
+        Orientation<T> expected = ops->calculateMisorientation(a, b);
+        for(size_t c = 0; c < 4; c++)
+        {
+          DREAM3D_REQUIRED(std::fabs(static_cast<double>(axisAngles[i * 4 + c]) - static_cast<double>(expected[c])), <=, tolerance)
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestLaueKernels()
+  {
+    const size_t count = 500;
+    std::mt19937_64 generator(54321);
+    std::vector<double> q1 = RandomQuaternions<double>(count, generator);
+    std::vector<double> q2 = RandomQuaternions<double>(count, generator);
+    std::uniform_real_distribution<double> eulerDist(0.0, 1.0);
+
+    std::vector<LaueOps::Pointer> allOps = LaueOps::GetAllOrientationOps();
+    for(uint32_t laueIndex = 0; laueIndex < allOps.size(); laueIndex++)
+    {
+      const LaueOps& ops = *allOps[laueIndex];
+      LaueKernels::visit(laueIndex, [&](auto kernel) {
+        using KernelType = decltype(kernel);
+        DREAM3D_REQUIRE(KernelType::k_LaueIndex == laueIndex || laueIndex == EbsdLib::CrystalStructure::LaueGroupEnd)
+        DREAM3D_REQUIRE_EQUAL(static_cast<int>(KernelType::k_SymOpsCount), ops.getNumSymOps())
+        for(size_t op = 0; op < KernelType::k_SymOpsCount; op++)
+        {
+          QuatD expected = ops.getQuatSymOp(static_cast<int32_t>(op));
+          QuatD actual = KernelType::getQuatSymOp(op);
+          DREAM3D_REQUIRE(expected.x() == actual.x() && expected.y() == actual.y() && expected.z() == actual.z() && expected.w() == actual.w())
+        }
+
+        bool hasFZQuat = true;
+        try
+        {
+          ops.getFZQuat(QuatD(0.0, 0.0, 0.0, 1.0));
+        } catch(const EbsdLib::method_not_implemented&)
+        {
+          hasFZQuat = false;
+        }
+
+        for(size_t i = 0; i < count; i++)
+        {
+          QuatD a(q1[i * 4], q1[i * 4 + 1], q1[i * 4 + 2], q1[i * 4 + 3]);
+          QuatD c(q2[i * 4], q2[i * 4 + 1], q2[i * 4 + 2], q2[i * 4 + 3]);
+
+          OrientationD expectedMiso = ops.calculateMisorientation(a, c);
+          OrientationD actualMiso = kernel.calculateMisorientation(a, c);
+          for(size_t k = 0; k < 4; k++)
+          {
+            DREAM3D_REQUIRE(expectedMiso[k] == actualMiso[k])
+          }
+
+          // The misorientation angle must be the smallest angle over all of the symmetry operators
+          QuatD qr = a * (c.conjugate());
+          double maxW = 0.0;
+          for(size_t op = 0; op < KernelType::k_SymOpsCount; op++)
+          {
+            maxW = std::max(maxW, std::fabs((KernelType::getQuatSymOp(op) * qr).w()));
+          }
+          DREAM3D_REQUIRED(std::fabs(actualMiso[3] - 2.0 * std::acos(std::min(maxW, 1.0))), <, 1.0E-6)
+
+          QuatD fz = kernel.getFZQuat(a);
+          for(size_t op = 0; op < KernelType::k_SymOpsCount; op++)
+          {
+            DREAM3D_REQUIRED(fz.w(), >=, std::fabs((KernelType::getQuatSymOp(op) * a).w()) - 1.0E-12)
+          }
+          if(hasFZQuat)
+          {
+            QuatD expectedFZ = ops.getFZQuat(a);
+            DREAM3D_REQUIRE(expectedFZ.x() == fz.x() && expectedFZ.y() == fz.y() && expectedFZ.z() == fz.z() && expectedFZ.w() == fz.w())
+          }
+
+          OrientationType rod = OrientationTransformation::qu2ro<QuatD, OrientationType>(a);
+          OrientationType expectedRod = ops.getODFFZRod(rod);
+          OrientationType actualRod = kernel.getODFFZRod(rod);
+          for(size_t k = 0; k < 4; k++)
+          {
+            DREAM3D_REQUIRE(expectedRod[k] == actualRod[k] || (std::isnan(expectedRod[k]) && std::isnan(actualRod[k])))
+          }
+
+          double eulers[3] = {eulerDist(generator) * EbsdLib::Constants::k_2PiD, eulerDist(generator) * EbsdLib::Constants::k_PiD, eulerDist(generator) * EbsdLib::Constants::k_2PiD};
+          double refDir[3] = {0.0, 0.0, 1.0};
+          refDir[i % 3] = 1.0;
+          DREAM3D_REQUIRE_EQUAL(ops.generateIPFColor(eulers, refDir, false), kernel.generateIPFColor(eulers, refDir, false))
+        }
+      });
+    }
+
+    bool caught = false;
+    try
+    {
+      LaueKernels::visit(EbsdLib::CrystalStructure::UnknownCrystalStructure, [](auto kernel) { return KernelLaueIndex(kernel); });
+    } catch(const std::out_of_range&)
+    {
+      caught = true;
+    }
+    DREAM3D_REQUIRE(caught)
+  }
+
+  // -----------------------------------------------------------------------------
+  template <typename KernelType>
+  static uint32_t KernelLaueIndex(KernelType)
+  {
+    return KernelType::k_LaueIndex;
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestRandomizeEulerAnglesBatch()
+  {
+    // More than one block of the batch so that several random streams are used
+    const size_t count = 10000;
+    std::mt19937_64 generator(97531);
+    std::uniform_real_distribution<double> angleDist(0.0, EbsdLib::Constants::k_PiD);
+    std::vector<double> eulers(count * 3);
+    for(auto& angle : eulers)
+    {
+      angle = angleDist(generator);
+    }
+
+    std::vector<LaueOps::Pointer> allOps = LaueOps::GetAllOrientationOps();
+    for(size_t laueIndex = 0; laueIndex < EbsdLib::CrystalStructure::LaueGroupEnd; laueIndex++)
+    {
+      const LaueOps::Pointer& op = allOps[laueIndex];
+      std::vector<double> output(count * 3);
+      std::vector<double> again(count * 3);
+      op->randomizeEulerAnglesBatch(eulers.data(), output.data(), count, 42);
+      op->randomizeEulerAnglesBatch(eulers.data(), again.data(), count, 42);
+      DREAM3D_REQUIRE(output == again)
+
+      // Every point has its own stream so a shorter batch gives the same leading results
+      std::vector<double> prefix(999 * 3);
+      op->randomizeEulerAnglesBatch(eulers.data(), prefix.data(), 999, 42);
+      DREAM3D_REQUIRE(std::equal(prefix.begin(), prefix.end(), output.begin()))
+
+      std::vector<float> eulersF(eulers.begin(), eulers.end());
+      std::vector<float> outputF(count * 3);
+      op->randomizeEulerAnglesBatch(eulersF.data(), outputF.data(), count);
+
+      for(size_t i = 0; i < count; i++)
+      {
+        // Every result is symmetrically equivalent to its input
+        QuatD q1 = OrientationTransformation::eu2qu<Euler<double>, QuatD>(Euler<double>(&eulers[i * 3]));
+        QuatD q2 = OrientationTransformation::eu2qu<Euler<double>, QuatD>(Euler<double>(&output[i * 3]));
+        OrientationD axisAngle = op->calculateMisorientation(q1, q2);
+        DREAM3D_REQUIRED(axisAngle[3], <, 1.0E-6)
+
+        QuatF q1F = OrientationTransformation::eu2qu<Euler<float>, QuatF>(Euler<float>(&eulersF[i * 3]));
+        QuatF q2F = OrientationTransformation::eu2qu<Euler<float>, QuatF>(Euler<float>(&outputF[i * 3]));
+        OrientationF axisAngleF = op->calculateMisorientation(q1F, q2F);
+        DREAM3D_REQUIRED(axisAngleF[3], <, 1.0E-2F)
+      }
+    }
+  }
+
+  void operator()()
+  {
+    std::cout << "<===== Start " << getNameOfClass() << std::endl;
+
+    int err = 0;
+    DREAM3D_REGISTER_TEST(TestCalculateMisorientations<double>());
+    DREAM3D_REGISTER_TEST(TestCalculateMisorientations<float>());
+    DREAM3D_REGISTER_TEST(TestLaueKernels());
+    DREAM3D_REGISTER_TEST(TestRandomizeEulerAnglesBatch());
+  }
+};
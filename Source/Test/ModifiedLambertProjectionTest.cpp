@@ -0,0 +1,295 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/EbsdMacros.h"
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/Math/EbsdLibMath.h"
+#include "EbsdLib/Math/RandomService.h"
+#include "EbsdLib/Utilities/ComputeStereographicProjection.h"
+#include "EbsdLib/Utilities/ModifiedLambertProjection.h"
+#include "EbsdLib/Utilities/PoleFigureUtilities.h"
+
+#include "UnitTestSupport.hpp"
+
+class ModifiedLambertProjectionTest
+{
+public:
+  ModifiedLambertProjectionTest() = default;
+  ~ModifiedLambertProjectionTest() = default;
+
+  ModifiedLambertProjectionTest(const ModifiedLambertProjectionTest&) = delete;            // Copy Constructor Not Implemented
+  ModifiedLambertProjectionTest(ModifiedLambertProjectionTest&&) = delete;                 // Move Constructor Not Implemented
+  ModifiedLambertProjectionTest& operator=(const ModifiedLambertProjectionTest&) = delete; // Copy Assignment Not Implemented
+  ModifiedLambertProjectionTest& operator=(ModifiedLambertProjectionTest&&) = delete;      // Move Assignment Not Implemented
+
+  EBSD_GET_NAME_OF_CLASS_DECL(ModifiedLambertProjectionTest)
+
+  // -----------------------------------------------------------------------------
+  EbsdLib::FloatArrayType::Pointer RandomSphereCoords(size_t numCoords, uint64_t seed)
+  {
+    std::vector<size_t> cDims(1, 3);
+    EbsdLib::FloatArrayType::Pointer xyz = EbsdLib::FloatArrayType::CreateArray(numCoords, cDims, "xyzCoords", true);
+    EbsdLib::RandomService::EngineType generator = EbsdLib::RandomService::CreateEngine(seed);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    for(size_t i = 0; i < numCoords; i++)
+    {
+      float phi = distribution(generator) * EbsdLib::Constants::k_2PiF;
+      float cosTheta = 2.0f * distribution(generator) - 1.0f;
+      float sinTheta = std::sqrt(std::max(0.0f, 1.0f - cosTheta * cosTheta));
+      xyz->setValue(i * 3, sinTheta * std::cos(phi));
+      xyz->setValue(i * 3 + 1, sinTheta * std::sin(phi));
+      xyz->setValue(i * 3 + 2, cosTheta);
+    }
+    return xyz;
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestParallelStereographicProjection()
+  {
+    // Enough sphere coordinates to be split over several tasks
+    const size_t numCoords = 100000;
+    EbsdLib::FloatArrayType::Pointer xyz = RandomSphereCoords(numCoords, 1357);
+
+    PoleFigureConfiguration_t config;
+    config.imageDim = 64;
+    config.lambertDim = 32;
+    config.sphereRadius = 1.0f;
+
+    // Discrete bins hold whole counts and must match a serial pass exactly
+    config.discrete = true;
+    EbsdLib::DoubleArrayType::Pointer intensity = EbsdLib::DoubleArrayType::CreateArray(0, "Intensity", true);
+    ComputeStereographicProjection discrete(xyz.get(), &config, intensity.get());
+    discrete();
+    std::vector<double> expected(static_cast<size_t>(config.imageDim * config.imageDim), 0.0);
+    ComputeStereographicProjection::AddDiscreteCoordinates(xyz->getPointer(0), numCoords, config.imageDim, expected.data());
+    DREAM3D_REQUIRE_EQUAL(intensity->getNumberOfTuples(), expected.size())
+    for(size_t i = 0; i < expected.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(intensity->getValue(i), expected[i])
+    }
+
+    // The Lambert squares only differ from a serial pass in the order of the sums
+    ModifiedLambertProjection::Pointer lambert = ModifiedLambertProjection::LambertBallToSquare(xyz.get(), config.lambertDim, config.sphereRadius);
+    ModifiedLambertProjection::Pointer serial = ModifiedLambertProjection::New();
+    serial->initializeSquares(config.lambertDim, config.sphereRadius);
+    serial->addCoordinates(xyz->getPointer(0), numCoords);
+    const std::array<EbsdLib::DoubleArrayType::Pointer, 2> actualSquares = {lambert->getNorthSquare(), lambert->getSouthSquare()};
+    const std::array<EbsdLib::DoubleArrayType::Pointer, 2> serialSquares = {serial->getNorthSquare(), serial->getSouthSquare()};
+    for(size_t square = 0; square < 2; square++)
+    {
+      const EbsdLib::DoubleArrayType::Pointer& actualSquare = actualSquares[square];
+      const EbsdLib::DoubleArrayType::Pointer& serialSquare = serialSquares[square];
+      DREAM3D_REQUIRE_EQUAL(actualSquare->getNumberOfTuples(), serialSquare->getNumberOfTuples())
+      for(size_t i = 0; i < serialSquare->getNumberOfTuples(); i++)
+      {
+        double diff = std::abs(actualSquare->getValue(i) - serialSquare->getValue(i));
+        DREAM3D_REQUIRED(diff, <=, 1.0E-9 * std::max(1.0, std::abs(serialSquare->getValue(i))))
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestCachedStereographicMapping()
+  {
+    const size_t numCoords = 5000;
+    std::vector<size_t> cDims(1, 3);
+    EbsdLib::FloatArrayType::Pointer xyz = EbsdLib::FloatArrayType::CreateArray(numCoords, cDims, "xyzCoords", true);
+    EbsdLib::RandomService::EngineType generator = EbsdLib::RandomService::CreateEngine(8642);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    for(size_t i = 0; i < numCoords; i++)
+    {
+      std::array<float, 3> v = {distribution(generator), distribution(generator), distribution(generator)};
+      float norm = std::max(std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]), 1.0E-6f);
+      xyz->setValue(i * 3, v[0] / norm);
+      xyz->setValue(i * 3 + 1, v[1] / norm);
+      xyz->setValue(i * 3 + 2, v[2] / norm);
+    }
+
+    for(int lambertDim : {16, 32})
+    {
+      ModifiedLambertProjection::Pointer lambert = ModifiedLambertProjection::LambertBallToSquare(xyz.get(), lambertDim, 1.0f);
+      lambert->normalizeSquaresToMRD();
+      for(int dim : {33, 64})
+      {
+        // Evaluate every pixel directly from the square coordinates of the sphere points
+        std::vector<double> expectedStereo(static_cast<size_t>(dim * dim), 0.0);
+        std::vector<double> expectedCircular(static_cast<size_t>(dim * dim), 0.0);
+        const float circularRadius = std::sqrt(2.0f);
+        for(int y = 0; y < dim; y++)
+        {
+          for(int x = 0; x < dim; x++)
+          {
+            for(bool circular : {false, true})
+            {
+              float unitRadius = circular ? circularRadius : 1.0f;
+              float res = 2.0f * unitRadius / static_cast<float>(dim);
+              float xtmp = static_cast<float>(x - dim / 2) * res + (res * 0.5f);
+              float ytmp = static_cast<float>(y - dim / 2) * res + (res * 0.5f);
+              float q = xtmp * xtmp + ytmp * ytmp;
+              if(q > unitRadius * unitRadius)
+              {
+                continue;
+              }
+              std::array<float, 3> point = {0.0f, 0.0f, 0.0f};
+              if(circular)
+              {
+                float t = std::sqrt(1.0f - (q / 4.0f));
+                point = {xtmp * t, ytmp * t, (q / 2.0f) - 1.0f};
+              }
+              else
+              {
+                point[2] = -(q - 1) / (q + 1);
+                point[0] = xtmp * (1 + point[2]);
+                point[1] = ytmp * (1 + point[2]);
+              }
+              double value = 0.0;
+              for(float sign : {1.0f, -1.0f})
+              {
+                std::array<float, 3> signedPoint = {point[0] * sign, point[1] * sign, point[2] * sign};
+                std::array<float, 2> sqCoord = {0.0f, 0.0f};
+                bool north = lambert->getSquareCoord(signedPoint.data(), sqCoord.data());
+                value += lambert->getInterpolatedValue(north ? ModifiedLambertProjection::NorthSquare : ModifiedLambertProjection::SouthSquare, sqCoord.data());
+              }
+              (circular ? expectedCircular : expectedStereo)[static_cast<size_t>(y * dim + x)] = value * 0.5;
+            }
+          }
+        }
+
+        // The second call of each projection reuses the cached mapping
+        for(int pass = 0; pass < 2; pass++)
+        {
+          EbsdLib::DoubleArrayType::Pointer stereo = lambert->createStereographicProjection(dim);
+          std::vector<float> circularImage = lambert->createCircularProjection(dim);
+          DREAM3D_REQUIRE_EQUAL(stereo->getNumberOfTuples(), expectedStereo.size())
+          DREAM3D_REQUIRE_EQUAL(circularImage.size(), expectedCircular.size())
+          for(size_t i = 0; i < expectedStereo.size(); i++)
+          {
+            double stereoDiff = std::abs(stereo->getValue(i) - expectedStereo[i]);
+            double circularDiff = std::abs(static_cast<double>(circularImage[i]) - expectedCircular[i]);
+            DREAM3D_REQUIRED(stereoDiff, <=, 1.0E-5 * std::max(1.0, std::abs(expectedStereo[i])))
+            DREAM3D_REQUIRED(circularDiff, <=, 1.0E-5 * std::max(1.0, std::abs(expectedCircular[i])))
+          }
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestStereographicMappingCacheBound()
+  {
+    EbsdLib::FloatArrayType::Pointer xyz = RandomSphereCoords(1000, 97531);
+    ModifiedLambertProjection::Pointer lambert = ModifiedLambertProjection::LambertBallToSquare(xyz.get(), 16, 1.0f);
+    ModifiedLambertProjection::ClearCache();
+    DREAM3D_REQUIRE_EQUAL(ModifiedLambertProjection::GetCachedMappingCount(), 0)
+
+    EbsdLib::DoubleArrayType::Pointer first = lambert->createStereographicProjection(20);
+    DREAM3D_REQUIRE_EQUAL(ModifiedLambertProjection::GetCachedMappingCount(), 1)
+    // Many image sizes only ever keep a few mappings
+    for(int dim = 21; dim < 40; dim++)
+    {
+      lambert->createStereographicProjection(dim);
+      lambert->createCircularProjection(dim);
+      DREAM3D_REQUIRED(ModifiedLambertProjection::GetCachedMappingCount(), <=, 4)
+    }
+    DREAM3D_REQUIRE_EQUAL(ModifiedLambertProjection::GetCachedMappingCount(), 4)
+
+    // An evicted mapping is rebuilt with the same values
+    EbsdLib::DoubleArrayType::Pointer rebuilt = lambert->createStereographicProjection(20);
+    DREAM3D_REQUIRE(std::equal(first->begin(), first->end(), rebuilt->begin()))
+
+    ModifiedLambertProjection::ClearCache();
+    DREAM3D_REQUIRE_EQUAL(ModifiedLambertProjection::GetCachedMappingCount(), 0)
+    rebuilt = lambert->createStereographicProjection(20);
+    DREAM3D_REQUIRE(std::equal(first->begin(), first->end(), rebuilt->begin()))
+    ModifiedLambertProjection::ClearCache();
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestLargeImageProjection()
+  {
+    // A 2048 x 2048 image with enough coordinates for more than one private image. The timing of the same
+    // projections is measured by the projection_benchmark app.
+    PoleFigureConfiguration_t config;
+    config.imageDim = 2048;
+    config.lambertDim = 512;
+    config.sphereRadius = 1.0f;
+    config.discrete = true;
+    const size_t imageSize = static_cast<size_t>(config.imageDim) * static_cast<size_t>(config.imageDim);
+    const size_t numCoords = 2 * imageSize + 1;
+    EbsdLib::FloatArrayType::Pointer xyz = RandomSphereCoords(numCoords, 4321);
+
+    EbsdLib::DoubleArrayType::Pointer intensity = EbsdLib::DoubleArrayType::CreateArray(0, "Intensity", true);
+    ComputeStereographicProjection(xyz.get(), &config, intensity.get())();
+    std::vector<double> expected(imageSize, 0.0);
+    ComputeStereographicProjection::AddDiscreteCoordinates(xyz->getPointer(0), numCoords, config.imageDim, expected.data());
+    DREAM3D_REQUIRE(std::equal(expected.begin(), expected.end(), intensity->begin()))
+
+    // The Lambert squares interpolate every coordinate so fewer of them are used
+    const size_t numLambertCoords = 6 * static_cast<size_t>(config.lambertDim) * static_cast<size_t>(config.lambertDim);
+    xyz->resizeTuples(numLambertCoords);
+    ModifiedLambertProjection::Pointer lambert = ModifiedLambertProjection::LambertBallToSquare(xyz.get(), config.lambertDim, config.sphereRadius);
+    ModifiedLambertProjection::Pointer serial = ModifiedLambertProjection::New();
+    serial->initializeSquares(config.lambertDim, config.sphereRadius);
+    serial->addCoordinates(xyz->getPointer(0), numLambertCoords);
+    const std::array<ModifiedLambertProjection::Square, 2> squares = {ModifiedLambertProjection::NorthSquare, ModifiedLambertProjection::SouthSquare};
+    for(ModifiedLambertProjection::Square square : squares)
+    {
+      const double* expectedSquare = (square == ModifiedLambertProjection::NorthSquare) ? serial->getNorthSquare()->getPointer(0) : serial->getSouthSquare()->getPointer(0);
+      const double* actualSquare = (square == ModifiedLambertProjection::NorthSquare) ? lambert->getNorthSquare()->getPointer(0) : lambert->getSouthSquare()->getPointer(0);
+      for(size_t i = 0; i < serial->getNorthSquare()->getNumberOfTuples(); i++)
+      {
+        double diff = std::abs(actualSquare[i] - expectedSquare[i]);
+        DREAM3D_REQUIRED(diff, <=, 1.0E-9 * std::max(1.0, std::abs(expectedSquare[i])))
+      }
+    }
+  }
+
+  void operator()()
+  {
+    std::cout << "<===== Start " << getNameOfClass() << std::endl;
+
+    int err = 0;
+    DREAM3D_REGISTER_TEST(TestParallelStereographicProjection());
+    DREAM3D_REGISTER_TEST(TestCachedStereographicMapping());
+    DREAM3D_REGISTER_TEST(TestStereographicMappingCacheBound());
+    DREAM3D_REGISTER_TEST(TestLargeImageProjection());
+  }
+};
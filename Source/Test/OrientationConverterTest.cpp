@@ -33,6 +33,8 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
 #include <iomanip>
 #include <iostream>
@@ -188,6 +190,238 @@ public:
     }
   }
 
+  // -----------------------------------------------------------------------------
+  template <typename T, template <class, typename> class ConverterType>
+  void TestFusedConversion(typename EbsdDataArray<T>::Pointer input)
+  {
+    using OCType = OrientationConverter<EbsdDataArray<T>, T>;
+    std::vector<OrientationRepresentation::Type> ocTypes = OCType::GetOrientationTypes();
+
+    typename OCType::Pointer converter = ConverterType<EbsdDataArray<T>, T>::New();
+    converter->setInputData(input);
+    std::vector<typename EbsdDataArray<T>::Pointer> fused = converter->convertRepresentationsTo(ocTypes);
+    DREAM3D_REQUIRE_EQUAL(fused.size(), ocTypes.size());
+
+    for(size_t t = 0; t < ocTypes.size(); t++)
+    {
+      converter->convertRepresentationTo(ocTypes[t]);
+      typename EbsdDataArray<T>::Pointer single = converter->getOutputData();
+      DREAM3D_REQUIRE_EQUAL(fused[t]->getNumberOfTuples(), single->getNumberOfTuples());
+      DREAM3D_REQUIRE_EQUAL(fused[t]->getNumberOfComponents(), single->getNumberOfComponents());
+      for(size_t i = 0; i < single->getSize(); i++)
+      {
+        T fusedValue = fused[t]->getValue(i);
+        T singleValue = single->getValue(i);
+        DREAM3D_REQUIRE((fusedValue == singleValue) || (std::isnan(fusedValue) && std::isnan(singleValue)));
+      }
+    }
+
+    bool caught = false;
+    try
+    {
+      converter->convertRepresentationsTo({OrientationRepresentation::Type::Unknown});
+    } catch(const std::runtime_error&)
+    {
+      caught = true;
+    }
+    DREAM3D_REQUIRE(caught);
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestFusedConversions()
+  {
+    size_t numSteps = 6;
+    size_t nTuples = numSteps * numSteps * numSteps;
+    std::vector<size_t> cDims(1, 3);
+    EbsdLib::DoubleArrayType::Pointer eulers = EbsdLib::DoubleArrayType::CreateArray(nTuples, cDims, "Eulers", true);
+    size_t index = 0;
+    for(size_t p2 = 0; p2 < numSteps; p2++)
+    {
+      for(size_t p = 0; p < numSteps; p++)
+      {
+        for(size_t p1 = 0; p1 < numSteps; p1++)
+        {
+          eulers->setComponent(index, 0, EbsdLib::Constants::k_2PiD * static_cast<double>(p1) / numSteps);
+          eulers->setComponent(index, 1, EbsdLib::Constants::k_PiD * static_cast<double>(p) / numSteps);
+          eulers->setComponent(index, 2, EbsdLib::Constants::k_2PiD * static_cast<double>(p2) / numSteps);
+          index++;
+        }
+      }
+    }
+    TestFusedConversion<double, EulerConverter>(eulers);
+
+    using OCType = OrientationConverter<EbsdLib::DoubleArrayType, double>;
+    OCType::Pointer ocEulers = EulerConverter<EbsdLib::DoubleArrayType, double>::New();
+    ocEulers->setInputData(eulers);
+    ocEulers->convertRepresentationTo(OrientationRepresentation::Type::Quaternion);
+    EbsdLib::DoubleArrayType::Pointer quats = ocEulers->getOutputData();
+    TestFusedConversion<double, QuaternionConverter>(quats);
+
+    ocEulers->convertRepresentationTo(OrientationRepresentation::Type::Homochoric);
+    EbsdLib::DoubleArrayType::Pointer homochoric = ocEulers->getOutputData();
+    TestFusedConversion<double, HomochoricConverter>(homochoric);
+
+    EbsdLib::FloatArrayType::Pointer eulersF = EbsdLib::FloatArrayType::CreateArray(nTuples, cDims, "Eulers", true);
+    for(size_t i = 0; i < eulers->getSize(); i++)
+    {
+      eulersF->setValue(i, static_cast<float>(eulers->getValue(i)));
+    }
+    TestFusedConversion<float, EulerConverter>(eulersF);
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestCallerProvidedOutput()
+  {
+    size_t numSteps = 5;
+    size_t nTuples = numSteps * numSteps * numSteps;
+    std::vector<size_t> cDims(1, 3);
+    EbsdLib::DoubleArrayType::Pointer eulers = EbsdLib::DoubleArrayType::CreateArray(nTuples, cDims, "Eulers", true);
+    for(size_t i = 0; i < nTuples; i++)
+    {
+      eulers->setComponent(i, 0, EbsdLib::Constants::k_2PiD * static_cast<double>(i % numSteps) / numSteps);
+      eulers->setComponent(i, 1, EbsdLib::Constants::k_PiD * static_cast<double>((i / numSteps) % numSteps) / numSteps);
+      eulers->setComponent(i, 2, EbsdLib::Constants::k_2PiD * static_cast<double>(i / (numSteps * numSteps)) / numSteps);
+    }
+
+    using OCType = OrientationConverter<EbsdLib::DoubleArrayType, double>;
+    std::vector<OrientationRepresentation::Type> ocTypes = OCType::GetOrientationTypes();
+    auto strides = OCType::GetComponentCounts<std::vector<size_t>>();
+    OCType::Pointer converter = EulerConverter<EbsdLib::DoubleArrayType, double>::New();
+    converter->setInputData(eulers);
+
+    const size_t chunkSize = 7;
+    std::vector<double> chunk(chunkSize * 9);
+    for(size_t t = 0; t < ocTypes.size(); t++)
+    {
+      converter->convertRepresentationTo(ocTypes[t]);
+      EbsdLib::DoubleArrayType::Pointer single = converter->getOutputData();
+
+      // The same caller owned array is reused and resized for each conversion
+      std::vector<size_t> outDims(1, strides[t]);
+      EbsdLib::DoubleArrayType::Pointer reused = EbsdLib::DoubleArrayType::CreateArray(1, outDims, "Reused", true);
+      converter->convertRepresentationTo(ocTypes[t], *reused);
+      converter->convertRepresentationTo(ocTypes[t], *reused);
+      DREAM3D_REQUIRE_EQUAL(reused->getNumberOfTuples(), nTuples);
+      DREAM3D_REQUIRE(converter->getOutputData() == single);
+      for(size_t i = 0; i < single->getSize(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(reused->getValue(i), single->getValue(i));
+      }
+
+      // Convert the input in chunks through a small buffer
+      for(size_t start = 0; start < nTuples; start += chunkSize)
+      {
+        size_t end = std::min(start + chunkSize, nTuples);
+        converter->convertRepresentationTo(ocTypes[t], chunk.data(), start, end);
+        for(size_t i = 0; i < (end - start) * strides[t]; i++)
+        {
+          DREAM3D_REQUIRE_EQUAL(chunk[i], single->getValue(start * strides[t] + i));
+        }
+      }
+    }
+
+    bool caught = false;
+    try
+    {
+      EbsdLib::DoubleArrayType::Pointer wrong = EbsdLib::DoubleArrayType::CreateArray(nTuples, cDims, "Wrong", true);
+      converter->convertRepresentationTo(OrientationRepresentation::Type::Quaternion, *wrong);
+    } catch(const std::runtime_error&)
+    {
+      caught = true;
+    }
+    DREAM3D_REQUIRE(caught);
+
+    caught = false;
+    try
+    {
+      converter->convertRepresentationTo(OrientationRepresentation::Type::Quaternion, chunk.data(), nTuples - 1, nTuples + 1);
+    } catch(const std::out_of_range&)
+    {
+      caught = true;
+    }
+    DREAM3D_REQUIRE(caught);
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestFusedSanityCheck()
+  {
+    using OCType = OrientationConverter<EbsdLib::DoubleArrayType, double>;
+    std::vector<size_t> cDims(1, 3);
+
+    // Eulers: tuples 1 and 3 are out of range and must be wrapped
+    std::vector<double> angles = {0.1, 0.2, 0.3, -0.5, 0.4, 7.0, 1.0, 1.5, 2.0, 6.5, -4.0, 0.25};
+    size_t nTuples = angles.size() / 3;
+    EbsdLib::DoubleArrayType::Pointer separate = EbsdLib::DoubleArrayType::CreateArray(nTuples, cDims, "Eulers", true);
+    EbsdLib::DoubleArrayType::Pointer fused = EbsdLib::DoubleArrayType::CreateArray(nTuples, cDims, "Eulers", true);
+    for(size_t i = 0; i < angles.size(); i++)
+    {
+      separate->setValue(i, angles[i]);
+      fused->setValue(i, angles[i]);
+    }
+
+    OCType::Pointer converter = EulerConverter<EbsdLib::DoubleArrayType, double>::New();
+    converter->setInputData(separate);
+    converter->convertRepresentationTo(OrientationRepresentation::Type::Quaternion);
+    EbsdLib::DoubleArrayType::Pointer expected = converter->getOutputData();
+
+    converter->setFusedSanityCheck(true);
+    converter->setInputData(fused);
+    converter->convertRepresentationTo(OrientationRepresentation::Type::Quaternion);
+    EbsdLib::DoubleArrayType::Pointer actual = converter->getOutputData();
+    DREAM3D_REQUIRE_EQUAL(converter->getRepairedTupleCount(), 2);
+    DREAM3D_REQUIRE_EQUAL(converter->getInvalidTupleCount(), 0);
+    for(size_t i = 0; i < expected->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(actual->getValue(i), expected->getValue(i));
+    }
+    for(size_t i = 0; i < separate->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(fused->getValue(i), separate->getValue(i));
+    }
+
+    // Quaternions: the second tuple is in the southern hemisphere. Neither mode changes the input.
+    std::vector<size_t> qDims(1, 4);
+    EbsdLib::DoubleArrayType::Pointer quats = EbsdLib::DoubleArrayType::CreateArray(2, qDims, "Quats", true);
+    std::vector<double> qValues = {0.1, 0.2, 0.3, 0.92736184954957035, -0.1, -0.2, -0.3, -0.92736184954957035};
+    for(size_t i = 0; i < qValues.size(); i++)
+    {
+      quats->setValue(i, qValues[i]);
+    }
+    OCType::Pointer quatConverter = QuaternionConverter<EbsdLib::DoubleArrayType, double>::New();
+    quatConverter->setInputData(quats);
+    std::vector<EbsdLib::DoubleArrayType::Pointer> expectedOutputs = quatConverter->convertRepresentationsTo({OrientationRepresentation::Type::Euler, OrientationRepresentation::Type::Rodrigues});
+    quatConverter->setFusedSanityCheck(true);
+    std::vector<EbsdLib::DoubleArrayType::Pointer> outputs = quatConverter->convertRepresentationsTo({OrientationRepresentation::Type::Euler, OrientationRepresentation::Type::Rodrigues});
+    DREAM3D_REQUIRE_EQUAL(quatConverter->getRepairedTupleCount(), 0);
+    for(size_t i = 0; i < qValues.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(quats->getValue(i), qValues[i]);
+    }
+    for(size_t o = 0; o < outputs.size(); o++)
+    {
+      for(size_t i = 0; i < outputs[o]->getSize(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(outputs[o]->getValue(i), expectedOutputs[o]->getValue(i));
+      }
+    }
+
+    // Orientation matrices: the second one is not orthonormal
+    std::vector<size_t> omDims(1, 9);
+    EbsdLib::DoubleArrayType::Pointer matrices = EbsdLib::DoubleArrayType::CreateArray(2, omDims, "Matrices", true);
+    std::vector<double> omValues = {1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 2.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+    for(size_t i = 0; i < omValues.size(); i++)
+    {
+      matrices->setValue(i, omValues[i]);
+    }
+    OCType::Pointer omConverter = OrientationMatrixConverter<EbsdLib::DoubleArrayType, double>::New();
+    omConverter->setFusedSanityCheck(true);
+    omConverter->setInputData(matrices);
+    std::vector<double> buffer(8);
+    omConverter->convertRepresentationTo(OrientationRepresentation::Type::Quaternion, buffer.data(), 0, 2);
+    DREAM3D_REQUIRE_EQUAL(omConverter->getRepairedTupleCount(), 0);
+    DREAM3D_REQUIRE_EQUAL(omConverter->getInvalidTupleCount(), 1);
+  }
+
   // -----------------------------------------------------------------------------
   void operator()()
   {
@@ -196,5 +430,8 @@ public:
     int err = 0;
     DREAM3D_REGISTER_TEST(TestEuler2Quaternion());
     DREAM3D_REGISTER_TEST(TestEulerConversion());
+    DREAM3D_REGISTER_TEST(TestFusedConversions());
+    DREAM3D_REGISTER_TEST(TestCallerProvidedOutput());
+    DREAM3D_REGISTER_TEST(TestFusedSanityCheck());
   }
 };
@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "EbsdLib/Core/EbsdDataArray.hpp"
+#include "EbsdLib/Core/FixedOrientation.hpp"
 #include "EbsdLib/Core/Orientation.hpp"
 #include "EbsdLib/Core/OrientationTransformation.hpp"
 #include "EbsdLib/Core/Quaternion.hpp"
@@ -950,6 +951,90 @@ Rotation vector map              : -0.7854   0.0000   0.0000
     }
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename FixedType, typename DynamicType>
+  void RequireSameOrientation(const FixedType& fixed, const DynamicType& dynamic, size_t numElements)
+  {
+    for(size_t i = 0; i < numElements; i++)
+    {
+      DREAM3D_REQUIRE(fixed[i] == dynamic[i] || (std::isinf(fixed[i]) && std::isinf(dynamic[i])))
+    }
+  }
+
+#define REQUIRE_SAME_CONVERSION(METHOD, FIXED_IN, DYNAMIC_IN, FIXED_OUT, NUM_ELEMENTS)                                                                                                                 \
+  RequireSameOrientation(OrientationTransformation::METHOD<decltype(FIXED_IN), FIXED_OUT>(FIXED_IN), OrientationTransformation::METHOD<OrientationD, OrientationD>(DYNAMIC_IN), NUM_ELEMENTS);
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestFixedOrientation()
+  {
+    // The size constructor only accepts the compile time size
+    bool caught = false;
+    try
+    {
+      Euler<double> eu(4);
+    } catch(const std::runtime_error&)
+    {
+      caught = true;
+    }
+    DREAM3D_REQUIRE(caught)
+
+    std::vector<std::array<double, 3>> eulers = {{0.0, 0.0, 0.0}, {0.3926990816987242, 0.0, 0.0}, {1.0, 0.5, 2.0}, {5.5, 2.9452431201934814, 3.1415927410125732}, {2.0, 1.5707963267948966, 0.25}};
+    for(const auto& values : eulers)
+    {
+      Euler<double> eu(values[0], values[1], values[2]);
+      OrientationD euD(values[0], values[1], values[2]);
+
+      OrientMatrix<double> om = OrientationTransformation::eu2om<Euler<double>, OrientMatrix<double>>(eu);
+      AxisAngle<double> ax = OrientationTransformation::eu2ax<Euler<double>, AxisAngle<double>>(eu);
+      Rodrigues<double> ro = OrientationTransformation::eu2ro<Euler<double>, Rodrigues<double>>(eu);
+      Homochoric<double> ho = OrientationTransformation::eu2ho<Euler<double>, Homochoric<double>>(eu);
+      Cubochoric<double> cu = OrientationTransformation::eu2cu<Euler<double>, Cubochoric<double>>(eu);
+      Stereographic<double> st = OrientationTransformation::eu2st<Euler<double>, Stereographic<double>>(eu);
+      OrientationD omD = OrientationTransformation::eu2om<OrientationD, OrientationD>(euD);
+      OrientationD axD = OrientationTransformation::eu2ax<OrientationD, OrientationD>(euD);
+      OrientationD roD = OrientationTransformation::eu2ro<OrientationD, OrientationD>(euD);
+      OrientationD hoD = OrientationTransformation::eu2ho<OrientationD, OrientationD>(euD);
+      OrientationD cuD = OrientationTransformation::eu2cu<OrientationD, OrientationD>(euD);
+      OrientationD stD = OrientationTransformation::eu2st<OrientationD, OrientationD>(euD);
+      RequireSameOrientation(om, omD, 9);
+      RequireSameOrientation(ax, axD, 4);
+      RequireSameOrientation(ro, roD, 4);
+      RequireSameOrientation(ho, hoD, 3);
+      RequireSameOrientation(cu, cuD, 3);
+      RequireSameOrientation(st, stD, 3);
+
+      // The composite conversions size their intermediate results from the fixed types
+      REQUIRE_SAME_CONVERSION(om2eu, om, omD, Euler<double>, 3)
+      REQUIRE_SAME_CONVERSION(om2ro, om, omD, Rodrigues<double>, 4)
+      REQUIRE_SAME_CONVERSION(om2ho, om, omD, Homochoric<double>, 3)
+      REQUIRE_SAME_CONVERSION(om2ax, om, omD, AxisAngle<double>, 4)
+      REQUIRE_SAME_CONVERSION(ax2eu, ax, axD, Euler<double>, 3)
+      REQUIRE_SAME_CONVERSION(ax2cu, ax, axD, Cubochoric<double>, 3)
+      REQUIRE_SAME_CONVERSION(ro2eu, ro, roD, Euler<double>, 3)
+      REQUIRE_SAME_CONVERSION(ro2om, ro, roD, OrientMatrix<double>, 9)
+      REQUIRE_SAME_CONVERSION(ro2ho, ro, roD, Homochoric<double>, 3)
+      REQUIRE_SAME_CONVERSION(ho2eu, ho, hoD, Euler<double>, 3)
+      REQUIRE_SAME_CONVERSION(ho2om, ho, hoD, OrientMatrix<double>, 9)
+      REQUIRE_SAME_CONVERSION(ho2ro, ho, hoD, Rodrigues<double>, 4)
+      REQUIRE_SAME_CONVERSION(cu2eu, cu, cuD, Euler<double>, 3)
+      REQUIRE_SAME_CONVERSION(cu2om, cu, cuD, OrientMatrix<double>, 9)
+      REQUIRE_SAME_CONVERSION(cu2ax, cu, cuD, AxisAngle<double>, 4)
+      REQUIRE_SAME_CONVERSION(cu2ro, cu, cuD, Rodrigues<double>, 4)
+      REQUIRE_SAME_CONVERSION(st2eu, st, stD, Euler<double>, 3)
+      REQUIRE_SAME_CONVERSION(st2om, st, stD, OrientMatrix<double>, 9)
+      REQUIRE_SAME_CONVERSION(om2qu, om, omD, QuatD, 4)
+      REQUIRE_SAME_CONVERSION(ho2qu, ho, hoD, QuatD, 4)
+      REQUIRE_SAME_CONVERSION(cu2qu, cu, cuD, QuatD, 4)
+      REQUIRE_SAME_CONVERSION(st2qu, st, stD, QuatD, 4)
+    }
+  }
+
+#undef REQUIRE_SAME_CONVERSION
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -1026,6 +1111,7 @@ Rotation vector map              : -0.7854   0.0000   0.0000
     DREAM3D_REGISTER_TEST(Test_st2_XXX());
 
     DREAM3D_REGISTER_TEST(TestInputs());
+    DREAM3D_REGISTER_TEST(TestFixedOrientation());
   }
 
 public:
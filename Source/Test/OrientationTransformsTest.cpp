@@ -45,6 +45,7 @@
 #include "EbsdLib/Core/EbsdDataArray.hpp"
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/Core/OrientationTransformationBatch.h"
 #include "EbsdLib/OrientationMath/OrientationConverter.hpp"
 #include "EbsdLib/Utilities/EbsdStringUtils.hpp"
 
@@ -556,6 +557,198 @@ public:
     }
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T, size_t N>
+  OrientationTransformation::Batch::SoASpan<T, N> MakeSpan(std::vector<T>& values)
+  {
+    OrientationTransformation::Batch::SoASpan<T, N> span;
+    span.size = values.size() / N;
+    for(size_t c = 0; c < N; c++)
+    {
+      span.components[c] = values.data() + c * span.size;
+    }
+    return span;
+  }
+
+  template <typename T, size_t N>
+  OrientationTransformation::Batch::SoASpan<const T, N> MakeConstSpan(const std::vector<T>& values)
+  {
+    OrientationTransformation::Batch::SoASpan<const T, N> span;
+    span.size = values.size() / N;
+    for(size_t c = 0; c < N; c++)
+    {
+      span.components[c] = values.data() + c * span.size;
+    }
+    return span;
+  }
+
+  /**
+   * @brief Runs one of the scalar OrientationTransformation functions over every tuple of an SoA array
+   */
+  template <typename T, size_t NIn, size_t NOut, typename InputType, typename OutputType, typename FunctionType>
+  std::vector<T> ScalarReference(const std::vector<T>& input, FunctionType function)
+  {
+    const size_t count = input.size() / NIn;
+    std::vector<T> output(count * NOut);
+    InputType in(NIn);
+    for(size_t i = 0; i < count; i++)
+    {
+      for(size_t c = 0; c < NIn; c++)
+      {
+        in[c] = input[c * count + i];
+      }
+      OutputType out = function(in);
+      for(size_t c = 0; c < NOut; c++)
+      {
+        output[c * count + i] = out[c];
+      }
+    }
+    return output;
+  }
+
+  /**
+   * @brief Largest difference between the batch and scalar results. Angles are compared modulo 2pi, the
+   * fourth Rodrigues component relative to its size and quaternions up to their sign because the sign
+   * of a 180 degree rotation is an arbitrary choice.
+   */
+  enum class CompareMode
+  {
+    Absolute,
+    Angle,
+    Rodrigues,
+    Quaternion
+  };
+
+  template <typename T>
+  double MaxDifference(const std::vector<T>& batch, const std::vector<T>& scalar, size_t numComps, CompareMode mode)
+  {
+    const size_t count = scalar.size() / numComps;
+    double maxDiff = 0.0;
+    for(size_t i = 0; i < count; i++)
+    {
+      double plus = 0.0;
+      double minus = 0.0;
+      for(size_t c = 0; c < numComps; c++)
+      {
+        const double a = batch[c * count + i];
+        const double b = scalar[c * count + i];
+        if(std::isnan(b))
+        {
+          // The scalar code has no answer (e.g. ho2qu very close to the identity)
+          DREAM3D_REQUIRE(std::isfinite(a))
+          continue;
+        }
+        double diff = std::fabs(a - b);
+        if(mode == CompareMode::Angle)
+        {
+          diff = std::min(diff, std::fabs(diff - EbsdLib::Constants::k_2PiD));
+        }
+        else if(mode == CompareMode::Rodrigues && c == 3)
+        {
+          diff = (std::isinf(a) && std::isinf(b)) ? 0.0 : diff / std::max(1.0, std::fabs(b));
+        }
+        plus = std::max(plus, diff);
+        minus = std::max(minus, std::fabs(a + b));
+      }
+      maxDiff = std::max(maxDiff, mode == CompareMode::Quaternion ? std::min(plus, minus) : plus);
+    }
+    return maxDiff;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void TestBatchConversions()
+  {
+    using OrientationType = Orientation<T>;
+    using QuaternionType = Quaternion<T>;
+    namespace OT = OrientationTransformation;
+    const double tolerance = std::is_same<T, float>::value ? 1.0E-5 : 1.0E-12;
+
+    std::cout << "  Batch conversions use " << OT::Batch::InstructionSet() << std::endl;
+
+    // Euler grid that includes Phi = 0 and Phi = Pi and more tuples than one internal block
+    const size_t nSteps = 16;
+    const size_t count = (nSteps + 1) * (nSteps + 1) * (nSteps + 1);
+    std::vector<T> eu(3 * count);
+    size_t tuple = 0;
+    for(size_t i = 0; i <= nSteps; i++)
+    {
+      for(size_t j = 0; j <= nSteps; j++)
+      {
+        for(size_t k = 0; k <= nSteps; k++)
+        {
+          eu[tuple] = static_cast<T>(i * EbsdLib::Constants::k_2PiD / nSteps);
+          eu[count + tuple] = static_cast<T>(j * EbsdLib::Constants::k_PiD / nSteps);
+          eu[2 * count + tuple] = static_cast<T>(k * EbsdLib::Constants::k_2PiD / nSteps);
+          tuple++;
+        }
+      }
+    }
+
+    // eu2qu
+    std::vector<T> qu = ScalarReference<T, 3, 4, OrientationType, QuaternionType>(eu, [](const OrientationType& in) { return OT::eu2qu<OrientationType, QuaternionType>(in); });
+    std::vector<T> batch(4 * count);
+    OT::Batch::eu2qu(MakeConstSpan<T, 3>(eu), MakeSpan<T, 4>(batch));
+    DREAM3D_REQUIRED(MaxDifference(batch, qu, 4, CompareMode::Quaternion), <, tolerance)
+
+    // qu2eu
+    std::vector<T> scalar = ScalarReference<T, 4, 3, QuaternionType, OrientationType>(qu, [](const QuaternionType& in) { return OT::qu2eu<QuaternionType, OrientationType>(in); });
+    batch.resize(3 * count);
+    OT::Batch::qu2eu(MakeConstSpan<T, 4>(qu), MakeSpan<T, 3>(batch));
+    DREAM3D_REQUIRED(MaxDifference(batch, scalar, 3, CompareMode::Angle), <, tolerance)
+
+    // qu2om
+    std::vector<T> om = ScalarReference<T, 4, 9, QuaternionType, OrientationType>(qu, [](const QuaternionType& in) { return OT::qu2om<QuaternionType, OrientationType>(in); });
+    batch.resize(9 * count);
+    OT::Batch::qu2om(MakeConstSpan<T, 4>(qu), MakeSpan<T, 9>(batch));
+    DREAM3D_REQUIRED(MaxDifference(batch, om, 9, CompareMode::Absolute), <, tolerance)
+
+    // om2qu
+    scalar = ScalarReference<T, 9, 4, OrientationType, QuaternionType>(om, [](const OrientationType& in) { return OT::om2qu<OrientationType, QuaternionType>(in); });
+    batch.resize(4 * count);
+    OT::Batch::om2qu(MakeConstSpan<T, 9>(om), MakeSpan<T, 4>(batch));
+    DREAM3D_REQUIRED(MaxDifference(batch, scalar, 4, CompareMode::Quaternion), <, tolerance)
+
+    // qu2ro
+    std::vector<T> ro = ScalarReference<T, 4, 4, QuaternionType, OrientationType>(qu, [](const QuaternionType& in) { return OT::qu2ro<QuaternionType, OrientationType>(in); });
+    batch.resize(4 * count);
+    OT::Batch::qu2ro(MakeConstSpan<T, 4>(qu), MakeSpan<T, 4>(batch));
+    DREAM3D_REQUIRED(MaxDifference(batch, ro, 4, CompareMode::Rodrigues), <, tolerance)
+
+    // ro2qu
+    scalar = ScalarReference<T, 4, 4, OrientationType, QuaternionType>(ro, [](const OrientationType& in) { return OT::ro2qu<OrientationType, QuaternionType>(in); });
+    batch.resize(4 * count);
+    OT::Batch::ro2qu(MakeConstSpan<T, 4>(ro), MakeSpan<T, 4>(batch));
+    DREAM3D_REQUIRED(MaxDifference(batch, scalar, 4, CompareMode::Absolute), <, tolerance)
+
+    // qu2ho
+    std::vector<T> ho = ScalarReference<T, 4, 3, QuaternionType, OrientationType>(qu, [](const QuaternionType& in) { return OT::qu2ho<QuaternionType, OrientationType>(in); });
+    batch.resize(3 * count);
+    OT::Batch::qu2ho(MakeConstSpan<T, 4>(qu), MakeSpan<T, 3>(batch));
+    DREAM3D_REQUIRED(MaxDifference(batch, ho, 3, CompareMode::Absolute), <, tolerance)
+
+    // ho2qu
+    scalar = ScalarReference<T, 3, 4, OrientationType, QuaternionType>(ho, [](const OrientationType& in) { return OT::ho2qu<OrientationType, QuaternionType>(in); });
+    batch.resize(4 * count);
+    OT::Batch::ho2qu(MakeConstSpan<T, 3>(ho), MakeSpan<T, 4>(batch));
+    DREAM3D_REQUIRED(MaxDifference(batch, scalar, 4, CompareMode::Absolute), <, tolerance)
+
+    // Mismatched spans are rejected
+    bool didThrow = false;
+    try
+    {
+      OT::Batch::eu2qu(MakeConstSpan<T, 3>(eu), MakeSpan<T, 4>(om));
+    } catch(const std::invalid_argument&)
+    {
+      didThrow = true;
+    }
+    DREAM3D_REQUIRE(didThrow)
+  }
+
   void operator()()
   {
     std::cout << "<===== Start " << getNameOfClass() << std::endl;
@@ -564,6 +757,9 @@ public:
 
     StartTest();
 
+    DREAM3D_REGISTER_TEST(TestBatchConversions<float>());
+    DREAM3D_REGISTER_TEST(TestBatchConversions<double>());
+
     DREAM3D_REGISTER_TEST(RemoveTestFiles());
   }
 
@@ -0,0 +1,477 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/EbsdMacros.h"
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/LaueOps/LaueOps.h"
+#include "EbsdLib/LaueOps/PoleFigureAccumulator.h"
+#include "EbsdLib/Math/EbsdLibMath.h"
+#include "EbsdLib/Math/RandomService.h"
+#include "EbsdLib/Utilities/ColorTable.h"
+#include "EbsdLib/Utilities/ComputeStereographicProjection.h"
+#include "EbsdLib/Utilities/PoleFigureUtilities.h"
+
+#include "UnitTestSupport.hpp"
+
+class PoleFigureAccumulatorTest
+{
+public:
+  PoleFigureAccumulatorTest() = default;
+  ~PoleFigureAccumulatorTest() = default;
+
+  PoleFigureAccumulatorTest(const PoleFigureAccumulatorTest&) = delete;            // Copy Constructor Not Implemented
+  PoleFigureAccumulatorTest(PoleFigureAccumulatorTest&&) = delete;                 // Move Constructor Not Implemented
+  PoleFigureAccumulatorTest& operator=(const PoleFigureAccumulatorTest&) = delete; // Copy Assignment Not Implemented
+  PoleFigureAccumulatorTest& operator=(PoleFigureAccumulatorTest&&) = delete;      // Move Assignment Not Implemented
+
+  EBSD_GET_NAME_OF_CLASS_DECL(PoleFigureAccumulatorTest)
+
+  // -----------------------------------------------------------------------------
+  void TestPoleFigureChunkedProjection()
+  {
+    // The number of directions in the three pole figure families of each Laue class
+    const std::array<std::array<size_t, 3>, 11> symSizes = {{{2, 6, 6}, {6, 12, 8}, {2, 2, 2}, {6, 12, 8}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 4, 4}, {2, 2, 2}, {2, 2, 2}}};
+
+    // More orientations than one chunk of the projection
+    const size_t numOrientations = 20000;
+    std::vector<size_t> cDims(1, 3);
+    EbsdLib::FloatArrayType::Pointer eulers = EbsdLib::FloatArrayType::CreateArray(numOrientations, cDims, "Eulers", true);
+    EbsdLib::RandomService::EngineType generator = EbsdLib::RandomService::CreateEngine(2468);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    for(size_t i = 0; i < numOrientations; i++)
+    {
+      eulers->setValue(i * 3, distribution(generator) * EbsdLib::Constants::k_2PiF);
+      eulers->setValue(i * 3 + 1, std::acos(2.0f * distribution(generator) - 1.0f));
+      eulers->setValue(i * 3 + 2, distribution(generator) * EbsdLib::Constants::k_2PiF);
+    }
+
+    std::vector<LaueOps::Pointer> allOps = LaueOps::GetAllOrientationOps();
+    for(size_t laueIndex = 0; laueIndex < EbsdLib::CrystalStructure::LaueGroupEnd; laueIndex++)
+    {
+      for(bool discrete : {true, false})
+      {
+        PoleFigureConfiguration_t config;
+        config.eulers = eulers.get();
+        config.imageDim = 64;
+        config.lambertDim = 32;
+        config.numColors = 32;
+        config.minScale = 0.0;
+        config.maxScale = 0.0;
+        config.sphereRadius = 1.0f;
+        config.discrete = discrete;
+        config.discreteHeatMap = false;
+        std::vector<EbsdLib::UInt8ArrayType::Pointer> images = allOps[laueIndex]->generatePoleFigure(config);
+        DREAM3D_REQUIRE_EQUAL(images.size(), 3)
+
+        // Project all the sphere coordinates at once like generatePoleFigure used to
+        std::array<EbsdLib::FloatArrayType::Pointer, 3> xyz;
+        for(size_t family = 0; family < 3; family++)
+        {
+          xyz[family] = EbsdLib::FloatArrayType::CreateArray(numOrientations * symSizes[laueIndex][family], cDims, "xyzCoords", true);
+        }
+        allOps[laueIndex]->generateSphereCoordsFromEulers(eulers.get(), xyz[0].get(), xyz[1].get(), xyz[2].get());
+        PoleFigureConfiguration_t expectedConfig = config;
+        std::array<EbsdLib::DoubleArrayType::Pointer, 3> intensities;
+        double maxValue = std::numeric_limits<double>::min();
+        double minValue = std::numeric_limits<double>::max();
+        for(size_t family = 0; family < 3; family++)
+        {
+          intensities[family] = EbsdLib::DoubleArrayType::CreateArray(static_cast<size_t>(config.imageDim * config.imageDim), "Intensity", true);
+          ComputeStereographicProjection projection(xyz[family].get(), &expectedConfig, intensities[family].get());
+          projection();
+          for(size_t i = 0; i < intensities[family]->getNumberOfTuples(); i++)
+          {
+            maxValue = std::max(maxValue, intensities[family]->getValue(i));
+            minValue = std::min(minValue, intensities[family]->getValue(i));
+          }
+        }
+        // Only the order of the floating point sums differs for the Lambert projection
+        DREAM3D_REQUIRED(std::abs(config.maxScale - maxValue), <=, 1.0E-9 * std::abs(maxValue))
+        DREAM3D_REQUIRED(std::abs(config.minScale - minValue), <=, 1.0E-9 * std::abs(maxValue))
+        expectedConfig.minScale = minValue;
+        expectedConfig.maxScale = maxValue;
+
+        size_t numDifferent = 0;
+        for(size_t family = 0; family < 3; family++)
+        {
+          EbsdLib::UInt8ArrayType::Pointer expected = EbsdLib::UInt8ArrayType::CreateArray(static_cast<size_t>(config.imageDim * config.imageDim), std::vector<size_t>(1, 4), "Expected", true);
+          PoleFigureUtilities::CreateColorImage(intensities[family].get(), expectedConfig, expected.get());
+          for(size_t i = 0; i < expected->getSize(); i++)
+          {
+            numDifferent += (expected->getValue(i) != images[family]->getValue(i)) ? 1 : 0;
+          }
+        }
+        if(discrete)
+        {
+          DREAM3D_REQUIRE_EQUAL(numDifferent, 0)
+        }
+        else
+        {
+          DREAM3D_REQUIRED(numDifferent, <, 3 * 64 * 64 * 4 / 100)
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestPoleFigureAccumulator()
+  {
+    const size_t numOrientations = 20000;
+    std::vector<size_t> cDims(1, 3);
+    EbsdLib::FloatArrayType::Pointer eulers = EbsdLib::FloatArrayType::CreateArray(numOrientations, cDims, "Eulers", true);
+    EbsdLib::RandomService::EngineType generator = EbsdLib::RandomService::CreateEngine(97531);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    for(size_t i = 0; i < numOrientations; i++)
+    {
+      eulers->setValue(i * 3, distribution(generator) * EbsdLib::Constants::k_2PiF);
+      eulers->setValue(i * 3 + 1, std::acos(2.0f * distribution(generator) - 1.0f));
+      eulers->setValue(i * 3 + 2, distribution(generator) * EbsdLib::Constants::k_2PiF);
+    }
+
+    std::vector<LaueOps::Pointer> allOps = LaueOps::GetAllOrientationOps();
+    for(uint32_t laueIndex : {EbsdLib::CrystalStructure::Cubic_High, EbsdLib::CrystalStructure::Hexagonal_High, EbsdLib::CrystalStructure::OrthoRhombic})
+    {
+      for(bool discrete : {true, false})
+      {
+        PoleFigureConfiguration_t config;
+        config.eulers = eulers.get();
+        config.imageDim = 64;
+        config.lambertDim = 32;
+        config.numColors = 32;
+        config.minScale = 0.0;
+        config.maxScale = 0.0;
+        config.sphereRadius = 1.0f;
+        config.discrete = discrete;
+        config.discreteHeatMap = false;
+        config.order = {2, 0, 1};
+        std::vector<EbsdLib::UInt8ArrayType::Pointer> expected = allOps[laueIndex]->generatePoleFigure(config);
+
+        // Uneven batches into one accumulator and the rest into a second one that is merged
+        PoleFigureAccumulator accumulator(*allOps[laueIndex], config);
+        PoleFigureAccumulator second(laueIndex, config);
+        const std::array<size_t, 4> batchEnds = {1, 1000, 12000, numOrientations};
+        size_t first = 0;
+        for(size_t batchEnd : batchEnds)
+        {
+          PoleFigureAccumulator& target = (batchEnd == numOrientations) ? second : accumulator;
+          target.add(eulers->getPointer(first * 3), batchEnd - first);
+          first = batchEnd;
+        }
+        accumulator.merge(second);
+        DREAM3D_REQUIRE_EQUAL(accumulator.getNumberOfOrientations(), numOrientations)
+
+        // Rendering does not consume the accumulated orientations
+        std::vector<EbsdLib::UInt8ArrayType::Pointer> partial = accumulator.createPoleFigures();
+        DREAM3D_REQUIRE_EQUAL(partial.size(), 3)
+
+        // A state round trip, like a merge from another process
+        PoleFigureAccumulator restored(laueIndex, config);
+        restored.mergeState(accumulator.getState());
+        DREAM3D_REQUIRE_EQUAL(restored.getNumberOfOrientations(), numOrientations)
+
+        double minScale = 0.0;
+        double maxScale = 0.0;
+        std::vector<EbsdLib::UInt8ArrayType::Pointer> images = restored.createPoleFigures(minScale, maxScale);
+        DREAM3D_REQUIRED(std::abs(config.maxScale - maxScale), <=, 1.0E-9 * std::abs(maxScale))
+        DREAM3D_REQUIRED(std::abs(config.minScale - minScale), <=, 1.0E-9 * std::abs(maxScale))
+
+        size_t numDifferent = 0;
+        for(size_t family = 0; family < 3; family++)
+        {
+          DREAM3D_REQUIRE_EQUAL(images[family]->getName(), expected[family]->getName())
+          DREAM3D_REQUIRE_EQUAL(images[family]->getSize(), expected[family]->getSize())
+          for(size_t i = 0; i < expected[family]->getSize(); i++)
+          {
+            numDifferent += (images[family]->getValue(i) != expected[family]->getValue(i)) ? 1 : 0;
+            numDifferent += (partial[family]->getValue(i) != expected[family]->getValue(i)) ? 1 : 0;
+          }
+        }
+        if(discrete)
+        {
+          DREAM3D_REQUIRE_EQUAL(numDifferent, 0)
+        }
+        else
+        {
+          DREAM3D_REQUIRED(numDifferent, <, 2 * 3 * 64 * 64 * 4 / 100)
+        }
+
+        bool caught = false;
+        try
+        {
+          restored.mergeState(std::vector<double>(3, 0.0));
+        } catch(const std::runtime_error&)
+        {
+          caught = true;
+        }
+        DREAM3D_REQUIRE(caught)
+
+        restored.reset();
+        DREAM3D_REQUIRE_EQUAL(restored.getNumberOfOrientations(), 0)
+        std::array<EbsdLib::DoubleArrayType::Pointer, 3> intensities = restored.computeIntensities();
+        for(const auto& intensity : intensities)
+        {
+          for(size_t i = 0; i < intensity->getNumberOfTuples(); i++)
+          {
+            DREAM3D_REQUIRE_EQUAL(intensity->getValue(i), 0.0)
+          }
+        }
+      }
+    }
+
+    bool caught = false;
+    try
+    {
+      PoleFigureConfiguration_t config;
+      config.imageDim = 64;
+      config.lambertDim = 32;
+      config.discrete = true;
+      PoleFigureAccumulator invalid(EbsdLib::CrystalStructure::LaueGroupEnd, config);
+    } catch(const std::out_of_range&)
+    {
+      caught = true;
+    }
+    DREAM3D_REQUIRE(caught)
+  }
+
+  // -----------------------------------------------------------------------------
+  template <typename Fn>
+  bool ThrowsRuntimeError(Fn&& fn)
+  {
+    try
+    {
+      fn();
+    } catch(const std::runtime_error&)
+    {
+      return true;
+    }
+    return false;
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestPoleFigureAccumulatorState()
+  {
+    PoleFigureConfiguration_t config;
+    config.imageDim = 32;
+    config.lambertDim = 16;
+    config.discrete = false;
+    std::array<float, 6> eulers = {0.1f, 0.2f, 0.3f, 1.0f, 0.5f, 2.0f};
+
+    std::vector<LaueOps::Pointer> allOps = LaueOps::GetAllOrientationOps();
+    PoleFigureAccumulator accumulator(*allOps[EbsdLib::CrystalStructure::Cubic_High], config);
+    accumulator.add(eulers.data(), 2);
+    std::vector<double> state = accumulator.getState();
+    DREAM3D_REQUIRE_EQUAL(state.size(), PoleFigureAccumulator::k_StateHeaderSize + 3 * 2 * 16 * 16)
+    DREAM3D_REQUIRE_EQUAL(state[0], static_cast<double>(EbsdLib::CrystalStructure::Cubic_High))
+    DREAM3D_REQUIRE_EQUAL(state[1], 0.0)
+    DREAM3D_REQUIRE_EQUAL(state[2], 32.0)
+    DREAM3D_REQUIRE_EQUAL(state[3], 16.0)
+    DREAM3D_REQUIRE_EQUAL(state[4], 2.0)
+
+    // Each differing header field is rejected by mergeState, and by merge for the matching accumulator
+    PoleFigureAccumulator target(EbsdLib::CrystalStructure::Cubic_High, config);
+    for(size_t field = 0; field < 4; field++)
+    {
+      std::vector<double> changed = state;
+      changed[field] = (field == 1) ? 1.0 : changed[field] + 1.0;
+      DREAM3D_REQUIRE(ThrowsRuntimeError([&]() { target.mergeState(changed); }))
+    }
+    DREAM3D_REQUIRE(ThrowsRuntimeError([&]() { target.mergeState(std::vector<double>(3, 0.0)); }))
+    DREAM3D_REQUIRE(ThrowsRuntimeError([&]() { target.mergeState(std::vector<double>(state.begin(), state.end() - 1)); }))
+    DREAM3D_REQUIRE_EQUAL(target.getNumberOfOrientations(), 0)
+
+    PoleFigureAccumulator otherLaue(EbsdLib::CrystalStructure::Hexagonal_High, config);
+    DREAM3D_REQUIRE(ThrowsRuntimeError([&]() { target.merge(otherLaue); }))
+    PoleFigureConfiguration_t discreteConfig = config;
+    discreteConfig.discrete = true;
+    PoleFigureAccumulator discrete(EbsdLib::CrystalStructure::Cubic_High, discreteConfig);
+    DREAM3D_REQUIRE(ThrowsRuntimeError([&]() { target.merge(discrete); }))
+    PoleFigureConfiguration_t imageConfig = config;
+    imageConfig.imageDim = 64;
+    PoleFigureAccumulator largerImage(EbsdLib::CrystalStructure::Cubic_High, imageConfig);
+    DREAM3D_REQUIRE(ThrowsRuntimeError([&]() { target.merge(largerImage); }))
+    PoleFigureConfiguration_t lambertConfig = config;
+    lambertConfig.lambertDim = 8;
+    PoleFigureAccumulator smallerLambert(EbsdLib::CrystalStructure::Cubic_High, lambertConfig);
+    DREAM3D_REQUIRE(ThrowsRuntimeError([&]() { target.merge(smallerLambert); }))
+
+    target.merge(accumulator);
+    DREAM3D_REQUIRE_EQUAL(target.getNumberOfOrientations(), 2)
+    target.mergeState(state);
+    DREAM3D_REQUIRE_EQUAL(target.getNumberOfOrientations(), 4)
+
+    // The default family sizes agree with the sizes of every Laue class
+    for(uint32_t laueIndex = 0; laueIndex < EbsdLib::CrystalStructure::LaueGroupEnd; laueIndex++)
+    {
+      std::array<size_t, 3> sizes = allOps[laueIndex]->getPoleFigureFamilySizes();
+      std::array<size_t, 3> defaultSizes = allOps[laueIndex]->LaueOps::getPoleFigureFamilySizes();
+      DREAM3D_REQUIRE(sizes == defaultSizes)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void SerialColorImage(const EbsdLib::DoubleArrayType& data, const PoleFigureConfiguration_t& config, std::vector<uint32_t>& rgba)
+  {
+    const int width = config.imageDim;
+    const int halfWidth = width / 2;
+    const float res = 2.0f / static_cast<float>(width);
+    const float max = static_cast<float>(config.maxScale);
+    const float min = static_cast<float>(config.minScale);
+    std::vector<float> colors(config.numColors * 3, 0.0f);
+    EbsdColorTable::GetColorTable(config.numColors, colors);
+    rgba.assign(static_cast<size_t>(width * width), 0);
+    for(int y = 0; y < width; y++)
+    {
+      for(int x = 0; x < width; x++)
+      {
+        float xtmp = static_cast<float>(x - halfWidth) * res + (res * 0.5f);
+        float ytmp = static_cast<float>(y - halfWidth) * res + (res * 0.5f);
+        size_t idx = static_cast<size_t>(width * y + x);
+        if((xtmp * xtmp + ytmp * ytmp) > 1.0)
+        {
+          rgba[idx] = 0xFFFFFFFF;
+          continue;
+        }
+        double value = (data.getValue(idx) - min) / (max - min);
+        int bin = std::min(static_cast<int>(value * config.numColors), config.numColors - 1);
+        std::array<float, 3> rgb = {0.0f, 0.0f, 0.0f};
+        if(bin >= 0 && !config.discreteHeatMap && config.discrete)
+        {
+          float frgb = (value > 0.0) ? 0.0f : 1.0f;
+          rgb = {frgb, frgb, frgb};
+        }
+        else if(bin >= 0)
+        {
+          rgb = {colors[3 * bin], colors[3 * bin + 1], colors[3 * bin + 2]};
+        }
+        rgba[idx] = EbsdLib::RgbColor::dRgb(static_cast<int>(rgb[0] * 255.0f), static_cast<int>(rgb[1] * 255.0f), static_cast<int>(rgb[2] * 255.0f), 255);
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestPoleFigureColorImage()
+  {
+    EbsdLib::RandomService::EngineType generator = EbsdLib::RandomService::CreateEngine(11235);
+    std::uniform_real_distribution<double> distribution(-0.5, 4.5);
+    for(int imageDim : {65, 256})
+    {
+      const size_t imageSize = static_cast<size_t>(imageDim * imageDim);
+      EbsdLib::DoubleArrayType::Pointer data = EbsdLib::DoubleArrayType::CreateArray(imageSize, "Intensity", true);
+      double expectedMin = std::numeric_limits<double>::max();
+      double expectedMax = std::numeric_limits<double>::min();
+      for(size_t i = 0; i < imageSize; i++)
+      {
+        // Leave some pixels at zero so the discrete pole figures have white pixels
+        double value = (i % 3 == 0) ? 0.0 : distribution(generator);
+        data->setValue(i, value);
+        expectedMin = std::min(expectedMin, value);
+        expectedMax = std::max(expectedMax, value);
+      }
+      double min = std::numeric_limits<double>::max();
+      double max = std::numeric_limits<double>::min();
+      PoleFigureUtilities::FindIntensityRange(*data, min, max);
+      DREAM3D_REQUIRE_EQUAL(min, expectedMin)
+      DREAM3D_REQUIRE_EQUAL(max, expectedMax)
+
+      for(bool discrete : {false, true})
+      {
+        for(bool discreteHeatMap : {false, true})
+        {
+          PoleFigureConfiguration_t config;
+          config.imageDim = imageDim;
+          config.numColors = 32;
+          // A scale narrower than the data so values below and above it are colored too
+          config.minScale = 0.25;
+          config.maxScale = 4.0;
+          config.discrete = discrete;
+          config.discreteHeatMap = discreteHeatMap;
+          EbsdLib::UInt8ArrayType::Pointer image = EbsdLib::UInt8ArrayType::CreateArray(imageSize, std::vector<size_t>(1, 4), "Image", true);
+          PoleFigureUtilities::CreateColorImage(data.get(), config, image.get());
+          std::vector<uint32_t> expected;
+          SerialColorImage(*data, config, expected);
+          const uint32_t* actual = reinterpret_cast<const uint32_t*>(image->getPointer(0));
+          for(size_t i = 0; i < imageSize; i++)
+          {
+            DREAM3D_REQUIRE_EQUAL(actual[i], expected[i])
+          }
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestFindIntensityRangeChunks()
+  {
+    // Larger than the grain of FindIntensityRange so the range of several tasks is merged
+    const size_t imageSize = 1024 * 1024;
+    EbsdLib::DoubleArrayType::Pointer data = EbsdLib::DoubleArrayType::CreateArray(imageSize, "Intensity", true);
+    for(size_t i = 0; i < imageSize; i++)
+    {
+      data->setValue(i, 1.0 + static_cast<double>(i % 1000) / 1000.0);
+    }
+    // The extremes in the first and the last chunk, then swapped
+    const std::array<std::array<size_t, 2>, 2> extremes = {{{5, imageSize - 3}, {imageSize - 3, 5}}};
+    for(const auto& positions : extremes)
+    {
+      data->setValue(positions[0], -2.5);
+      data->setValue(positions[1], 7.25);
+      double min = std::numeric_limits<double>::max();
+      double max = std::numeric_limits<double>::min();
+      PoleFigureUtilities::FindIntensityRange(*data, min, max);
+      DREAM3D_REQUIRE_EQUAL(min, -2.5)
+      DREAM3D_REQUIRE_EQUAL(max, 7.25)
+    }
+  }
+
+  void operator()()
+  {
+    std::cout << "<===== Start " << getNameOfClass() << std::endl;
+
+    int err = 0;
+    DREAM3D_REGISTER_TEST(TestPoleFigureChunkedProjection());
+    DREAM3D_REGISTER_TEST(TestPoleFigureAccumulator());
+    DREAM3D_REGISTER_TEST(TestPoleFigureAccumulatorState());
+    DREAM3D_REGISTER_TEST(TestPoleFigureColorImage());
+    DREAM3D_REGISTER_TEST(TestFindIntensityRangeChunks());
+  }
+};
@@ -0,0 +1,137 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdMacros.h"
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/Math/Philox.hpp"
+#include "EbsdLib/Math/RandomService.h"
+
+#include "UnitTestSupport.hpp"
+
+class RandomServiceTest
+{
+public:
+  RandomServiceTest() = default;
+  ~RandomServiceTest() = default;
+
+  RandomServiceTest(const RandomServiceTest&) = delete;            // Copy Constructor Not Implemented
+  RandomServiceTest(RandomServiceTest&&) = delete;                 // Move Constructor Not Implemented
+  RandomServiceTest& operator=(const RandomServiceTest&) = delete; // Copy Assignment Not Implemented
+  RandomServiceTest& operator=(RandomServiceTest&&) = delete;      // Move Assignment Not Implemented
+
+  EBSD_GET_NAME_OF_CLASS_DECL(RandomServiceTest)
+
+  // -----------------------------------------------------------------------------
+  void TestRandomService()
+  {
+    const uint64_t seed = 9876;
+    EbsdLib::RandomService::SetGlobalSeed(seed);
+    DREAM3D_REQUIRE_EQUAL(EbsdLib::RandomService::GetGlobalSeed(), seed)
+    std::vector<uint64_t> first(16);
+    for(auto& value : first)
+    {
+      value = EbsdLib::RandomService::GetThreadEngine()();
+    }
+
+    // Reseeding restarts the sequence of this thread even if another thread draws first
+    EbsdLib::RandomService::SetGlobalSeed(seed);
+    std::thread otherThread([]() { EbsdLib::RandomService::GetThreadEngine()(); });
+    otherThread.join();
+    EbsdLib::RandomService::EngineType expected = EbsdLib::RandomService::CreateEngine(seed, 0);
+    for(const auto& value : first)
+    {
+      DREAM3D_REQUIRE_EQUAL(value, expected())
+      DREAM3D_REQUIRE_EQUAL(EbsdLib::RandomService::GetThreadEngine()(), value)
+    }
+
+    EbsdLib::RandomService::EngineType stream0 = EbsdLib::RandomService::CreateEngine(seed, 0);
+    EbsdLib::RandomService::EngineType stream1 = EbsdLib::RandomService::CreateEngine(seed, 1);
+    DREAM3D_REQUIRE(stream0() != stream1())
+    DREAM3D_REQUIRE(EbsdLib::RandomService::CreateEngine(seed, 1)() == EbsdLib::RandomService::CreateEngine(seed, 1)())
+
+    EbsdLib::RandomService::ResetGlobalSeed();
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestPhiloxEngine()
+  {
+    // Known answers of Philox4x32-10 from the Random123 distribution
+    using CounterType = EbsdLib::PhiloxEngine::CounterType;
+    CounterType result = EbsdLib::PhiloxEngine::Generate({{0, 0, 0, 0}}, {{0, 0}});
+    DREAM3D_REQUIRE(result == CounterType({{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}}))
+    result = EbsdLib::PhiloxEngine::Generate({{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}}, {{0xffffffff, 0xffffffff}});
+    DREAM3D_REQUIRE(result == CounterType({{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}}))
+    result = EbsdLib::PhiloxEngine::Generate({{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}}, {{0xa4093822, 0x299f31d0}});
+    DREAM3D_REQUIRE(result == CounterType({{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}))
+
+    // The engine returns the words of counter (position, stream) under the key of the seed
+    const uint64_t seed = 0x299f31d0a4093822ULL;
+    EbsdLib::PhiloxEngine engine(seed, 7);
+    for(uint32_t position = 0; position < 2; position++)
+    {
+      result = EbsdLib::PhiloxEngine::Generate({{position, 0, 7, 0}}, {{0xa4093822, 0x299f31d0}});
+      const uint64_t expected0 = static_cast<uint64_t>(result[0]) | (static_cast<uint64_t>(result[1]) << 32);
+      const uint64_t expected1 = static_cast<uint64_t>(result[2]) | (static_cast<uint64_t>(result[3]) << 32);
+      DREAM3D_REQUIRE_EQUAL(engine(), expected0)
+      DREAM3D_REQUIRE_EQUAL(engine(), expected1)
+    }
+
+    EbsdLib::PhiloxEngine other(seed, 8);
+    EbsdLib::PhiloxEngine same(seed, 8);
+    double sum = 0.0;
+    for(int i = 0; i < 10000; i++)
+    {
+      double value = other.nextDouble();
+      DREAM3D_REQUIRE(value >= 0.0 && value < 1.0)
+      DREAM3D_REQUIRE_EQUAL(value, same.nextDouble())
+      DREAM3D_REQUIRE(other.nextIndex(24) < 24)
+      same.nextIndex(24);
+      sum += value;
+    }
+    DREAM3D_REQUIRED(std::abs(sum / 10000.0 - 0.5), <, 0.02)
+  }
+
+  void operator()()
+  {
+    std::cout << "<===== Start " << getNameOfClass() << std::endl;
+
+    int err = 0;
+    DREAM3D_REGISTER_TEST(TestRandomService());
+    DREAM3D_REGISTER_TEST(TestPhiloxEngine());
+  }
+};
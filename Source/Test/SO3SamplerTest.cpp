@@ -77,6 +77,67 @@ public:
     DREAM3D_REQUIRE_EQUAL(333227, orientations.size());
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void SO3ContiguousTest()
+  {
+    SO3Sampler::Pointer sampler = SO3Sampler::New();
+    for(int pgnum : {1, 3, 12, 18, 27, 28, 32})
+    {
+      SO3Sampler::OrientationListArrayType orientations = sampler->SampleRFZ(12, pgnum);
+      EbsdLib::DoubleArrayType::Pointer rodArray = sampler->SampleRFZArray(12, pgnum);
+      DREAM3D_REQUIRE_EQUAL(rodArray->getNumberOfTuples(), orientations.size())
+      DREAM3D_REQUIRE_EQUAL(rodArray->getNumberOfComponents(), 4)
+
+      // The streamed batches arrive in the same order as the list
+      size_t index = 0;
+      size_t numBatches = 0;
+      auto iter = orientations.begin();
+      bool same = true;
+      sampler->SampleRFZ(12, pgnum, [&](const double* rods, size_t count) {
+        numBatches++;
+        for(size_t i = 0; i < count; i++, index++, ++iter)
+        {
+          for(size_t c = 0; c < 4; c++)
+          {
+            same = same && (rods[i * 4 + c] == (*iter)[c]) && (rodArray->getValue(index * 4 + c) == (*iter)[c]);
+          }
+        }
+      });
+      DREAM3D_REQUIRE(same)
+      DREAM3D_REQUIRE_EQUAL(index, orientations.size())
+      DREAM3D_REQUIRE_EQUAL(numBatches, 24)
+
+      // A caller provided array is filled with the same values
+      EbsdLib::DoubleArrayType::Pointer callerArray = EbsdLib::DoubleArrayType::CreateArray(7, {4}, "Rodrigues", true);
+      sampler->SampleRFZArray(12, pgnum, *callerArray);
+      DREAM3D_REQUIRE_EQUAL(callerArray->getNumberOfTuples(), rodArray->getNumberOfTuples())
+      DREAM3D_REQUIRE(std::equal(rodArray->begin(), rodArray->end(), callerArray->begin()))
+    }
+
+    EbsdLib::DoubleArrayType::Pointer wrongArray = EbsdLib::DoubleArrayType::CreateArray(0, {3}, "Rodrigues", true);
+    bool wrongCaught = false;
+    try
+    {
+      sampler->SampleRFZArray(10, 1, *wrongArray);
+    } catch(const std::invalid_argument&)
+    {
+      wrongCaught = true;
+    }
+    DREAM3D_REQUIRE(wrongCaught)
+
+    bool caught = false;
+    try
+    {
+      sampler->SampleRFZArray(10, 33);
+    } catch(const std::out_of_range&)
+    {
+      caught = true;
+    }
+    DREAM3D_REQUIRE(caught)
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -137,6 +198,7 @@ public:
     DREAM3D_REGISTER_TEST(InsideCubicFZTest())
     DREAM3D_REGISTER_TEST(TestPyramid())
     DREAM3D_REGISTER_TEST(SO3CountTest())
+    DREAM3D_REGISTER_TEST(SO3ContiguousTest())
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
 };
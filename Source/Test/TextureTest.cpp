@@ -33,7 +33,11 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <iostream>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -49,6 +53,8 @@
 #include "EbsdLib/LaueOps/TriclinicOps.h"
 #include "EbsdLib/LaueOps/TrigonalLowOps.h"
 #include "EbsdLib/LaueOps/TrigonalOps.h"
+#include "EbsdLib/Math/DiscreteSampler.hpp"
+#include "EbsdLib/Math/RandomService.h"
 #include "EbsdLib/Texture/StatsGen.hpp"
 #include "EbsdLib/Texture/Texture.hpp"
 
@@ -186,6 +192,179 @@ public:
     TestTextureOdf<TrigonalOps>();
   }
 
+  /**
+   * @brief Spreads the components with the original serial triple loop of CalculateODFData before
+   * the normalization so that the kernel version can be checked against it.
+   */
+  template <class LaueOps>
+  float SerialSpreadODF(const std::vector<float>& e1s, const std::vector<float>& e2s, const std::vector<float>& e3s, const std::vector<float>& weights, const std::vector<float>& sigmas,
+                        std::vector<float>& odf)
+  {
+    LaueOps ops;
+    std::array<size_t, 3> odfNumBins = ops.getOdfNumBins();
+    odf.assign(static_cast<size_t>(ops.getODFSize()), 0.0f);
+    float totaladdweight = 0.0f;
+    for(size_t i = 0; i < e1s.size(); i++)
+    {
+      OrientationF eu(e1s[i], e2s[i], e3s[i]);
+      OrientationD rod = OrientationTransformation::eu2ro<OrientationF, OrientationD>(eu);
+      int bin = ops.getOdfBin(ops.getODFFZRod(rod));
+      int bin1 = static_cast<int>(bin % odfNumBins[0]);
+      int bin2 = static_cast<int>((bin / odfNumBins[0]) % odfNumBins[1]);
+      int bin3 = static_cast<int>(bin / (odfNumBins[0] * odfNumBins[1]));
+      for(int j = static_cast<int>(-sigmas[i]); j <= sigmas[i]; j++)
+      {
+        for(int k = static_cast<int>(-sigmas[i]); k <= sigmas[i]; k++)
+        {
+          for(int l = static_cast<int>(-sigmas[i]); l <= sigmas[i]; l++)
+          {
+            int addbin1 = bin1 + j;
+            int addbin2 = bin2 + k;
+            int addbin3 = bin3 + l;
+            bool good = addbin1 >= 0 && addbin1 < static_cast<int>(odfNumBins[0]) && addbin2 >= 0 && addbin2 < static_cast<int>(odfNumBins[1]) && addbin3 >= 0 &&
+                        addbin3 < static_cast<int>(odfNumBins[2]);
+            float dist = static_cast<float>(std::pow(static_cast<float>(j * j + k * k + l * l), 0.5));
+            float fraction = static_cast<float>(1.0 - (double(dist / int(sigmas[i])) * double(dist / int(sigmas[i]))));
+            if(dist <= int(sigmas[i]) && good)
+            {
+              float addweight = (sigmas[i] == 0.0f) ? weights[i] : weights[i] * fraction;
+              size_t addbin = (addbin3 * odfNumBins[0] * odfNumBins[1]) + (addbin2 * odfNumBins[0]) + addbin1;
+              odf[addbin] += addweight;
+              totaladdweight += addweight;
+            }
+          }
+        }
+      }
+    }
+    return totaladdweight;
+  }
+
+  template <class LaueOps>
+  void TestCalculateODFDataKernel()
+  {
+    // Components of several radii including one on the edge of the bin grid
+    std::vector<float> e1s = {0.1f, 1.2f, 2.5f, 0.0f, 0.7f, 0.3f};
+    std::vector<float> e2s = {0.2f, 0.4f, 0.9f, 0.0f, 0.3f, 0.5f};
+    std::vector<float> e3s = {0.3f, 0.8f, 1.1f, 0.0f, 0.2f, 0.9f};
+    std::vector<float> weights = {5000.0f, 20000.0f, 1000.0f, 3000.0f, 800.0f, 1500.0f};
+    std::vector<float> sigmas = {1.0f, 3.0f, 0.0f, 2.0f, 4.5f, 3.0f};
+
+    std::vector<float> expected;
+    float totaladdweight = SerialSpreadODF<LaueOps>(e1s, e2s, e3s, weights, sigmas, expected);
+    LaueOps ops;
+    float totalweight = static_cast<float>(ops.getODFSize());
+    for(auto& value : expected)
+    {
+      value = (totaladdweight > totalweight) ? value / (totaladdweight / totalweight) : value + (totalweight - totaladdweight) / totalweight;
+      value = value / totalweight;
+    }
+
+    std::vector<float> odf;
+    Texture::CalculateODFData<float, LaueOps, std::vector<float>>(e1s, e2s, e3s, weights, sigmas, true, odf, e1s.size());
+    DREAM3D_REQUIRE_EQUAL(odf.size(), expected.size())
+    float maxValue = *std::max_element(expected.begin(), expected.end());
+    for(size_t i = 0; i < odf.size(); i++)
+    {
+      DREAM3D_REQUIRED(std::abs(odf[i] - expected[i]), <=, 1.0E-5f * maxValue)
+    }
+
+    // Double containers use the same code path
+    std::vector<double> e1d(e1s.begin(), e1s.end());
+    std::vector<double> e2d(e2s.begin(), e2s.end());
+    std::vector<double> e3d(e3s.begin(), e3s.end());
+    std::vector<double> weightsD(weights.begin(), weights.end());
+    std::vector<double> sigmasD(sigmas.begin(), sigmas.end());
+    std::vector<double> odfD;
+    Texture::CalculateODFData<double, LaueOps, std::vector<double>>(e1d, e2d, e3d, weightsD, sigmasD, true, odfD, e1d.size());
+    DREAM3D_REQUIRE_EQUAL(odfD.size(), expected.size())
+    double sumD = 0.0;
+    double sumF = 0.0;
+    for(size_t i = 0; i < odfD.size(); i++)
+    {
+      sumD += odfD[i];
+      sumF += odf[i];
+    }
+    DREAM3D_REQUIRED(std::abs(sumD - sumF), <, 1.0E-3 * sumF)
+  }
+
+  void TestDiscreteSampler()
+  {
+    std::mt19937_64 generator(24680);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::vector<float> weights(5832);
+    for(size_t i = 0; i < weights.size(); i++)
+    {
+      // Leave some empty bins
+      weights[i] = (i % 5 == 0) ? 0.0f : static_cast<float>(distribution(generator));
+    }
+    float weightSum = 0.0f;
+    for(const auto& weight : weights)
+    {
+      weightSum += weight;
+    }
+    for(auto& weight : weights)
+    {
+      weight /= weightSum;
+    }
+
+    DiscreteSampler<float> sampler(weights, weights.size());
+    DREAM3D_REQUIRE_EQUAL(sampler.size(), weights.size())
+
+    // find() must choose the same bin as the linear scans it replaces
+    for(size_t n = 0; n < 20000; n++)
+    {
+      float random = static_cast<float>(distribution(generator));
+      size_t expected = 0;
+      float totaldensity = 0.0f;
+      for(size_t j = 0; j < weights.size(); j++)
+      {
+        float td1 = totaldensity;
+        totaldensity = totaldensity + weights[j];
+        if(random < totaldensity && random >= td1)
+        {
+          expected = j;
+          break;
+        }
+      }
+      DREAM3D_REQUIRE_EQUAL(sampler.find(random), expected)
+    }
+    DREAM3D_REQUIRE_EQUAL(sampler.find(-1.0f), 0)
+    DREAM3D_REQUIRE_EQUAL(sampler.find(2.0f), 0)
+
+    // sample() follows the weights
+    std::vector<double> counts(4, 0.0);
+    DiscreteSampler<double> smallSampler(std::vector<double>{1.0, 0.0, 2.0, 1.0}, 4);
+    const size_t numSamples = 100000;
+    for(size_t n = 0; n < numSamples; n++)
+    {
+      counts[smallSampler.sample(generator)]++;
+    }
+    DREAM3D_REQUIRE_EQUAL(counts[1], 0.0)
+    DREAM3D_REQUIRED(std::fabs(counts[0] / numSamples - 0.25), <, 0.01)
+    DREAM3D_REQUIRED(std::fabs(counts[2] / numSamples - 0.5), <, 0.01)
+  }
+
+  void TestGenODFPlotDataSeeded()
+  {
+    CubicOps ops;
+    std::vector<float> odf(static_cast<size_t>(ops.getODFSize()), 1.0f / static_cast<float>(ops.getODFSize()));
+    const size_t npoints = 10000;
+    std::vector<float> eulers(npoints * 3);
+    std::vector<float> again(npoints * 3);
+
+    EbsdLib::RandomService::SetGlobalSeed(13579);
+    StatsGen::GenODFPlotData<float, CubicOps, std::vector<float>>(odf, eulers.data(), npoints);
+    EbsdLib::RandomService::SetGlobalSeed(13579);
+    StatsGen::GenODFPlotData<float, CubicOps, std::vector<float>>(odf, again.data(), npoints);
+    // Sample i only depends on the seed and i, so fewer points give the same leading samples
+    std::vector<float> prefix(1234 * 3);
+    EbsdLib::RandomService::SetGlobalSeed(13579);
+    StatsGen::GenODFPlotData<float, CubicOps, std::vector<float>>(odf, prefix.data(), 1234);
+    EbsdLib::RandomService::ResetGlobalSeed();
+    DREAM3D_REQUIRE(eulers == again)
+    DREAM3D_REQUIRE(std::equal(prefix.begin(), prefix.end(), eulers.begin()))
+  }
+
   void operator()()
   {
     std::cout << "<===== Start " << getNameOfClass() << std::endl;
@@ -193,6 +372,11 @@ public:
     int err = EXIT_SUCCESS;
     DREAM3D_REGISTER_TEST(TestOdfGeneration())
     DREAM3D_REGISTER_TEST(TestMdfGeneration())
+    DREAM3D_REGISTER_TEST(TestCalculateODFDataKernel<CubicOps>())
+    DREAM3D_REGISTER_TEST(TestCalculateODFDataKernel<HexagonalOps>())
+    DREAM3D_REGISTER_TEST(TestCalculateODFDataKernel<OrthoRhombicOps>())
+    DREAM3D_REGISTER_TEST(TestDiscreteSampler())
+    DREAM3D_REGISTER_TEST(TestGenODFPlotDataSeeded())
   }
 
 public: